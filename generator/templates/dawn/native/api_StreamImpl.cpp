@@ -107,7 +107,8 @@ void stream::Stream<{{BoolCppType}}>::Write(stream::Sink* sink, const {{BoolCppT
 {% endcall %}
 
 {% call render_streaming_impl("dawn cache device descriptor", true, false,
-                              omits=["load data function", "store data function", "function userdata"]) %}
+                              omits=["load data function", "store data function", "function userdata",
+                                     "memory cache size"]) %}
 {% endcall %}
 
 {% call render_streaming_impl("extent 3D", true, true) %}
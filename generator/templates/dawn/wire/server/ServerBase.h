@@ -60,6 +60,11 @@ namespace dawn::wire::server {
             (procs.*WGPUTraits<T>::Release)(handle);
         }
 
+        //* Used for multithreaded clients, which reserve blocks of IDs for each thread.
+        void AllowOutOfOrderObjectIds() {
+            std::apply([](auto&... known) { (known.AllowOutOfOrderIds(), ...); }, mKnown);
+        }
+
         void DestroyAllObjects(const DawnProcTable& procs) {
             //* Release devices first to force completion of any async work.
             {
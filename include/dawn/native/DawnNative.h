@@ -147,6 +147,11 @@ struct DAWN_NATIVE_EXPORT DawnInstanceDescriptor : wgpu::ChainedStruct {
     WGPULoggingCallback loggingCallback = nullptr;
     void* loggingCallbackUserdata = nullptr;
 
+    // Byte budget of an in-memory cache shared by the blob caches of all the devices of the
+    // instance, so that devices with the same cache key reuse each other's shader compilations.
+    // Zero disables the shared cache.
+    uint64_t sharedBlobCacheSize = 0;
+
     // Equality operators, mostly for testing. Note that this tests
     // strict pointer-pointer equality if the struct contains member pointers.
     bool operator==(const DawnInstanceDescriptor& rhs) const;
@@ -202,6 +207,11 @@ DAWN_NATIVE_EXPORT std::vector<const char*> GetTogglesUsed(WGPUDevice device);
 // Backdoor to get the number of lazy clears for testing
 DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(WGPUDevice device);
 
+// Backdoor to get the peak and average number of bytes uploaded per serial through the staging
+// memory of the device, for testing.
+DAWN_NATIVE_EXPORT uint64_t GetPeakUploadUsagePerSerialForTesting(WGPUDevice device);
+DAWN_NATIVE_EXPORT uint64_t GetAverageUploadUsagePerSerialForTesting(WGPUDevice device);
+
 //  Query if texture has been initialized
 DAWN_NATIVE_EXPORT bool IsTextureSubresourceInitialized(
     WGPUTexture texture,
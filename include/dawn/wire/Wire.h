@@ -52,6 +52,16 @@ class DAWN_WIRE_EXPORT CommandSerializer {
     virtual bool Flush() = 0;
     virtual size_t GetMaximumAllocationSize() const = 0;
     virtual void OnSerializeError();
+
+    // Optional support for batching commands, enabled if CanReserveCmdSpace returns true.
+    // Reserve space for serializing several commands: return at least |minSize| bytes of
+    // contiguous space and its total size in |reservedSize|, or nullptr to indicate a fatal error
+    // like GetCmdSpace. Only the first |size| bytes of the reserved space are committed by the
+    // next call to CommitCmdSpace. GetCmdSpace and Flush are not called while space is reserved.
+    // The default implementations do not support batching.
+    virtual bool CanReserveCmdSpace() const;
+    virtual void* ReserveCmdSpace(size_t minSize, size_t* reservedSize);
+    virtual void CommitCmdSpace(size_t size);
 };
 
 class DAWN_WIRE_EXPORT CommandHandler {
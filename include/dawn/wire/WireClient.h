@@ -76,6 +76,15 @@ struct ReservedInstance {
 struct DAWN_WIRE_EXPORT WireClientDescriptor {
     CommandSerializer* serializer;
     client::MemoryTransferService* memoryTransferService = nullptr;
+    // Pack commands in space reserved with CommandSerializer::ReserveCmdSpace, if the serializer
+    // supports it. The commands are only committed by WireClient::Flush, which must be used
+    // instead of calling the serializer's Flush directly.
+    bool batchCommands = false;
+    // Allow calling the API from multiple threads concurrently. Each thread serializes commands
+    // in its own buffer and the buffers are merged in the order the commands were serialized by
+    // WireClient::Flush, which must be used instead of calling the serializer's Flush directly.
+    // Destroying or disconnecting the client must still not race with other calls.
+    bool multithreaded = false;
 };
 
 class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
@@ -85,6 +94,10 @@ class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
 
     const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
 
+    // Commits the batched commands and the commands of all the threads, if any, and flushes the
+    // serializer.
+    bool Flush();
+
     ReservedBuffer ReserveBuffer(WGPUDevice device, const WGPUBufferDescriptor* descriptor);
     ReservedTexture ReserveTexture(WGPUDevice device, const WGPUTextureDescriptor* descriptor);
     ReservedSwapChain ReserveSwapChain(WGPUDevice device,
@@ -181,6 +194,12 @@ class DAWN_WIRE_EXPORT MemoryTransferService {
         // There could be nothing to be serialized (if using shared memory)
         virtual void SerializeDataUpdate(void* serializePointer, size_t offset, size_t size) = 0;
 
+        // Gets called when the application gets a writable pointer to the subrange
+        // (offset, offset + size) of the allocation. Only the subranges reported since the last
+        // SerializeDataUpdate may have been modified, so implementations can use this to only
+        // transfer them. The default implementation does nothing.
+        virtual void OnGetMappedRange(size_t offset, size_t size);
+
       private:
         WriteHandle(const WriteHandle&) = delete;
         WriteHandle& operator=(const WriteHandle&) = delete;
@@ -191,6 +210,38 @@ class DAWN_WIRE_EXPORT MemoryTransferService {
     MemoryTransferService& operator=(const MemoryTransferService&) = delete;
 };
 
+// Sends the file descriptors of the shared memory regions used by the service returned by
+// CreateSharedMemoryTransferService() to the server process, out of band of the command stream.
+class DAWN_WIRE_EXPORT SharedMemoryHandleSender {
+  public:
+    SharedMemoryHandleSender();
+    virtual ~SharedMemoryHandleSender();
+
+    // Sends |fd| so that server::SharedMemoryHandleReceiver::TakeHandle(|id|) returns it. It
+    // must be received before the commands serialized after this call. |fd| stays owned by the
+    // caller. Returns false on failure.
+    virtual bool SendHandle(uint64_t id, int fd) = 0;
+
+  private:
+    SharedMemoryHandleSender(const SharedMemoryHandleSender&) = delete;
+    SharedMemoryHandleSender& operator=(const SharedMemoryHandleSender&) = delete;
+};
+
+// Creates a SharedMemoryHandleSender that sends the file descriptors with SCM_RIGHTS over
+// |socketFd|, a connected Unix domain socket of type SOCK_SEQPACKET or SOCK_DGRAM. The server
+// must use server::CreateSocketSharedMemoryHandleReceiver() with the other end of the socket.
+// |socketFd| must outlive the sender. Returns nullptr if this is not supported on this platform.
+DAWN_WIRE_EXPORT std::unique_ptr<SharedMemoryHandleSender> CreateSocketSharedMemoryHandleSender(
+    int socketFd);
+
+// Creates a MemoryTransferService that shares the mapped data with a server running on the same
+// host through shared memory, instead of copying it in the command stream. The file descriptor
+// of each shared memory region is sent with |handleSender|, which must outlive the service. The
+// server must use the service returned by server::CreateSharedMemoryTransferService(). Returns
+// nullptr if shared memory is not supported on this platform.
+DAWN_WIRE_EXPORT std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService(
+    SharedMemoryHandleSender* handleSender);
+
 // Backdoor to get the order of the ProcMap for testing
 DAWN_WIRE_EXPORT std::vector<std::string_view> GetProcMapNamesForTesting();
 }  // namespace client
@@ -45,6 +45,9 @@ struct DAWN_WIRE_EXPORT WireServerDescriptor {
     const DawnProcTable* procs;
     CommandSerializer* serializer;
     server::MemoryTransferService* memoryTransferService = nullptr;
+    // Must match WireClientDescriptor::multithreaded. A multithreaded client allocates object IDs
+    // out of order, which the server otherwise treats as a fatal error.
+    bool multithreadedClient = false;
 };
 
 class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -151,6 +154,34 @@ class DAWN_WIRE_EXPORT MemoryTransferService {
     MemoryTransferService(const MemoryTransferService&) = delete;
     MemoryTransferService& operator=(const MemoryTransferService&) = delete;
 };
+
+// Receives the file descriptors sent by a client::SharedMemoryHandleSender.
+class DAWN_WIRE_EXPORT SharedMemoryHandleReceiver {
+  public:
+    SharedMemoryHandleReceiver();
+    virtual ~SharedMemoryHandleReceiver();
+
+    // Returns the file descriptor that the client sent with |id| and transfers its ownership to
+    // the caller. Each descriptor can only be taken once. Returns -1 if there is none.
+    virtual int TakeHandle(uint64_t id) = 0;
+
+  private:
+    SharedMemoryHandleReceiver(const SharedMemoryHandleReceiver&) = delete;
+    SharedMemoryHandleReceiver& operator=(const SharedMemoryHandleReceiver&) = delete;
+};
+
+// Creates the server counterpart of client::CreateSocketSharedMemoryHandleSender(), that
+// receives the file descriptors from |socketFd| without blocking. |socketFd| must outlive the
+// receiver. Returns nullptr if this is not supported on this platform.
+DAWN_WIRE_EXPORT std::unique_ptr<SharedMemoryHandleReceiver>
+CreateSocketSharedMemoryHandleReceiver(int socketFd);
+
+// Creates the server counterpart of client::CreateSharedMemoryTransferService(). The file
+// descriptors of the shared memory regions are taken from |handleReceiver|, which must outlive the
+// service. Regions are only mapped if they are sealed against resizing. Returns nullptr if shared
+// memory is not supported on this platform.
+DAWN_WIRE_EXPORT std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService(
+    SharedMemoryHandleReceiver* handleReceiver);
 }  // namespace server
 
 }  // namespace dawn::wire
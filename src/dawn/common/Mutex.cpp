@@ -42,6 +42,23 @@ void Mutex::Lock() {
     mOwner.store(currentThread, std::memory_order_release);
 #endif  // DAWN_ENABLE_ASSERTS
 }
+
+bool Mutex::TryLock() {
+#if defined(DAWN_ENABLE_ASSERTS)
+    auto currentThread = std::this_thread::get_id();
+    DAWN_ASSERT(mOwner.load(std::memory_order_acquire) != currentThread);
+#endif  // DAWN_ENABLE_ASSERTS
+
+    if (!mNativeMutex.try_lock()) {
+        return false;
+    }
+
+#if defined(DAWN_ENABLE_ASSERTS)
+    mOwner.store(currentThread, std::memory_order_release);
+#endif  // DAWN_ENABLE_ASSERTS
+    return true;
+}
+
 void Mutex::Unlock() {
 #if defined(DAWN_ENABLE_ASSERTS)
     DAWN_ASSERT(IsLockedByCurrentThread());
@@ -50,6 +50,8 @@ class Mutex : public RefCounted, NonCopyable {
                 mMutex->Lock();
             }
         }
+        // Takes ownership of a mutex that is already locked by the current thread.
+        AutoLockBase(MutexRef mutex, std::adopt_lock_t) : mMutex(std::move(mutex)) {}
         ~AutoLockBase() {
             if (mMutex != nullptr) {
                 mMutex->Unlock();
@@ -68,6 +70,8 @@ class Mutex : public RefCounted, NonCopyable {
     ~Mutex() override;
 
     void Lock();
+    // Returns true if the mutex was acquired without blocking.
+    bool TryLock();
     void Unlock();
 
     // This method is only enabled when DAWN_ENABLE_ASSERTS is turned on.
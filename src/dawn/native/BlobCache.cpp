@@ -28,7 +28,11 @@
 #include "dawn/native/BlobCache.h"
 
 #include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
 
+#include "absl/hash/hash.h"
 #include "dawn/common/Assert.h"
 #include "dawn/common/Version_autogen.h"
 #include "dawn/native/CacheKey.h"
@@ -37,25 +41,129 @@
 
 namespace dawn::native {
 
-BlobCache::BlobCache(const dawn::native::DawnCacheDeviceDescriptor& desc)
-    : mLoadFunction(desc.loadDataFunction),
+namespace {
+
+std::string_view ToKeyView(const CacheKey& key) {
+    return std::string_view(reinterpret_cast<const char*>(key.data()), key.size());
+}
+
+}  // anonymous namespace
+
+BlobCache::BlobCache(const dawn::native::DawnCacheDeviceDescriptor& desc, BlobCache* sharedCache)
+    : mMemoryCacheShardBudget(static_cast<size_t>(desc.memoryCacheSize / kMemoryCacheShardCount)),
+      mSharedCache(sharedCache),
+      mLoadFunction(desc.loadDataFunction),
       mStoreFunction(desc.storeDataFunction),
-      mFunctionUserdata(desc.functionUserdata) {}
+      mFunctionUserdata(desc.functionUserdata) {
+    // The shared cache is only ever read through its memory tier.
+    DAWN_ASSERT(sharedCache == nullptr ||
+                (sharedCache->IsMemoryCacheEnabled() && sharedCache->mSharedCache == nullptr));
+}
+
+BlobCache::~BlobCache() = default;
 
 Blob BlobCache::Load(const CacheKey& key) {
-    std::lock_guard<std::mutex> lock(mMutex);
-    return LoadInternal(key);
+    if (!IsMemoryCacheEnabled() && mSharedCache == nullptr) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return LoadInternal(key);
+    }
+
+    DAWN_ASSERT(ValidateCacheKey(key));
+    std::string_view keyView = ToKeyView(key);
+    if (IsMemoryCacheEnabled()) {
+        if (Ref<CachedBlob> cached = MemoryCacheLoad(keyView); cached != nullptr) {
+            return cached->CreateSharedBlob();
+        }
+    }
+
+    Blob result;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        result = LoadInternal(key);
+    }
+    if (!result.Empty()) {
+        Ref<CachedBlob> cached = AcquireRef(new CachedBlob(std::move(result)));
+        StoreInMemory(keyView, cached);
+        return cached->CreateSharedBlob();
+    }
+
+    if (mSharedCache == nullptr) {
+        return result;
+    }
+    // Another BlobCache may have stored the blob in the shared cache. It is kept in this cache's
+    // memory tier too, without a copy, so that it survives eviction from the shared cache.
+    Ref<CachedBlob> shared = mSharedCache->MemoryCacheLoad(keyView);
+    if (shared == nullptr) {
+        return result;
+    }
+    if (IsMemoryCacheEnabled()) {
+        MemoryCacheStore(keyView, shared);
+    }
+    return shared->CreateSharedBlob();
+}
+
+Blob BlobCache::LoadLatest(const CacheKey& key) {
+    Blob result;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        result = LoadInternal(key);
+    }
+    if (result.Empty()) {
+        return Load(key);
+    }
+    if (!IsMemoryCacheEnabled() && mSharedCache == nullptr) {
+        return result;
+    }
+
+    // Refresh the memory tiers so that later loads see the latest data too.
+    Ref<CachedBlob> cached = AcquireRef(new CachedBlob(std::move(result)));
+    StoreInMemory(ToKeyView(key), cached);
+    return cached->CreateSharedBlob();
 }
 
 void BlobCache::Store(const CacheKey& key, size_t valueSize, const void* value) {
-    std::lock_guard<std::mutex> lock(mMutex);
-    StoreInternal(key, valueSize, value);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        StoreInternal(key, valueSize, value);
+    }
+
+    if (IsMemoryCacheEnabled() || mSharedCache != nullptr) {
+        Blob copy = CreateBlob(valueSize);
+        memcpy(copy.Data(), value, valueSize);
+        StoreInMemory(ToKeyView(key), AcquireRef(new CachedBlob(std::move(copy))));
+    }
 }
 
 void BlobCache::Store(const CacheKey& key, const Blob& value) {
     Store(key, value.Size(), value.Data());
 }
 
+void BlobCache::Store(const CacheKey& key, Blob&& value) {
+    if (!IsMemoryCacheEnabled() && mSharedCache == nullptr) {
+        Store(key, value.Size(), value.Data());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        StoreInternal(key, value.Size(), value.Data());
+    }
+    StoreInMemory(ToKeyView(key), AcquireRef(new CachedBlob(std::move(value))));
+}
+
+BlobCache::MemoryCacheStats BlobCache::GetMemoryCacheStats() {
+    MemoryCacheStats stats;
+    stats.hits = mMemoryCacheHits.load(std::memory_order_relaxed);
+    stats.misses = mMemoryCacheMisses.load(std::memory_order_relaxed);
+    stats.evictions = mMemoryCacheEvictions.load(std::memory_order_relaxed);
+    for (MemoryCacheShard& shard : mMemoryCacheShards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entryCount += shard.entries.size();
+        stats.byteSize += shard.byteSize;
+    }
+    return stats;
+}
+
 Blob BlobCache::LoadInternal(const CacheKey& key) {
     DAWN_ASSERT(ValidateCacheKey(key));
     if (mLoadFunction == nullptr) {
@@ -89,4 +197,85 @@ bool BlobCache::ValidateCacheKey(const CacheKey& key) {
            key.end();
 }
 
+bool BlobCache::IsMemoryCacheEnabled() const {
+    return mMemoryCacheShardBudget > 0;
+}
+
+BlobCache::MemoryCacheShard& BlobCache::GetMemoryCacheShard(std::string_view key) {
+    return mMemoryCacheShards[absl::Hash<std::string_view>()(key) % kMemoryCacheShardCount];
+}
+
+Ref<BlobCache::CachedBlob> BlobCache::MemoryCacheLoad(std::string_view key) {
+    MemoryCacheShard& shard = GetMemoryCacheShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end()) {
+        mMemoryCacheMisses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    mMemoryCacheHits.fetch_add(1, std::memory_order_relaxed);
+    return it->second->value;
+}
+
+void BlobCache::MemoryCacheStore(std::string_view key, Ref<CachedBlob> value) {
+    const size_t size = value->Size();
+    if (size > mMemoryCacheShardBudget) {
+        return;
+    }
+
+    MemoryCacheShard& shard = GetMemoryCacheShard(key);
+    // Evicted entries are moved out and released after the shard lock is dropped.
+    std::list<MemoryCacheShard::Entry> evicted;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            shard.byteSize -= it->second->value->Size();
+            it->second->value = std::move(value);
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        } else {
+            shard.lru.push_front({std::string(key), std::move(value)});
+            shard.entries.emplace(shard.lru.front().key, shard.lru.begin());
+        }
+        shard.byteSize += size;
+
+        // The entry that was just stored fits in the budget so it is never evicted here.
+        while (shard.byteSize > mMemoryCacheShardBudget) {
+            auto last = std::prev(shard.lru.end());
+            shard.entries.erase(last->key);
+            shard.byteSize -= last->value->Size();
+            evicted.splice(evicted.end(), shard.lru, last);
+            mMemoryCacheEvictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void BlobCache::StoreInMemory(std::string_view key, Ref<CachedBlob> value) {
+    if (mSharedCache != nullptr) {
+        mSharedCache->MemoryCacheStore(key, value);
+    }
+    if (IsMemoryCacheEnabled()) {
+        MemoryCacheStore(key, std::move(value));
+    }
+}
+
+BlobCache::CachedBlob::CachedBlob(Blob blob) : mBlob(std::move(blob)) {}
+
+BlobCache::CachedBlob::~CachedBlob() = default;
+
+Blob BlobCache::CachedBlob::CreateSharedBlob() {
+    // The deleter holds a reference that keeps the data alive as long as the returned Blob.
+    Ref<CachedBlob> self = this;
+    return Blob::UnsafeCreateWithDeleter(mBlob.Data(), mBlob.Size(),
+                                         [self = std::move(self)] {});
+}
+
+size_t BlobCache::CachedBlob::Size() const {
+    return mBlob.Size();
+}
+
 }  // namespace dawn::native
@@ -28,11 +28,20 @@
 #ifndef SRC_DAWN_NATIVE_BLOBCACHE_H_
 #define SRC_DAWN_NATIVE_BLOBCACHE_H_
 
+#include <array>
+#include <atomic>
+#include <list>
 #include <mutex>
+#include <string>
+#include <string_view>
 
+#include "absl/container/flat_hash_map.h"
 #include "dawn/common/Platform.h"
+#include "dawn/common/Ref.h"
+#include "dawn/common/RefCounted.h"
 #include "dawn/native/Blob.h"
 #include "dawn/native/CacheResult.h"
+#include "partition_alloc/pointers/raw_ptr.h"
 #include "partition_alloc/pointers/raw_ptr_exclusion.h"
 
 namespace dawn::platform {
@@ -45,16 +54,41 @@ class CacheKey;
 class InstanceBase;
 
 // This class should always be thread-safe because it may be called asynchronously.
+// When DawnCacheDeviceDescriptor::memoryCacheSize is non-zero, a bounded in-memory LRU tier sits in
+// front of the embedder's load and store functions so that hot keys are served without calling
+// into the embedder. Blobs returned from a memory hit share their data with the cached entry and
+// must not be modified.
+// A BlobCache may also be given a memory-only BlobCache that is shared with other BlobCaches, like
+// the instance's shared cache which is shared by all its devices. Stored blobs are added to the
+// shared cache, and loads that miss both the memory tier and the embedder fall back to it.
 class BlobCache {
   public:
-    explicit BlobCache(const dawn::native::DawnCacheDeviceDescriptor& desc);
+    struct MemoryCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t entryCount = 0;
+        uint64_t byteSize = 0;
+    };
+
+    explicit BlobCache(const dawn::native::DawnCacheDeviceDescriptor& desc,
+                       BlobCache* sharedCache = nullptr);
+    ~BlobCache();
 
     // Returns empty blob if the key is not found in the cache.
     Blob Load(const CacheKey& key);
+    // Like Load but asks the embedder before the memory tiers, which may hold older data for keys
+    // that are also written by other processes. Used for keys whose data is merged from several
+    // producers.
+    Blob LoadLatest(const CacheKey& key);
 
     // Value to store must be non-empty/non-null.
     void Store(const CacheKey& key, size_t valueSize, const void* value);
     void Store(const CacheKey& key, const Blob& value);
+    // Takes ownership of the blob so that the in-memory tier can keep it without a copy.
+    void Store(const CacheKey& key, Blob&& value);
+
+    MemoryCacheStats GetMemoryCacheStats();
 
     // Store a CacheResult into the cache if it isn't cached yet.
     // Calls T::ToBlob which should be defined elsewhere.
@@ -75,7 +109,54 @@ class BlobCache {
     // that the cache key contains the dawn version string in it.
     bool ValidateCacheKey(const CacheKey& key);
 
-    // Protects thread safety of access to mCache.
+    // A blob kept alive by the in-memory tier and by all the Blobs handed out for it.
+    class CachedBlob : public RefCounted {
+      public:
+        explicit CachedBlob(Blob blob);
+        ~CachedBlob() override;
+
+        // Returns a Blob that points to the same data and holds a reference on this CachedBlob.
+        Blob CreateSharedBlob();
+        size_t Size() const;
+
+      private:
+        Blob mBlob;
+    };
+
+    // The in-memory tier is split into shards by key hash so that concurrent lookups of different
+    // keys rarely contend. Each shard owns an equal part of the byte budget and its own LRU list.
+    struct MemoryCacheShard {
+        struct Entry {
+            std::string key;
+            Ref<CachedBlob> value;
+        };
+
+        std::mutex mutex;
+        // Most recently used entries are at the front.
+        std::list<Entry> lru;
+        // Keys are views into the strings owned by the list entries.
+        absl::flat_hash_map<std::string_view, std::list<Entry>::iterator> entries;
+        size_t byteSize = 0;
+    };
+    static constexpr size_t kMemoryCacheShardCount = 8;
+
+    bool IsMemoryCacheEnabled() const;
+    MemoryCacheShard& GetMemoryCacheShard(std::string_view key);
+    Ref<CachedBlob> MemoryCacheLoad(std::string_view key);
+    void MemoryCacheStore(std::string_view key, Ref<CachedBlob> value);
+    // Adds the value to the memory tier, if enabled, and to the shared cache, if any.
+    void StoreInMemory(std::string_view key, Ref<CachedBlob> value);
+
+    const size_t mMemoryCacheShardBudget;
+    std::array<MemoryCacheShard, kMemoryCacheShardCount> mMemoryCacheShards;
+    std::atomic<uint64_t> mMemoryCacheHits = 0;
+    std::atomic<uint64_t> mMemoryCacheMisses = 0;
+    std::atomic<uint64_t> mMemoryCacheEvictions = 0;
+
+    // The memory-only cache shared with other BlobCaches, if any. It outlives this BlobCache.
+    const raw_ptr<BlobCache> mSharedCache;
+
+    // Protects thread safety of access to the embedder's cache functions.
     std::mutex mMutex;
     // TODO(https://crbug.com/dawn/2365): Convert these members to `raw_ptr`.
     RAW_PTR_EXCLUSION WGPUDawnLoadCacheDataFunction mLoadFunction;
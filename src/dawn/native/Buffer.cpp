@@ -58,6 +58,10 @@
 namespace dawn::native {
 
 namespace {
+
+// The largest indirect buffer whose content is kept on the CPU for indirect draw validation.
+constexpr uint64_t kMaxImmutableContentSize = 64 * 1024;
+
 struct MapRequestTask : TrackTaskCallback {
     MapRequestTask(dawn::platform::Platform* platform, Ref<BufferBase> buffer, MapRequestID id)
         : TrackTaskCallback(platform), buffer(std::move(buffer)), id(id) {}
@@ -902,6 +906,10 @@ MaybeError BufferBase::Unmap() {
         return {};
     }
 
+    if (mState == BufferState::MappedAtCreation) {
+        KeepImmutableContentIfNeeded();
+    }
+
     // Make sure writes are now visibile to the GPU if we used a staging buffer.
     if (mState == BufferState::MappedAtCreation && mStagingBuffer != nullptr) {
         DAWN_TRY(CopyFromStagingBuffer());
@@ -910,6 +918,29 @@ MaybeError BufferBase::Unmap() {
     return {};
 }
 
+void BufferBase::KeepImmutableContentIfNeeded() {
+    DAWN_ASSERT(mState == BufferState::MappedAtCreation);
+    // Usages with which the buffer content may be written after it is unmapped.
+    constexpr wgpu::BufferUsage kWritableUsages =
+        wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Storage |
+        wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::MapWrite;
+    if (IsError() || mSize == 0 || mSize > kMaxImmutableContentSize ||
+        !(mUsage & wgpu::BufferUsage::Indirect) || (GetUsageExternalOnly() & kWritableUsages)) {
+        return;
+    }
+
+    const void* content = GetMappedRange(0, mSize, /*writable*/ false);
+    if (content == nullptr) {
+        return;
+    }
+    mImmutableContent = std::make_unique<uint8_t[]>(mSize);
+    memcpy(mImmutableContent.get(), content, mSize);
+}
+
+const uint8_t* BufferBase::GetImmutableContent() const {
+    return mImmutableContent.get();
+}
+
 void BufferBase::UnmapInternal(WGPUBufferMapAsyncStatus callbackStatus) {
     // Unmaps resources on the backend.
     if (mState == BufferState::PendingMap) {
@@ -116,6 +116,12 @@ class BufferBase : public SharedResource {
     void* GetMappedRange(size_t offset, size_t size, bool writable = true);
     MaybeError Unmap();
 
+    // Returns a copy of the content of the buffer if it is known on the CPU and can't change
+    // anymore, or nullptr otherwise. This is only the case for small indirect buffers that can
+    // only be written while they are mapped at creation, and lets indirect draws from them be
+    // validated on the CPU.
+    const uint8_t* GetImmutableContent() const;
+
     void DumpMemoryStatistics(dawn::native::MemoryDump* dump, const char* prefix) const;
 
     // Dawn API
@@ -164,6 +170,7 @@ class BufferBase : public SharedResource {
 
     virtual bool IsCPUWritableAtCreation() const = 0;
     MaybeError CopyFromStagingBuffer();
+    void KeepImmutableContentIfNeeded();
 
     MaybeError ValidateMapAsync(wgpu::MapMode mode,
                                 size_t offset,
@@ -186,6 +193,10 @@ class BufferBase : public SharedResource {
     // i.e. buffer->mStagingBuffer->mStagingBuffer... is not possible.
     Ref<BufferBase> mStagingBuffer;
 
+    // The content of the buffer, copied when it is unmapped after creation, if it can't change
+    // anymore. See GetImmutableContent.
+    std::unique_ptr<uint8_t[]> mImmutableContent;
+
     WGPUBufferMapCallback mMapCallback = nullptr;
     raw_ptr<void> mMapUserdata = nullptr;
     MapRequestID mLastMapID = MapRequestID(0);
@@ -37,6 +37,101 @@
 
 namespace dawn::native {
 
+namespace {
+
+std::unique_ptr<char[]> AllocateBlock(CommandBlockPool* pool, size_t size) {
+    if (pool != nullptr) {
+        return pool->AcquireBlock(size);
+    }
+    return std::unique_ptr<char[]>(new (std::nothrow) char[size]);
+}
+
+void FreeBlocks(CommandBlockPool* pool, CommandBlocks* blocks) {
+    if (pool != nullptr && !blocks->empty()) {
+        pool->ReleaseBlocks(std::move(*blocks));
+    }
+    blocks->clear();
+}
+
+}  // anonymous namespace
+
+CommandBlockPool::CommandBlockPool(size_t maxPooledSize) : mMaxPooledSize(maxPooledSize) {}
+
+CommandBlockPool::~CommandBlockPool() = default;
+
+// static
+size_t CommandBlockPool::GetSizeClass(size_t size) {
+    // CommandAllocator doubles the size of its blocks starting from twice the base size.
+    size_t sizeClass = 0;
+    for (size_t classSize = 2 * CommandAllocator::kDefaultBaseAllocationSize;
+         classSize <= CommandAllocator::kMaxBlockSize; classSize *= 2, sizeClass++) {
+        if (size == classSize) {
+            return sizeClass;
+        }
+    }
+    return kSizeClassCount;
+}
+
+std::unique_ptr<char[]> CommandBlockPool::AcquireBlock(size_t size) {
+    size_t sizeClass = GetSizeClass(size);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mAcquiredSinceTrim = true;
+        if (sizeClass < kSizeClassCount && !mFreeBlocks[sizeClass].empty()) {
+            std::unique_ptr<char[]> block = std::move(mFreeBlocks[sizeClass].back());
+            mFreeBlocks[sizeClass].pop_back();
+            mPooledSize -= size;
+            mHits++;
+            return block;
+        }
+        mMisses++;
+    }
+    return std::unique_ptr<char[]>(new (std::nothrow) char[size]);
+}
+
+void CommandBlockPool::ReleaseBlocks(CommandBlocks blocks) {
+    // The blocks that aren't kept are freed when `blocks` is destroyed, outside of the lock.
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (BlockDef& block : blocks) {
+        size_t sizeClass = GetSizeClass(block.size);
+        if (sizeClass == kSizeClassCount || mPooledSize + block.size > mMaxPooledSize) {
+            continue;
+        }
+        mFreeBlocks[sizeClass].push_back(std::move(block.block));
+        mPooledSize += block.size;
+    }
+}
+
+void CommandBlockPool::Trim() {
+    std::array<std::vector<std::unique_ptr<char[]>>, kSizeClassCount> freeBlocks;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::swap(freeBlocks, mFreeBlocks);
+        mPooledSize = 0;
+        mAcquiredSinceTrim = false;
+    }
+}
+
+void CommandBlockPool::TrimIfUnused() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mAcquiredSinceTrim) {
+            mAcquiredSinceTrim = false;
+            return;
+        }
+    }
+    Trim();
+}
+
+CommandBlockPool::Stats CommandBlockPool::GetStats() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Stats stats;
+    stats.hits = mHits;
+    stats.misses = mMisses;
+    stats.pooledSize = mPooledSize;
+    return stats;
+}
+
 // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
 CommandIterator::CommandIterator() {
@@ -50,6 +145,7 @@ CommandIterator::~CommandIterator() {
 CommandIterator::CommandIterator(CommandIterator&& other) {
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
+        mPool = std::move(other.mPool);
         other.Reset();
     }
     Reset();
@@ -59,20 +155,26 @@ CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
     DAWN_ASSERT(IsEmpty());
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
+        mPool = std::move(other.mPool);
         other.Reset();
     }
     Reset();
     return *this;
 }
 
-CommandIterator::CommandIterator(CommandAllocator allocator) : mBlocks(allocator.AcquireBlocks()) {
+CommandIterator::CommandIterator(CommandAllocator allocator)
+    : mBlocks(allocator.AcquireBlocks()), mPool(allocator.mPool) {
     Reset();
 }
 
 void CommandIterator::AcquireCommandBlocks(std::vector<CommandAllocator> allocators) {
     DAWN_ASSERT(IsEmpty());
     mBlocks.clear();
+    mPool = nullptr;
     for (CommandAllocator& allocator : allocators) {
+        if (mPool == nullptr) {
+            mPool = allocator.mPool;
+        }
         CommandBlocks blocks = allocator.AcquireBlocks();
         if (!blocks.empty()) {
             mBlocks.reserve(mBlocks.size() + blocks.size());
@@ -84,6 +186,10 @@ void CommandIterator::AcquireCommandBlocks(std::vector<CommandAllocator> allocat
     Reset();
 }
 
+const Ref<CommandBlockPool>& CommandIterator::GetBlockPool() const {
+    return mPool;
+}
+
 bool CommandIterator::NextCommandIdInNewBlock(uint32_t* commandId) {
     mCurrentBlock++;
     if (mCurrentBlock >= mBlocks.size()) {
@@ -113,7 +219,7 @@ void CommandIterator::MakeEmptyAsDataWasDestroyed() {
     }
 
     mCurrentPtr = reinterpret_cast<char*>(&mEndOfBlock);
-    mBlocks.clear();
+    FreeBlocks(mPool.Get(), &mBlocks);
     Reset();
     DAWN_ASSERT(IsEmpty());
 }
@@ -136,12 +242,18 @@ CommandAllocator::CommandAllocator() {
     ResetPointers();
 }
 
+CommandAllocator::CommandAllocator(Ref<CommandBlockPool> pool) : mPool(std::move(pool)) {
+    ResetPointers();
+}
+
 CommandAllocator::~CommandAllocator() {
     Reset();
 }
 
 CommandAllocator::CommandAllocator(CommandAllocator&& other)
-    : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+    : mBlocks(std::move(other.mBlocks)),
+      mPool(other.mPool),
+      mLastAllocationSize(other.mLastAllocationSize) {
     other.mBlocks.clear();
     if (!other.IsEmpty()) {
         mCurrentPtr = other.mCurrentPtr;
@@ -166,7 +278,7 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
 
 void CommandAllocator::Reset() {
     ResetPointers();
-    mBlocks.clear();
+    FreeBlocks(mPool.Get(), &mBlocks);
     mLastAllocationSize = kDefaultBaseAllocationSize;
 }
 
@@ -210,9 +322,9 @@ char* CommandAllocator::AllocateInNewBlock(uint32_t commandId,
 
 bool CommandAllocator::GetNewBlock(size_t minimumSize) {
     // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
-    mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
+    mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, kMaxBlockSize));
 
-    auto block = std::unique_ptr<char[]>(new (std::nothrow) char[mLastAllocationSize]);
+    std::unique_ptr<char[]> block = AllocateBlock(mPool.Get(), mLastAllocationSize);
     if (DAWN_UNLIKELY(block == nullptr)) {
         return false;
     }
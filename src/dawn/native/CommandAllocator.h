@@ -28,16 +28,20 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 #define SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string_view>
 #include <vector>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Math.h"
 #include "dawn/common/NonCopyable.h"
+#include "dawn/common/Ref.h"
+#include "dawn/common/RefCounted.h"
 #include "partition_alloc/pointers/raw_ptr_exclusion.h"
 
 namespace dawn::native {
@@ -69,6 +73,11 @@ namespace dawn::native {
 // and must tell the CommandIterator when the allocated commands have been processed for
 // deletion.
 
+// The allocators of a device share a CommandBlockPool so that the blocks of the command buffers
+// that were destroyed are reused by the next encoders instead of going through the system
+// allocator every time:
+//     CommandAllocator allocator(device->GetCommandBlockPool());
+
 // These are the lists of blocks, should not be used directly, only through CommandAllocator
 // and CommandIterator
 struct BlockDef {
@@ -82,6 +91,54 @@ constexpr uint32_t kEndOfBlock = std::numeric_limits<uint32_t>::max();
 constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
 }  // namespace detail
 
+// A thread-safe cache of free command blocks. CommandAllocator grows its blocks through a few
+// power of two sizes, and each of these sizes has a list of free blocks. Blocks of other sizes
+// are never pooled. The total size of the pooled blocks is capped, blocks released past the cap
+// are freed.
+class CommandBlockPool : public RefCounted {
+  public:
+    static constexpr size_t kDefaultMaxPooledSize = 4 * 1024 * 1024;
+
+    explicit CommandBlockPool(size_t maxPooledSize = kDefaultMaxPooledSize);
+
+    // Returns a block of `size` bytes, reusing a pooled block if there is one. Returns nullptr
+    // if the allocation failed.
+    std::unique_ptr<char[]> AcquireBlock(size_t size);
+    // Puts the blocks back in the pool, or frees them if they can't be pooled.
+    void ReleaseBlocks(CommandBlocks blocks);
+    // Frees all the pooled blocks.
+    void Trim();
+    // Frees all the pooled blocks if none were acquired since the previous call, so that the
+    // blocks are kept while encoders keep being created.
+    void TrimIfUnused();
+
+    struct Stats {
+        // The number of AcquireBlock calls that reused a pooled block.
+        uint64_t hits = 0;
+        // The number of AcquireBlock calls that had to allocate a block.
+        uint64_t misses = 0;
+        // The total size of the blocks currently in the pool.
+        size_t pooledSize = 0;
+    };
+    Stats GetStats();
+
+  private:
+    ~CommandBlockPool() override;
+
+    static constexpr size_t kSizeClassCount = 3;
+    // Returns the size class of blocks of `size` bytes, or kSizeClassCount if they aren't pooled.
+    static size_t GetSizeClass(size_t size);
+
+    const size_t mMaxPooledSize;
+
+    std::mutex mMutex;
+    std::array<std::vector<std::unique_ptr<char[]>>, kSizeClassCount> mFreeBlocks;
+    size_t mPooledSize = 0;
+    uint64_t mHits = 0;
+    uint64_t mMisses = 0;
+    bool mAcquiredSinceTrim = false;
+};
+
 class CommandAllocator;
 
 class CommandIterator : public NonCopyable {
@@ -97,6 +154,9 @@ class CommandIterator : public NonCopyable {
 
     void AcquireCommandBlocks(std::vector<CommandAllocator> allocators);
 
+    // The pool the blocks are returned to when they are destroyed, if any.
+    const Ref<CommandBlockPool>& GetBlockPool() const;
+
     template <typename E>
     bool NextCommandId(E* commandId) {
         return NextCommandId(reinterpret_cast<uint32_t*>(commandId));
@@ -158,6 +218,7 @@ class CommandIterator : public NonCopyable {
     }
 
     CommandBlocks mBlocks;
+    Ref<CommandBlockPool> mPool;
     // RAW_PTR_EXCLUSION: This is an extremely hot pointer during command iteration, but always
     // points to at least a valid uint32_t, either inside a block, or at mEndOfBlock.
     RAW_PTR_EXCLUSION char* mCurrentPtr = nullptr;
@@ -169,9 +230,12 @@ class CommandIterator : public NonCopyable {
 class CommandAllocator : public NonCopyable {
   public:
     CommandAllocator();
+    // Blocks are taken from and returned to `pool`, if it isn't nullptr.
+    explicit CommandAllocator(Ref<CommandBlockPool> pool);
     ~CommandAllocator();
 
-    // NOTE: A moved-from CommandAllocator is reset to its initial empty state.
+    // NOTE: A moved-from CommandAllocator is reset to its initial empty state. It keeps its pool
+    // and a move-constructed CommandAllocator uses the same pool.
     CommandAllocator(CommandAllocator&&);
     CommandAllocator& operator=(CommandAllocator&&);
 
@@ -221,7 +285,10 @@ class CommandAllocator : public NonCopyable {
 
     // The default value of mLastAllocationSize.
     static constexpr size_t kDefaultBaseAllocationSize = 2048;
+    // The size blocks grow up to, unless a single command needs a larger block.
+    static constexpr size_t kMaxBlockSize = 16384;
 
+    friend CommandBlockPool;
     friend CommandIterator;
     CommandBlocks&& AcquireBlocks();
 
@@ -274,6 +341,7 @@ class CommandAllocator : public NonCopyable {
     void ResetPointers();
 
     CommandBlocks mBlocks;
+    Ref<CommandBlockPool> mPool;
     size_t mLastAllocationSize = kDefaultBaseAllocationSize;
 
     // Data used for the block range at initialization so that the first call to Allocate sees
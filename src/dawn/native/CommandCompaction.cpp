@@ -0,0 +1,331 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/CommandCompaction.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/BitSetIterator.h"
+#include "dawn/common/Constants.h"
+#include "dawn/native/BindGroup.h"
+#include "dawn/native/Buffer.h"
+#include "dawn/native/CommandVisitor.h"
+#include "dawn/native/Commands.h"
+#include "dawn/native/ComputePipeline.h"
+#include "dawn/native/QuerySet.h"
+#include "dawn/native/RenderBundle.h"
+#include "dawn/native/RenderPipeline.h"
+#include "dawn/native/Texture.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::native {
+
+namespace {
+
+// Each piece of pass state that is set by a command is tracked in a slot.
+constexpr size_t kPipelineSlot = 0;
+constexpr size_t kFirstBindGroupSlot = kPipelineSlot + 1;
+constexpr size_t kFirstVertexBufferSlot = kFirstBindGroupSlot + kMaxBindGroups;
+constexpr size_t kIndexBufferSlot = kFirstVertexBufferSlot + kMaxVertexBuffers;
+constexpr size_t kViewportSlot = kIndexBufferSlot + 1;
+constexpr size_t kScissorRectSlot = kViewportSlot + 1;
+constexpr size_t kBlendConstantSlot = kScissorRectSlot + 1;
+constexpr size_t kStencilReferenceSlot = kBlendConstantSlot + 1;
+constexpr size_t kSlotCount = kStencilReferenceSlot + 1;
+static_assert(kSlotCount < 64);
+
+using SlotMask = std::bitset<kSlotCount>;
+
+constexpr uint64_t kAllSlotsBits = (uint64_t(1) << kSlotCount) - 1;
+// The state that is reset by executing render bundles. The rest of the state, like the viewport,
+// is used by the bundles' draws.
+constexpr uint64_t kBindingSlotsBits = (uint64_t(1) << kViewportSlot) - 1;
+
+constexpr SlotMask kAllSlots(kAllSlotsBits);
+constexpr SlotMask kBindingSlots(kBindingSlotsBits);
+constexpr SlotMask kDynamicStateSlots(kAllSlotsBits & ~kBindingSlotsBits);
+
+// A command setting some state, with its additional data.
+struct StateCommand {
+    Command type;
+    const void* cmd = nullptr;
+    const uint32_t* dynamicOffsets = nullptr;
+};
+
+bool SetsSameState(const StateCommand& a, const StateCommand& b) {
+    DAWN_ASSERT(a.type == b.type);
+    switch (a.type) {
+        case Command::SetComputePipeline:
+            return static_cast<const SetComputePipelineCmd*>(a.cmd)->pipeline ==
+                   static_cast<const SetComputePipelineCmd*>(b.cmd)->pipeline;
+        case Command::SetRenderPipeline:
+            return static_cast<const SetRenderPipelineCmd*>(a.cmd)->pipeline ==
+                   static_cast<const SetRenderPipelineCmd*>(b.cmd)->pipeline;
+        case Command::SetBindGroup: {
+            auto* cmdA = static_cast<const SetBindGroupCmd*>(a.cmd);
+            auto* cmdB = static_cast<const SetBindGroupCmd*>(b.cmd);
+            return cmdA->group == cmdB->group &&
+                   cmdA->dynamicOffsetCount == cmdB->dynamicOffsetCount &&
+                   std::equal(a.dynamicOffsets, a.dynamicOffsets + cmdA->dynamicOffsetCount,
+                              b.dynamicOffsets);
+        }
+        case Command::SetVertexBuffer: {
+            auto* cmdA = static_cast<const SetVertexBufferCmd*>(a.cmd);
+            auto* cmdB = static_cast<const SetVertexBufferCmd*>(b.cmd);
+            return cmdA->buffer == cmdB->buffer && cmdA->offset == cmdB->offset &&
+                   cmdA->size == cmdB->size;
+        }
+        case Command::SetIndexBuffer: {
+            auto* cmdA = static_cast<const SetIndexBufferCmd*>(a.cmd);
+            auto* cmdB = static_cast<const SetIndexBufferCmd*>(b.cmd);
+            return cmdA->buffer == cmdB->buffer && cmdA->format == cmdB->format &&
+                   cmdA->offset == cmdB->offset && cmdA->size == cmdB->size;
+        }
+        case Command::SetViewport: {
+            auto* cmdA = static_cast<const SetViewportCmd*>(a.cmd);
+            auto* cmdB = static_cast<const SetViewportCmd*>(b.cmd);
+            return cmdA->x == cmdB->x && cmdA->y == cmdB->y && cmdA->width == cmdB->width &&
+                   cmdA->height == cmdB->height && cmdA->minDepth == cmdB->minDepth &&
+                   cmdA->maxDepth == cmdB->maxDepth;
+        }
+        case Command::SetScissorRect: {
+            auto* cmdA = static_cast<const SetScissorRectCmd*>(a.cmd);
+            auto* cmdB = static_cast<const SetScissorRectCmd*>(b.cmd);
+            return cmdA->x == cmdB->x && cmdA->y == cmdB->y && cmdA->width == cmdB->width &&
+                   cmdA->height == cmdB->height;
+        }
+        case Command::SetBlendConstant:
+            return static_cast<const SetBlendConstantCmd*>(a.cmd)->color ==
+                   static_cast<const SetBlendConstantCmd*>(b.cmd)->color;
+        case Command::SetStencilReference:
+            return static_cast<const SetStencilReferenceCmd*>(a.cmd)->reference ==
+                   static_cast<const SetStencilReferenceCmd*>(b.cmd)->reference;
+        default:
+            DAWN_UNREACHABLE();
+    }
+}
+
+// Finds the redundant state commands of a command stream. For each slot it tracks the command
+// whose state the backend will see, and the command that set the slot since the last draw or
+// dispatch, if any. That pending command is removed if it is overwritten or discarded before a
+// draw or dispatch, or if it sets the state the backend already sees.
+class RedundantStateFinder {
+  public:
+    explicit RedundantStateFinder(std::vector<bool>* removed) : mRemoved(removed) {}
+
+    void OnSetState(size_t slot, size_t commandIndex, StateCommand command) {
+        if (mPending[slot]) {
+            Remove(mPendingIndices[slot]);
+        }
+        mPending.set(slot);
+        mPendingIndices[slot] = commandIndex;
+        mPendingCommands[slot] = command;
+    }
+
+    // The pending state of `slots` is used by a draw or dispatch.
+    void Use(SlotMask slots) {
+        for (size_t slot : IterateBitSet(mPending & slots)) {
+            if (mApplied[slot] && SetsSameState(mAppliedCommands[slot], mPendingCommands[slot])) {
+                Remove(mPendingIndices[slot]);
+            } else {
+                mApplied.set(slot);
+                mAppliedCommands[slot] = mPendingCommands[slot];
+            }
+        }
+        mPending &= ~slots;
+    }
+
+    // The pending state of `slots` can't be used anymore.
+    void Discard(SlotMask slots) {
+        for (size_t slot : IterateBitSet(mPending & slots)) {
+            Remove(mPendingIndices[slot]);
+        }
+        mPending &= ~slots;
+    }
+
+    // The state of `slots` seen by the backend is unknown from now on.
+    void Reset(SlotMask slots) { mApplied &= ~slots; }
+
+  private:
+    void Remove(size_t commandIndex) { (*mRemoved)[commandIndex] = true; }
+
+    raw_ptr<std::vector<bool>> mRemoved;
+    SlotMask mApplied;
+    SlotMask mPending;
+    std::array<StateCommand, kSlotCount> mAppliedCommands;
+    std::array<StateCommand, kSlotCount> mPendingCommands;
+    std::array<size_t, kSlotCount> mPendingIndices;
+};
+
+template <typename T>
+void MoveCommand(CommandAllocator* allocator, Command type, T* cmd) {
+    *allocator->Allocate<T>(type) = std::move(*cmd);
+}
+
+template <typename T, typename D>
+void MoveCommand(CommandAllocator* allocator, Command type, T* cmd, D* data, size_t count) {
+    MoveCommand(allocator, type, cmd);
+    // SetBindGroup has no data allocated when it has no dynamic offsets.
+    if (data != nullptr) {
+        std::move(data, data + count, allocator->AllocateData<D>(count));
+    }
+}
+
+// Moves the command to `allocator`, or skips it when `allocator` is nullptr.
+void MoveOrSkipCommand(CommandIterator* commands, CommandAllocator* allocator, Command type) {
+    VisitCommand(commands, type, [&](auto* cmd, auto... data) {
+        if (allocator != nullptr) {
+            MoveCommand(allocator, type, cmd, data...);
+        }
+    });
+}
+
+// Returns for each command whether it is a redundant state command.
+std::vector<bool> FindRedundantStateCommands(CommandIterator* commands) {
+    std::vector<bool> removed;
+    RedundantStateFinder finder(&removed);
+
+    Command type;
+    while (commands->NextCommandId(&type)) {
+        const size_t index = removed.size();
+        removed.push_back(false);
+
+        switch (type) {
+            case Command::SetComputePipeline:
+                finder.OnSetState(kPipelineSlot, index,
+                                  {type, commands->NextCommand<SetComputePipelineCmd>()});
+                break;
+            case Command::SetRenderPipeline:
+                finder.OnSetState(kPipelineSlot, index,
+                                  {type, commands->NextCommand<SetRenderPipelineCmd>()});
+                break;
+            case Command::SetBindGroup: {
+                auto* cmd = commands->NextCommand<SetBindGroupCmd>();
+                const uint32_t* dynamicOffsets = nullptr;
+                if (cmd->dynamicOffsetCount > 0) {
+                    dynamicOffsets = commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                }
+                finder.OnSetState(kFirstBindGroupSlot + static_cast<uint32_t>(cmd->index), index,
+                                  {type, cmd, dynamicOffsets});
+                break;
+            }
+            case Command::SetVertexBuffer: {
+                auto* cmd = commands->NextCommand<SetVertexBufferCmd>();
+                finder.OnSetState(kFirstVertexBufferSlot + static_cast<uint8_t>(cmd->slot), index,
+                                  {type, cmd});
+                break;
+            }
+            case Command::SetIndexBuffer:
+                finder.OnSetState(kIndexBufferSlot, index,
+                                  {type, commands->NextCommand<SetIndexBufferCmd>()});
+                break;
+            case Command::SetViewport:
+                finder.OnSetState(kViewportSlot, index,
+                                  {type, commands->NextCommand<SetViewportCmd>()});
+                break;
+            case Command::SetScissorRect:
+                finder.OnSetState(kScissorRectSlot, index,
+                                  {type, commands->NextCommand<SetScissorRectCmd>()});
+                break;
+            case Command::SetBlendConstant:
+                finder.OnSetState(kBlendConstantSlot, index,
+                                  {type, commands->NextCommand<SetBlendConstantCmd>()});
+                break;
+            case Command::SetStencilReference:
+                finder.OnSetState(kStencilReferenceSlot, index,
+                                  {type, commands->NextCommand<SetStencilReferenceCmd>()});
+                break;
+
+            case Command::Dispatch:
+            case Command::DispatchIndirect:
+            case Command::Draw:
+            case Command::DrawIndexed:
+            case Command::DrawIndirect:
+            case Command::DrawIndexedIndirect:
+            case Command::MultiDrawIndirect:
+            case Command::MultiDrawIndexedIndirect:
+                finder.Use(kAllSlots);
+                MoveOrSkipCommand(commands, nullptr, type);
+                break;
+
+            case Command::ExecuteBundles:
+                // Render bundles use the dynamic state of the pass, and leave the rest of the
+                // state unset.
+                finder.Use(kDynamicStateSlots);
+                finder.Discard(kBindingSlots);
+                finder.Reset(kBindingSlots);
+                MoveOrSkipCommand(commands, nullptr, type);
+                break;
+
+            case Command::BeginComputePass:
+            case Command::BeginRenderPass:
+            case Command::EndComputePass:
+            case Command::EndRenderPass:
+                // Passes start with the backend's default state, which isn't known here.
+                finder.Discard(kAllSlots);
+                finder.Reset(kAllSlots);
+                MoveOrSkipCommand(commands, nullptr, type);
+                break;
+
+            default:
+                MoveOrSkipCommand(commands, nullptr, type);
+                break;
+        }
+    }
+    commands->Reset();
+
+    return removed;
+}
+
+}  // anonymous namespace
+
+CommandIterator RemoveRedundantStateCommands(CommandIterator* commands,
+                                             CommandCompactionStats* stats) {
+    std::vector<bool> removed = FindRedundantStateCommands(commands);
+
+    stats->commandCount = removed.size();
+    stats->removedCommandCount = std::count(removed.begin(), removed.end(), true);
+    if (stats->removedCommandCount == 0) {
+        return std::move(*commands);
+    }
+
+    CommandAllocator allocator(commands->GetBlockPool());
+    Command type;
+    for (size_t index = 0; commands->NextCommandId(&type); ++index) {
+        MoveOrSkipCommand(commands, removed[index] ? nullptr : &allocator, type);
+    }
+    FreeCommands(commands);
+
+    return CommandIterator(std::move(allocator));
+}
+
+}  // namespace dawn::native
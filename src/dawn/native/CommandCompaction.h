@@ -0,0 +1,54 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_COMMANDCOMPACTION_H_
+#define SRC_DAWN_NATIVE_COMMANDCOMPACTION_H_
+
+#include <cstdint>
+
+#include "dawn/native/CommandAllocator.h"
+
+namespace dawn::native {
+
+struct CommandCompactionStats {
+    // The number of commands before compaction, not counting their additional data.
+    uint64_t commandCount = 0;
+    uint64_t removedCommandCount = 0;
+};
+
+// Returns the commands of a finished command buffer without the state setting commands of its
+// passes that don't change the state seen by the backend: those setting the state to the value
+// it already has at the next draw or dispatch, and those that are overwritten or discarded
+// before any draw or dispatch uses them. The remaining commands are kept in the same order.
+// `commands` is freed and must not be used anymore. Pointers to the commands, like the ones held
+// by IndirectDrawMetadata, are invalidated so this must only run once the commands are final.
+CommandIterator RemoveRedundantStateCommands(CommandIterator* commands,
+                                             CommandCompactionStats* stats);
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_COMMANDCOMPACTION_H_
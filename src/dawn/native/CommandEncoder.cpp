@@ -45,6 +45,7 @@
 #include "dawn/native/ChainUtils.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandBufferStateTracker.h"
+#include "dawn/native/CommandCompaction.h"
 #include "dawn/native/CommandValidation.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/ComputePassEncoder.h"
@@ -1100,7 +1101,19 @@ CommandBufferResourceUsage CommandEncoder::AcquireResourceUsages() {
 }
 
 CommandIterator CommandEncoder::AcquireCommands() {
-    return mEncodingContext.AcquireCommands();
+    CommandIterator commands = mEncodingContext.AcquireCommands();
+
+    // The indirect draw validation is done when the render passes end so the commands are final
+    // and can be compacted.
+    DeviceBase* device = GetDevice();
+    if (!device->IsToggleEnabled(Toggle::RemoveRedundantStateCommands)) {
+        return commands;
+    }
+    TRACE_EVENT0(device->GetPlatform(), Recording, "CommandEncoder::RemoveRedundantStateCommands");
+    CommandCompactionStats stats;
+    CommandIterator compacted = RemoveRedundantStateCommands(&commands, &stats);
+    device->AddCommandCompactionStats(stats);
+    return compacted;
 }
 
 void CommandEncoder::TrackUsedQuerySet(QuerySetBase* querySet) {
@@ -0,0 +1,168 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_COMMANDVISITOR_H_
+#define SRC_DAWN_NATIVE_COMMANDVISITOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Compiler.h"
+#include "dawn/native/CommandAllocator.h"
+#include "dawn/native/Commands.h"
+
+namespace dawn::native {
+
+class RenderBundleBase;
+
+namespace detail {
+
+template <typename T, typename Visitor>
+DAWN_FORCE_INLINE decltype(auto) VisitCommand(CommandIterator* commands, Visitor& visitor) {
+    return visitor(commands->NextCommand<T>());
+}
+
+template <typename T, typename D, typename GetCount, typename Visitor>
+DAWN_FORCE_INLINE decltype(auto) VisitCommandWithData(CommandIterator* commands,
+                                                      GetCount getCount,
+                                                      Visitor& visitor) {
+    T* cmd = commands->NextCommand<T>();
+    size_t count = static_cast<size_t>(getCount(cmd));
+    return visitor(cmd, commands->NextData<D>(count), count);
+}
+
+}  // namespace detail
+
+// Decodes the next command of `commands`, which has type `type`, and calls `visitor` with a
+// pointer to it. Commands that are followed by additional data also get a pointer to the data
+// and its number of elements:
+//     visitor(DrawCmd* cmd)
+//     visitor(SetBindGroupCmd* cmd, uint32_t* dynamicOffsets, size_t dynamicOffsetCount)
+// The switch on the command type is instantiated and inlined for each visitor so that the
+// overload handling each command is resolved at compile time. The overloads must all return the
+// same type, which is returned by VisitCommand. A generic lambda can handle all the commands at
+// once, or an Overloaded set of lambdas can handle some commands and fall back to a generic one:
+//     Command type;
+//     while (commands->NextCommandId(&type)) {
+//         VisitCommand(commands, type, [&](auto* cmd, auto... data) { ... });
+//     }
+template <typename Visitor>
+DAWN_FORCE_INLINE decltype(auto) VisitCommand(CommandIterator* commands,
+                                              Command type,
+                                              Visitor&& visitor) {
+    switch (type) {
+        case Command::BeginComputePass:
+            return detail::VisitCommand<BeginComputePassCmd>(commands, visitor);
+        case Command::BeginOcclusionQuery:
+            return detail::VisitCommand<BeginOcclusionQueryCmd>(commands, visitor);
+        case Command::BeginRenderPass:
+            return detail::VisitCommand<BeginRenderPassCmd>(commands, visitor);
+        case Command::ClearBuffer:
+            return detail::VisitCommand<ClearBufferCmd>(commands, visitor);
+        case Command::CopyBufferToBuffer:
+            return detail::VisitCommand<CopyBufferToBufferCmd>(commands, visitor);
+        case Command::CopyBufferToTexture:
+            return detail::VisitCommand<CopyBufferToTextureCmd>(commands, visitor);
+        case Command::CopyTextureToBuffer:
+            return detail::VisitCommand<CopyTextureToBufferCmd>(commands, visitor);
+        case Command::CopyTextureToTexture:
+            return detail::VisitCommand<CopyTextureToTextureCmd>(commands, visitor);
+        case Command::Dispatch:
+            return detail::VisitCommand<DispatchCmd>(commands, visitor);
+        case Command::DispatchIndirect:
+            return detail::VisitCommand<DispatchIndirectCmd>(commands, visitor);
+        case Command::Draw:
+            return detail::VisitCommand<DrawCmd>(commands, visitor);
+        case Command::DrawIndexed:
+            return detail::VisitCommand<DrawIndexedCmd>(commands, visitor);
+        case Command::DrawIndirect:
+            return detail::VisitCommand<DrawIndirectCmd>(commands, visitor);
+        case Command::DrawIndexedIndirect:
+            return detail::VisitCommand<DrawIndexedIndirectCmd>(commands, visitor);
+        case Command::MultiDrawIndirect:
+            return detail::VisitCommand<MultiDrawIndirectCmd>(commands, visitor);
+        case Command::MultiDrawIndexedIndirect:
+            return detail::VisitCommand<MultiDrawIndexedIndirectCmd>(commands, visitor);
+        case Command::EndComputePass:
+            return detail::VisitCommand<EndComputePassCmd>(commands, visitor);
+        case Command::EndOcclusionQuery:
+            return detail::VisitCommand<EndOcclusionQueryCmd>(commands, visitor);
+        case Command::EndRenderPass:
+            return detail::VisitCommand<EndRenderPassCmd>(commands, visitor);
+        case Command::ExecuteBundles:
+            return detail::VisitCommandWithData<ExecuteBundlesCmd, Ref<RenderBundleBase>>(
+                commands, [](ExecuteBundlesCmd* cmd) { return cmd->count; }, visitor);
+        case Command::InsertDebugMarker:
+            return detail::VisitCommandWithData<InsertDebugMarkerCmd, char>(
+                commands, [](InsertDebugMarkerCmd* cmd) { return cmd->length + 1; }, visitor);
+        case Command::PixelLocalStorageBarrier:
+            return detail::VisitCommand<PixelLocalStorageBarrierCmd>(commands, visitor);
+        case Command::PopDebugGroup:
+            return detail::VisitCommand<PopDebugGroupCmd>(commands, visitor);
+        case Command::PushDebugGroup:
+            return detail::VisitCommandWithData<PushDebugGroupCmd, char>(
+                commands, [](PushDebugGroupCmd* cmd) { return cmd->length + 1; }, visitor);
+        case Command::ResolveQuerySet:
+            return detail::VisitCommand<ResolveQuerySetCmd>(commands, visitor);
+        case Command::SetComputePipeline:
+            return detail::VisitCommand<SetComputePipelineCmd>(commands, visitor);
+        case Command::SetRenderPipeline:
+            return detail::VisitCommand<SetRenderPipelineCmd>(commands, visitor);
+        case Command::SetStencilReference:
+            return detail::VisitCommand<SetStencilReferenceCmd>(commands, visitor);
+        case Command::SetViewport:
+            return detail::VisitCommand<SetViewportCmd>(commands, visitor);
+        case Command::SetScissorRect:
+            return detail::VisitCommand<SetScissorRectCmd>(commands, visitor);
+        case Command::SetBlendConstant:
+            return detail::VisitCommand<SetBlendConstantCmd>(commands, visitor);
+        case Command::SetBindGroup: {
+            // The dynamic offsets are only allocated when there are some.
+            SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+            uint32_t* dynamicOffsets = nullptr;
+            if (cmd->dynamicOffsetCount > 0) {
+                dynamicOffsets = commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+            }
+            return visitor(cmd, dynamicOffsets, size_t(cmd->dynamicOffsetCount));
+        }
+        case Command::SetIndexBuffer:
+            return detail::VisitCommand<SetIndexBufferCmd>(commands, visitor);
+        case Command::SetVertexBuffer:
+            return detail::VisitCommand<SetVertexBufferCmd>(commands, visitor);
+        case Command::WriteBuffer:
+            return detail::VisitCommandWithData<WriteBufferCmd, uint8_t>(
+                commands, [](WriteBufferCmd* cmd) { return cmd->size; }, visitor);
+        case Command::WriteTimestamp:
+            return detail::VisitCommand<WriteTimestampCmd>(commands, visitor);
+    }
+    DAWN_UNREACHABLE();
+}
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_COMMANDVISITOR_H_
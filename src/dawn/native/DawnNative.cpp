@@ -33,6 +33,7 @@
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DynamicUploader.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/Texture.h"
 #include "dawn/platform/DawnPlatform.h"
@@ -166,9 +167,10 @@ DawnInstanceDescriptor::DawnInstanceDescriptor() {
 bool DawnInstanceDescriptor::operator==(const DawnInstanceDescriptor& rhs) const {
     return (nextInChain == rhs.nextInChain) &&
            std::tie(additionalRuntimeSearchPathsCount, additionalRuntimeSearchPaths, platform,
-                    backendValidationLevel, beginCaptureOnStartup) ==
+                    backendValidationLevel, beginCaptureOnStartup, sharedBlobCacheSize) ==
                std::tie(rhs.additionalRuntimeSearchPathsCount, rhs.additionalRuntimeSearchPaths,
-                        rhs.platform, rhs.backendValidationLevel, rhs.beginCaptureOnStartup);
+                        rhs.platform, rhs.backendValidationLevel, rhs.beginCaptureOnStartup,
+                        rhs.sharedBlobCacheSize);
 }
 
 // Instance
@@ -233,6 +235,16 @@ size_t GetLazyClearCountForTesting(WGPUDevice device) {
     return FromAPI(device)->GetLazyClearCountForTesting();
 }
 
+uint64_t GetPeakUploadUsagePerSerialForTesting(WGPUDevice device) {
+    auto deviceLock(FromAPI(device)->GetScopedLock());
+    return FromAPI(device)->GetDynamicUploader()->GetStats().peakSerialUsage;
+}
+
+uint64_t GetAverageUploadUsagePerSerialForTesting(WGPUDevice device) {
+    auto deviceLock(FromAPI(device)->GetScopedLock());
+    return FromAPI(device)->GetDynamicUploader()->GetStats().averageSerialUsage;
+}
+
 bool IsTextureSubresourceInitialized(WGPUTexture texture,
                                      uint32_t baseMipLevel,
                                      uint32_t levelCount,
@@ -403,6 +403,8 @@ DeviceBase::DeviceBase(AdapterBase* adapter,
         cacheDesc.functionUserdata = GetPlatform()->GetCachingInterface();
     }
 
+    BlobCache* sharedBlobCache = adapter->GetInstance()->GetSharedBlobCache();
+
     // Disable caching if the toggle is passed, or the WGSL writer is not enabled.
     // TODO(crbug.com/dawn/1481): Shader caching currently has a dependency on the WGSL writer to
     // generate cache keys. We can lift the dependency once we also cache frontend parsing,
@@ -415,8 +417,10 @@ DeviceBase::DeviceBase(AdapterBase* adapter,
         cacheDesc.loadDataFunction = nullptr;
         cacheDesc.storeDataFunction = nullptr;
         cacheDesc.functionUserdata = nullptr;
+        cacheDesc.memoryCacheSize = 0;
+        sharedBlobCache = nullptr;
     }
-    mBlobCache = std::make_unique<BlobCache>(cacheDesc);
+    mBlobCache = std::make_unique<BlobCache>(cacheDesc, sharedBlobCache);
 
     if (descriptor->requiredLimits != nullptr) {
         mLimits.v1 =
@@ -470,6 +474,7 @@ MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
     mErrorScopeStack = std::make_unique<ErrorScopeStack>();
     mDynamicUploader = std::make_unique<DynamicUploader>(this);
     mCallbackTaskManager = AcquireRef(new CallbackTaskManager());
+    mCommandBlockPool = AcquireRef(new CommandBlockPool());
     mInternalPipelineStore = std::make_unique<InternalPipelineStore>(this);
 
     DAWN_ASSERT(GetPlatform() != nullptr);
@@ -1297,9 +1302,20 @@ BindGroupBase* DeviceBase::APICreateBindGroup(const BindGroupDescriptor* descrip
 }
 BindGroupLayoutBase* DeviceBase::APICreateBindGroupLayout(
     const BindGroupLayoutDescriptor* descriptor) {
+    auto resultOrError = [&] {
+        auto deviceLock(GetScopedLockForCachedObjectCreation());
+        return CreateBindGroupLayout(descriptor);
+    }();
+    if (resultOrError.IsSuccess()) {
+        return ReturnToAPI(resultOrError.AcquireSuccess());
+    }
+
+    // Acquire the device lock for error handling.
+    // TODO(dawn:1662): Make error handling thread-safe.
+    auto deviceLock(GetScopedLock());
     Ref<BindGroupLayoutBase> result;
-    if (ConsumedError(CreateBindGroupLayout(descriptor), &result,
-                      "calling %s.CreateBindGroupLayout(%s).", this, descriptor)) {
+    if (ConsumedError(std::move(resultOrError), &result, "calling %s.CreateBindGroupLayout(%s).",
+                      this, descriptor)) {
         return ReturnToAPI(
             BindGroupLayoutBase::MakeError(this, descriptor ? descriptor->label : nullptr));
     }
@@ -1449,9 +1465,20 @@ Future DeviceBase::APICreateComputePipelineAsync2(
 }
 PipelineLayoutBase* DeviceBase::APICreatePipelineLayout(
     const PipelineLayoutDescriptor* descriptor) {
+    auto resultOrError = [&] {
+        auto deviceLock(GetScopedLockForCachedObjectCreation());
+        return CreatePipelineLayout(descriptor);
+    }();
+    if (resultOrError.IsSuccess()) {
+        return ReturnToAPI(resultOrError.AcquireSuccess());
+    }
+
+    // Acquire the device lock for error handling.
+    // TODO(dawn:1662): Make error handling thread-safe.
+    auto deviceLock(GetScopedLock());
     Ref<PipelineLayoutBase> result;
-    if (ConsumedError(CreatePipelineLayout(descriptor), &result,
-                      "calling %s.CreatePipelineLayout(%s).", this, descriptor)) {
+    if (ConsumedError(std::move(resultOrError), &result, "calling %s.CreatePipelineLayout(%s).",
+                      this, descriptor)) {
         result = PipelineLayoutBase::MakeError(this, descriptor ? descriptor->label : nullptr);
     }
     return ReturnToAPI(std::move(result));
@@ -1465,8 +1492,19 @@ QuerySetBase* DeviceBase::APICreateQuerySet(const QuerySetDescriptor* descriptor
     return ReturnToAPI(std::move(result));
 }
 SamplerBase* DeviceBase::APICreateSampler(const SamplerDescriptor* descriptor) {
+    auto resultOrError = [&] {
+        auto deviceLock(GetScopedLockForCachedObjectCreation());
+        return CreateSampler(descriptor);
+    }();
+    if (resultOrError.IsSuccess()) {
+        return ReturnToAPI(resultOrError.AcquireSuccess());
+    }
+
+    // Acquire the device lock for error handling.
+    // TODO(dawn:1662): Make error handling thread-safe.
+    auto deviceLock(GetScopedLock());
     Ref<SamplerBase> result;
-    if (ConsumedError(CreateSampler(descriptor), &result, "calling %s.CreateSampler(%s).", this,
+    if (ConsumedError(std::move(resultOrError), &result, "calling %s.CreateSampler(%s).", this,
                       descriptor)) {
         result = SamplerBase::MakeError(this, descriptor ? descriptor->label : nullptr);
     }
@@ -1729,6 +1767,9 @@ bool DeviceBase::APITick() {
 
 MaybeError DeviceBase::Tick() {
     if (IsLost() || !mQueue->HasScheduledCommands()) {
+        // Command blocks are recycled while encoders keep being created. Don't keep them around
+        // once the device stays idle.
+        mCommandBlockPool->TrimIfUnused();
         return {};
     }
 
@@ -1744,6 +1785,10 @@ MaybeError DeviceBase::Tick() {
     mDynamicUploader->Deallocate(mQueue->GetCompletedCommandSerial());
     mQueue->Tick(mQueue->GetCompletedCommandSerial());
 
+    CommandBlockPool::Stats poolStats = mCommandBlockPool->GetStats();
+    TRACE_COUNTER2(GetPlatform(), Recording, "CommandBlockPool", "hits", poolStats.hits, "misses",
+                   poolStats.misses);
+
     return {};
 }
 
@@ -1913,6 +1958,22 @@ void DeviceBase::IncrementLazyClearCountForTesting() {
     ++mLazyClearCountForTesting;
 }
 
+const CommandCompactionStats& DeviceBase::GetCommandCompactionStats() const {
+    return mCommandCompactionStats;
+}
+
+void DeviceBase::AddCommandCompactionStats(const CommandCompactionStats& stats) {
+    mCommandCompactionStats.commandCount += stats.commandCount;
+    mCommandCompactionStats.removedCommandCount += stats.removedCommandCount;
+    TRACE_COUNTER2(GetPlatform(), Recording, "RedundantStateCommands", "recorded",
+                   mCommandCompactionStats.commandCount, "removed",
+                   mCommandCompactionStats.removedCommandCount);
+}
+
+const Ref<CommandBlockPool>& DeviceBase::GetCommandBlockPool() const {
+    return mCommandBlockPool;
+}
+
 void DeviceBase::EmitWarningOnce(const std::string& message) {
     if (mWarnings.insert(message).second) {
         this->EmitLog(WGPULoggingType_Warning, message.c_str());
@@ -2547,6 +2608,10 @@ bool DeviceBase::PreferNotUsingMappableOrUniformBufferAsStorage() const {
     return false;
 }
 
+bool DeviceBase::CanCreateCachedObjectsWithoutDeviceLock() const {
+    return false;
+}
+
 uint64_t DeviceBase::GetBufferCopyOffsetAlignmentForDepthStencil() const {
     // For depth-stencil texture, buffer offset must be a multiple of 4, which is required
     // by WebGPU and Vulkan SPEC.
@@ -2596,7 +2661,23 @@ Mutex::AutoLockAndHoldRef DeviceBase::GetScopedLockSafeForDelete() {
 }
 
 Mutex::AutoLock DeviceBase::GetScopedLock() {
-    return Mutex::AutoLock(mMutex.Get());
+    if (mMutex == nullptr || mMutex->TryLock()) {
+        return Mutex::AutoLock(mMutex.Get(), std::adopt_lock);
+    }
+
+    // Only contended acquisitions are timed so that the uncontended path stays a single try-lock.
+    {
+        SCOPED_DAWN_HISTOGRAM_TIMER_MICROS(GetPlatform(), "DeviceLockWaitUS");
+        mMutex->Lock();
+    }
+    return Mutex::AutoLock(mMutex.Get(), std::adopt_lock);
+}
+
+Mutex::AutoLock DeviceBase::GetScopedLockForCachedObjectCreation() {
+    if (CanCreateCachedObjectsWithoutDeviceLock()) {
+        return Mutex::AutoLock();
+    }
+    return GetScopedLock();
 }
 
 bool DeviceBase::IsLockedByCurrentThreadIfNeeded() const {
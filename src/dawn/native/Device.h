@@ -42,6 +42,7 @@
 #include "dawn/common/RefCountedWithExternalCount.h"
 #include "dawn/common/StackAllocated.h"
 #include "dawn/native/CacheKey.h"
+#include "dawn/native/CommandCompaction.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/ComputePipeline.h"
 #include "dawn/native/CreatePipelineAsyncEvent.h"
@@ -375,6 +376,10 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
 
     size_t GetLazyClearCountForTesting();
     void IncrementLazyClearCountForTesting();
+    const CommandCompactionStats& GetCommandCompactionStats() const;
+    void AddCommandCompactionStats(const CommandCompactionStats& stats);
+    // The pool of command blocks shared by the encoders of the device.
+    const Ref<CommandBlockPool>& GetCommandBlockPool() const;
     void EmitWarningOnce(const std::string& message);
     void EmitLog(const char* message);
     void EmitLog(WGPULoggingType loggingType, const char* message);
@@ -419,6 +424,11 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
     // Whether the backend prefer not using mappable/uniform buffer as storage buffer.
     virtual bool PreferNotUsingMappableOrUniformBufferAsStorage() const;
 
+    // Whether the backend can create the objects deduplicated in the device caches (samplers, bind
+    // group layouts and pipeline layouts) concurrently without holding the device lock. The caches
+    // have their own locks, so only the backend's part of the creation needs to be thread-safe.
+    virtual bool CanCreateCachedObjectsWithoutDeviceLock() const;
+
     bool HasFeature(Feature feature) const;
 
     const CombinedLimits& GetLimits() const;
@@ -443,8 +453,11 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
     // before the AutoLockAndHoldRef).
     [[nodiscard]] Mutex::AutoLockAndHoldRef GetScopedLockSafeForDelete();
     // This lock won't guarantee the wrapped mutex will be alive if the Device is deleted before the
-    // AutoLock. It would crash if such thing happens.
+    // AutoLock. It would crash if such thing happens. The time spent waiting when the lock is
+    // contended is reported through the platform's histograms.
     [[nodiscard]] Mutex::AutoLock GetScopedLock();
+    // Returns an empty lock if CanCreateCachedObjectsWithoutDeviceLock(), otherwise the device lock.
+    [[nodiscard]] Mutex::AutoLock GetScopedLockForCachedObjectCreation();
 
     // This method returns true if Feature::ImplicitDeviceSynchronization is turned on and the
     // device is locked by current thread. This method is only enabled when DAWN_ENABLE_ASSERTS is
@@ -601,6 +614,7 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
     TogglesState mToggles;
 
     size_t mLazyClearCountForTesting = 0;
+    CommandCompactionStats mCommandCompactionStats;
     std::atomic_uint64_t mNextPipelineCompatibilityToken;
 
     CombinedLimits mLimits;
@@ -611,6 +625,7 @@ class DeviceBase : public ErrorSink, public RefCountedWithExternalCount<RefCount
     Ref<BufferBase> mTemporaryUniformBuffer;
 
     Ref<CallbackTaskManager> mCallbackTaskManager;
+    Ref<CommandBlockPool> mCommandBlockPool;
     std::unique_ptr<dawn::platform::WorkerTaskPool> mWorkerTaskPool;
 
     // Ensure `mAsyncTaskManager` is always destroyed before mWorkerTaskPool
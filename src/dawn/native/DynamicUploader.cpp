@@ -27,6 +27,8 @@
 
 #include "dawn/native/DynamicUploader.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "dawn/common/Math.h"
@@ -36,9 +38,20 @@
 
 namespace dawn::native {
 
+namespace {
+
+// Large staging buffers are bucketed in size classes that are quarters of a power of two so
+// that reuse wastes at most a third of the buffer.
+uint64_t GetStagingBufferSizeClass(uint64_t size) {
+    uint64_t granularity = std::max(NextPowerOfTwo(size) / 4, uint64_t(4));
+    return Align(size, granularity);
+}
+
+}  // anonymous namespace
+
 DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {
     mRingBuffers.emplace_back(
-        std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+        std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, RingBufferAllocator(mRingBufferSize)}));
 }
 
 void DynamicUploader::ReleaseStagingBuffer(Ref<BufferBase> stagingBuffer) {
@@ -46,33 +59,56 @@ void DynamicUploader::ReleaseStagingBuffer(Ref<BufferBase> stagingBuffer) {
                                     mDevice->GetQueue()->GetPendingCommandSerial());
 }
 
+ResultOrError<Ref<BufferBase>> DynamicUploader::CreateStagingBuffer(uint64_t size) {
+    BufferDescriptor bufferDesc = {};
+    bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
+    bufferDesc.size = Align(size, 4);
+    bufferDesc.mappedAtCreation = true;
+    bufferDesc.label = "Dawn_DynamicUploaderStaging";
+
+    IgnoreLazyClearCountScope scope(mDevice);
+    return mDevice->CreateBuffer(&bufferDesc);
+}
+
+ResultOrError<UploadHandle> DynamicUploader::AllocateLargeStagingBuffer(uint64_t allocationSize) {
+    uint64_t sizeClass = GetStagingBufferSizeClass(allocationSize);
+
+    Ref<BufferBase> stagingBuffer;
+    auto it = mFreeLargeStagingBuffers.find(sizeClass);
+    if (it != mFreeLargeStagingBuffers.end() && !it->second.empty()) {
+        stagingBuffer = std::move(it->second.back().buffer);
+        it->second.pop_back();
+        DAWN_ASSERT(mPooledStagingBufferBytes >= sizeClass);
+        mPooledStagingBufferBytes -= sizeClass;
+        mPooledStagingBufferCount--;
+        mPooledStagingBufferHits++;
+    } else {
+        DAWN_TRY_ASSIGN(stagingBuffer, CreateStagingBuffer(sizeClass));
+    }
+
+    UploadHandle uploadHandle;
+    uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
+    uploadHandle.stagingBuffer = stagingBuffer.Get();
+
+    mPendingLargeStagingBuffers.Enqueue(std::move(stagingBuffer),
+                                        mDevice->GetQueue()->GetPendingCommandSerial());
+    return uploadHandle;
+}
+
 ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
                                                               ExecutionSerial serial,
                                                               uint64_t offsetAlignment) {
-    // Disable further sub-allocation should the request be too large.
-    if (allocationSize > kRingBufferSize) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(allocationSize, 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
-        Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+    TrackUsage(allocationSize, serial);
 
-        UploadHandle uploadHandle;
-        uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
-        uploadHandle.stagingBuffer = stagingBuffer.Get();
-
-        ReleaseStagingBuffer(std::move(stagingBuffer));
-        return uploadHandle;
+    // Disable further sub-allocation should the request be too large.
+    if (allocationSize > mRingBufferSize) {
+        return AllocateLargeStagingBuffer(allocationSize);
     }
 
     // Note: Validation ensures size is already aligned.
     // First-fit: find next buffer large enough to satisfy the allocation request.
     uint64_t startOffset = RingBufferAllocator::kInvalidOffset;
-    RingBuffer* targetRingBuffer = mRingBuffers.back().get();
+    RingBuffer* targetRingBuffer = nullptr;
     for (auto& ringBuffer : mRingBuffers) {
         RingBufferAllocator& ringBufferAllocator = ringBuffer->mAllocator;
         // Prevent overflow.
@@ -84,31 +120,24 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
         }
     }
 
-    // Upon failure, append a newly created ring buffer to fulfill the
+    // Upon failure, append a newly created ring buffer of the current size to fulfill the
     // request.
     if (startOffset == RingBufferAllocator::kInvalidOffset) {
         mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
-            new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+            new RingBuffer{nullptr, RingBufferAllocator(mRingBufferSize)}));
 
         targetRingBuffer = mRingBuffers.back().get();
         startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
     }
 
     DAWN_ASSERT(startOffset != RingBufferAllocator::kInvalidOffset);
+    DAWN_ASSERT(targetRingBuffer != nullptr);
 
     // Allocate the staging buffer backing the ringbuffer.
     // Note: the first ringbuffer will be lazily created.
     if (targetRingBuffer->mStagingBuffer == nullptr) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(targetRingBuffer->mAllocator.GetSize(), 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
-        Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
-        targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
+        DAWN_TRY_ASSIGN(targetRingBuffer->mStagingBuffer,
+                        CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
     }
 
     DAWN_ASSERT(targetRingBuffer->mStagingBuffer != nullptr);
@@ -122,6 +151,43 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     return uploadHandle;
 }
 
+void DynamicUploader::TrackUsage(uint64_t allocationSize, ExecutionSerial serial) {
+    if (serial != mCurrentSerial) {
+        if (mCurrentSerialUsage > 0) {
+            UpdateRingBufferSize(mCurrentSerialUsage);
+        }
+        mCurrentSerial = serial;
+        mCurrentSerialUsage = 0;
+    }
+    mCurrentSerialUsage += allocationSize;
+}
+
+void DynamicUploader::UpdateRingBufferSize(uint64_t serialUsage) {
+    mPeakSerialUsage = std::max(mPeakSerialUsage, serialUsage);
+    mTotalSerialUsage += serialUsage;
+    mTrackedSerialCount++;
+
+    // Grow eagerly so that a ring buffer can hold the uploads of two consecutive serials, since
+    // the previous serial is usually still in flight while the next one is being recorded.
+    if (serialUsage > mRingBufferSize / 2 && mRingBufferSize < kMaxRingBufferSize) {
+        mRingBufferSize = std::min(NextPowerOfTwo(serialUsage * 2), kMaxRingBufferSize);
+        mWindowPeakUsage = 0;
+        mWindowSerialCount = 0;
+        return;
+    }
+
+    // Shrink lazily, only after a whole window of serials used at most a quarter of the ring.
+    mWindowPeakUsage = std::max(mWindowPeakUsage, serialUsage);
+    if (++mWindowSerialCount < kUsageWindowSerialCount) {
+        return;
+    }
+    if (mWindowPeakUsage <= mRingBufferSize / 4 && mRingBufferSize > kMinRingBufferSize) {
+        mRingBufferSize = std::max(NextPowerOfTwo(mWindowPeakUsage * 2), kMinRingBufferSize);
+    }
+    mWindowPeakUsage = 0;
+    mWindowSerialCount = 0;
+}
+
 void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
     // Reclaim memory within the ring buffers by ticking (or removing requests no longer
     // in-flight).
@@ -130,14 +196,48 @@ void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
         mRingBuffers[i]->mAllocator.Deallocate(lastCompletedSerial);
 
         // Never erase the last buffer as to prevent re-creating smaller buffers
-        // again. The last buffer is the largest.
-        if (mRingBuffers[i]->mAllocator.Empty() && i < mRingBuffers.size() - 1) {
+        // again, unless its size no longer matches the adapted ring buffer size.
+        bool isLast = i == mRingBuffers.size() - 1;
+        if (mRingBuffers[i]->mAllocator.Empty() &&
+            (!isLast || mRingBuffers[i]->mAllocator.GetSize() != mRingBufferSize)) {
             mRingBuffers.erase(mRingBuffers.begin() + i);
         } else {
             i++;
         }
     }
     mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+    // Return the large staging buffers that are no longer in use to the pool, within budget.
+    for (Ref<BufferBase>& buffer : mPendingLargeStagingBuffers.IterateUpTo(lastCompletedSerial)) {
+        uint64_t size = buffer->GetSize();
+        if (mPooledStagingBufferBytes + size > kMaxPooledStagingBufferBytes) {
+            continue;
+        }
+        mPooledStagingBufferBytes += size;
+        mPooledStagingBufferCount++;
+        mFreeLargeStagingBuffers[size].push_back({std::move(buffer), lastCompletedSerial});
+    }
+    mPendingLargeStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+    // Release the pooled staging buffers that have not been reused for a while.
+    for (auto it = mFreeLargeStagingBuffers.begin(); it != mFreeLargeStagingBuffers.end();) {
+        std::vector<PooledStagingBuffer>& buffers = it->second;
+        auto idleEnd = std::remove_if(
+            buffers.begin(), buffers.end(), [&](const PooledStagingBuffer& pooled) {
+                return uint64_t(lastCompletedSerial) - uint64_t(pooled.returnedSerial) >
+                       kMaxPooledStagingBufferIdleSerials;
+            });
+        uint64_t releasedCount = std::distance(idleEnd, buffers.end());
+        mPooledStagingBufferBytes -= releasedCount * it->first;
+        mPooledStagingBufferCount -= releasedCount;
+        buffers.erase(idleEnd, buffers.end());
+
+        if (buffers.empty()) {
+            mFreeLargeStagingBuffers.erase(it++);
+        } else {
+            ++it;
+        }
+    }
 }
 
 ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
@@ -154,11 +254,29 @@ bool DynamicUploader::ShouldFlush() {
     return GetTotalAllocatedSize() > kTotalAllocatedSizeThreshold;
 }
 
+DynamicUploaderStats DynamicUploader::GetStats() const {
+    DynamicUploaderStats stats;
+    stats.peakSerialUsage = std::max(mPeakSerialUsage, mCurrentSerialUsage);
+    uint64_t serialCount = mTrackedSerialCount + (mCurrentSerialUsage > 0 ? 1 : 0);
+    if (serialCount > 0) {
+        stats.averageSerialUsage = (mTotalSerialUsage + mCurrentSerialUsage) / serialCount;
+    }
+    stats.ringBufferSize = mRingBufferSize;
+    stats.pooledStagingBufferCount = mPooledStagingBufferCount;
+    stats.pooledStagingBufferHits = mPooledStagingBufferHits;
+    return stats;
+}
+
 uint64_t DynamicUploader::GetTotalAllocatedSize() {
+    // Pooled staging buffers that are not in flight are not counted: flushing would not release
+    // them and their total size is bounded by kMaxPooledStagingBufferBytes.
     uint64_t size = 0;
     for (const auto& buffer : mReleasedStagingBuffers.IterateAll()) {
         size += buffer->GetSize();
     }
+    for (const auto& buffer : mPendingLargeStagingBuffers.IterateAll()) {
+        size += buffer->GetSize();
+    }
     for (const auto& buffer : mRingBuffers) {
         if (buffer->mStagingBuffer != nullptr) {
             size += buffer->mStagingBuffer->GetSize();
@@ -31,6 +31,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "dawn/common/Ref.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/Forward.h"
@@ -50,6 +51,19 @@ struct UploadHandle {
     raw_ptr<BufferBase> stagingBuffer = nullptr;
 };
 
+// Statistics about the upload demand observed by the DynamicUploader, used to size the ring
+// buffers and exposed for testing and tracing.
+struct DynamicUploaderStats {
+    // Largest and average number of bytes uploaded within a single serial.
+    uint64_t peakSerialUsage = 0;
+    uint64_t averageSerialUsage = 0;
+    // Size of newly created ring buffers.
+    uint64_t ringBufferSize = 0;
+    // Number of large staging buffers kept for reuse, and how many allocations reused one.
+    uint64_t pooledStagingBufferCount = 0;
+    uint64_t pooledStagingBufferHits = 0;
+};
+
 class DynamicUploader {
   public:
     explicit DynamicUploader(DeviceBase* device);
@@ -68,8 +82,20 @@ class DynamicUploader {
 
     bool ShouldFlush();
 
+    DynamicUploaderStats GetStats() const;
+
+    // The ring buffer size adapts to the observed per-serial demand between these bounds.
+    // Allocations larger than the current ring buffer size use pooled dedicated staging buffers.
+    static constexpr uint64_t kMinRingBufferSize = 4 * 1024 * 1024;
+    static constexpr uint64_t kMaxRingBufferSize = 16 * 1024 * 1024;
+
   private:
-    static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
+    // Number of serials over which the peak usage is observed before shrinking the ring buffers.
+    static constexpr uint64_t kUsageWindowSerialCount = 32;
+    // Pooled staging buffers not reused for this many serials are released.
+    static constexpr uint64_t kMaxPooledStagingBufferIdleSerials = 64;
+    static constexpr uint64_t kMaxPooledStagingBufferBytes = 128 * 1024 * 1024;
+
     uint64_t GetTotalAllocatedSize();
 
     struct RingBuffer {
@@ -77,12 +103,44 @@ class DynamicUploader {
         RingBufferAllocator mAllocator;
     };
 
+    struct PooledStagingBuffer {
+        Ref<BufferBase> buffer;
+        // The last completed serial when the buffer was returned to the pool.
+        ExecutionSerial returnedSerial;
+    };
+
     ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize,
                                                  ExecutionSerial serial,
                                                  uint64_t offsetAlignment);
+    ResultOrError<UploadHandle> AllocateLargeStagingBuffer(uint64_t allocationSize);
+    ResultOrError<Ref<BufferBase>> CreateStagingBuffer(uint64_t size);
+
+    void TrackUsage(uint64_t allocationSize, ExecutionSerial serial);
+    void UpdateRingBufferSize(uint64_t serialUsage);
 
     std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
     SerialQueue<ExecutionSerial, Ref<BufferBase>> mReleasedStagingBuffers;
+
+    // Large staging buffers created by the uploader stay mapped for their whole lifetime. Once
+    // the GPU is done with them they are kept for reuse, bucketed by size classes that are quarters
+    // of a power of two.
+    SerialQueue<ExecutionSerial, Ref<BufferBase>> mPendingLargeStagingBuffers;
+    absl::flat_hash_map<uint64_t, std::vector<PooledStagingBuffer>> mFreeLargeStagingBuffers;
+    uint64_t mPooledStagingBufferBytes = 0;
+    uint64_t mPooledStagingBufferCount = 0;
+    uint64_t mPooledStagingBufferHits = 0;
+
+    uint64_t mRingBufferSize = kMinRingBufferSize;
+
+    // Demand tracking for the serial currently being recorded and the current window.
+    ExecutionSerial mCurrentSerial = kBeginningOfGPUTime;
+    uint64_t mCurrentSerialUsage = 0;
+    uint64_t mWindowPeakUsage = 0;
+    uint64_t mWindowSerialCount = 0;
+    uint64_t mPeakSerialUsage = 0;
+    uint64_t mTotalSerialUsage = 0;
+    uint64_t mTrackedSerialCount = 0;
+
     raw_ptr<DeviceBase> mDevice;
 };
 }  // namespace dawn::native
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -282,6 +283,61 @@ size_t GetBatchDataSize(uint32_t numDraws) {
     return sizeof(BatchInfo) + (numDraws * kIndirectDrawByteSize);
 }
 
+// Does the same validation as the shader above on the CPU for indirect buffers whose content is
+// known and immutable, when the indirect parameters don't need to be modified for the backend.
+// On success the draws are made to use the indirect buffer directly so that no validation pass
+// is needed. Returns false if the draws must be validated on the GPU instead, including when
+// some of them are invalid as the GPU validation is what zeroes their parameters.
+bool ValidateOnCPU(const DeviceBase* device,
+                   const IndirectDrawMetadata::IndexedIndirectConfig& config,
+                   const IndirectDrawMetadata::IndexedIndirectBufferValidationInfo& validationInfo) {
+    const bool isIndexed = config.drawType == IndirectDrawMetadata::DrawType::Indexed;
+    if (config.duplicateBaseVertexInstance ||
+        (isIndexed && device->ShouldApplyIndexBufferOffsetToFirstIndex())) {
+        return false;
+    }
+
+    BufferBase* indirectBuffer = validationInfo.GetIndirectBuffer();
+    const uint8_t* content = indirectBuffer->GetImmutableContent();
+    if (content == nullptr) {
+        return false;
+    }
+
+    const bool validateFirstInstance =
+        device->IsValidationEnabled() && !device->HasFeature(Feature::IndirectFirstInstance);
+    const uint32_t numParams = isIndexed ? 5 : 4;
+    for (const IndirectDrawMetadata::IndirectValidationBatch& batch :
+         validationInfo.GetBatches()) {
+        for (const IndirectDrawMetadata::IndirectDraw& draw : batch.draws) {
+            DAWN_ASSERT(draw.inputBufferOffset + numParams * sizeof(uint32_t) <=
+                        indirectBuffer->GetSize());
+            uint32_t params[5];
+            memcpy(params, content + draw.inputBufferOffset, numParams * sizeof(uint32_t));
+
+            // firstInstance is always the last parameter.
+            if (validateFirstInstance && params[numParams - 1] != 0) {
+                return false;
+            }
+            if (isIndexed && device->IsValidationEnabled()) {
+                const uint64_t indexCount = params[0];
+                const uint64_t firstIndex = params[2];
+                if (firstIndex + indexCount > draw.numIndexBufferElements) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    for (const IndirectDrawMetadata::IndirectValidationBatch& batch :
+         validationInfo.GetBatches()) {
+        for (const IndirectDrawMetadata::IndirectDraw& draw : batch.draws) {
+            draw.cmd->indirectBuffer = indirectBuffer;
+            draw.cmd->indirectOffset = draw.inputBufferOffset;
+        }
+    }
+    return true;
+}
+
 }  // namespace
 
 uint32_t ComputeMaxDrawCallsPerIndirectValidationBatch(const CombinedLimits& limits) {
@@ -347,6 +403,10 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
         device->ShouldApplyIndexBufferOffsetToFirstIndex();
 
     for (auto& [config, validationInfo] : bufferInfoMap) {
+        if (ValidateOnCPU(device, config, validationInfo)) {
+            continue;
+        }
+
         const uint64_t indirectDrawCommandSize =
             config.drawType == IndirectDrawMetadata::DrawType::Indexed ? kDrawIndexedIndirectSize
                                                                        : kDrawIndirectSize;
@@ -422,6 +482,10 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
         }
     }
 
+    if (passes.empty()) {
+        return {};
+    }
+
     auto* const store = device->GetInternalPipelineStore();
     ScratchBuffer& outputParamsBuffer = store->scratchIndirectStorage;
     ScratchBuffer& batchDataBuffer = store->scratchStorage;
@@ -35,6 +35,7 @@
 #include "dawn/common/Log.h"
 #include "dawn/common/SystemUtils.h"
 #include "dawn/common/WGSLFeatureMapping.h"
+#include "dawn/native/BlobCache.h"
 #include "dawn/native/CallbackTaskManager.h"
 #include "dawn/native/ChainUtils.h"
 #include "dawn/native/Device.h"
@@ -223,6 +224,14 @@ MaybeError InstanceBase::Initialize(const UnpackedPtr<InstanceDescriptor>& descr
 
         mLoggingCallback = dawnDesc->loggingCallback;
         mLoggingCallbackUserdata = dawnDesc->loggingCallbackUserdata;
+
+        if (dawnDesc->sharedBlobCacheSize > 0) {
+            // The shared cache only has a memory tier. Each device's blob cache still uses its own
+            // embedder functions.
+            DawnCacheDeviceDescriptor sharedCacheDesc = {};
+            sharedCacheDesc.memoryCacheSize = dawnDesc->sharedBlobCacheSize;
+            mSharedBlobCache = std::make_unique<BlobCache>(sharedCacheDesc);
+        }
     }
 
     if (!mLoggingCallback) {
@@ -580,6 +589,10 @@ const std::vector<std::string>& InstanceBase::GetRuntimeSearchPaths() const {
     return mRuntimeSearchPaths;
 }
 
+BlobCache* InstanceBase::GetSharedBlobCache() const {
+    return mSharedBlobCache.get();
+}
+
 const Ref<CallbackTaskManager>& InstanceBase::GetCallbackTaskManager() const {
     return mCallbackTaskManager;
 }
@@ -57,6 +57,7 @@ class Platform;
 
 namespace dawn::native {
 
+class BlobCache;
 class CallbackTaskManager;
 class DeviceBase;
 class Surface;
@@ -135,6 +136,10 @@ class InstanceBase final : public ErrorSink, public RefCountedWithExternalCount<
 
     const std::vector<std::string>& GetRuntimeSearchPaths() const;
 
+    // Returns the in-memory cache shared by the blob caches of all the devices of the instance,
+    // or nullptr if DawnInstanceDescriptor::sharedBlobCacheSize is zero.
+    BlobCache* GetSharedBlobCache() const;
+
     const Ref<CallbackTaskManager>& GetCallbackTaskManager() const;
     EventManager* GetEventManager();
 
@@ -205,6 +210,8 @@ class InstanceBase final : public ErrorSink, public RefCountedWithExternalCount<
     std::unique_ptr<dawn::platform::Platform> mDefaultPlatform;
     raw_ptr<dawn::platform::Platform> mPlatform = nullptr;
 
+    std::unique_ptr<BlobCache> mSharedBlobCache;
+
     BackendsArray mBackends;
     BackendsBitset mBackendsTried;
 
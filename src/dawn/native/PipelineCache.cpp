@@ -40,6 +40,11 @@ Blob PipelineCacheBase::Initialize() {
     return blob;
 }
 
+Blob PipelineCacheBase::LoadStoredBlob() {
+    DAWN_ASSERT(mInitialized);
+    return mCache->LoadLatest(mKey);
+}
+
 bool PipelineCacheBase::CacheHit() const {
     DAWN_ASSERT(mInitialized);
     return mCacheHit;
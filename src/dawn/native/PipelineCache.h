@@ -58,6 +58,10 @@ class PipelineCacheBase : public RefCounted {
     // implementations to get the cache and set the cache hit state. Should only be called once.
     Blob Initialize();
 
+    // Returns the blob currently stored for the key. Unlike the blob returned by Initialize, it
+    // includes what was stored by other caches with the same key since then.
+    Blob LoadStoredBlob();
+
   private:
     // Backend implementation of serialization of the cache into a blob.
     // Note: given that no local cached blob should be destructed and copy elision has strict
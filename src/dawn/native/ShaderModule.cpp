@@ -1063,6 +1063,21 @@ ResultOrError<Extent3D> ValidateComputeStageWorkgroupSize(
     return Extent3D{workgroup_size.x, workgroup_size.y, workgroup_size.z};
 }
 
+const std::string& TintProgram::GetWGSLForCacheKey() const {
+    std::call_once(mWGSLForCacheKeyOnce, [&] {
+#if TINT_BUILD_WGSL_WRITER
+        tint::wgsl::writer::Options options{};
+        mWGSLForCacheKey = tint::wgsl::writer::Generate(program, options)->wgsl;
+#else
+        // TODO(crbug.com/dawn/1481): We shouldn't need to write back to WGSL if we have a CacheKey
+        // built from the initial shader module input. Then, we would never need to parse the
+        // program and write back out to WGSL.
+        DAWN_UNREACHABLE();
+#endif
+    });
+    return mWGSLForCacheKey;
+}
+
 ShaderModuleParseResult::ShaderModuleParseResult() = default;
 ShaderModuleParseResult::~ShaderModuleParseResult() = default;
 
@@ -31,6 +31,7 @@
 #include <bitset>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <variant>
@@ -114,6 +115,15 @@ struct TintProgram : public RefCounted {
         : program(std::move(program)), file(std::move(file)) {}
     const tint::Program program;
     const std::unique_ptr<tint::Source::File> file;  // Keep the tint::Source::File alive
+
+    // Returns the WGSL generated from |program| that is part of the cache keys of the backend
+    // compilations. It is generated once and shared by the compilations of all the entry points
+    // of the module, which may run concurrently.
+    const std::string& GetWGSLForCacheKey() const;
+
+  private:
+    mutable std::once_flag mWGSLForCacheKeyOnce;
+    mutable std::string mWGSLForCacheKey;
 };
 
 struct ShaderModuleParseResult {
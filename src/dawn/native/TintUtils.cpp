@@ -201,16 +201,8 @@ tint::ast::transform::SubstituteOverride::Config BuildSubstituteOverridesTransfo
 
 // static
 template <>
-void stream::Stream<tint::Program>::Write(stream::Sink* sink, const tint::Program& p) {
-#if TINT_BUILD_WGSL_WRITER
-    tint::wgsl::writer::Options options{};
-    StreamIn(sink, tint::wgsl::writer::Generate(p, options)->wgsl);
-#else
-    // TODO(crbug.com/dawn/1481): We shouldn't need to write back to WGSL if we have a CacheKey
-    // built from the initial shader module input. Then, we would never need to parse the program
-    // and write back out to WGSL.
-    DAWN_UNREACHABLE();
-#endif
+void stream::Stream<TintProgram>::Write(stream::Sink* sink, const TintProgram& p) {
+    StreamIn(sink, p.GetWGSLForCacheKey());
 }
 
 }  // namespace dawn::native
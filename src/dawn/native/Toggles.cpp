@@ -592,6 +592,20 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
       "Don't validate the required VkImage size against the size of the AHardwareBuffer on import. "
       "Some drivers report the wrong size.",
       "https://crbug.com/333424893", ToggleStage::Device}},
+    {Toggle::VulkanMergePipelineCaches,
+     {"vulkan_merge_pipeline_caches",
+      "Use a single VkPipelineCache for all the pipelines of the device and, when writing it back "
+      "to the blob cache, merge it with the data stored by other devices or processes since it was "
+      "loaded. This lets short-lived processes that create the same pipelines share their cache. "
+      "Writes are not atomic: data stored by another process while the cache is written back can "
+      "be overwritten (last writer wins).",
+      "https://crbug.com/dawn/549", ToggleStage::Device}},
+    {Toggle::RemoveRedundantStateCommands,
+     {"remove_redundant_state_commands",
+      "Remove the state setting commands of finished command buffers that don't change the state "
+      "used by the next draw or dispatch, like setting the same pipeline or bind group again. This "
+      "makes the backends record fewer commands for applications that set state defensively.",
+      "https://crbug.com/dawn/1753", ToggleStage::Device}},
     // Comment to separate the }} so it is clearer what to copy-paste to add a toggle.
 }};
 }  // anonymous namespace
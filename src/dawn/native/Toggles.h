@@ -145,6 +145,8 @@ enum class Toggle {
 
     D3D11UseUnmonitoredFence,
     IgnoreImportedAHardwareBufferVulkanImageSize,
+    VulkanMergePipelineCaches,
+    RemoveRedundantStateCommands,
 
     EnumCount,
     InvalidEnum = EnumCount,
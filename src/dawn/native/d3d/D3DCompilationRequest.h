@@ -34,6 +34,7 @@
 
 #include "dawn/native/CacheRequest.h"
 #include "dawn/native/Serializable.h"
+#include "dawn/native/ShaderModule.h"
 #include "dawn/native/d3d/d3d_platform.h"
 
 #include "tint/tint.h"
@@ -58,7 +59,7 @@ enum class Compiler { FXC, DXC };
 using InterStageShaderVariablesMask = std::bitset<tint::hlsl::writer::kMaxInterStageLocations>;
 
 #define HLSL_COMPILATION_REQUEST_MEMBERS(X)                                                      \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(const TintProgram*, inputProgram)                                                          \
     X(std::string_view, entryPointName)                                                          \
     X(SingleShaderStage, stage)                                                                  \
     X(uint32_t, shaderModel)                                                                     \
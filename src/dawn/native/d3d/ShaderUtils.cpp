@@ -231,7 +231,7 @@ MaybeError TranslateToHLSL(d3d::HlslCompilationRequest r,
     {
         TRACE_EVENT0(tracePlatform.UnsafeGetValue(), General, "RunTransforms");
         DAWN_TRY_ASSIGN(transformedProgram,
-                        RunTransforms(&transformManager, r.inputProgram, transformInputs,
+                        RunTransforms(&transformManager, &r.inputProgram->program, transformInputs,
                                       &transformOutputs, nullptr));
     }
 
@@ -190,7 +190,7 @@ ResultOrError<d3d::CompiledShader> ShaderModule::Compile(
     }
 
     auto tintProgram = GetTintProgram();
-    req.hlsl.inputProgram = &(tintProgram->program);
+    req.hlsl.inputProgram = tintProgram.Get();
     req.hlsl.entryPointName = programmableStage.entryPoint.c_str();
     req.hlsl.stage = stage;
     // Put the firstIndex into the internally reserved group and binding to avoid conflicting with
@@ -330,7 +330,7 @@ ResultOrError<d3d::CompiledShader> ShaderModule::Compile(
     }
 
     auto tintProgram = GetTintProgram();
-    req.hlsl.inputProgram = &(tintProgram->program);
+    req.hlsl.inputProgram = tintProgram.Get();
     req.hlsl.entryPointName = programmableStage.entryPoint.c_str();
     req.hlsl.stage = stage;
     req.hlsl.firstIndexOffsetShaderRegister = layout->GetFirstIndexOffsetShaderRegister();
@@ -56,7 +56,7 @@ using OptionalVertexPullingTransformConfig =
 
 #define MSL_COMPILATION_REQUEST_MEMBERS(X)                                                       \
     X(SingleShaderStage, stage)                                                                  \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(const TintProgram*, inputProgram)                                                          \
     X(OptionalVertexPullingTransformConfig, vertexPullingTransformConfig)                        \
     X(std::optional<tint::ast::transform::SubstituteOverride::Config>, substituteOverrideConfig) \
     X(LimitsForCompilationRequest, limits)                                                       \
@@ -269,7 +269,7 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(
     MslCompilationRequest req = {};
     req.stage = stage;
     auto tintProgram = programmableStage.module->GetTintProgram();
-    req.inputProgram = &(tintProgram->program);
+    req.inputProgram = tintProgram.Get();
     req.vertexPullingTransformConfig = std::move(vertexPullingTransformConfig);
     req.substituteOverrideConfig = std::move(substituteOverrideConfig);
     req.entryPointName = programmableStage.entryPoint.c_str();
@@ -334,8 +334,8 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(
             {
                 TRACE_EVENT0(r.platform.UnsafeGetValue(), General, "RunTransforms");
                 DAWN_TRY_ASSIGN(program,
-                                RunTransforms(&transformManager, r.inputProgram, transformInputs,
-                                              &transformOutputs, nullptr));
+                                RunTransforms(&transformManager, &r.inputProgram->program,
+                                              transformInputs, &transformOutputs, nullptr));
             }
 
             // TODO(dawn:2180): refactor out.
@@ -579,6 +579,11 @@ bool Device::CanTextureLoadResolveTargetInTheSameRenderpass() const {
     return true;
 }
 
+bool Device::CanCreateCachedObjectsWithoutDeviceLock() const {
+    // Null objects don't own any backend state that would need the device lock.
+    return true;
+}
+
 Texture::Texture(DeviceBase* device, const UnpackedPtr<TextureDescriptor>& descriptor)
     : TextureBase(device, descriptor) {}
 
@@ -139,6 +139,7 @@ class Device final : public DeviceBase {
     float GetTimestampPeriodInNS() const override;
 
     bool CanTextureLoadResolveTargetInTheSameRenderpass() const override;
+    bool CanCreateCachedObjectsWithoutDeviceLock() const override;
 
   private:
     using DeviceBase::DeviceBase;
@@ -88,7 +88,7 @@ opengl::CombinedSampler* AppendCombinedSampler(opengl::CombinedSamplerInfo* info
 using InterstageLocationAndName = std::pair<uint32_t, std::string>;
 
 #define GLSL_COMPILATION_REQUEST_MEMBERS(X)                                                      \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(const TintProgram*, inputProgram)                                                          \
     X(std::string, entryPointName)                                                               \
     X(SingleShaderStage, stage)                                                                  \
     X(std::optional<tint::ast::transform::SubstituteOverride::Config>, substituteOverrideConfig) \
@@ -411,9 +411,9 @@ ResultOrError<GLuint> ShaderModule::CompileShader(
     GLSLCompilationRequest req = {};
 
     auto tintProgram = GetTintProgram();
-    req.inputProgram = &(tintProgram->program);
+    req.inputProgram = tintProgram.Get();
 
-    tint::inspector::Inspector inspector(*req.inputProgram);
+    tint::inspector::Inspector inspector(req.inputProgram->program);
 
     // Since (non-Vulkan) GLSL does not support descriptor sets, generate a
     // mapping from the original group/binding pair to a binding-only
@@ -540,7 +540,7 @@ ResultOrError<GLuint> ShaderModule::CompileShader(
 
             tint::Program program;
             tint::ast::transform::DataMap transformOutputs;
-            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, r.inputProgram,
+            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, &r.inputProgram->program,
                                                    transformInputs, &transformOutputs, nullptr));
 
             // TODO(dawn:2180): refactor out.
@@ -30,9 +30,11 @@
 #include <algorithm>
 #include <vector>
 
+#include "dawn/common/MatchVariant.h"
 #include "dawn/native/BindGroupTracker.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CommandValidation.h"
+#include "dawn/native/CommandVisitor.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/EnumMaskIterator.h"
@@ -176,31 +178,7 @@ class DescriptorSetTracker : public BindGroupTrackerBase<true, uint32_t> {
 MaybeError TransitionAndClearForSyncScope(Device* device,
                                           CommandRecordingContext* recordingContext,
                                           const SyncScopeResourceUsage& scope) {
-    // Separate barriers with vertex stages in destination stages from all other barriers.
-    // This avoids creating unnecessary fragment->vertex dependencies when merging barriers.
-    // Eg. merging a compute->vertex barrier and a fragment->fragment barrier would create
-    // a compute|fragment->vertex|fragment barrier.
-    const VkPipelineStageFlags vertexStages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
-                                              VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
-                                              VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-
-    struct Barriers {
-        std::vector<VkBufferMemoryBarrier> bufferBarriers;
-        std::vector<VkImageMemoryBarrier> imageBarriers;
-        VkPipelineStageFlags srcStages = 0;
-        VkPipelineStageFlags dstStages = 0;
-    };
-
-    Barriers vertexBarriers;
-    Barriers nonVertexBarriers;
-
-    auto MergeBufferBarrier = [](Barriers* barriers, VkPipelineStageFlags srcStages,
-                                 VkPipelineStageFlags dstStages,
-                                 const VkBufferMemoryBarrier& bufferBarrier) {
-        barriers->srcStages |= srcStages;
-        barriers->dstStages |= dstStages;
-        barriers->bufferBarriers.push_back(bufferBarrier);
-    };
+    PipelineBarrierBatch* barriers = &recordingContext->barriers;
 
     for (size_t i = 0; i < scope.buffers.size(); ++i) {
         Buffer* buffer = ToBackend(scope.buffers[i]);
@@ -213,22 +191,10 @@ MaybeError TransitionAndClearForSyncScope(Device* device,
         if (buffer->TrackUsageAndGetResourceBarrier(
                 recordingContext, scope.bufferSyncInfos[i].usage,
                 scope.bufferSyncInfos[i].shaderStages, &bufferBarrier, &srcStages, &dstStages)) {
-            MergeBufferBarrier((dstStages & vertexStages) ? &vertexBarriers : &nonVertexBarriers,
-                               srcStages, dstStages, bufferBarrier);
+            barriers->AddBufferBarrier(srcStages, dstStages, bufferBarrier);
         }
     }
 
-    auto MergeImageBarriers = [](Barriers* barriers, VkPipelineStageFlags srcStages,
-                                 VkPipelineStageFlags dstStages,
-                                 const std::vector<VkImageMemoryBarrier>& imageBarriers) {
-        barriers->srcStages |= srcStages;
-        barriers->dstStages |= dstStages;
-        barriers->imageBarriers.insert(barriers->imageBarriers.end(), imageBarriers.begin(),
-                                       imageBarriers.end());
-    };
-
-    // TODO(crbug.com/dawn/851): Add image barriers directly to the correct vector.
-    std::vector<VkImageMemoryBarrier> imageBarriers;
     for (size_t i = 0; i < scope.textures.size(); ++i) {
         Texture* texture = ToBackend(scope.textures[i]);
 
@@ -245,24 +211,14 @@ MaybeError TransitionAndClearForSyncScope(Device* device,
                 }
                 return {};
             }));
-        texture->TransitionUsageForPass(recordingContext, scope.textureSyncInfos[i], &imageBarriers,
-                                        &srcStages, &dstStages);
-
-        if (!imageBarriers.empty()) {
-            MergeImageBarriers((dstStages & vertexStages) ? &vertexBarriers : &nonVertexBarriers,
-                               srcStages, dstStages, imageBarriers);
-            imageBarriers.clear();
-        }
+        texture->TransitionUsageForPass(recordingContext, scope.textureSyncInfos[i],
+                                        barriers->GetImageBarrierScratch(), &srcStages,
+                                        &dstStages);
+        barriers->AddImageBarriersFromScratch(srcStages, dstStages);
     }
 
-    for (const Barriers& barriers : {vertexBarriers, nonVertexBarriers}) {
-        if (!barriers.bufferBarriers.empty() || !barriers.imageBarriers.empty()) {
-            device->fn.CmdPipelineBarrier(
-                recordingContext->commandBuffer, barriers.srcStages, barriers.dstStages, 0, 0,
-                nullptr, barriers.bufferBarriers.size(), barriers.bufferBarriers.data(),
-                barriers.imageBarriers.size(), barriers.imageBarriers.data());
-        }
-    }
+    barriers->Record(device->fn, recordingContext->commandBuffer,
+                     &recordingContext->barrierCounters);
 
     return {};
 }
@@ -359,6 +315,40 @@ void RecordResolveQuerySetCmd(VkCommandBuffer commands,
     }
 }
 
+VkDebugUtilsLabelEXT MakeDebugUtilsLabel(const char* label) {
+    VkDebugUtilsLabelEXT utilsLabel;
+    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+    utilsLabel.pNext = nullptr;
+    utilsLabel.pLabelName = label;
+    // Default color to black
+    utilsLabel.color[0] = 0.0;
+    utilsLabel.color[1] = 0.0;
+    utilsLabel.color[2] = 0.0;
+    utilsLabel.color[3] = 1.0;
+    return utilsLabel;
+}
+
+// The debug commands are dropped when VK_EXT_debug_utils isn't available.
+void RecordInsertDebugMarker(Device* device, VkCommandBuffer commands, const char* label) {
+    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+        VkDebugUtilsLabelEXT utilsLabel = MakeDebugUtilsLabel(label);
+        device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
+    }
+}
+
+void RecordPushDebugGroup(Device* device, VkCommandBuffer commands, const char* label) {
+    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+        VkDebugUtilsLabelEXT utilsLabel = MakeDebugUtilsLabel(label);
+        device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
+    }
+}
+
+void RecordPopDebugGroup(Device* device, VkCommandBuffer commands) {
+    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+        device->fn.CmdEndDebugUtilsLabelEXT(commands);
+    }
+}
+
 }  // anonymous namespace
 
 MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
@@ -891,52 +881,22 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
             }
 
             case Command::InsertDebugMarker: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    InsertDebugMarkerCmd* cmd = mCommands.NextCommand<InsertDebugMarkerCmd>();
-                    const char* label = mCommands.NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(&mCommands, Command::InsertDebugMarker);
-                }
+                InsertDebugMarkerCmd* cmd = mCommands.NextCommand<InsertDebugMarkerCmd>();
+                const char* label = mCommands.NextData<char>(cmd->length + 1);
+                RecordInsertDebugMarker(device, commands, label);
                 break;
             }
 
             case Command::PopDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    mCommands.NextCommand<PopDebugGroupCmd>();
-                    device->fn.CmdEndDebugUtilsLabelEXT(commands);
-                } else {
-                    SkipCommand(&mCommands, Command::PopDebugGroup);
-                }
+                mCommands.NextCommand<PopDebugGroupCmd>();
+                RecordPopDebugGroup(device, commands);
                 break;
             }
 
             case Command::PushDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    PushDebugGroupCmd* cmd = mCommands.NextCommand<PushDebugGroupCmd>();
-                    const char* label = mCommands.NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(&mCommands, Command::PushDebugGroup);
-                }
+                PushDebugGroupCmd* cmd = mCommands.NextCommand<PushDebugGroupCmd>();
+                const char* label = mCommands.NextData<char>(cmd->length + 1);
+                RecordPushDebugGroup(device, commands, label);
                 break;
             }
 
@@ -1000,134 +960,90 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
 
     uint64_t currentDispatch = 0;
     DescriptorSetTracker descriptorSets = {};
+    bool passEnded = false;
+
+    auto visitor = Overloaded{
+        [&](EndComputePassCmd*) -> MaybeError {
+            // Write timestamp at the end of compute pass if it's set.
+            if (computePassCmd->timestampWrites.endOfPassWriteIndex !=
+                wgpu::kQuerySetIndexUndefined) {
+                RecordWriteTimestampCmd(recordingContext, device,
+                                        computePassCmd->timestampWrites.querySet.Get(),
+                                        computePassCmd->timestampWrites.endOfPassWriteIndex, false,
+                                        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+            }
+            passEnded = true;
+            return {};
+        },
+
+        [&](DispatchCmd* dispatch) -> MaybeError {
+            DAWN_TRY(TransitionAndClearForSyncScope(
+                device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
+            descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+
+            device->fn.CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
+            currentDispatch++;
+            return {};
+        },
+
+        [&](DispatchIndirectCmd* dispatch) -> MaybeError {
+            VkBuffer indirectBuffer = ToBackend(dispatch->indirectBuffer)->GetHandle();
+
+            DAWN_TRY(TransitionAndClearForSyncScope(
+                device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
+            descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+
+            device->fn.CmdDispatchIndirect(commands, indirectBuffer,
+                                           static_cast<VkDeviceSize>(dispatch->indirectOffset));
+            currentDispatch++;
+            return {};
+        },
+
+        [&](SetBindGroupCmd* cmd, uint32_t* dynamicOffsets, size_t) -> MaybeError {
+            BindGroup* bindGroup = ToBackend(cmd->group.Get());
+            descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
+                                          dynamicOffsets);
+            return {};
+        },
+
+        [&](SetComputePipelineCmd* cmd) -> MaybeError {
+            ComputePipeline* pipeline = ToBackend(cmd->pipeline).Get();
+
+            device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_COMPUTE,
+                                       pipeline->GetHandle());
+            descriptorSets.OnSetPipeline(pipeline);
+            return {};
+        },
+
+        [&](InsertDebugMarkerCmd*, char* label, size_t) -> MaybeError {
+            RecordInsertDebugMarker(device, commands, label);
+            return {};
+        },
+
+        [&](PopDebugGroupCmd*) -> MaybeError {
+            RecordPopDebugGroup(device, commands);
+            return {};
+        },
+
+        [&](PushDebugGroupCmd*, char* label, size_t) -> MaybeError {
+            RecordPushDebugGroup(device, commands, label);
+            return {};
+        },
+
+        [&](WriteTimestampCmd* cmd) -> MaybeError {
+            RecordWriteTimestampCmd(recordingContext, device, cmd->querySet.Get(), cmd->queryIndex,
+                                    false, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+            return {};
+        },
+
+        [](auto*, auto...) -> MaybeError { DAWN_UNREACHABLE(); },
+    };
 
     Command type;
     while (mCommands.NextCommandId(&type)) {
-        switch (type) {
-            case Command::EndComputePass: {
-                mCommands.NextCommand<EndComputePassCmd>();
-
-                // Write timestamp at the end of compute pass if it's set.
-                if (computePassCmd->timestampWrites.endOfPassWriteIndex !=
-                    wgpu::kQuerySetIndexUndefined) {
-                    RecordWriteTimestampCmd(recordingContext, device,
-                                            computePassCmd->timestampWrites.querySet.Get(),
-                                            computePassCmd->timestampWrites.endOfPassWriteIndex,
-                                            false, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
-                }
-                return {};
-            }
-
-            case Command::Dispatch: {
-                DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
-
-                DAWN_TRY(TransitionAndClearForSyncScope(
-                    device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
-
-                device->fn.CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
-                currentDispatch++;
-                break;
-            }
-
-            case Command::DispatchIndirect: {
-                DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
-                VkBuffer indirectBuffer = ToBackend(dispatch->indirectBuffer)->GetHandle();
-
-                DAWN_TRY(TransitionAndClearForSyncScope(
-                    device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
-
-                device->fn.CmdDispatchIndirect(commands, indirectBuffer,
-                                               static_cast<VkDeviceSize>(dispatch->indirectOffset));
-                currentDispatch++;
-                break;
-            }
-
-            case Command::SetBindGroup: {
-                SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
-
-                BindGroup* bindGroup = ToBackend(cmd->group.Get());
-                uint32_t* dynamicOffsets = nullptr;
-                if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
-                }
-
-                descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
-                                              dynamicOffsets);
-                break;
-            }
-
-            case Command::SetComputePipeline: {
-                SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
-                ComputePipeline* pipeline = ToBackend(cmd->pipeline).Get();
-
-                device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_COMPUTE,
-                                           pipeline->GetHandle());
-                descriptorSets.OnSetPipeline(pipeline);
-                break;
-            }
-
-            case Command::InsertDebugMarker: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    InsertDebugMarkerCmd* cmd = mCommands.NextCommand<InsertDebugMarkerCmd>();
-                    const char* label = mCommands.NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(&mCommands, Command::InsertDebugMarker);
-                }
-                break;
-            }
-
-            case Command::PopDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    mCommands.NextCommand<PopDebugGroupCmd>();
-                    device->fn.CmdEndDebugUtilsLabelEXT(commands);
-                } else {
-                    SkipCommand(&mCommands, Command::PopDebugGroup);
-                }
-                break;
-            }
-
-            case Command::PushDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    PushDebugGroupCmd* cmd = mCommands.NextCommand<PushDebugGroupCmd>();
-                    const char* label = mCommands.NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(&mCommands, Command::PushDebugGroup);
-                }
-                break;
-            }
-
-            case Command::WriteTimestamp: {
-                WriteTimestampCmd* cmd = mCommands.NextCommand<WriteTimestampCmd>();
-
-                RecordWriteTimestampCmd(recordingContext, device, cmd->querySet.Get(),
-                                        cmd->queryIndex, false, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-                break;
-            }
-
-            default:
-                DAWN_UNREACHABLE();
+        DAWN_TRY(VisitCommand(&mCommands, type, visitor));
+        if (passEnded) {
+            return {};
         }
     }
 
@@ -1205,271 +1121,186 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
         clampFragDepthArgsDirty = false;
     };
 
-    auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
-        switch (type) {
-            case Command::Draw: {
-                DrawCmd* draw = iter->NextCommand<DrawCmd>();
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
-                                   draw->firstVertex, draw->firstInstance);
-                break;
-            }
-
-            case Command::DrawIndexed: {
-                DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
-                                          draw->firstIndex, draw->baseVertex, draw->firstInstance);
-                break;
-            }
-
-            case Command::DrawIndirect: {
-                DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
-                                           static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
-                break;
-            }
-
-            case Command::DrawIndexedIndirect: {
-                DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                DAWN_ASSERT(buffer != nullptr);
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndexedIndirect(commands, buffer->GetHandle(),
-                                                  static_cast<VkDeviceSize>(draw->indirectOffset),
-                                                  1, 0);
-                break;
-            }
-
-            case Command::InsertDebugMarker: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                    const char* label = iter->NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(iter, Command::InsertDebugMarker);
-                }
-                break;
-            }
-
-            case Command::PopDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    iter->NextCommand<PopDebugGroupCmd>();
-                    device->fn.CmdEndDebugUtilsLabelEXT(commands);
-                } else {
-                    SkipCommand(iter, Command::PopDebugGroup);
-                }
-                break;
+    // The commands that can be in render bundles as well as directly in the render pass.
+    auto renderBundleVisitor = Overloaded{
+        [&](DrawCmd* draw) {
+            descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount, draw->firstVertex,
+                               draw->firstInstance);
+        },
+
+        [&](DrawIndexedCmd* draw) {
+            descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
+                                      draw->firstIndex, draw->baseVertex, draw->firstInstance);
+        },
+
+        [&](DrawIndirectCmd* draw) {
+            Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+
+            descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
+                                       static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
+        },
+
+        [&](DrawIndexedIndirectCmd* draw) {
+            Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+            DAWN_ASSERT(buffer != nullptr);
+
+            descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDrawIndexedIndirect(commands, buffer->GetHandle(),
+                                              static_cast<VkDeviceSize>(draw->indirectOffset), 1,
+                                              0);
+        },
+
+        [&](InsertDebugMarkerCmd*, char* label, size_t) {
+            RecordInsertDebugMarker(device, commands, label);
+        },
+
+        [&](PopDebugGroupCmd*) { RecordPopDebugGroup(device, commands); },
+
+        [&](PushDebugGroupCmd*, char* label, size_t) {
+            RecordPushDebugGroup(device, commands, label);
+        },
+
+        [&](SetBindGroupCmd* cmd, uint32_t* dynamicOffsets, size_t) {
+            BindGroup* bindGroup = ToBackend(cmd->group.Get());
+            descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
+                                          dynamicOffsets);
+        },
+
+        [&](SetIndexBufferCmd* cmd) {
+            VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+
+            device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
+                                          VulkanIndexType(cmd->format));
+        },
+
+        [&](SetRenderPipelineCmd* cmd) {
+            RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+
+            device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                       pipeline->GetHandle());
+            lastPipeline = pipeline;
+
+            descriptorSets.OnSetPipeline(pipeline);
+
+            // Apply the deferred min/maxDepth push constants update if needed.
+            ApplyClampFragDepthArgs();
+        },
+
+        [&](SetVertexBufferCmd* cmd) {
+            VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
+            VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+
+            device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
+                                            &*buffer, &offset);
+        },
+    };
+    auto unreachable = [](auto*, auto...) { DAWN_UNREACHABLE(); };
+    auto bundleVisitor = Overloaded{renderBundleVisitor, unreachable};
+
+    bool passEnded = false;
+    auto visitor = Overloaded{
+        renderBundleVisitor,
+
+        [&](EndRenderPassCmd*) {
+            device->fn.CmdEndRenderPass(commands);
+
+            // Write timestamp at the end of render pass if it's set.
+            // We've observed that this must be called after the render pass ends or the
+            // timestamps produced are nonsensical on multiple Android devices.
+            if (renderPassCmd->timestampWrites.endOfPassWriteIndex !=
+                wgpu::kQuerySetIndexUndefined) {
+                RecordWriteTimestampCmd(recordingContext, device,
+                                        renderPassCmd->timestampWrites.querySet.Get(),
+                                        renderPassCmd->timestampWrites.endOfPassWriteIndex, true,
+                                        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
             }
-
-            case Command::PushDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                    const char* label = iter->NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(iter, Command::PushDebugGroup);
-                }
-                break;
+            passEnded = true;
+        },
+
+        [&](SetBlendConstantCmd* cmd) {
+            const std::array<float, 4> blendConstants = ConvertToFloatColor(cmd->color);
+            device->fn.CmdSetBlendConstants(commands, blendConstants.data());
+        },
+
+        [&](SetStencilReferenceCmd* cmd) {
+            device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, cmd->reference);
+        },
+
+        [&](SetViewportCmd* cmd) {
+            VkViewport viewport;
+            viewport.x = cmd->x;
+            viewport.y = cmd->y + cmd->height;
+            viewport.width = cmd->width;
+            viewport.height = -cmd->height;
+            viewport.minDepth = cmd->minDepth;
+            viewport.maxDepth = cmd->maxDepth;
+
+            // Vulkan disallows width = 0, but VK_KHR_maintenance1 which we require allows
+            // height = 0 so use that to do an empty viewport.
+            if (viewport.width == 0) {
+                viewport.height = 0;
+
+                // Set the viewport x range to a range that's always valid.
+                viewport.x = 0;
+                viewport.width = 1;
             }
 
-            case Command::SetBindGroup: {
-                SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                BindGroup* bindGroup = ToBackend(cmd->group.Get());
-                uint32_t* dynamicOffsets = nullptr;
-                if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+            device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+
+            // Try applying the push constants that contain min/maxDepth immediately. This can
+            // be deferred if no pipeline is currently bound.
+            clampFragDepthArgs = {viewport.minDepth, viewport.maxDepth};
+            clampFragDepthArgsDirty = true;
+            ApplyClampFragDepthArgs();
+        },
+
+        [&](SetScissorRectCmd* cmd) {
+            VkRect2D rect;
+            rect.offset.x = cmd->x;
+            rect.offset.y = cmd->y;
+            rect.extent.width = cmd->width;
+            rect.extent.height = cmd->height;
+
+            device->fn.CmdSetScissor(commands, 0, 1, &rect);
+        },
+
+        [&](ExecuteBundlesCmd*, Ref<RenderBundleBase>* bundles, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                CommandIterator* iter = bundles[i]->GetCommands();
+                iter->Reset();
+                Command type;
+                while (iter->NextCommandId(&type)) {
+                    VisitCommand(iter, type, bundleVisitor);
                 }
-
-                descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
-                                              dynamicOffsets);
-                break;
-            }
-
-            case Command::SetIndexBuffer: {
-                SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
-
-                device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
-                                              VulkanIndexType(cmd->format));
-                break;
             }
+        },
 
-            case Command::SetRenderPipeline: {
-                SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+        [&](BeginOcclusionQueryCmd* cmd) {
+            device->fn.CmdBeginQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
+                                     cmd->queryIndex, 0);
+        },
 
-                device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                           pipeline->GetHandle());
-                lastPipeline = pipeline;
+        [&](EndOcclusionQueryCmd* cmd) {
+            device->fn.CmdEndQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
+                                   cmd->queryIndex);
+        },
 
-                descriptorSets.OnSetPipeline(pipeline);
+        [&](WriteTimestampCmd* cmd) {
+            RecordWriteTimestampCmd(recordingContext, device, cmd->querySet.Get(), cmd->queryIndex,
+                                    true, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        },
 
-                // Apply the deferred min/maxDepth push constants update if needed.
-                ApplyClampFragDepthArgs();
-                break;
-            }
-
-            case Command::SetVertexBuffer: {
-                SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
-
-                device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
-                                                &*buffer, &offset);
-                break;
-            }
-
-            default:
-                DAWN_UNREACHABLE();
-                break;
-        }
+        unreachable,
     };
 
     Command type;
     while (mCommands.NextCommandId(&type)) {
-        switch (type) {
-            case Command::EndRenderPass: {
-                mCommands.NextCommand<EndRenderPassCmd>();
-
-                device->fn.CmdEndRenderPass(commands);
-
-                // Write timestamp at the end of render pass if it's set.
-                // We've observed that this must be called after the render pass ends or the
-                // timestamps produced are nonsensical on multiple Android devices.
-                if (renderPassCmd->timestampWrites.endOfPassWriteIndex !=
-                    wgpu::kQuerySetIndexUndefined) {
-                    RecordWriteTimestampCmd(recordingContext, device,
-                                            renderPassCmd->timestampWrites.querySet.Get(),
-                                            renderPassCmd->timestampWrites.endOfPassWriteIndex,
-                                            true, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
-                }
-
-                return {};
-            }
-
-            case Command::SetBlendConstant: {
-                SetBlendConstantCmd* cmd = mCommands.NextCommand<SetBlendConstantCmd>();
-                const std::array<float, 4> blendConstants = ConvertToFloatColor(cmd->color);
-                device->fn.CmdSetBlendConstants(commands, blendConstants.data());
-                break;
-            }
-
-            case Command::SetStencilReference: {
-                SetStencilReferenceCmd* cmd = mCommands.NextCommand<SetStencilReferenceCmd>();
-                device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK,
-                                                  cmd->reference);
-                break;
-            }
-
-            case Command::SetViewport: {
-                SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
-                VkViewport viewport;
-                viewport.x = cmd->x;
-                viewport.y = cmd->y + cmd->height;
-                viewport.width = cmd->width;
-                viewport.height = -cmd->height;
-                viewport.minDepth = cmd->minDepth;
-                viewport.maxDepth = cmd->maxDepth;
-
-                // Vulkan disallows width = 0, but VK_KHR_maintenance1 which we require allows
-                // height = 0 so use that to do an empty viewport.
-                if (viewport.width == 0) {
-                    viewport.height = 0;
-
-                    // Set the viewport x range to a range that's always valid.
-                    viewport.x = 0;
-                    viewport.width = 1;
-                }
-
-                device->fn.CmdSetViewport(commands, 0, 1, &viewport);
-
-                // Try applying the push constants that contain min/maxDepth immediately. This can
-                // be deferred if no pipeline is currently bound.
-                clampFragDepthArgs = {viewport.minDepth, viewport.maxDepth};
-                clampFragDepthArgsDirty = true;
-                ApplyClampFragDepthArgs();
-                break;
-            }
-
-            case Command::SetScissorRect: {
-                SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
-                VkRect2D rect;
-                rect.offset.x = cmd->x;
-                rect.offset.y = cmd->y;
-                rect.extent.width = cmd->width;
-                rect.extent.height = cmd->height;
-
-                device->fn.CmdSetScissor(commands, 0, 1, &rect);
-                break;
-            }
-
-            case Command::ExecuteBundles: {
-                ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
-                auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
-
-                for (uint32_t i = 0; i < cmd->count; ++i) {
-                    CommandIterator* iter = bundles[i]->GetCommands();
-                    iter->Reset();
-                    while (iter->NextCommandId(&type)) {
-                        EncodeRenderBundleCommand(iter, type);
-                    }
-                }
-                break;
-            }
-
-            case Command::BeginOcclusionQuery: {
-                BeginOcclusionQueryCmd* cmd = mCommands.NextCommand<BeginOcclusionQueryCmd>();
-
-                device->fn.CmdBeginQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
-                                         cmd->queryIndex, 0);
-                break;
-            }
-
-            case Command::EndOcclusionQuery: {
-                EndOcclusionQueryCmd* cmd = mCommands.NextCommand<EndOcclusionQueryCmd>();
-
-                device->fn.CmdEndQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
-                                       cmd->queryIndex);
-                break;
-            }
-
-            case Command::WriteTimestamp: {
-                WriteTimestampCmd* cmd = mCommands.NextCommand<WriteTimestampCmd>();
-
-                RecordWriteTimestampCmd(recordingContext, device, cmd->querySet.Get(),
-                                        cmd->queryIndex, true, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-                break;
-            }
-
-            default: {
-                EncodeRenderBundleCommand(&mCommands, type);
-                break;
-            }
+        VisitCommand(&mCommands, type, visitor);
+        if (passEnded) {
+            return {};
         }
     }
 
@@ -0,0 +1,156 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/vulkan/CommandRecordingContext.h"
+
+#include <algorithm>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::native::vulkan {
+
+namespace {
+
+constexpr VkPipelineStageFlags kVertexStages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                                               VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                               VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+
+}  // anonymous namespace
+
+PipelineBarrierBatch::PipelineBarrierBatch() = default;
+PipelineBarrierBatch::~PipelineBarrierBatch() = default;
+PipelineBarrierBatch::PipelineBarrierBatch(PipelineBarrierBatch&&) = default;
+PipelineBarrierBatch& PipelineBarrierBatch::operator=(PipelineBarrierBatch&&) = default;
+
+bool PipelineBarrierBatch::Group::Empty() const {
+    return bufferBarriers.empty() && imageBarriers.empty();
+}
+
+void PipelineBarrierBatch::Group::Clear() {
+    bufferBarriers.clear();
+    imageBarriers.clear();
+    srcStages = 0;
+    dstStages = 0;
+}
+
+PipelineBarrierBatch::Group* PipelineBarrierBatch::GetGroup(VkPipelineStageFlags dstStages) {
+    return (dstStages & kVertexStages) ? &mVertexGroup : &mNonVertexGroup;
+}
+
+void PipelineBarrierBatch::AddBufferBarrier(VkPipelineStageFlags srcStages,
+                                            VkPipelineStageFlags dstStages,
+                                            const VkBufferMemoryBarrier& barrier) {
+    Group* group = GetGroup(dstStages);
+    group->srcStages |= srcStages;
+    group->dstStages |= dstStages;
+    group->bufferBarriers.push_back(barrier);
+}
+
+std::vector<VkImageMemoryBarrier>* PipelineBarrierBatch::GetImageBarrierScratch() {
+    return &mImageBarrierScratch;
+}
+
+void PipelineBarrierBatch::AddImageBarriersFromScratch(VkPipelineStageFlags srcStages,
+                                                       VkPipelineStageFlags dstStages) {
+    if (mImageBarrierScratch.empty()) {
+        return;
+    }
+
+    Group* group = GetGroup(dstStages);
+    group->srcStages |= srcStages;
+    group->dstStages |= dstStages;
+    group->imageBarriers.insert(group->imageBarriers.end(), mImageBarrierScratch.begin(),
+                                mImageBarrierScratch.end());
+    mImageBarrierScratch.clear();
+}
+
+void PipelineBarrierBatch::Record(const VulkanFunctions& fn,
+                                  VkCommandBuffer commands,
+                                  Counters* counters) {
+    DAWN_ASSERT(mImageBarrierScratch.empty());
+
+    // When both groups wait on the same source stages, merging them doesn't add any dependency
+    // that wasn't already there, so record them as a single barrier.
+    if (!mVertexGroup.Empty() && !mNonVertexGroup.Empty() &&
+        mVertexGroup.srcStages == mNonVertexGroup.srcStages) {
+        mVertexGroup.dstStages |= mNonVertexGroup.dstStages;
+        mVertexGroup.bufferBarriers.insert(mVertexGroup.bufferBarriers.end(),
+                                           mNonVertexGroup.bufferBarriers.begin(),
+                                           mNonVertexGroup.bufferBarriers.end());
+        mVertexGroup.imageBarriers.insert(mVertexGroup.imageBarriers.end(),
+                                          mNonVertexGroup.imageBarriers.begin(),
+                                          mNonVertexGroup.imageBarriers.end());
+        mNonVertexGroup.Clear();
+        counters->merged++;
+    }
+
+    for (Group* group : {&mVertexGroup, &mNonVertexGroup}) {
+        if (!group->Empty()) {
+            RecordGroup(fn, commands, *group, counters);
+            group->Clear();
+        }
+    }
+}
+
+void PipelineBarrierBatch::RecordGroup(const VulkanFunctions& fn,
+                                       VkCommandBuffer commands,
+                                       const Group& group,
+                                       Counters* counters) {
+    counters->recorded++;
+
+    // Buffer barriers don't change any layout so, unless they transfer queue family ownership,
+    // several of them are equivalent to a single global memory barrier with the same stages and
+    // the union of their accesses, which is cheaper for drivers to process.
+    const bool canUseMemoryBarrier =
+        group.bufferBarriers.size() > 1 &&
+        std::all_of(group.bufferBarriers.begin(), group.bufferBarriers.end(),
+                    [](const VkBufferMemoryBarrier& barrier) {
+                        return barrier.srcQueueFamilyIndex == barrier.dstQueueFamilyIndex;
+                    });
+    if (!canUseMemoryBarrier) {
+        fn.CmdPipelineBarrier(commands, group.srcStages, group.dstStages, 0, 0, nullptr,
+                              group.bufferBarriers.size(), group.bufferBarriers.data(),
+                              group.imageBarriers.size(), group.imageBarriers.data());
+        return;
+    }
+
+    VkMemoryBarrier memoryBarrier;
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = nullptr;
+    memoryBarrier.srcAccessMask = 0;
+    memoryBarrier.dstAccessMask = 0;
+    for (const VkBufferMemoryBarrier& barrier : group.bufferBarriers) {
+        memoryBarrier.srcAccessMask |= barrier.srcAccessMask;
+        memoryBarrier.dstAccessMask |= barrier.dstAccessMask;
+    }
+    counters->merged += group.bufferBarriers.size() - 1;
+
+    fn.CmdPipelineBarrier(commands, group.srcStages, group.dstStages, 0, 1, &memoryBarrier, 0,
+                          nullptr, group.imageBarriers.size(), group.imageBarriers.data());
+}
+
+}  // namespace dawn::native::vulkan
@@ -47,8 +47,63 @@ struct CommandPoolAndBuffer {
     VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
 };
 
+// Accumulates the barriers of a synchronization scope so that they are recorded with as few
+// vkCmdPipelineBarrier as possible. The vectors are cleared but not freed after each scope so
+// that recording many small passes doesn't reallocate them.
+class PipelineBarrierBatch {
+  public:
+    PipelineBarrierBatch();
+    ~PipelineBarrierBatch();
+    PipelineBarrierBatch(PipelineBarrierBatch&&);
+    PipelineBarrierBatch& operator=(PipelineBarrierBatch&&);
+
+    struct Counters {
+        // The number of vkCmdPipelineBarrier recorded.
+        uint64_t recorded = 0;
+        // The number of vkCmdPipelineBarrier and buffer barriers avoided by merging them.
+        uint64_t merged = 0;
+    };
+
+    void AddBufferBarrier(VkPipelineStageFlags srcStages,
+                          VkPipelineStageFlags dstStages,
+                          const VkBufferMemoryBarrier& barrier);
+
+    // Image barriers are first appended to the scratch vector and then added to the batch with
+    // the stages they synchronize. AddImageBarriersFromScratch clears the scratch vector.
+    std::vector<VkImageMemoryBarrier>* GetImageBarrierScratch();
+    void AddImageBarriersFromScratch(VkPipelineStageFlags srcStages,
+                                     VkPipelineStageFlags dstStages);
+
+    // Records the accumulated barriers in |commands| and empties the batch.
+    void Record(const VulkanFunctions& fn, VkCommandBuffer commands, Counters* counters);
+
+  private:
+    struct Group {
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+
+        bool Empty() const;
+        void Clear();
+    };
+
+    Group* GetGroup(VkPipelineStageFlags dstStages);
+    void RecordGroup(const VulkanFunctions& fn,
+                     VkCommandBuffer commands,
+                     const Group& group,
+                     Counters* counters);
+
+    // Barriers with vertex stages in their destination stages are kept separate from all other
+    // barriers. This avoids creating unnecessary fragment->vertex dependencies when merging
+    // barriers. Eg. merging a compute->vertex barrier and a fragment->fragment barrier would
+    // create a compute|fragment->vertex|fragment barrier.
+    Group mVertexGroup;
+    Group mNonVertexGroup;
+    std::vector<VkImageMemoryBarrier> mImageBarrierScratch;
+};
+
 // Used to track operations that are handled after recording.
-// Currently only tracks semaphores, but may be used to do barrier coalescing in the future.
 struct CommandRecordingContext {
     VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
     std::vector<VkSemaphore> waitSemaphores = {};
@@ -81,6 +136,10 @@ struct CommandRecordingContext {
     // Need to track if a render pass has already been recorded for the
     // VulkanSplitCommandBufferOnComputePassAfterRenderPass workaround.
     bool hasRecordedRenderPass = false;
+
+    // Storage for the barriers of the synchronization scopes, and counters reported on submit.
+    PipelineBarrierBatch barriers;
+    PipelineBarrierBatch::Counters barrierCounters;
 };
 
 }  // namespace dawn::native::vulkan
@@ -120,6 +120,19 @@ MaybeError ComputePipeline::InitializeImpl() {
     // Try to see if we have anything in the blob cache.
     platform::metrics::DawnHistogramTimer cacheTimer(GetDevice()->GetPlatform());
     Ref<PipelineCache> cache = ToBackend(GetDevice()->GetOrCreatePipelineCache(GetCacheKey()));
+
+    // Ask whether the pipeline was found in merged caches to report their hit rate. This is done
+    // after recording the cache key as the feedback is an output that must not be keyed.
+    VkPipelineCreationFeedbackEXT creationFeedback = {};
+    VkPipelineCreationFeedbackCreateInfoEXT creationFeedbackInfo = {};
+    const bool useCreationFeedback =
+        cache->IsMerged() && device->GetDeviceInfo().HasExt(DeviceExt::PipelineCreationFeedback);
+    if (useCreationFeedback) {
+        creationFeedbackInfo.pPipelineCreationFeedback = &creationFeedback;
+        PNextChainBuilder createInfoChain(&createInfo);
+        createInfoChain.Add(&creationFeedbackInfo,
+                            VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT);
+    }
     if (cache->CacheHit()) {
         DAWN_TRY(CheckVkSuccess(
             device->fn.CreateComputePipelines(device->GetVkDevice(), cache->GetHandle(), 1,
@@ -135,7 +148,7 @@ MaybeError ComputePipeline::InitializeImpl() {
         cacheTimer.RecordMicroseconds("Vulkan.CreateComputePipelines.CacheMiss");
     }
     // TODO(dawn:549): Flush is currently in the same thread, but perhaps deferrable.
-    DAWN_TRY(cache->FlushIfNeeded());
+    DAWN_TRY(cache->DidCreatePipeline(useCreationFeedback ? &creationFeedback : nullptr));
 
     SetLabelImpl();
 
@@ -27,6 +27,8 @@
 
 #include "dawn/native/vulkan/DescriptorSetAllocator.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "dawn/native/Queue.h"
@@ -39,6 +41,9 @@ namespace dawn::native::vulkan {
 
 // TODO(enga): Figure out this value.
 static constexpr uint32_t kMaxDescriptorsPerPool = 512;
+// The limit on the number of descriptors in the pools of layouts that need more than one pool.
+static constexpr uint32_t kMaxDescriptorsPerGrownPool = 16 * kMaxDescriptorsPerPool;
+static_assert(kMaxDescriptorsPerGrownPool <= std::numeric_limits<uint16_t>::max());
 
 // static
 Ref<DescriptorSetAllocator> DescriptorSetAllocator::Create(
@@ -53,39 +58,32 @@ DescriptorSetAllocator::DescriptorSetAllocator(
     : ObjectBase(device) {
     // Compute the total number of descriptors for this layout.
     uint32_t totalDescriptorCount = 0;
-    mPoolSizes.reserve(descriptorCountPerType.size());
+    mDescriptorCountPerSet.reserve(descriptorCountPerType.size());
     for (const auto& [type, count] : descriptorCountPerType) {
         DAWN_ASSERT(count > 0);
         totalDescriptorCount += count;
-        mPoolSizes.push_back(VkDescriptorPoolSize{type, count});
+        mDescriptorCountPerSet.push_back(VkDescriptorPoolSize{type, count});
     }
 
     if (totalDescriptorCount == 0) {
-        // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
-        // number of pools, each of which has non-zero descriptor counts.
         // Since the descriptor set layout is empty, we should be able to allocate
-        // |kMaxDescriptorsPerPool| sets from this 1-sized descriptor pool.
-        // The type of this descriptor pool doesn't matter because it is never used.
-        mPoolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
-        mMaxSets = kMaxDescriptorsPerPool;
+        // |kMaxDescriptorsPerPool| sets from a 1-sized descriptor pool.
+        mNextPoolSetCount = kMaxDescriptorsPerPool;
+        mMaxSetsPerPool = kMaxDescriptorsPerGrownPool;
     } else {
         DAWN_ASSERT(totalDescriptorCount <= kMaxBindingsPerPipelineLayout);
         static_assert(kMaxBindingsPerPipelineLayout <= kMaxDescriptorsPerPool);
 
         // Compute the total number of descriptors sets that fits given the max.
-        mMaxSets = kMaxDescriptorsPerPool / totalDescriptorCount;
-        DAWN_ASSERT(mMaxSets > 0);
-
-        // Grow the number of desciptors in the pool to fit the computed |mMaxSets|.
-        for (auto& poolSize : mPoolSizes) {
-            poolSize.descriptorCount *= mMaxSets;
-        }
+        mNextPoolSetCount = kMaxDescriptorsPerPool / totalDescriptorCount;
+        mMaxSetsPerPool = kMaxDescriptorsPerGrownPool / totalDescriptorCount;
+        DAWN_ASSERT(mNextPoolSetCount > 0);
     }
 }
 
 DescriptorSetAllocator::~DescriptorSetAllocator() {
     for (auto& pool : mDescriptorPools) {
-        DAWN_ASSERT(pool.freeSetIndices.size() == mMaxSets);
+        DAWN_ASSERT(pool.freeSetIndices.size() == pool.sets.size());
         if (pool.vkPool != VK_NULL_HANDLE) {
             Device* device = ToBackend(GetDevice());
             device->GetFencedDeleter()->DeleteWhenUnused(pool.vkPool);
@@ -94,6 +92,12 @@ DescriptorSetAllocator::~DescriptorSetAllocator() {
 }
 
 ResultOrError<DescriptorSetAllocation> DescriptorSetAllocator::Allocate(BindGroupLayout* layout) {
+    if (mAvailableDescriptorPoolIndices.empty() && !mPendingDeallocations.Empty()) {
+        // Sets freed for commands that already completed are only recycled on the next device
+        // Tick. Recycle them now instead of creating a pool when bind groups are created and
+        // destroyed faster than the device ticks.
+        FinishDeallocation(GetDevice()->GetQueue()->GetCompletedCommandSerial());
+    }
     if (mAvailableDescriptorPoolIndices.empty()) {
         DAWN_TRY(AllocateDescriptorPool(layout));
     }
@@ -149,13 +153,29 @@ void DescriptorSetAllocator::FinishDeallocation(ExecutionSerial completedSerial)
 }
 
 MaybeError DescriptorSetAllocator::AllocateDescriptorPool(BindGroupLayout* layout) {
+    const SetIndex setCount = mNextPoolSetCount;
+
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    if (mDescriptorCountPerSet.empty()) {
+        // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
+        // number of pools, each of which has non-zero descriptor counts.
+        // The type of this descriptor pool doesn't matter because it is never used.
+        poolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
+    } else {
+        // Grow the number of desciptors in the pool to fit |setCount| sets.
+        poolSizes = mDescriptorCountPerSet;
+        for (auto& poolSize : poolSizes) {
+            poolSize.descriptorCount *= setCount;
+        }
+    }
+
     VkDescriptorPoolCreateInfo createInfo;
     createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     createInfo.pNext = nullptr;
     createInfo.flags = 0;
-    createInfo.maxSets = mMaxSets;
-    createInfo.poolSizeCount = static_cast<PoolIndex>(mPoolSizes.size());
-    createInfo.pPoolSizes = mPoolSizes.data();
+    createInfo.maxSets = setCount;
+    createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    createInfo.pPoolSizes = poolSizes.data();
 
     Device* device = ToBackend(GetDevice());
 
@@ -164,16 +184,16 @@ MaybeError DescriptorSetAllocator::AllocateDescriptorPool(BindGroupLayout* layou
                                                             nullptr, &*descriptorPool),
                             "CreateDescriptorPool"));
 
-    std::vector<VkDescriptorSetLayout> layouts(mMaxSets, layout->GetHandle());
+    std::vector<VkDescriptorSetLayout> layouts(setCount, layout->GetHandle());
 
     VkDescriptorSetAllocateInfo allocateInfo;
     allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocateInfo.pNext = nullptr;
     allocateInfo.descriptorPool = descriptorPool;
-    allocateInfo.descriptorSetCount = mMaxSets;
+    allocateInfo.descriptorSetCount = setCount;
     allocateInfo.pSetLayouts = AsVkArray(layouts.data());
 
-    std::vector<VkDescriptorSet> sets(mMaxSets);
+    std::vector<VkDescriptorSet> sets(setCount);
     MaybeError result =
         CheckVkSuccess(device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo,
                                                          AsVkArray(sets.data())),
@@ -185,9 +205,9 @@ MaybeError DescriptorSetAllocator::AllocateDescriptorPool(BindGroupLayout* layou
     }
 
     std::vector<SetIndex> freeSetIndices;
-    freeSetIndices.reserve(mMaxSets);
+    freeSetIndices.reserve(setCount);
 
-    for (SetIndex i = 0; i < mMaxSets; ++i) {
+    for (SetIndex i = 0; i < setCount; ++i) {
         freeSetIndices.push_back(i);
     }
 
@@ -195,6 +215,8 @@ MaybeError DescriptorSetAllocator::AllocateDescriptorPool(BindGroupLayout* layou
     mDescriptorPools.emplace_back(
         DescriptorPool{descriptorPool, std::move(sets), std::move(freeSetIndices)});
 
+    mNextPoolSetCount = std::min(static_cast<SetIndex>(setCount * 2), mMaxSetsPerPool);
+
     return {};
 }
 
@@ -63,8 +63,13 @@ class DescriptorSetAllocator : public ObjectBase {
 
     MaybeError AllocateDescriptorPool(BindGroupLayout* layout);
 
-    std::vector<VkDescriptorPoolSize> mPoolSizes;
-    SetIndex mMaxSets;
+    // The number of descriptors of each type needed by a single set. Empty if the layout has no
+    // descriptors.
+    std::vector<VkDescriptorPoolSize> mDescriptorCountPerSet;
+    // Each new pool holds twice as many sets as the previous one, up to mMaxSetsPerPool, so that
+    // layouts with a lot of bind groups need few calls to vkCreateDescriptorPool.
+    SetIndex mNextPoolSetCount;
+    SetIndex mMaxSetsPerPool;
 
     struct DescriptorPool {
         VkDescriptorPool vkPool;
@@ -126,6 +126,13 @@ MaybeError Device::Initialize(const UnpackedPtr<DeviceDescriptor>& descriptor) {
     }
 
     mRenderPassCache = std::make_unique<RenderPassCache>(this);
+    if (IsToggleEnabled(Toggle::VulkanMergePipelineCaches)) {
+        // The device cache key includes the adapter, the enabled features and the toggles so
+        // only devices created the same way share the merged cache.
+        CacheKey key;
+        StreamIn(&key, CacheKey::Type::PipelineCache, GetCacheKey());
+        mMergedPipelineCache = PipelineCache::CreateMerged(this, key);
+    }
     mResourceMemoryAllocator = std::make_unique<MutexProtected<ResourceMemoryAllocator>>(this);
 
     mExternalMemoryService = std::make_unique<external_memory::Service>(this);
@@ -233,6 +240,9 @@ ResultOrError<Ref<TextureViewBase>> Device::CreateTextureViewImpl(
     return TextureView::Create(texture, descriptor);
 }
 Ref<PipelineCacheBase> Device::GetOrCreatePipelineCacheImpl(const CacheKey& key) {
+    if (mMergedPipelineCache != nullptr) {
+        return mMergedPipelineCache;
+    }
     return PipelineCache::Create(this, key);
 }
 void Device::InitializeComputePipelineAsyncImpl(Ref<CreateComputePipelineAsyncEvent> event) {
@@ -325,6 +335,7 @@ MaybeError Device::TickImpl() {
     GetResourceMemoryAllocator()->Tick(completedSerial);
     GetFencedDeleter()->Tick(completedSerial);
     mDescriptorAllocatorsPendingDeallocation.ClearUpTo(completedSerial);
+    FlushMergedPipelineCache();
 
     DAWN_TRY(queue->SubmitPendingCommands());
     DAWN_TRY(CheckDebugLayerAndGenerateErrors());
@@ -332,6 +343,19 @@ MaybeError Device::TickImpl() {
     return {};
 }
 
+void Device::FlushMergedPipelineCache() {
+    if (mMergedPipelineCache == nullptr) {
+        return;
+    }
+    // Failing to write the cache back only makes later pipeline creations slower, so it is logged
+    // instead of being an error of the device.
+    MaybeError maybeError = mMergedPipelineCache->FlushMergedIfDirty();
+    if (maybeError.IsError()) {
+        std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+        EmitLog(WGPULoggingType_Info, error->GetFormattedMessage().c_str());
+    }
+}
+
 VkInstance Device::GetVkInstance() const {
     return ToBackend(GetPhysicalDevice())->GetVulkanInstance()->GetVkInstance();
 }
@@ -367,6 +391,10 @@ external_semaphore::Service* Device::GetExternalSemaphoreService() const {
     return mExternalSemaphoreService.get();
 }
 
+PipelineCache* Device::GetMergedPipelineCache() const {
+    return mMergedPipelineCache.Get();
+}
+
 void Device::EnqueueDeferredDeallocation(DescriptorSetAllocator* allocator) {
     mDescriptorAllocatorsPendingDeallocation.Enqueue(allocator,
                                                      GetQueue()->GetPendingCommandSerial());
@@ -882,6 +910,9 @@ void Device::DestroyImpl() {
 
     ToBackend(GetPhysicalDevice())->GetVulkanInstance()->StopListeningForDeviceMessages(this);
 
+    FlushMergedPipelineCache();
+    mMergedPipelineCache = nullptr;
+
     for (Ref<DescriptorSetAllocator>& allocator :
          mDescriptorAllocatorsPendingDeallocation.IterateUpTo(kMaxExecutionSerial)) {
         allocator->FinishDeallocation(kMaxExecutionSerial);
@@ -78,6 +78,8 @@ class Device final : public DeviceBase {
     RenderPassCache* GetRenderPassCache() const;
     MutexProtected<ResourceMemoryAllocator>& GetResourceMemoryAllocator() const;
     external_semaphore::Service* GetExternalSemaphoreService() const;
+    // Returns the cache shared by all pipelines when VulkanMergePipelineCaches is enabled.
+    PipelineCache* GetMergedPipelineCache() const;
 
     void EnqueueDeferredDeallocation(DescriptorSetAllocator* allocator);
 
@@ -171,6 +173,7 @@ class Device final : public DeviceBase {
     ResultOrError<VulkanDeviceKnobs> CreateDevice(VkPhysicalDevice vkPhysicalDevice);
 
     MaybeError CheckDebugLayerAndGenerateErrors();
+    void FlushMergedPipelineCache();
     void AppendDebugLayerMessages(ErrorData* error) override;
     void CheckDebugMessagesAfterDestruction() const;
 
@@ -191,6 +194,7 @@ class Device final : public DeviceBase {
     std::unique_ptr<MutexProtected<FencedDeleter>> mDeleter;
     std::unique_ptr<MutexProtected<ResourceMemoryAllocator>> mResourceMemoryAllocator;
     std::unique_ptr<RenderPassCache> mRenderPassCache;
+    Ref<PipelineCache> mMergedPipelineCache;
 
     std::unique_ptr<external_memory::Service> mExternalMemoryService;
     std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
@@ -28,7 +28,10 @@
 #include "dawn/native/vulkan/PipelineCacheVk.h"
 
 #include <memory>
+#include <string_view>
+#include <utility>
 
+#include "absl/hash/hash.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/vulkan/DeviceVk.h"
@@ -37,15 +40,35 @@
 
 namespace dawn::native::vulkan {
 
+namespace {
+
+// How many times the merged cache is merged again with the stored data when another device or
+// process stores data while it is being merged.
+constexpr uint32_t kMaxMergeAttempts = 3;
+
+size_t HashBlob(const Blob& blob) {
+    return absl::Hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(blob.Data()), blob.Size()));
+}
+
+}  // anonymous namespace
+
 // static
 Ref<PipelineCache> PipelineCache::Create(DeviceBase* device, const CacheKey& key) {
-    Ref<PipelineCache> cache = AcquireRef(new PipelineCache(device, key));
+    Ref<PipelineCache> cache = AcquireRef(new PipelineCache(device, key, /*isMerged*/ false));
+    cache->Initialize();
+    return cache;
+}
+
+// static
+Ref<PipelineCache> PipelineCache::CreateMerged(DeviceBase* device, const CacheKey& key) {
+    Ref<PipelineCache> cache = AcquireRef(new PipelineCache(device, key, /*isMerged*/ true));
     cache->Initialize();
     return cache;
 }
 
-PipelineCache::PipelineCache(DeviceBase* device, const CacheKey& key)
-    : PipelineCacheBase(device->GetBlobCache(), key), mDevice(device) {}
+PipelineCache::PipelineCache(DeviceBase* device, const CacheKey& key, bool isMerged)
+    : PipelineCacheBase(device->GetBlobCache(), key), mDevice(device), mIsMerged(isMerged) {}
 
 PipelineCache::~PipelineCache() {
     if (mHandle == VK_NULL_HANDLE) {
@@ -64,29 +87,135 @@ VkPipelineCache PipelineCache::GetHandle() const {
     return mHandle;
 }
 
+bool PipelineCache::IsMerged() const {
+    return mIsMerged;
+}
+
+MaybeError PipelineCache::DidCreatePipeline(const VkPipelineCreationFeedbackEXT* feedback) {
+    if (!mIsMerged) {
+        return FlushIfNeeded();
+    }
+
+    mPipelineCount.fetch_add(1, std::memory_order_relaxed);
+    if (feedback != nullptr && (feedback->flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT) &&
+        (feedback->flags &
+         VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT)) {
+        mPipelineHitCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // The driver may have added the pipeline to the cache.
+        mMergedDirty.store(true, std::memory_order_release);
+    }
+    return {};
+}
+
+MaybeError PipelineCache::FlushMergedIfDirty() {
+    DAWN_ASSERT(mIsMerged);
+    if (!mMergedDirty.exchange(false, std::memory_order_acquire)) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(mMergeMutex);
+    DAWN_TRY(Flush());
+    mFlushCount++;
+    return {};
+}
+
+PipelineCache::MergedStats PipelineCache::GetMergedStats() const {
+    DAWN_ASSERT(mIsMerged);
+    MergedStats stats;
+    stats.loadHit = CacheHit();
+    stats.pipelineCount = mPipelineCount.load(std::memory_order_relaxed);
+    stats.pipelineHitCount = mPipelineHitCount.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mMergeMutex);
+    stats.flushCount = mFlushCount;
+    stats.mergeCount = mMergeCount;
+    return stats;
+}
+
 MaybeError PipelineCache::SerializeToBlobImpl(Blob* blob) {
     if (mHandle == VK_NULL_HANDLE) {
         // Pipeline cache isn't created successfully
         return {};
     }
+    if (mIsMerged) {
+        return SerializeMergedToBlob(blob);
+    }
+    return GetCacheData(mHandle, blob);
+}
 
+MaybeError PipelineCache::GetCacheData(VkPipelineCache cache, Blob* blob) {
     size_t bufferSize;
     Device* device = ToBackend(GetDevice());
     DAWN_TRY(CheckVkSuccess(
-        device->fn.GetPipelineCacheData(device->GetVkDevice(), mHandle, &bufferSize, nullptr),
+        device->fn.GetPipelineCacheData(device->GetVkDevice(), cache, &bufferSize, nullptr),
         "GetPipelineCacheData"));
     if (bufferSize == 0) {
         return {};
     }
     *blob = CreateBlob(bufferSize);
     DAWN_TRY(CheckVkSuccess(
-        device->fn.GetPipelineCacheData(device->GetVkDevice(), mHandle, &bufferSize, blob->Data()),
+        device->fn.GetPipelineCacheData(device->GetVkDevice(), cache, &bufferSize, blob->Data()),
         "GetPipelineCacheData"));
     return {};
 }
 
+MaybeError PipelineCache::SerializeMergedToBlob(Blob* blob) {
+    // Other devices or processes may have stored data since this cache was loaded or last
+    // flushed. Writing only this cache's data would drop their pipelines, so the stored data is
+    // merged in first. The blob cache can't atomically replace the data it merged with, so the
+    // stored data is loaded again after merging and the merge is redone if it changed. Data
+    // stored between the last check and the store in Flush() is still overwritten.
+    Blob stored = LoadStoredBlob();
+    for (uint32_t attempt = 1;; ++attempt) {
+        size_t storedHash = HashBlob(stored);
+        if (stored.Empty() || storedHash == mSyncedDataHash) {
+            DAWN_TRY(GetCacheData(mHandle, blob));
+        } else {
+            DAWN_TRY(MergeStoredData(stored, blob));
+            mMergeCount++;
+        }
+
+        Blob latest = LoadStoredBlob();
+        if (attempt == kMaxMergeAttempts || HashBlob(latest) == storedHash) {
+            break;
+        }
+        stored = std::move(latest);
+    }
+
+    mSyncedDataHash = HashBlob(*blob);
+    return {};
+}
+
+MaybeError PipelineCache::MergeStoredData(const Blob& stored, Blob* blob) {
+    // The merge goes into a temporary cache because the destination of vkMergePipelineCaches
+    // must be externally synchronized and mHandle is used concurrently for pipeline creation.
+    Device* device = ToBackend(GetDevice());
+    VkPipelineCacheCreateInfo createInfo;
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.initialDataSize = stored.Size();
+    createInfo.pInitialData = stored.Data();
+
+    VkPipelineCache merged = VK_NULL_HANDLE;
+    DAWN_TRY(CheckVkSuccess(
+        device->fn.CreatePipelineCache(device->GetVkDevice(), &createInfo, nullptr, &*merged),
+        "CreatePipelineCache"));
+    MaybeError maybeError = CheckVkSuccess(
+        device->fn.MergePipelineCaches(device->GetVkDevice(), merged, 1, &*mHandle),
+        "MergePipelineCaches");
+    if (maybeError.IsSuccess()) {
+        maybeError = GetCacheData(merged, blob);
+    }
+    device->fn.DestroyPipelineCache(device->GetVkDevice(), merged, nullptr);
+    return maybeError;
+}
+
 void PipelineCache::Initialize() {
     Blob blob = PipelineCacheBase::Initialize();
+    if (mIsMerged) {
+        mSyncedDataHash = HashBlob(blob);
+    }
 
     VkPipelineCacheCreateInfo createInfo;
     createInfo.flags = 0;
@@ -28,6 +28,9 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_PIPELINECACHEVK_H_
 #define SRC_DAWN_NATIVE_VULKAN_PIPELINECACHEVK_H_
 
+#include <atomic>
+#include <mutex>
+
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/PipelineCache.h"
 #include "partition_alloc/pointers/raw_ptr.h"
@@ -42,20 +45,68 @@ namespace dawn::native::vulkan {
 
 class PipelineCache final : public PipelineCacheBase {
   public:
+    // Creates a cache whose data is stored under the key of a single pipeline.
     static Ref<PipelineCache> Create(DeviceBase* device, const CacheKey& key);
+    // Creates a cache that is shared by all the pipelines of a device. When it is flushed, its
+    // data is merged with the data stored under the same key by other devices or processes since
+    // it was loaded, so that the stored cache accumulates the pipelines of all of them. The blob
+    // cache has no atomic read-modify-write, so the merge is redone if the stored data changes
+    // while merging, but data stored concurrently with the final write is lost: the last writer
+    // wins, and the lost pipelines are only stored again when the device that has them flushes.
+    static Ref<PipelineCache> CreateMerged(DeviceBase* device, const CacheKey& key);
 
     DeviceBase* GetDevice() const;
     VkPipelineCache GetHandle() const;
+    bool IsMerged() const;
+
+    // Records that a pipeline was created with the cache. `feedback` is the creation feedback of
+    // the pipeline, or nullptr if it wasn't requested. Per-pipeline caches are flushed right away
+    // on a miss while merged caches are only marked dirty and flushed by FlushMergedIfDirty.
+    MaybeError DidCreatePipeline(const VkPipelineCreationFeedbackEXT* feedback);
+
+    // Merges the merged cache with the stored data and writes the result back if pipelines were
+    // created since the last flush.
+    MaybeError FlushMergedIfDirty();
+
+    struct MergedStats {
+        // Whether data was found for the cache when it was created.
+        bool loadHit = false;
+        // The number of pipelines created with the cache, and how many of them the driver
+        // reported as found in the cache. Hits are only counted when pipeline creation feedback
+        // is supported.
+        uint64_t pipelineCount = 0;
+        uint64_t pipelineHitCount = 0;
+        // The number of times the cache was written back, and how many of them merged data
+        // stored by other devices or processes.
+        uint64_t flushCount = 0;
+        uint64_t mergeCount = 0;
+    };
+    MergedStats GetMergedStats() const;
 
   private:
-    explicit PipelineCache(DeviceBase* device, const CacheKey& key);
+    PipelineCache(DeviceBase* device, const CacheKey& key, bool isMerged);
     ~PipelineCache() override;
 
     void Initialize();
     MaybeError SerializeToBlobImpl(Blob* blob) override;
+    MaybeError GetCacheData(VkPipelineCache cache, Blob* blob);
+    MaybeError SerializeMergedToBlob(Blob* blob);
+    MaybeError MergeStoredData(const Blob& stored, Blob* blob);
 
     raw_ptr<DeviceBase> mDevice;
     VkPipelineCache mHandle = VK_NULL_HANDLE;
+
+    const bool mIsMerged;
+    std::atomic<bool> mMergedDirty = false;
+    std::atomic<uint64_t> mPipelineCount = 0;
+    std::atomic<uint64_t> mPipelineHitCount = 0;
+    // Protects the flushes of the merged cache and the state below.
+    mutable std::mutex mMergeMutex;
+    // The hash of the data last loaded from or written to the blob cache, used to detect when
+    // another device or process stored data that must be merged.
+    size_t mSyncedDataHash = 0;
+    uint64_t mFlushCount = 0;
+    uint64_t mMergeCount = 0;
 };
 
 }  // namespace dawn::native::vulkan
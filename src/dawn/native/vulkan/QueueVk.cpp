@@ -457,7 +457,14 @@ MaybeError Queue::SubmitPendingCommands() {
     }
     DAWN_ASSERT(externalTextureSemaphoreIter == externalTextureSemaphores.end());
 
+    TRACE_COUNTER2(device->GetPlatform(), Recording, "VulkanPipelineBarriers", "recorded",
+                   mRecordingContext.barrierCounters.recorded, "merged",
+                   mRecordingContext.barrierCounters.merged);
+
+    // Keep the storage of the barrier batch for the next recording context.
+    PipelineBarrierBatch barriers = std::move(mRecordingContext.barriers);
     mRecordingContext = CommandRecordingContext();
+    mRecordingContext.barriers = std::move(barriers);
     DAWN_TRY(PrepareRecordingContext());
 
     return {};
@@ -199,7 +199,7 @@ ShaderModule::~ShaderModule() = default;
 
 #define SPIRV_COMPILATION_REQUEST_MEMBERS(X)                                                     \
     X(SingleShaderStage, stage)                                                                  \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(const TintProgram*, inputProgram)                                                          \
     X(std::optional<tint::ast::transform::SubstituteOverride::Config>, substituteOverrideConfig) \
     X(LimitsForCompilationRequest, limits)                                                       \
     X(std::string_view, entryPointName)                                                          \
@@ -342,7 +342,7 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
     SpirvCompilationRequest req = {};
     req.stage = stage;
     auto tintProgram = GetTintProgram();
-    req.inputProgram = &(tintProgram->program);
+    req.inputProgram = tintProgram.Get();
     req.entryPointName = programmableStage.entryPoint;
     req.disableSymbolRenaming = GetDevice()->IsToggleEnabled(Toggle::DisableSymbolRenaming);
     req.platform = UnsafeUnkeyedValue(GetDevice()->GetPlatform());
@@ -419,8 +419,8 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
             {
                 TRACE_EVENT0(r.platform.UnsafeGetValue(), General, "RunTransforms");
                 DAWN_TRY_ASSIGN(program,
-                                RunTransforms(&transformManager, r.inputProgram, transformInputs,
-                                              &transformOutputs, nullptr));
+                                RunTransforms(&transformManager, &r.inputProgram->program,
+                                              transformInputs, &transformOutputs, nullptr));
             }
 
             // Get the entry point name after the renamer pass.
@@ -113,6 +113,7 @@ enum class DeviceExt {
     ZeroInitializeWorkgroupMemory,
     Maintenance4,
     SubgroupSizeControl,
+    PipelineCreationFeedback,
 
     // Others
     DepthClipEnable,
@@ -27,77 +27,232 @@
 
 #include "dawn/platform/WorkerThread.h"
 
-#include <condition_variable>
-#include <functional>
-#include <thread>
+#include <algorithm>
+#include <deque>
+#include <utility>
 
 #include "dawn/common/Assert.h"
+#include "dawn/common/Ref.h"
+#include "dawn/common/RefCounted.h"
 
 namespace {
 
-class AsyncWaitableEventImpl {
+// The completion state shared between a task and the WaitableEvent returned to the caller. Checking
+// for completion is a single atomic load, the mutex and condition variable are only used when a
+// caller actually blocks in Wait().
+class TaskCompletion : public dawn::RefCounted {
   public:
-    AsyncWaitableEventImpl() : mIsComplete(false) {}
-
     void Wait() {
+        if (IsComplete()) {
+            return;
+        }
         std::unique_lock<std::mutex> lock(mMutex);
-        mCondition.wait(lock, [this] { return mIsComplete; });
+        mCondition.wait(lock, [this] { return mIsComplete.load(std::memory_order_relaxed); });
     }
 
-    bool IsComplete() {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mIsComplete;
-    }
+    bool IsComplete() const { return mIsComplete.load(std::memory_order_acquire); }
 
     void MarkAsComplete() {
         {
             std::lock_guard<std::mutex> lock(mMutex);
-            mIsComplete = true;
+            mIsComplete.store(true, std::memory_order_release);
         }
         mCondition.notify_all();
     }
 
   private:
+    std::atomic<bool> mIsComplete = false;
     std::mutex mMutex;
     std::condition_variable mCondition;
-    bool mIsComplete;
 };
 
 class AsyncWaitableEvent final : public dawn::platform::WaitableEvent {
   public:
-    AsyncWaitableEvent() : mWaitableEventImpl(std::make_shared<AsyncWaitableEventImpl>()) {}
+    explicit AsyncWaitableEvent(dawn::Ref<TaskCompletion> completion)
+        : mCompletion(std::move(completion)) {}
 
-    void Wait() override { mWaitableEventImpl->Wait(); }
+    void Wait() override { mCompletion->Wait(); }
 
-    bool IsComplete() override { return mWaitableEventImpl->IsComplete(); }
-
-    std::shared_ptr<AsyncWaitableEventImpl> GetWaitableEventImpl() const {
-        return mWaitableEventImpl;
-    }
+    bool IsComplete() override { return mCompletion->IsComplete(); }
 
   private:
-    std::shared_ptr<AsyncWaitableEventImpl> mWaitableEventImpl;
+    dawn::Ref<TaskCompletion> mCompletion;
+};
+
+struct Task {
+    dawn::platform::PostWorkerTaskCallback callback = nullptr;
+    void* userdata = nullptr;
+    dawn::Ref<TaskCompletion> completion;
 };
 
+// The pool and worker index of the current thread, if it is a worker thread. Tasks posted from a
+// worker thread go to that worker's own deque.
+thread_local const dawn::platform::AsyncWorkerThreadPool* tCurrentPool = nullptr;
+thread_local uint32_t tCurrentWorkerIndex = 0;
+
 }  // anonymous namespace
 
 namespace dawn::platform {
 
+struct AsyncWorkerThreadPool::Worker {
+    // The owning thread pushes and pops at the back of the deque, other threads steal from the
+    // front.
+    bool PopBack(Task* task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        *task = std::move(tasks.back());
+        tasks.pop_back();
+        return true;
+    }
+
+    bool StealFront(Task* task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        *task = std::move(tasks.front());
+        tasks.pop_front();
+        return true;
+    }
+
+    void PushBack(Task task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t maxThreadCount)
+    : mMaxThreadCount(maxThreadCount != 0
+                          ? maxThreadCount
+                          : std::max(1u, std::thread::hardware_concurrency())) {
+    mWorkers.reserve(mMaxThreadCount);
+    for (uint32_t i = 0; i < mMaxThreadCount; ++i) {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    mThreads.reserve(mMaxThreadCount);
+}
+
+AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsShuttingDown = true;
+    }
+    mCondition.notify_all();
+
+    // Workers drain all the queued tasks before exiting so that every returned WaitableEvent is
+    // eventually completed.
+    for (std::thread& thread : mThreads) {
+        thread.join();
+    }
+    DAWN_ASSERT(mQueuedTaskCount.load() == 0);
+}
+
 std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
     dawn::platform::PostWorkerTaskCallback callback,
     void* userdata) {
-    std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
+    Ref<TaskCompletion> completion = AcquireRef(new TaskCompletion());
+    auto waitableEvent = std::make_unique<AsyncWaitableEvent>(completion);
 
-    std::function<void()> doTask = [callback, userdata,
-                                    waitableEventImpl = waitableEvent->GetWaitableEventImpl()] {
-        callback(userdata);
-        waitableEventImpl->MarkAsComplete();
-    };
+    Task task;
+    task.callback = callback;
+    task.userdata = userdata;
+    task.completion = std::move(completion);
 
-    std::thread thread(doTask);
-    thread.detach();
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mIsShuttingDown && tCurrentPool != this) {
+            // The workers may have already drained the queue and exited, so a task posted from
+            // another thread while the pool is destroyed runs on the calling thread.
+            lock.unlock();
+            task.callback(task.userdata);
+            task.completion->MarkAsComplete();
+            return waitableEvent;
+        }
+
+        // Count the task before it becomes visible in a deque so that a worker taking it never
+        // observes a count of zero. A task posted by a worker while the pool is shutting down is
+        // still queued: the workers keep running until the count reaches zero.
+        mQueuedTaskCount.fetch_add(1, std::memory_order_acq_rel);
+        StartThreadIfNeededLocked();
+
+        uint32_t workerIndex;
+        if (tCurrentPool == this) {
+            workerIndex = tCurrentWorkerIndex;
+        } else {
+            workerIndex = mNextWorkerIndex;
+            mNextWorkerIndex = (mNextWorkerIndex + 1) % mThreads.size();
+        }
+        mWorkers[workerIndex]->PushBack(std::move(task));
+    }
+    mCondition.notify_one();
 
     return waitableEvent;
 }
 
+uint32_t AsyncWorkerThreadPool::GetMaxThreadCount() const {
+    return mMaxThreadCount;
+}
+
+uint32_t AsyncWorkerThreadPool::GetStartedThreadCount() const {
+    return mStartedThreadCount.load(std::memory_order_acquire);
+}
+
+void AsyncWorkerThreadPool::StartThreadIfNeededLocked() {
+    // Only start a new thread when there are more queued tasks than sleeping workers to run them.
+    // No thread is started during shutdown, as the destructor is already joining mThreads.
+    if (mIsShuttingDown || mThreads.size() >= mMaxThreadCount ||
+        mQueuedTaskCount.load() <= mIdleThreadCount) {
+        return;
+    }
+
+    uint32_t workerIndex = static_cast<uint32_t>(mThreads.size());
+    mThreads.emplace_back([this, workerIndex] { ThreadLoop(workerIndex); });
+    mStartedThreadCount.store(static_cast<uint32_t>(mThreads.size()), std::memory_order_release);
+}
+
+void AsyncWorkerThreadPool::ThreadLoop(uint32_t workerIndex) {
+    tCurrentPool = this;
+    tCurrentWorkerIndex = workerIndex;
+
+    while (true) {
+        Task task;
+        bool hasTask = mWorkers[workerIndex]->PopBack(&task);
+
+        // Steal from the other started workers, beginning with the next one so that thieves
+        // spread over the victims.
+        uint32_t startedThreadCount = GetStartedThreadCount();
+        for (uint32_t i = 1; !hasTask && i < startedThreadCount; ++i) {
+            hasTask = mWorkers[(workerIndex + i) % startedThreadCount]->StealFront(&task);
+        }
+
+        if (hasTask) {
+            mQueuedTaskCount.fetch_sub(1, std::memory_order_acq_rel);
+            task.callback(task.userdata);
+            task.completion->MarkAsComplete();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mQueuedTaskCount.load() > 0) {
+            // Another worker took the last visible task but hasn't decremented the count yet, try
+            // again.
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        if (mIsShuttingDown) {
+            return;
+        }
+
+        mIdleThreadCount++;
+        mCondition.wait(lock, [this] { return mQueuedTaskCount.load() > 0 || mIsShuttingDown; });
+        mIdleThreadCount--;
+    }
+}
+
 }  // namespace dawn::platform
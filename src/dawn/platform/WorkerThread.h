@@ -28,18 +28,58 @@
 #ifndef SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 #define SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::platform {
 
+// AsyncWorkerThreadPool runs tasks on a bounded set of persistent worker threads. Each worker owns
+// a deque of tasks: a worker pops the most recently pushed task from its own deque and, when that
+// is empty, steals the oldest task from another worker. Threads are started lazily as tasks are
+// posted, up to the maximum thread count, and stay alive until the pool is destroyed.
 class AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool, public NonCopyable {
   public:
+    // A |maxThreadCount| of 0 uses the number of hardware threads.
+    explicit AsyncWorkerThreadPool(uint32_t maxThreadCount = 0);
+    ~AsyncWorkerThreadPool() override;
+
     std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
         dawn::platform::PostWorkerTaskCallback callback,
         void* userdata) override;
+
+    uint32_t GetMaxThreadCount() const;
+    uint32_t GetStartedThreadCount() const;
+
+  private:
+    struct Worker;
+
+    void ThreadLoop(uint32_t workerIndex);
+    void StartThreadIfNeededLocked();
+
+    const uint32_t mMaxThreadCount;
+    // One worker per potential thread, allocated up front so that workers can be accessed without
+    // holding mMutex.
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+
+    // mMutex guards the thread list and the sleeping state of the workers. mQueuedTaskCount is
+    // only incremented while holding mMutex so that sleeping workers never miss a wake-up, but it
+    // is decremented without the lock when a worker takes a task.
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::vector<std::thread> mThreads;
+    std::atomic<uint32_t> mStartedThreadCount = 0;
+    std::atomic<uint64_t> mQueuedTaskCount = 0;
+    uint32_t mIdleThreadCount = 0;
+    uint32_t mNextWorkerIndex = 0;
+    bool mIsShuttingDown = false;
 };
 
 }  // namespace dawn::platform
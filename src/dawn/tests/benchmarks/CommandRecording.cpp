@@ -0,0 +1,348 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <array>
+#include <vector>
+
+#include "dawn/native/Device.h"
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kRenderTargetSize = 4;
+
+// Benchmarks for the CPU cost of recording and submitting commands in Dawn. The Null backend
+// doesn't translate the commands, so this measures the frontend encoding, validation and
+// resource tracking. Each benchmark reports the number of commands of interest as its items.
+class CommandRecording : public NullDeviceBenchmarkFixture {
+  protected:
+    CommandRecording() {
+        // Each thread records its own command encoders, but the device and queue are shared.
+        requiredFeatures.push_back(wgpu::FeatureName::ImplicitDeviceSynchronization);
+    }
+
+    // The objects needed to record render passes. They are created by each thread.
+    struct RenderObjects {
+        wgpu::TextureView renderTarget;
+        wgpu::RenderPipeline pipeline;
+        std::array<wgpu::Buffer, 2> vertexBuffers;
+        std::array<wgpu::BindGroup, 2> bindGroups;
+        wgpu::Buffer indexBuffer;
+    };
+
+    RenderObjects CreateRenderObjects() {
+        RenderObjects objects;
+
+        wgpu::TextureDescriptor textureDesc = {};
+        textureDesc.size = {kRenderTargetSize, kRenderTargetSize};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        objects.renderTarget = device.CreateTexture(&textureDesc).CreateView();
+
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform}});
+
+        utils::ComboRenderPipelineDescriptor renderDesc;
+        renderDesc.layout = utils::MakePipelineLayout(device, {bgl});
+        renderDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> offset : vec4f;
+            @vertex fn main(@location(0) pos : vec4f) -> @builtin(position) vec4f {
+                return pos + offset;
+            })");
+        renderDesc.vertex.bufferCount = 1;
+        renderDesc.cBuffers[0].arrayStride = 4 * sizeof(float);
+        renderDesc.cBuffers[0].attributeCount = 1;
+        renderDesc.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+        renderDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4f {
+                return vec4f(0.0, 1.0, 0.0, 1.0);
+            })");
+        renderDesc.cTargets[0].format = textureDesc.format;
+        objects.pipeline = device.CreateRenderPipeline(&renderDesc);
+
+        wgpu::BufferDescriptor bufferDesc = {};
+        bufferDesc.size = 3 * 4 * sizeof(float);
+        bufferDesc.usage = wgpu::BufferUsage::Vertex;
+        for (wgpu::Buffer& buffer : objects.vertexBuffers) {
+            buffer = device.CreateBuffer(&bufferDesc);
+        }
+
+        bufferDesc.size = 4 * sizeof(float);
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        for (wgpu::BindGroup& bindGroup : objects.bindGroups) {
+            bindGroup = utils::MakeBindGroup(device, bgl, {{0, device.CreateBuffer(&bufferDesc)}});
+        }
+
+        bufferDesc.size = 3 * sizeof(uint32_t);
+        bufferDesc.usage = wgpu::BufferUsage::Index;
+        objects.indexBuffer = device.CreateBuffer(&bufferDesc);
+
+        return objects;
+    }
+
+    // Encodes a render pass with the pipeline and first bind group and vertex buffer set, lets
+    // `recordDraws` add the draws, and finishes the encoder.
+    template <typename F>
+    wgpu::CommandBuffer EncodeRenderPass(const RenderObjects& objects, F&& recordDraws) {
+        wgpu::RenderPassColorAttachment attachment = {};
+        attachment.view = objects.renderTarget;
+        attachment.loadOp = wgpu::LoadOp::Clear;
+        attachment.storeOp = wgpu::StoreOp::Store;
+
+        wgpu::RenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&passDesc);
+        pass.SetPipeline(objects.pipeline);
+        pass.SetBindGroup(0, objects.bindGroups[0]);
+        pass.SetVertexBuffer(0, objects.vertexBuffers[0]);
+        recordDraws(pass);
+        pass.End();
+        return encoder.Finish();
+    }
+
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override {
+        wgpu::DeviceDescriptor deviceDesc = {};
+        deviceDesc.requiredFeatures = requiredFeatures.data();
+        deviceDesc.requiredFeatureCount = requiredFeatures.size();
+        return deviceDesc;
+    }
+
+    std::vector<wgpu::FeatureName> requiredFeatures;
+};
+
+BENCHMARK_DEFINE_F(CommandRecording, Draw)
+(benchmark::State& state) {
+    const RenderObjects objects = CreateRenderObjects();
+    const int64_t drawCount = state.range(0);
+
+    for (auto _ : state) {
+        wgpu::CommandBuffer commands = EncodeRenderPass(objects, [&](wgpu::RenderPassEncoder pass) {
+            for (int64_t i = 0; i < drawCount; ++i) {
+                pass.Draw(3);
+            }
+        });
+        benchmark::DoNotOptimize(commands);
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandRecording, Draw)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+BENCHMARK_DEFINE_F(CommandRecording, DrawIndexed)
+(benchmark::State& state) {
+    const RenderObjects objects = CreateRenderObjects();
+    const int64_t drawCount = state.range(0);
+
+    for (auto _ : state) {
+        wgpu::CommandBuffer commands = EncodeRenderPass(objects, [&](wgpu::RenderPassEncoder pass) {
+            pass.SetIndexBuffer(objects.indexBuffer, wgpu::IndexFormat::Uint32);
+            for (int64_t i = 0; i < drawCount; ++i) {
+                pass.DrawIndexed(3);
+            }
+        });
+        benchmark::DoNotOptimize(commands);
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandRecording, DrawIndexed)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+// Changes the bind group before each draw, which invalidates the cached validation of the
+// bindings in the CommandBufferStateTracker.
+BENCHMARK_DEFINE_F(CommandRecording, SetBindGroup)
+(benchmark::State& state) {
+    const RenderObjects objects = CreateRenderObjects();
+    const int64_t drawCount = state.range(0);
+
+    for (auto _ : state) {
+        wgpu::CommandBuffer commands = EncodeRenderPass(objects, [&](wgpu::RenderPassEncoder pass) {
+            for (int64_t i = 0; i < drawCount; ++i) {
+                pass.SetBindGroup(0, objects.bindGroups[i % objects.bindGroups.size()]);
+                pass.Draw(3);
+            }
+        });
+        benchmark::DoNotOptimize(commands);
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandRecording, SetBindGroup)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+// Changes the vertex buffer before each draw, which invalidates the cached validation of the
+// vertex buffers in the CommandBufferStateTracker.
+BENCHMARK_DEFINE_F(CommandRecording, SetVertexBuffer)
+(benchmark::State& state) {
+    const RenderObjects objects = CreateRenderObjects();
+    const int64_t drawCount = state.range(0);
+
+    for (auto _ : state) {
+        wgpu::CommandBuffer commands = EncodeRenderPass(objects, [&](wgpu::RenderPassEncoder pass) {
+            for (int64_t i = 0; i < drawCount; ++i) {
+                pass.SetVertexBuffer(0, objects.vertexBuffers[i % objects.vertexBuffers.size()]);
+                pass.Draw(3);
+            }
+        });
+        benchmark::DoNotOptimize(commands);
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandRecording, SetVertexBuffer)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+BENCHMARK_DEFINE_F(CommandRecording, Dispatch)
+(benchmark::State& state) {
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage}});
+
+    wgpu::ComputePipelineDescriptor computeDesc = {};
+    computeDesc.layout = utils::MakePipelineLayout(device, {bgl});
+    computeDesc.compute.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : u32;
+        @compute @workgroup_size(1) fn main() { data = 0u; }
+    )");
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&computeDesc);
+
+    wgpu::BufferDescriptor bufferDesc = {};
+    bufferDesc.size = sizeof(uint32_t);
+    bufferDesc.usage = wgpu::BufferUsage::Storage;
+    std::array<wgpu::BindGroup, 2> bindGroups;
+    for (wgpu::BindGroup& bindGroup : bindGroups) {
+        bindGroup = utils::MakeBindGroup(device, bgl, {{0, device.CreateBuffer(&bufferDesc)}});
+    }
+
+    const int64_t dispatchCount = state.range(0);
+    for (auto _ : state) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(pipeline);
+        for (int64_t i = 0; i < dispatchCount; ++i) {
+            pass.SetBindGroup(0, bindGroups[i % bindGroups.size()]);
+            pass.DispatchWorkgroups(1);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        benchmark::DoNotOptimize(commands);
+    }
+    state.SetItemsProcessed(state.iterations() * dispatchCount);
+}
+BENCHMARK_REGISTER_F(CommandRecording, Dispatch)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+// Records and submits small command buffers, so that the fixed cost of creating and finishing an
+// encoder and of the submit dominates.
+BENCHMARK_DEFINE_F(CommandRecording, Submit)
+(benchmark::State& state) {
+    const RenderObjects objects = CreateRenderObjects();
+    const int64_t drawCount = state.range(0);
+    wgpu::Queue queue = device.GetQueue();
+
+    for (auto _ : state) {
+        wgpu::CommandBuffer commands = EncodeRenderPass(objects, [&](wgpu::RenderPassEncoder pass) {
+            for (int64_t i = 0; i < drawCount; ++i) {
+                pass.Draw(3);
+            }
+        });
+        queue.Submit(1, &commands);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(CommandRecording, Submit)
+    ->Arg(1)
+    ->Arg(100)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+// Creates, finishes and submits many small command buffers at once, like a frame made of many
+// encoders. Their command blocks are recycled through the device's CommandBlockPool, the hit rate
+// of the pool is reported as a counter.
+BENCHMARK_DEFINE_F(CommandRecording, EncoderCycle)
+(benchmark::State& state) {
+    const RenderObjects objects = CreateRenderObjects();
+    const int64_t encoderCount = state.range(0);
+    wgpu::Queue queue = device.GetQueue();
+    native::CommandBlockPool* pool = native::FromAPI(device.Get())->GetCommandBlockPool().Get();
+    const native::CommandBlockPool::Stats initialStats = pool->GetStats();
+
+    std::vector<wgpu::CommandBuffer> commands(encoderCount);
+    for (auto _ : state) {
+        for (wgpu::CommandBuffer& commandBuffer : commands) {
+            commandBuffer = EncodeRenderPass(objects, [](wgpu::RenderPassEncoder pass) {
+                pass.Draw(3);
+            });
+        }
+        queue.Submit(commands.size(), commands.data());
+        for (wgpu::CommandBuffer& commandBuffer : commands) {
+            commandBuffer = nullptr;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * encoderCount);
+
+    const native::CommandBlockPool::Stats stats = pool->GetStats();
+    const uint64_t hits = stats.hits - initialStats.hits;
+    const uint64_t misses = stats.misses - initialStats.misses;
+    state.counters["PoolHitRate"] =
+        hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+}
+BENCHMARK_REGISTER_F(CommandRecording, EncoderCycle)
+    ->Arg(1)
+    ->Arg(200)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+}  // namespace
+}  // namespace dawn
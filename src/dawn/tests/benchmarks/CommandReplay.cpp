@@ -0,0 +1,259 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kRenderTargetSize = 4;
+
+// Benchmarks for the CPU cost of replaying command buffers in the Vulkan backend, which happens
+// when they are submitted. They run on SwiftShader so that they give comparable results on every
+// machine, and are skipped when it isn't available. Only the submits are timed: the encoding and
+// validation of the commands, and waiting for the GPU, happen with the timer paused.
+class CommandReplay : public benchmark::Fixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        static std::unique_ptr<native::Instance> nativeInstance = []() {
+            dawnProcSetProcs(&native::GetProcs());
+            return std::make_unique<native::Instance>();
+        }();
+
+        wgpu::RequestAdapterOptions options = {};
+        options.backendType = wgpu::BackendType::Vulkan;
+        options.forceFallbackAdapter = true;
+        std::vector<native::Adapter> adapters = nativeInstance->EnumerateAdapters(&options);
+        if (adapters.empty()) {
+            return;
+        }
+        device = wgpu::Device::Acquire(adapters[0].CreateDevice());
+        queue = device.GetQueue();
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        queue = nullptr;
+        device = nullptr;
+    }
+
+  protected:
+    bool SkipIfUnavailable(benchmark::State& state) {
+        if (device == nullptr) {
+            state.SkipWithError("SwiftShader is not available");
+            return true;
+        }
+        return false;
+    }
+
+    // Submits `commands` with the timer running, then waits for them to finish so that the GPU
+    // work doesn't pile up between iterations.
+    void TimedSubmit(benchmark::State& state, wgpu::CommandBuffer commands) {
+        state.ResumeTiming();
+        queue.Submit(1, &commands);
+        state.PauseTiming();
+
+        bool done = false;
+        queue.OnSubmittedWorkDone(wgpu::CallbackMode::AllowSpontaneous,
+                                  [&done](wgpu::QueueWorkDoneStatus) { done = true; });
+        while (!done) {
+            device.Tick();
+        }
+    }
+
+    // Encodes a render pass with the pipeline set, and lets `recordDraws` add the draws.
+    template <typename F>
+    wgpu::CommandBuffer EncodeRenderPass(F&& recordDraws) {
+        wgpu::RenderPassColorAttachment attachment = {};
+        attachment.view = renderTarget;
+        attachment.loadOp = wgpu::LoadOp::Clear;
+        attachment.storeOp = wgpu::StoreOp::Store;
+
+        wgpu::RenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&passDesc);
+        recordDraws(pass);
+        pass.End();
+        return encoder.Finish();
+    }
+
+    void CreateRenderObjects() {
+        wgpu::TextureDescriptor textureDesc = {};
+        textureDesc.size = {kRenderTargetSize, kRenderTargetSize};
+        textureDesc.format = kRenderTargetFormat;
+        textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        renderTarget = device.CreateTexture(&textureDesc).CreateView();
+
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform}});
+
+        utils::ComboRenderPipelineDescriptor renderDesc;
+        renderDesc.layout = utils::MakePipelineLayout(device, {bgl});
+        renderDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> offset : vec4f;
+            @vertex fn main(@builtin(vertex_index) i : u32) -> @builtin(position) vec4f {
+                return vec4f(f32(i), 0.0, 0.0, 1.0) + offset;
+            })");
+        renderDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4f {
+                return vec4f(0.0, 1.0, 0.0, 1.0);
+            })");
+        renderDesc.cTargets[0].format = kRenderTargetFormat;
+        renderPipeline = device.CreateRenderPipeline(&renderDesc);
+
+        wgpu::BufferDescriptor bufferDesc = {};
+        bufferDesc.size = 4 * sizeof(float);
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        for (wgpu::BindGroup& bindGroup : bindGroups) {
+            bindGroup = utils::MakeBindGroup(device, bgl, {{0, device.CreateBuffer(&bufferDesc)}});
+        }
+    }
+
+    // Sets one of the two bind groups before each draw, so that none of them are redundant.
+    template <typename Encoder>
+    void RecordDraws(Encoder encoder, int64_t drawCount) {
+        encoder.SetPipeline(renderPipeline);
+        for (int64_t i = 0; i < drawCount; ++i) {
+            encoder.SetBindGroup(0, bindGroups[i % bindGroups.size()]);
+            encoder.Draw(3);
+        }
+    }
+
+    static constexpr wgpu::TextureFormat kRenderTargetFormat = wgpu::TextureFormat::RGBA8Unorm;
+
+    wgpu::Device device;
+    wgpu::Queue queue;
+
+    wgpu::TextureView renderTarget;
+    wgpu::RenderPipeline renderPipeline;
+    std::array<wgpu::BindGroup, 2> bindGroups;
+};
+
+// Replays the draws recorded directly in a render pass.
+BENCHMARK_DEFINE_F(CommandReplay, RenderPass)
+(benchmark::State& state) {
+    if (SkipIfUnavailable(state)) {
+        return;
+    }
+    CreateRenderObjects();
+    const int64_t drawCount = state.range(0);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgpu::CommandBuffer commands = EncodeRenderPass(
+            [&](wgpu::RenderPassEncoder pass) { RecordDraws(pass, drawCount); });
+        TimedSubmit(state, commands);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandReplay, RenderPass)->Arg(100)->Arg(10000);
+
+// Replays the same draws from a render bundle, which is encoded only once.
+BENCHMARK_DEFINE_F(CommandReplay, RenderBundle)
+(benchmark::State& state) {
+    if (SkipIfUnavailable(state)) {
+        return;
+    }
+    CreateRenderObjects();
+    const int64_t drawCount = state.range(0);
+
+    wgpu::RenderBundleEncoderDescriptor bundleDesc = {};
+    bundleDesc.colorFormatCount = 1;
+    bundleDesc.colorFormats = &kRenderTargetFormat;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    RecordDraws(bundleEncoder, drawCount);
+    wgpu::RenderBundle bundle = bundleEncoder.Finish();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgpu::CommandBuffer commands =
+            EncodeRenderPass([&](wgpu::RenderPassEncoder pass) { pass.ExecuteBundles(1, &bundle); });
+        TimedSubmit(state, commands);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandReplay, RenderBundle)->Arg(100)->Arg(10000);
+
+// Replays the dispatches of a compute pass.
+BENCHMARK_DEFINE_F(CommandReplay, ComputePass)
+(benchmark::State& state) {
+    if (SkipIfUnavailable(state)) {
+        return;
+    }
+    const int64_t dispatchCount = state.range(0);
+
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage}});
+
+    wgpu::ComputePipelineDescriptor computeDesc = {};
+    computeDesc.layout = utils::MakePipelineLayout(device, {bgl});
+    computeDesc.compute.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : u32;
+        @compute @workgroup_size(1) fn main() { data = 0u; }
+    )");
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&computeDesc);
+
+    wgpu::BufferDescriptor bufferDesc = {};
+    bufferDesc.size = sizeof(uint32_t);
+    bufferDesc.usage = wgpu::BufferUsage::Storage;
+    std::array<wgpu::BindGroup, 2> computeBindGroups;
+    for (wgpu::BindGroup& bindGroup : computeBindGroups) {
+        bindGroup = utils::MakeBindGroup(device, bgl, {{0, device.CreateBuffer(&bufferDesc)}});
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(pipeline);
+        for (int64_t i = 0; i < dispatchCount; ++i) {
+            pass.SetBindGroup(0, computeBindGroups[i % computeBindGroups.size()]);
+            pass.DispatchWorkgroups(1);
+        }
+        pass.End();
+        TimedSubmit(state, encoder.Finish());
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * dispatchCount);
+}
+BENCHMARK_REGISTER_F(CommandReplay, ComputePass)->Arg(100)->Arg(10000);
+
+}  // namespace
+}  // namespace dawn
@@ -0,0 +1,108 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "dawn/native/CommandAllocator.h"
+#include "dawn/native/CommandVisitor.h"
+#include "dawn/native/Commands.h"
+
+namespace dawn {
+namespace {
+
+using native::Command;
+
+// Records the commands of a render pass that sets a bind group with dynamic offsets before each
+// draw, so that both fixed size commands and commands with additional data are decoded.
+native::CommandIterator RecordDraws(int64_t drawCount) {
+    native::CommandAllocator allocator;
+    for (int64_t i = 0; i < drawCount; ++i) {
+        native::SetBindGroupCmd* setBindGroup =
+            allocator.Allocate<native::SetBindGroupCmd>(Command::SetBindGroup);
+        setBindGroup->dynamicOffsetCount = 2;
+        uint32_t* dynamicOffsets = allocator.AllocateData<uint32_t>(2);
+        dynamicOffsets[0] = 0;
+        dynamicOffsets[1] = 256;
+
+        native::DrawCmd* draw = allocator.Allocate<native::DrawCmd>(Command::Draw);
+        draw->vertexCount = 3;
+        draw->instanceCount = 1;
+    }
+    return native::CommandIterator(std::move(allocator));
+}
+
+// Measures decoding the commands with VisitCommand, the way command buffers are walked when they
+// are replayed by the backends and destroyed.
+void BM_VisitCommands(benchmark::State& state) {
+    const int64_t drawCount = state.range(0);
+    native::CommandIterator commands = RecordDraws(drawCount);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        commands.Reset();
+        Command type;
+        while (commands.NextCommandId(&type)) {
+            native::VisitCommand(&commands, type, [&](auto* cmd, auto...) {
+                using T = std::remove_pointer_t<decltype(cmd)>;
+                if constexpr (std::is_same_v<T, native::DrawCmd>) {
+                    sum += cmd->vertexCount;
+                } else if constexpr (std::is_same_v<T, native::SetBindGroupCmd>) {
+                    sum += cmd->dynamicOffsetCount;
+                }
+            });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount * 2);
+
+    native::FreeCommands(&commands);
+}
+BENCHMARK(BM_VisitCommands)->Arg(100)->Arg(10000);
+
+// Measures skipping the commands with SkipCommand, which is also built on VisitCommand.
+void BM_SkipCommands(benchmark::State& state) {
+    const int64_t drawCount = state.range(0);
+    native::CommandIterator commands = RecordDraws(drawCount);
+
+    for (auto _ : state) {
+        commands.Reset();
+        Command type;
+        while (commands.NextCommandId(&type)) {
+            native::SkipCommand(&commands, type);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount * 2);
+
+    native::FreeCommands(&commands);
+}
+BENCHMARK(BM_SkipCommands)->Arg(100)->Arg(10000);
+
+}  // namespace
+}  // namespace dawn
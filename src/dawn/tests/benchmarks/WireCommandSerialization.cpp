@@ -0,0 +1,199 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <dawn/wire/WireClient.h>
+#include <dawn/wire/WireServer.h>
+
+#include <memory>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+
+namespace dawn {
+namespace {
+
+// A command handler dropping the commands once the wire is set up, so that the benchmarks only
+// measure the client-side serialization.
+class DiscardingCommandHandler : public wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        return commands + size;
+    }
+};
+
+// Sets up a wire client and server on top of a Null device, and records a render pass on the
+// client.
+class WireSerializationBenchmark {
+  public:
+    explicit WireSerializationBenchmark(bool batchCommands) {
+        mNativeInstance = std::make_unique<native::Instance>();
+
+        mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+        mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+        wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &native::GetProcs();
+        serverDesc.serializer = mS2cBuf.get();
+        mWireServer = std::make_unique<wire::WireServer>(serverDesc);
+        mC2sBuf->SetHandler(mWireServer.get());
+
+        wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = mC2sBuf.get();
+        clientDesc.batchCommands = batchCommands;
+        mWireClient = std::make_unique<wire::WireClient>(clientDesc);
+        mS2cBuf->SetHandler(mWireClient.get());
+
+        dawnProcSetProcs(&wire::client::GetProcs());
+
+        wire::ReservedInstance reserved = mWireClient->ReserveInstance();
+        mWireServer->InjectInstance(mNativeInstance->Get(), reserved.handle);
+        mInstance = wgpu::Instance::Acquire(reserved.instance);
+
+        wgpu::RequestAdapterOptions options = {};
+        options.backendType = wgpu::BackendType::Null;
+        wgpu::Adapter adapter;
+        mInstance.RequestAdapter(
+            &options, wgpu::CallbackMode::AllowSpontaneous,
+            [&adapter](wgpu::RequestAdapterStatus status, wgpu::Adapter result, const char*) {
+                DAWN_ASSERT(status == wgpu::RequestAdapterStatus::Success);
+                adapter = std::move(result);
+            });
+        FlushUntil([&adapter] { return adapter != nullptr; });
+
+        wgpu::DeviceDescriptor deviceDesc = {};
+        adapter.RequestDevice(
+            &deviceDesc, wgpu::CallbackMode::AllowSpontaneous,
+            [this](wgpu::RequestDeviceStatus status, wgpu::Device result, const char*) {
+                DAWN_ASSERT(status == wgpu::RequestDeviceStatus::Success);
+                device = std::move(result);
+            });
+        FlushUntil([this] { return device != nullptr; });
+
+        // From now on, drop the client commands instead of executing them on the server.
+        mC2sBuf->SetHandler(&mDiscardingHandler);
+
+        wgpu::TextureDescriptor textureDesc = {};
+        textureDesc.size = {64, 64, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        wgpu::TextureView view = device.CreateTexture(&textureDesc).CreateView();
+
+        wgpu::RenderPassColorAttachment attachment = {};
+        attachment.view = view;
+        attachment.loadOp = wgpu::LoadOp::Clear;
+        attachment.storeOp = wgpu::StoreOp::Store;
+        wgpu::RenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+
+        encoder = device.CreateCommandEncoder();
+        pass = encoder.BeginRenderPass(&passDesc);
+
+        wgpu::BindGroupLayoutDescriptor bglDesc = {};
+        wgpu::BindGroupDescriptor bgDesc = {};
+        bgDesc.layout = device.CreateBindGroupLayout(&bglDesc);
+        bindGroup = device.CreateBindGroup(&bgDesc);
+
+        wgpu::BufferDescriptor bufferDesc = {};
+        bufferDesc.size = 1024;
+        bufferDesc.usage = wgpu::BufferUsage::Vertex;
+        vertexBuffer = device.CreateBuffer(&bufferDesc);
+    }
+
+    ~WireSerializationBenchmark() {
+        pass = nullptr;
+        encoder = nullptr;
+        bindGroup = nullptr;
+        vertexBuffer = nullptr;
+        device = nullptr;
+        mInstance = nullptr;
+        mWireClient->Flush();
+
+        mC2sBuf->SetHandler(nullptr);
+        mS2cBuf->SetHandler(nullptr);
+        mWireClient = nullptr;
+        mWireServer = nullptr;
+        dawnProcSetProcs(&native::GetProcs());
+    }
+
+    bool Flush() { return mWireClient->Flush(); }
+
+    wgpu::Device device;
+    wgpu::CommandEncoder encoder;
+    wgpu::RenderPassEncoder pass;
+    wgpu::BindGroup bindGroup;
+    wgpu::Buffer vertexBuffer;
+
+  private:
+    template <typename F>
+    void FlushUntil(F done) {
+        for (uint32_t i = 0; i < 1000 && !done(); ++i) {
+            mWireClient->Flush();
+            native::GetProcs().instanceProcessEvents(mNativeInstance->Get());
+            mS2cBuf->Flush();
+        }
+        DAWN_ASSERT(done());
+    }
+
+    std::unique_ptr<native::Instance> mNativeInstance;
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<wire::WireServer> mWireServer;
+    std::unique_ptr<wire::WireClient> mWireClient;
+    DiscardingCommandHandler mDiscardingHandler;
+    wgpu::Instance mInstance;
+};
+
+// Records state.range(0) draws with their bind group and vertex buffer per frame, and flushes
+// the wire at the end of each frame. state.range(1) enables batching of the commands.
+void BM_WireDrawHeavyStream(benchmark::State& state) {
+    const int64_t drawsPerFrame = state.range(0);
+    WireSerializationBenchmark wire(state.range(1) != 0);
+
+    for (auto _ : state) {
+        for (int64_t i = 0; i < drawsPerFrame; ++i) {
+            wire.pass.SetBindGroup(0, wire.bindGroup);
+            wire.pass.SetVertexBuffer(0, wire.vertexBuffer);
+            wire.pass.Draw(3);
+        }
+        wire.Flush();
+    }
+    state.SetItemsProcessed(state.iterations() * drawsPerFrame * 3);
+    state.counters["commands/s"] =
+        benchmark::Counter(state.iterations() * drawsPerFrame * 3, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_WireDrawHeavyStream)
+    ->ArgNames({"draws", "batched"})
+    ->ArgsProduct({{100, 1000, 10000}, {0, 1}});
+
+}  // namespace
+}  // namespace dawn
@@ -0,0 +1,225 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <dawn/wire/WireClient.h>
+#include <dawn/wire/WireServer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(LINUX_DESKTOP)
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace dawn {
+namespace {
+
+// Benchmarks the transfer of mapped buffer data between the wire client and server.
+// The inline baselines perform the same copies as the default inline MemoryTransferService, where
+// the whole mapped range goes through the command stream.
+
+constexpr size_t kMiB = 1024 * 1024;
+
+// Emulates the application writing state.range(1) percent of the mapped range, in 64 KiB chunks
+// spread over the range, and reports the written ranges to |writeHandle| if any.
+void WriteMappedRange(benchmark::State& state,
+                      uint8_t* data,
+                      size_t size,
+                      uint8_t value,
+                      wire::client::MemoryTransferService::WriteHandle* writeHandle = nullptr) {
+    constexpr size_t kChunkSize = 64 * 1024;
+    const size_t writtenPercent = static_cast<size_t>(state.range(1));
+    for (size_t offset = 0; offset < size; offset += kChunkSize * 100 / writtenPercent) {
+        size_t chunkSize = std::min(kChunkSize, size - offset);
+        memset(data + offset, value, chunkSize);
+        if (writeHandle != nullptr) {
+            writeHandle->OnGetMappedRange(offset, chunkSize);
+        }
+    }
+}
+
+void BM_InlineWriteTransfer(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) * kMiB;
+    std::vector<uint8_t> staging(size);
+    std::vector<uint8_t> commandStream(size);
+    std::vector<uint8_t> target(size);
+
+    uint8_t value = 0;
+    for (auto _ : state) {
+        WriteMappedRange(state, staging.data(), size, value++);
+        // Unmap: the client serializes the whole mapped range and the server copies it out.
+        memcpy(commandStream.data(), staging.data(), size);
+        memcpy(target.data(), commandStream.data(), size);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+void BM_InlineReadTransfer(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) * kMiB;
+    std::vector<uint8_t> mapped(size, 1);
+    std::vector<uint8_t> commandStream(size);
+    std::vector<uint8_t> staging(size);
+
+    for (auto _ : state) {
+        // Map completion: the server serializes the mapped range and the client copies it out.
+        memcpy(commandStream.data(), mapped.data(), size);
+        memcpy(staging.data(), commandStream.data(), size);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+#if DAWN_PLATFORM_IS(LINUX_DESKTOP)
+// The client and server shared memory services, with the file descriptors of the regions sent
+// over a socket pair like they would be between two processes.
+struct SharedMemoryServices {
+    SharedMemoryServices() {
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets) != 0) {
+            return;
+        }
+        handleSender = wire::client::CreateSocketSharedMemoryHandleSender(sockets[0]);
+        handleReceiver = wire::server::CreateSocketSharedMemoryHandleReceiver(sockets[1]);
+        if (handleSender == nullptr || handleReceiver == nullptr) {
+            return;
+        }
+        client = wire::client::CreateSharedMemoryTransferService(handleSender.get());
+        server = wire::server::CreateSharedMemoryTransferService(handleReceiver.get());
+    }
+
+    ~SharedMemoryServices() {
+        server = nullptr;
+        client = nullptr;
+        handleReceiver = nullptr;
+        handleSender = nullptr;
+        if (sockets[0] >= 0) {
+            close(sockets[0]);
+            close(sockets[1]);
+        }
+    }
+
+    int sockets[2] = {-1, -1};
+    std::unique_ptr<wire::client::SharedMemoryHandleSender> handleSender;
+    std::unique_ptr<wire::server::SharedMemoryHandleReceiver> handleReceiver;
+    std::unique_ptr<wire::client::MemoryTransferService> client;
+    std::unique_ptr<wire::server::MemoryTransferService> server;
+};
+
+void BM_SharedMemoryWriteTransfer(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) * kMiB;
+    SharedMemoryServices services;
+    if (services.client == nullptr || services.server == nullptr) {
+        state.SkipWithError("Shared memory is not supported");
+        return;
+    }
+
+    std::unique_ptr<wire::client::MemoryTransferService::WriteHandle> clientHandle(
+        services.client->CreateWriteHandle(size));
+    std::vector<char> createInfo(clientHandle->SerializeCreateSize());
+    clientHandle->SerializeCreate(createInfo.data());
+
+    wire::server::MemoryTransferService::WriteHandle* handle = nullptr;
+    if (!services.server->DeserializeWriteHandle(createInfo.data(), createInfo.size(), &handle)) {
+        state.SkipWithError("Failed to open the shared memory");
+        return;
+    }
+    std::unique_ptr<wire::server::MemoryTransferService::WriteHandle> serverHandle(handle);
+
+    std::vector<uint8_t> target(size);
+    serverHandle->SetTarget(target.data());
+    serverHandle->SetDataLength(size);
+
+    std::vector<char> commandStream;
+    uint8_t value = 0;
+    for (auto _ : state) {
+        WriteMappedRange(state, static_cast<uint8_t*>(clientHandle->GetData()), size, value++,
+                         clientHandle.get());
+        // Unmap: only the written ranges are described in the command stream.
+        commandStream.resize(clientHandle->SizeOfSerializeDataUpdate(0, size));
+        clientHandle->SerializeDataUpdate(commandStream.data(), 0, size);
+        serverHandle->DeserializeDataUpdate(commandStream.data(), commandStream.size(), 0, size);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+void BM_SharedMemoryReadTransfer(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) * kMiB;
+    SharedMemoryServices services;
+    if (services.client == nullptr || services.server == nullptr) {
+        state.SkipWithError("Shared memory is not supported");
+        return;
+    }
+
+    std::unique_ptr<wire::client::MemoryTransferService::ReadHandle> clientHandle(
+        services.client->CreateReadHandle(size));
+    std::vector<char> createInfo(clientHandle->SerializeCreateSize());
+    clientHandle->SerializeCreate(createInfo.data());
+
+    wire::server::MemoryTransferService::ReadHandle* handle = nullptr;
+    if (!services.server->DeserializeReadHandle(createInfo.data(), createInfo.size(), &handle)) {
+        state.SkipWithError("Failed to open the shared memory");
+        return;
+    }
+    std::unique_ptr<wire::server::MemoryTransferService::ReadHandle> serverHandle(handle);
+
+    std::vector<uint8_t> mapped(size, 1);
+    for (auto _ : state) {
+        // Map completion: the server copies the mapped range directly to the shared memory.
+        serverHandle->SerializeDataUpdate(mapped.data(), 0, size, nullptr);
+        clientHandle->DeserializeDataUpdate(nullptr, 0, 0, size);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+#endif  // DAWN_PLATFORM_IS(LINUX_DESKTOP)
+
+// Arguments are the mapped size in MiB and the percentage of it written by the application.
+void WriteTransferArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t size : {1, 16, 256}) {
+        for (int64_t writtenPercent : {1, 10, 100}) {
+            b->Args({size, writtenPercent});
+        }
+    }
+}
+
+BENCHMARK(BM_InlineWriteTransfer)->Apply(WriteTransferArgs);
+BENCHMARK(BM_InlineReadTransfer)->Arg(1)->Arg(16)->Arg(256);
+#if DAWN_PLATFORM_IS(LINUX_DESKTOP)
+BENCHMARK(BM_SharedMemoryWriteTransfer)->Apply(WriteTransferArgs);
+BENCHMARK(BM_SharedMemoryReadTransfer)->Arg(1)->Arg(16)->Arg(256);
+#endif
+
+}  // namespace
+}  // namespace dawn
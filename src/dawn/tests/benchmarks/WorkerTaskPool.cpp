@@ -0,0 +1,118 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dawn/platform/DawnPlatform.h"
+
+namespace dawn {
+namespace {
+
+// A pool that matches the previous behavior of the default platform pool, spawning a detached
+// thread for each task. Used as the baseline for the persistent pool.
+class ThreadPerTaskPool : public platform::WorkerTaskPool {
+  public:
+    std::unique_ptr<platform::WaitableEvent> PostWorkerTask(platform::PostWorkerTaskCallback callback,
+                                                            void* userdata) override {
+        auto event = std::make_unique<Event>();
+        std::thread([callback, userdata, state = event->state] {
+            callback(userdata);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->isComplete = true;
+            }
+            state->condition.notify_all();
+        }).detach();
+        return event;
+    }
+
+  private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool isComplete = false;
+    };
+
+    struct Event : platform::WaitableEvent {
+        void Wait() override {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->condition.wait(lock, [this] { return state->isComplete; });
+        }
+        bool IsComplete() override {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            return state->isComplete;
+        }
+        std::shared_ptr<State> state = std::make_shared<State>();
+    };
+};
+
+// Emulates the CPU cost of compiling a small pipeline on a worker thread.
+void CompilePipelineTask(void* userdata) {
+    uint64_t value = reinterpret_cast<uintptr_t>(userdata);
+    for (uint32_t i = 0; i < 20000; ++i) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    benchmark::DoNotOptimize(value);
+}
+
+// Posts batches of state.range(0) tasks, emulating that many outstanding
+// Create*PipelineAsync calls, and waits for all of them to complete.
+void RunOutstandingTasks(benchmark::State& state, platform::WorkerTaskPool* pool) {
+    const size_t outstandingTasks = static_cast<size_t>(state.range(0));
+    std::vector<std::unique_ptr<platform::WaitableEvent>> events(outstandingTasks);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < outstandingTasks; ++i) {
+            events[i] = pool->PostWorkerTask(CompilePipelineTask, reinterpret_cast<void*>(i));
+        }
+        for (auto& event : events) {
+            event->Wait();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * outstandingTasks);
+}
+
+void BM_PlatformWorkerTaskPool(benchmark::State& state) {
+    platform::Platform platform;
+    std::unique_ptr<platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+    RunOutstandingTasks(state, pool.get());
+}
+BENCHMARK(BM_PlatformWorkerTaskPool)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+
+void BM_ThreadPerTaskPool(benchmark::State& state) {
+    ThreadPerTaskPool pool;
+    RunOutstandingTasks(state, &pool);
+}
+BENCHMARK(BM_ThreadPerTaskPool)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+
+}  // namespace
+}  // namespace dawn
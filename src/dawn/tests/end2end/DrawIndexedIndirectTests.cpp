@@ -25,6 +25,7 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <cstring>
 #include <vector>
 
 #include "dawn/tests/DawnTest.h"
@@ -96,6 +97,19 @@ class DrawIndexedIndirectTest : public DawnTest {
             device, wgpu::BufferUsage::Indirect | wgpu::BufferUsage::Storage, indirectParamList);
     }
 
+    // Creates an indirect buffer whose content can only be written at creation. Draws using it
+    // may be validated on the CPU instead of with a compute pass.
+    wgpu::Buffer CreateImmutableIndirectBuffer(std::initializer_list<uint32_t> indirectParamList) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = indirectParamList.size() * sizeof(uint32_t);
+        descriptor.usage = wgpu::BufferUsage::Indirect;
+        descriptor.mappedAtCreation = true;
+        wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+        memcpy(buffer.GetMappedRange(), indirectParamList.begin(), descriptor.size);
+        buffer.Unmap();
+        return buffer;
+    }
+
     wgpu::Buffer CreateIndexBuffer(std::initializer_list<uint32_t> indexList) {
         return utils::CreateBufferFromData<uint32_t>(device, wgpu::BufferUsage::Index, indexList);
     }
@@ -104,8 +118,14 @@ class DrawIndexedIndirectTest : public DawnTest {
                                            wgpu::Buffer indexBuffer,
                                            uint64_t indexOffset,
                                            uint64_t indirectOffset) {
-        wgpu::Buffer indirectBuffer = CreateIndirectBuffer(bufferList);
+        return EncodeDrawCommands(CreateIndirectBuffer(bufferList), indexBuffer, indexOffset,
+                                  indirectOffset);
+    }
 
+    wgpu::CommandBuffer EncodeDrawCommands(wgpu::Buffer indirectBuffer,
+                                           wgpu::Buffer indexBuffer,
+                                           uint64_t indexOffset,
+                                           uint64_t indirectOffset) {
         wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
         {
             wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
@@ -275,6 +295,42 @@ TEST_P(DrawIndexedIndirectTest, ValidateWithOffsets) {
              notFilled);
 }
 
+// Test validation of draws whose indirect buffer content is only written at creation.
+TEST_P(DrawIndexedIndirectTest, ValidateImmutableIndirectBuffer) {
+    // TODO(crbug.com/dawn/789): Test is failing under SwANGLE on Windows only.
+    DAWN_SUPPRESS_TEST_IF(IsANGLE() && IsWindows());
+
+    // TODO(crbug.com/dawn/1292): Some Intel OpenGL drivers don't seem to like
+    // the offsets that Tint/GLSL produces.
+    DAWN_SUPPRESS_TEST_IF(IsIntel() && IsOpenGL() && IsLinux());
+
+    // It doesn't make sense to test invalid inputs when validation is disabled.
+    DAWN_SUPPRESS_TEST_IF(HasToggleEnabled("skip_validation"));
+
+    utils::RGBA8 filled(0, 255, 0, 255);
+    utils::RGBA8 notFilled(0, 0, 0, 0);
+
+    wgpu::Buffer indexBuffer = CreateIndexBuffer({0, 1, 2, 0, 3, 1, 0, 1, 2});
+    wgpu::Buffer indirectBuffer =
+        CreateImmutableIndirectBuffer({3, 1, 0, 0, 0, 10, 1, 0, 0, 0, 3, 1, 3, 0, 0});
+
+    // Test valid draws. Should draw the respective triangles.
+    TestDraw(EncodeDrawCommands(indirectBuffer, indexBuffer, 0, 0), filled, notFilled);
+    TestDraw(EncodeDrawCommands(indirectBuffer, indexBuffer, 0, 10 * sizeof(uint32_t)), notFilled,
+             filled);
+
+    // Test a draw with an excessive indexCount. Should draw nothing.
+    TestDraw(EncodeDrawCommands(indirectBuffer, indexBuffer, 0, 5 * sizeof(uint32_t)), notFilled,
+             notFilled);
+
+    // Test that validation properly accounts for index buffer offset.
+    TestDraw(EncodeDrawCommands(indirectBuffer, indexBuffer, 6 * sizeof(uint32_t), 0), filled,
+             notFilled);
+    TestDraw(EncodeDrawCommands(indirectBuffer, indexBuffer, 6 * sizeof(uint32_t),
+                                10 * sizeof(uint32_t)),
+             notFilled, notFilled);
+}
+
 TEST_P(DrawIndexedIndirectTest, ValidateMultiplePasses) {
     // TODO(crbug.com/dawn/789): Test is failing under SwANGLE on Windows only.
     DAWN_SUPPRESS_TEST_IF(IsANGLE() && IsWindows());
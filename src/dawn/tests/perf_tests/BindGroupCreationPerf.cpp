@@ -0,0 +1,143 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumIterations = 1000;
+
+enum class BindGroupUsage {
+    // Only create and release the bind groups.
+    None,
+    // Use each bind group in a compute pass before releasing it.
+    ComputePass,
+};
+
+struct BindGroupCreationParams : AdapterTestParam {
+    BindGroupCreationParams(const AdapterTestParam& param, BindGroupUsage usage)
+        : AdapterTestParam(param), usage(usage) {}
+
+    BindGroupUsage usage;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const BindGroupCreationParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+
+    switch (param.usage) {
+        case BindGroupUsage::None:
+            ostream << "_NotUsed";
+            break;
+        case BindGroupUsage::ComputePass:
+            ostream << "_ComputePass";
+            break;
+    }
+
+    return ostream;
+}
+
+// Test the performance of creating and releasing a lot of transient bind groups each frame, which
+// exercises the recycling of the backends' descriptor allocations.
+class BindGroupCreationPerf : public DawnPerfTestWithParams<BindGroupCreationParams> {
+  public:
+    BindGroupCreationPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~BindGroupCreationPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mUniformBuffer;
+    wgpu::Buffer mStorageBuffer;
+    wgpu::ComputePipeline mPipeline;
+};
+
+void BindGroupCreationPerf::SetUp() {
+    DawnPerfTestWithParams<BindGroupCreationParams>::SetUp();
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 256;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+    mUniformBuffer = device.CreateBuffer(&bufferDesc);
+
+    bufferDesc.usage = wgpu::BufferUsage::Storage;
+    mStorageBuffer = device.CreateBuffer(&bufferDesc);
+
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<uniform> input : vec4u;
+        @group(0) @binding(1) var<storage, read_write> output : vec4u;
+        @compute @workgroup_size(1) fn main() {
+            output = input;
+        }
+    )");
+    mPipeline = device.CreateComputePipeline(&pipelineDesc);
+}
+
+void BindGroupCreationPerf::Step() {
+    const bool useBindGroups = GetParam().usage == BindGroupUsage::ComputePass;
+
+    wgpu::CommandEncoder encoder;
+    wgpu::ComputePassEncoder pass;
+    if (useBindGroups) {
+        encoder = device.CreateCommandEncoder();
+        pass = encoder.BeginComputePass();
+        pass.SetPipeline(mPipeline);
+    }
+
+    wgpu::BindGroupLayout layout = mPipeline.GetBindGroupLayout(0);
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        wgpu::BindGroup bindGroup =
+            utils::MakeBindGroup(device, layout, {{0, mUniformBuffer}, {1, mStorageBuffer}});
+        if (useBindGroups) {
+            pass.SetBindGroup(0, bindGroup);
+            pass.DispatchWorkgroups(1);
+        }
+    }
+
+    if (useBindGroups) {
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+}
+
+TEST_P(BindGroupCreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BindGroupCreationPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {BindGroupUsage::None, BindGroupUsage::ComputePass});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -27,6 +27,7 @@
 
 #include <vector>
 
+#include "dawn/native/DawnNative.h"
 #include "dawn/tests/perf_tests/DawnPerfTest.h"
 #include "dawn/utils/WGPUHelpers.h"
 
@@ -310,6 +311,94 @@ TEST_P(BufferMapExtendedUsagesPerf, Run) {
     RunTest();
 }
 
+// Sizes of the RGBA8 texture data streamed each frame. They are all larger than the initial
+// DynamicUploader ring buffer size.
+enum class StreamingSize {
+    TextureSize_8MB = 8 * 1024 * 1024,
+    TextureSize_16MB = 16 * 1024 * 1024,
+    TextureSize_32MB = 32 * 1024 * 1024,
+    TextureSize_64MB = 64 * 1024 * 1024,
+};
+
+struct TextureStreamingParams : AdapterTestParam {
+    TextureStreamingParams(const AdapterTestParam& param, StreamingSize streamingSize)
+        : AdapterTestParam(param), streamingSize(streamingSize) {}
+
+    StreamingSize streamingSize;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const TextureStreamingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_TextureSize_" << static_cast<uint64_t>(param.streamingSize) / (1024 * 1024)
+            << "MB";
+    return ostream;
+}
+
+// Test streaming a large texture with Queue::WriteTexture every frame, which stresses the
+// allocation and reuse of large staging buffers in the DynamicUploader.
+class TextureStreamingPerf : public DawnPerfTestWithParams<TextureStreamingParams> {
+  public:
+    static constexpr unsigned int kFramesPerStep = 4;
+    static constexpr uint32_t kTextureWidth = 2048;
+    static constexpr uint32_t kBytesPerTexel = 4;
+
+    TextureStreamingPerf()
+        : DawnPerfTestWithParams(kFramesPerStep, 3),
+          data(static_cast<size_t>(GetParam().streamingSize)) {}
+    ~TextureStreamingPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Texture texture;
+    wgpu::Extent3D copySize;
+    std::vector<uint8_t> data;
+};
+
+void TextureStreamingPerf::SetUp() {
+    DawnPerfTestWithParams<TextureStreamingParams>::SetUp();
+
+    uint32_t height = static_cast<uint32_t>(data.size() / (kTextureWidth * kBytesPerTexel));
+    copySize = {kTextureWidth, height, 1};
+
+    wgpu::TextureDescriptor desc = {};
+    desc.size = copySize;
+    desc.format = wgpu::TextureFormat::RGBA8Unorm;
+    desc.usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::TextureBinding;
+    texture = device.CreateTexture(&desc);
+}
+
+void TextureStreamingPerf::Step() {
+    wgpu::ImageCopyTexture imageCopyTexture = utils::CreateImageCopyTexture(texture);
+    wgpu::TextureDataLayout textureDataLayout =
+        utils::CreateTextureDataLayout(0, kTextureWidth * kBytesPerTexel);
+
+    for (unsigned int i = 0; i < kFramesPerStep; ++i) {
+        queue.WriteTexture(&imageCopyTexture, data.data(), data.size(), &textureDataLayout,
+                           &copySize);
+        // Each frame is submitted separately so that uploads span several serials.
+        queue.Submit(0, nullptr);
+    }
+}
+
+TEST_P(TextureStreamingPerf, Run) {
+    RunTest();
+
+    // Report how much staging memory the uploads used per serial. The wire has no access to the
+    // native device.
+    if (!UsesWire()) {
+        constexpr double kMiB = 1024.0 * 1024.0;
+        PrintResult("peak_upload_usage_per_serial",
+                    native::GetPeakUploadUsagePerSerialForTesting(device.Get()) / kMiB, "MiB",
+                    false);
+        PrintResult("average_upload_usage_per_serial",
+                    native::GetAverageUploadUsagePerSerialForTesting(device.Get()) / kMiB, "MiB",
+                    false);
+    }
+}
+
 DAWN_INSTANTIATE_TEST_P(BufferUploadPerf,
                         {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
                         {UploadMethod::WriteBuffer, UploadMethod::MappedAtCreation},
@@ -326,5 +415,11 @@ DAWN_INSTANTIATE_TEST_P(BufferMapExtendedUsagesPerf,
                          UploadSize::BufferSize_1MB, UploadSize::BufferSize_4MB,
                          UploadSize::BufferSize_16MB});
 
+DAWN_INSTANTIATE_TEST_P(TextureStreamingPerf,
+                        {D3D12Backend(), D3D11Backend(), MetalBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {StreamingSize::TextureSize_8MB, StreamingSize::TextureSize_16MB,
+                         StreamingSize::TextureSize_32MB, StreamingSize::TextureSize_64MB});
+
 }  // anonymous namespace
 }  // namespace dawn
@@ -0,0 +1,161 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstring>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumIterations = 50;
+constexpr uint32_t kDrawCount = 256;
+constexpr uint32_t kTextureSize = 64;
+
+constexpr char kShader[] = R"(
+        @vertex fn vs_main(@builtin(vertex_index) index : u32) -> @builtin(position) vec4f {
+            var pos = array(vec2f(0.0, 0.5), vec2f(-0.5, -0.5), vec2f(0.5, -0.5));
+            return vec4f(pos[index], 0.0, 1.0);
+        }
+
+        @fragment fn fs_main() -> @location(0) vec4f {
+            return vec4f(0.0, 1.0, 0.0, 1.0);
+        })";
+
+enum class IndirectBufferContent {
+    // The indirect buffer is written with Queue.WriteBuffer(), so its content may change after
+    // the draws are encoded and they are validated on the GPU.
+    WriteBuffer,
+    // The indirect buffer is only written with mappedAtCreation = true, so the draws can be
+    // validated on the CPU.
+    MappedAtCreation,
+};
+
+struct DrawIndirectValidationParams : AdapterTestParam {
+    DrawIndirectValidationParams(const AdapterTestParam& param,
+                                 IndirectBufferContent indirectBufferContent)
+        : AdapterTestParam(param), indirectBufferContent(indirectBufferContent) {}
+
+    IndirectBufferContent indirectBufferContent;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const DrawIndirectValidationParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+
+    switch (param.indirectBufferContent) {
+        case IndirectBufferContent::WriteBuffer:
+            ostream << "_WriteBuffer";
+            break;
+        case IndirectBufferContent::MappedAtCreation:
+            ostream << "_MappedAtCreation";
+            break;
+    }
+    return ostream;
+}
+
+// Test submitting render passes that only contain indirect draws, all of which need to be
+// validated before they are executed.
+class DrawIndirectValidationPerf : public DawnPerfTestWithParams<DrawIndirectValidationParams> {
+  public:
+    DrawIndirectValidationPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~DrawIndirectValidationPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    utils::BasicRenderPass mRenderPass;
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Buffer mIndirectBuffer;
+};
+
+void DrawIndirectValidationPerf::SetUp() {
+    DawnPerfTestWithParams<DrawIndirectValidationParams>::SetUp();
+
+    mRenderPass = utils::CreateBasicRenderPass(device, kTextureSize, kTextureSize);
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+    utils::ComboRenderPipelineDescriptor descriptor;
+    descriptor.vertex.module = module;
+    descriptor.cFragment.module = module;
+    descriptor.cTargets[0].format = mRenderPass.colorFormat;
+    mPipeline = device.CreateRenderPipeline(&descriptor);
+
+    std::vector<uint32_t> drawParams;
+    drawParams.reserve(kDrawCount * 4);
+    for (uint32_t i = 0; i < kDrawCount; ++i) {
+        drawParams.insert(drawParams.end(), {3, 1, 0, 0});
+    }
+    const uint64_t size = drawParams.size() * sizeof(uint32_t);
+
+    switch (GetParam().indirectBufferContent) {
+        case IndirectBufferContent::WriteBuffer:
+            mIndirectBuffer = utils::CreateBufferFromData(device, drawParams.data(), size,
+                                                          wgpu::BufferUsage::Indirect);
+            break;
+        case IndirectBufferContent::MappedAtCreation: {
+            wgpu::BufferDescriptor bufferDesc;
+            bufferDesc.size = size;
+            bufferDesc.usage = wgpu::BufferUsage::Indirect;
+            bufferDesc.mappedAtCreation = true;
+            mIndirectBuffer = device.CreateBuffer(&bufferDesc);
+            memcpy(mIndirectBuffer.GetMappedRange(), drawParams.data(), size);
+            mIndirectBuffer.Unmap();
+            break;
+        }
+    }
+}
+
+void DrawIndirectValidationPerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        pass.SetPipeline(mPipeline);
+        for (uint32_t draw = 0; draw < kDrawCount; ++draw) {
+            pass.DrawIndirect(mIndirectBuffer, draw * 4 * sizeof(uint32_t));
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+}
+
+TEST_P(DrawIndirectValidationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(DrawIndirectValidationPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {IndirectBufferContent::WriteBuffer,
+                         IndirectBufferContent::MappedAtCreation});
+
+}  // anonymous namespace
+}  // namespace dawn
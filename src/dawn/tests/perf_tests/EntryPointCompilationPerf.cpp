@@ -0,0 +1,176 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumIterations = 1;
+
+enum class CompilationMode {
+    // Create the pipelines one after the other with CreateComputePipeline.
+    Sequential,
+    // Create all the pipelines with CreateComputePipelineAsync and wait for all of them.
+    Concurrent,
+};
+
+struct EntryPointCompilationParams : AdapterTestParam {
+    EntryPointCompilationParams(const AdapterTestParam& param,
+                                CompilationMode compilationMode,
+                                uint32_t entryPointCount)
+        : AdapterTestParam(param),
+          compilationMode(compilationMode),
+          entryPointCount(entryPointCount) {}
+
+    CompilationMode compilationMode;
+    uint32_t entryPointCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const EntryPointCompilationParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+
+    switch (param.compilationMode) {
+        case CompilationMode::Sequential:
+            ostream << "_Sequential";
+            break;
+        case CompilationMode::Concurrent:
+            ostream << "_Concurrent";
+            break;
+    }
+
+    ostream << "_" << param.entryPointCount << "EntryPoints";
+    return ostream;
+}
+
+// Test the performance of creating a compute pipeline for each entry point of a shader module with
+// many entry points, like an uber-shader. Each step uses a new shader module so that no
+// compilation is served from a cache.
+class EntryPointCompilationPerf : public DawnPerfTestWithParams<EntryPointCompilationParams> {
+  public:
+    EntryPointCompilationPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~EntryPointCompilationPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    std::string MakeShaderSource();
+
+    uint32_t mStepIndex = 0;
+    std::vector<std::string> mEntryPoints;
+};
+
+void EntryPointCompilationPerf::SetUp() {
+    DawnPerfTestWithParams<EntryPointCompilationParams>::SetUp();
+
+    for (uint32_t i = 0; i < GetParam().entryPointCount; ++i) {
+        mEntryPoints.push_back("main" + std::to_string(i));
+    }
+}
+
+std::string EntryPointCompilationPerf::MakeShaderSource() {
+    std::ostringstream source;
+    // The step index makes each module unique so that it isn't deduplicated by the device.
+    source << "const kStep = " << mStepIndex++ << "u;\n";
+    source << R"(
+        struct Data {
+            values : array<vec4u, 64>,
+        }
+        @group(0) @binding(0) var<storage, read_write> data : Data;
+
+        fn mix_values(seed : u32) -> vec4u {
+            var result = vec4u(seed, kStep, 0, 0);
+            for (var i = 0u; i < 64u; i++) {
+                result = (result ^ data.values[i]) * vec4u(3, 5, 7, 11) + vec4u(i);
+            }
+            return result;
+        }
+    )";
+    for (uint32_t i = 0; i < mEntryPoints.size(); ++i) {
+        source << "@compute @workgroup_size(64) fn " << mEntryPoints[i]
+               << "(@builtin(local_invocation_index) index : u32) {\n"
+               << "    data.values[index] = mix_values(index + " << i << "u);\n"
+               << "}\n";
+    }
+    return source.str();
+}
+
+void EntryPointCompilationPerf::Step() {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, MakeShaderSource().c_str());
+
+    std::vector<wgpu::ComputePipelineDescriptor> descriptors(mEntryPoints.size());
+    for (size_t i = 0; i < mEntryPoints.size(); ++i) {
+        descriptors[i].compute.module = module;
+        descriptors[i].compute.entryPoint = mEntryPoints[i].c_str();
+    }
+
+    switch (GetParam().compilationMode) {
+        case CompilationMode::Sequential: {
+            for (const wgpu::ComputePipelineDescriptor& descriptor : descriptors) {
+                device.CreateComputePipeline(&descriptor);
+            }
+            break;
+        }
+
+        case CompilationMode::Concurrent: {
+            std::atomic<size_t> pendingCount = descriptors.size();
+            for (const wgpu::ComputePipelineDescriptor& descriptor : descriptors) {
+                device.CreateComputePipelineAsync(
+                    &descriptor, wgpu::CallbackMode::AllowProcessEvents,
+                    [&pendingCount](wgpu::CreatePipelineAsyncStatus status,
+                                    wgpu::ComputePipeline, const char*) {
+                        EXPECT_EQ(status, wgpu::CreatePipelineAsyncStatus::Success);
+                        pendingCount--;
+                    });
+            }
+            while (pendingCount > 0) {
+                WaitABit();
+            }
+            break;
+        }
+    }
+}
+
+TEST_P(EntryPointCompilationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(EntryPointCompilationPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {CompilationMode::Sequential, CompilationMode::Concurrent},
+                        {1, 8, 32});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,133 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumIterations = 50;
+constexpr uint32_t kDrawCount = 1000;
+constexpr uint32_t kTextureSize = 64;
+
+constexpr char kShader[] = R"(
+        @group(0) @binding(0) var<uniform> offset : vec4f;
+
+        @vertex fn vs_main(@location(0) pos : vec4f) -> @builtin(position) vec4f {
+            return pos + offset;
+        }
+
+        @fragment fn fs_main() -> @location(0) vec4f {
+            return vec4f(0.0, 1.0, 0.0, 1.0);
+        })";
+
+constexpr float kVertexData[12] = {
+    0.0f, 0.5f, 0.0f, 1.0f, -0.5f, -0.5f, 0.0f, 1.0f, 0.5f, -0.5f, 0.0f, 1.0f,
+};
+
+// Test encoding and submitting render passes where all the state is set again before each draw,
+// like engines that don't track the state they set. Running it with and without the
+// remove_redundant_state_commands toggle shows the cost of the redundant commands in the
+// backends and of removing them.
+class RedundantStatePerf : public DawnPerfTestWithParams<> {
+  public:
+    RedundantStatePerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~RedundantStatePerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    utils::BasicRenderPass mRenderPass;
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Buffer mVertexBuffer;
+    wgpu::BindGroup mBindGroup;
+};
+
+void RedundantStatePerf::SetUp() {
+    DawnPerfTestWithParams::SetUp();
+
+    mRenderPass = utils::CreateBasicRenderPass(device, kTextureSize, kTextureSize);
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+    utils::ComboRenderPipelineDescriptor descriptor;
+    descriptor.vertex.module = module;
+    descriptor.vertex.bufferCount = 1;
+    descriptor.cBuffers[0].arrayStride = 4 * sizeof(float);
+    descriptor.cBuffers[0].attributeCount = 1;
+    descriptor.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+    descriptor.cFragment.module = module;
+    descriptor.cTargets[0].format = mRenderPass.colorFormat;
+    mPipeline = device.CreateRenderPipeline(&descriptor);
+
+    mVertexBuffer = utils::CreateBufferFromData(device, kVertexData, sizeof(kVertexData),
+                                                wgpu::BufferUsage::Vertex);
+
+    float offset[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    wgpu::Buffer uniformBuffer =
+        utils::CreateBufferFromData(device, offset, sizeof(offset), wgpu::BufferUsage::Uniform);
+    mBindGroup =
+        utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0), {{0, uniformBuffer}});
+}
+
+void RedundantStatePerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        for (uint32_t draw = 0; draw < kDrawCount; ++draw) {
+            pass.SetPipeline(mPipeline);
+            pass.SetBindGroup(0, mBindGroup);
+            pass.SetVertexBuffer(0, mVertexBuffer);
+            pass.SetViewport(0, 0, kTextureSize, kTextureSize, 0, 1);
+            pass.SetScissorRect(0, 0, kTextureSize, kTextureSize);
+            pass.Draw(3);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+}
+
+TEST_P(RedundantStatePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(RedundantStatePerf,
+                      D3D12Backend(),
+                      D3D12Backend({"remove_redundant_state_commands"}),
+                      MetalBackend(),
+                      MetalBackend({"remove_redundant_state_commands"}),
+                      OpenGLBackend(),
+                      OpenGLBackend({"remove_redundant_state_commands"}),
+                      VulkanBackend(),
+                      VulkanBackend({"remove_redundant_state_commands"}));
+
+}  // anonymous namespace
+}  // namespace dawn
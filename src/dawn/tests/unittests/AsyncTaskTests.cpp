@@ -29,9 +29,12 @@
 // AsyncTaskTests:
 //     Simple tests for native::AsyncTask and native::AsnycTaskManager.
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -39,6 +42,7 @@
 #include "dawn/native/AsyncTask.h"
 #include "dawn/platform/DawnPlatform.h"
 #include "gtest/gtest.h"
+#include "partition_alloc/pointers/raw_ptr.h"
 
 namespace dawn {
 namespace {
@@ -103,5 +107,128 @@ TEST_F(AsyncTaskTest, Basic) {
     ASSERT_TRUE(idset.empty());
 }
 
+// Test that many more tasks than worker threads all get run.
+TEST_F(AsyncTaskTest, ManyTasks) {
+    platform::Platform platform;
+    std::unique_ptr<platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    native::AsyncTaskManager taskManager(pool.get());
+    ConcurrentTaskResultQueue taskResultQueue;
+
+    constexpr size_t kTaskCount = 1000u;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, i); });
+    }
+
+    taskManager.WaitAllPendingTasks();
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    ASSERT_EQ(kTaskCount, results.size());
+    std::set<uint32_t> idset;
+    for (std::unique_ptr<SimpleTaskResult>& result : results) {
+        idset.insert(result->id);
+    }
+    ASSERT_EQ(kTaskCount, idset.size());
+}
+
+// Test that a task running on a worker thread can post more tasks to the same pool.
+TEST_F(AsyncTaskTest, PostFromWorkerTask) {
+    platform::Platform platform;
+    std::unique_ptr<platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    struct Userdata {
+        raw_ptr<platform::WorkerTaskPool> pool;
+        std::atomic<uint32_t> count = 0;
+        std::mutex mutex;
+        std::vector<std::unique_ptr<platform::WaitableEvent>> childEvents;
+    } userdata;
+    userdata.pool = pool.get();
+
+    constexpr uint32_t kParentCount = 16u;
+    constexpr uint32_t kChildCount = 8u;
+    std::vector<std::unique_ptr<platform::WaitableEvent>> parentEvents;
+    for (uint32_t i = 0; i < kParentCount; ++i) {
+        parentEvents.push_back(pool->PostWorkerTask(
+            [](void* data) {
+                Userdata* userdata = static_cast<Userdata*>(data);
+                for (uint32_t j = 0; j < kChildCount; ++j) {
+                    std::unique_ptr<platform::WaitableEvent> event = userdata->pool->PostWorkerTask(
+                        [](void* data) { static_cast<Userdata*>(data)->count++; }, data);
+                    std::lock_guard<std::mutex> lock(userdata->mutex);
+                    userdata->childEvents.push_back(std::move(event));
+                }
+            },
+            &userdata));
+    }
+
+    for (std::unique_ptr<platform::WaitableEvent>& event : parentEvents) {
+        event->Wait();
+        EXPECT_TRUE(event->IsComplete());
+    }
+    for (std::unique_ptr<platform::WaitableEvent>& event : userdata.childEvents) {
+        event->Wait();
+        EXPECT_TRUE(event->IsComplete());
+    }
+    EXPECT_EQ(kParentCount * kChildCount, userdata.count.load());
+}
+
+// Test that destroying the pool runs all the tasks that were already posted.
+TEST_F(AsyncTaskTest, DestroyPoolRunsPendingTasks) {
+    platform::Platform platform;
+    std::unique_ptr<platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    std::atomic<uint32_t> count = 0;
+    constexpr uint32_t kTaskCount = 100u;
+    std::vector<std::unique_ptr<platform::WaitableEvent>> events;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        events.push_back(pool->PostWorkerTask(
+            [](void* data) { (*static_cast<std::atomic<uint32_t>*>(data))++; }, &count));
+    }
+
+    pool = nullptr;
+    EXPECT_EQ(kTaskCount, count.load());
+    for (std::unique_ptr<platform::WaitableEvent>& event : events) {
+        EXPECT_TRUE(event->IsComplete());
+    }
+}
+
+// Test that a task can post a follow-up task while the pool is being destroyed, and that the
+// follow-up task is run before the destruction completes.
+TEST_F(AsyncTaskTest, PostFromWorkerTaskDuringDestruction) {
+    platform::Platform platform;
+    std::unique_ptr<platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    struct Userdata {
+        raw_ptr<platform::WorkerTaskPool> pool;
+        std::atomic<bool> isDestroying = false;
+        std::atomic<uint32_t> count = 0;
+        std::unique_ptr<platform::WaitableEvent> followUpEvent;
+    } userdata;
+    userdata.pool = pool.get();
+
+    std::unique_ptr<platform::WaitableEvent> event = pool->PostWorkerTask(
+        [](void* data) {
+            Userdata* userdata = static_cast<Userdata*>(data);
+            while (!userdata->isDestroying.load()) {
+                std::this_thread::yield();
+            }
+            // Give the destructor time to start draining the workers.
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            userdata->count++;
+            userdata->followUpEvent = userdata->pool->PostWorkerTask(
+                [](void* data) { static_cast<Userdata*>(data)->count++; }, data);
+        },
+        &userdata);
+
+    userdata.isDestroying = true;
+    pool = nullptr;
+
+    EXPECT_EQ(2u, userdata.count.load());
+    EXPECT_TRUE(event->IsComplete());
+    ASSERT_NE(nullptr, userdata.followUpEvent);
+    EXPECT_TRUE(userdata.followUpEvent->IsComplete());
+}
+
 }  // anonymous namespace
 }  // namespace dawn
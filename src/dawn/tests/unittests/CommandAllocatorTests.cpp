@@ -513,4 +513,96 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     iterator.MakeEmptyAsDataWasDestroyed();
 }
 
+// Allocates a single draw command with `allocator` and destroys it through a CommandIterator.
+void AllocateAndDestroyDraw(CommandAllocator allocator) {
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    CommandIterator iterator(std::move(allocator));
+    iterator.MakeEmptyAsDataWasDestroyed();
+}
+
+// Test that the blocks of destroyed commands are reused by the next allocator using the pool.
+TEST(CommandAllocator, PoolReusesBlocks) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+
+    AllocateAndDestroyDraw(CommandAllocator(pool));
+    CommandBlockPool::Stats stats = pool->GetStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_GT(stats.pooledSize, 0u);
+
+    CommandAllocator allocator(pool);
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    stats = pool->GetStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.pooledSize, 0u);
+
+    // Resetting the allocator gives the block back to the pool too.
+    allocator.Reset();
+    EXPECT_GT(pool->GetStats().pooledSize, 0u);
+}
+
+// Test that blocks that are moved around keep going back to the pool.
+TEST(CommandAllocator, PoolWithMovedAllocators) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+
+    CommandAllocator allocator(pool);
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    std::vector<CommandAllocator> allocators;
+    allocators.push_back(std::move(allocator));
+
+    // The moved-from allocator still uses the pool.
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    allocators.push_back(std::move(allocator));
+
+    CommandIterator iterator;
+    iterator.AcquireCommandBlocks(std::move(allocators));
+    CommandIterator movedIterator(std::move(iterator));
+    movedIterator.MakeEmptyAsDataWasDestroyed();
+
+    CommandBlockPool::Stats stats = pool->GetStats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_GT(stats.pooledSize, 0u);
+
+    AllocateAndDestroyDraw(CommandAllocator(pool));
+    AllocateAndDestroyDraw(CommandAllocator(pool));
+    EXPECT_EQ(pool->GetStats().hits, 2u);
+}
+
+// Test that the size of the pooled blocks is capped and that blocks larger than the largest
+// size class aren't pooled.
+TEST(CommandAllocator, PoolIsCapped) {
+    {
+        Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool(0));
+        AllocateAndDestroyDraw(CommandAllocator(pool));
+        EXPECT_EQ(pool->GetStats().pooledSize, 0u);
+    }
+    {
+        Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+        CommandAllocator allocator(pool);
+        allocator.Allocate<CommandBig>(CommandType::Big);
+        CommandIterator iterator(std::move(allocator));
+        iterator.MakeEmptyAsDataWasDestroyed();
+        EXPECT_EQ(pool->GetStats().pooledSize, 0u);
+    }
+}
+
+// Test that trimming the pool frees its blocks, and that TrimIfUnused keeps them while they are
+// being acquired.
+TEST(CommandAllocator, PoolTrim) {
+    Ref<CommandBlockPool> pool = AcquireRef(new CommandBlockPool());
+    AllocateAndDestroyDraw(CommandAllocator(pool));
+    ASSERT_GT(pool->GetStats().pooledSize, 0u);
+
+    pool->TrimIfUnused();
+    EXPECT_GT(pool->GetStats().pooledSize, 0u);
+    pool->TrimIfUnused();
+    EXPECT_EQ(pool->GetStats().pooledSize, 0u);
+
+    AllocateAndDestroyDraw(CommandAllocator(pool));
+    ASSERT_GT(pool->GetStats().pooledSize, 0u);
+    pool->Trim();
+    EXPECT_EQ(pool->GetStats().pooledSize, 0u);
+}
+
 }  // namespace dawn::native
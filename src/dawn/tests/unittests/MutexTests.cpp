@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <thread>
+
 #include "dawn/common/Mutex.h"
 #include "gtest/gtest.h"
 
@@ -80,6 +82,29 @@ TEST_F(MutexTest, AutoLockAndHoldRef) {
     }
 }
 
+// Test that TryLock() acquires an unlocked mutex and fails on a mutex held by another thread.
+TEST_F(MutexTest, TryLock) {
+    EXPECT_TRUE(mMutex.TryLock());
+    EXPECT_TRUE(mMutex.IsLockedByCurrentThread());
+
+    bool lockedByOtherThread = true;
+    std::thread([&] { lockedByOtherThread = mMutex.TryLock(); }).join();
+    EXPECT_FALSE(lockedByOtherThread);
+
+    mMutex.Unlock();
+    EXPECT_FALSE(mMutex.IsLockedByCurrentThread());
+}
+
+// Test that AutoLock can adopt a mutex that is already locked and unlocks it when out of scope.
+TEST_F(MutexTest, AutoLockAdoptLock) {
+    ASSERT_TRUE(mMutex.TryLock());
+    {
+        Mutex::AutoLock autoLock(&mMutex, std::adopt_lock);
+        EXPECT_TRUE(mMutex.IsLockedByCurrentThread());
+    }
+    EXPECT_FALSE(mMutex.IsLockedByCurrentThread());
+}
+
 using MutexDeathTest = MutexTest;
 
 // Test that Unlock() call on unlocked mutex will cause assertion failure.
@@ -0,0 +1,269 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "dawn/common/Version_autogen.h"
+#include "dawn/native/BlobCache.h"
+#include "dawn/native/CacheKey.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+namespace {
+
+// A fake embedder cache that records how many times it is called.
+struct FakeEmbedderCache {
+    std::unordered_map<std::string, std::string> entries;
+    uint32_t loadCount = 0;
+    uint32_t storeCount = 0;
+};
+
+class BlobCacheTests : public testing::Test {
+  protected:
+    std::unique_ptr<BlobCache> CreateBlobCache(uint64_t memoryCacheSize,
+                                               BlobCache* sharedCache = nullptr) {
+        DawnCacheDeviceDescriptor desc = {};
+        desc.memoryCacheSize = memoryCacheSize;
+        desc.functionUserdata = &mEmbedderCache;
+        desc.loadDataFunction = [](const void* key, size_t keySize, void* value, size_t valueSize,
+                                   void* userdata) -> size_t {
+            auto* cache = static_cast<FakeEmbedderCache*>(userdata);
+            cache->loadCount++;
+            auto it = cache->entries.find(std::string(static_cast<const char*>(key), keySize));
+            if (it == cache->entries.end()) {
+                return 0;
+            }
+            if (value != nullptr) {
+                memcpy(value, it->second.data(), std::min(valueSize, it->second.size()));
+            }
+            return it->second.size();
+        };
+        desc.storeDataFunction = [](const void* key, size_t keySize, const void* value,
+                                    size_t valueSize, void* userdata) {
+            auto* cache = static_cast<FakeEmbedderCache*>(userdata);
+            cache->storeCount++;
+            cache->entries[std::string(static_cast<const char*>(key), keySize)] =
+                std::string(static_cast<const char*>(value), valueSize);
+        };
+        return std::make_unique<BlobCache>(desc, sharedCache);
+    }
+
+    // Creates a cache without embedder functions, like the instance's shared cache.
+    static std::unique_ptr<BlobCache> CreateMemoryOnlyBlobCache(uint64_t memoryCacheSize,
+                                                                BlobCache* sharedCache = nullptr) {
+        DawnCacheDeviceDescriptor desc = {};
+        desc.memoryCacheSize = memoryCacheSize;
+        return std::make_unique<BlobCache>(desc, sharedCache);
+    }
+
+    static CacheKey MakeKey(uint32_t id) {
+        CacheKey key;
+        StreamIn(&key, kDawnVersion, id);
+        return key;
+    }
+
+    static Blob MakeValue(size_t size, uint8_t fill) {
+        Blob blob = CreateBlob(size);
+        memset(blob.Data(), fill, size);
+        return blob;
+    }
+
+    FakeEmbedderCache mEmbedderCache;
+};
+
+// Test that without a memory budget every load goes to the embedder.
+TEST_F(BlobCacheTests, MemoryCacheDisabled) {
+    std::unique_ptr<BlobCache> cache = CreateBlobCache(0);
+    cache->Store(MakeKey(0), MakeValue(16, 0xAB));
+    EXPECT_EQ(mEmbedderCache.storeCount, 1u);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        Blob blob = cache->Load(MakeKey(0));
+        ASSERT_EQ(blob.Size(), 16u);
+        EXPECT_EQ(blob.Data()[0], 0xAB);
+    }
+    // Each load queries the size and then the data.
+    EXPECT_EQ(mEmbedderCache.loadCount, 6u);
+
+    BlobCache::MemoryCacheStats stats = cache->GetMemoryCacheStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(stats.entryCount, 0u);
+}
+
+// Test that stored values are served from memory and still written through to the embedder.
+TEST_F(BlobCacheTests, StoreThenLoadHitsMemory) {
+    std::unique_ptr<BlobCache> cache = CreateBlobCache(1024 * 1024);
+    cache->Store(MakeKey(0), MakeValue(16, 0xAB));
+    EXPECT_EQ(mEmbedderCache.storeCount, 1u);
+
+    Blob blob1 = cache->Load(MakeKey(0));
+    Blob blob2 = cache->Load(MakeKey(0));
+    ASSERT_EQ(blob1.Size(), 16u);
+    EXPECT_EQ(blob1.Data()[15], 0xAB);
+    // Hits share the same cached data instead of copying it.
+    EXPECT_EQ(blob1.Data(), blob2.Data());
+    EXPECT_EQ(mEmbedderCache.loadCount, 0u);
+
+    BlobCache::MemoryCacheStats stats = cache->GetMemoryCacheStats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(stats.entryCount, 1u);
+    EXPECT_EQ(stats.byteSize, 16u);
+}
+
+// Test that a value loaded from the embedder is kept in memory for the next load.
+TEST_F(BlobCacheTests, EmbedderHitIsKeptInMemory) {
+    {
+        std::unique_ptr<BlobCache> cache = CreateBlobCache(0);
+        cache->Store(MakeKey(0), MakeValue(32, 0x12));
+    }
+
+    std::unique_ptr<BlobCache> cache = CreateBlobCache(1024 * 1024);
+    EXPECT_EQ(cache->Load(MakeKey(0)).Size(), 32u);
+    EXPECT_EQ(mEmbedderCache.loadCount, 2u);
+    EXPECT_EQ(cache->Load(MakeKey(0)).Size(), 32u);
+    EXPECT_EQ(mEmbedderCache.loadCount, 2u);
+
+    // A key that is in neither tier is a miss each time.
+    EXPECT_TRUE(cache->Load(MakeKey(1)).Empty());
+    EXPECT_TRUE(cache->Load(MakeKey(1)).Empty());
+
+    BlobCache::MemoryCacheStats stats = cache->GetMemoryCacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.entryCount, 1u);
+}
+
+// Test that the memory tier stays within its byte budget by evicting entries, and that blobs
+// handed out before an eviction stay valid.
+TEST_F(BlobCacheTests, EvictionRespectsBudget) {
+    constexpr uint64_t kBudget = 64 * 1024;
+    constexpr size_t kValueSize = 1024;
+    std::unique_ptr<BlobCache> cache = CreateBlobCache(kBudget);
+
+    cache->Store(MakeKey(0), MakeValue(kValueSize, 0x42));
+    Blob held = cache->Load(MakeKey(0));
+
+    for (uint32_t i = 1; i < 1000; ++i) {
+        cache->Store(MakeKey(i), MakeValue(kValueSize, static_cast<uint8_t>(i)));
+    }
+
+    BlobCache::MemoryCacheStats stats = cache->GetMemoryCacheStats();
+    EXPECT_LE(stats.byteSize, kBudget);
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_EQ(stats.byteSize, stats.entryCount * kValueSize);
+
+    ASSERT_EQ(held.Size(), kValueSize);
+    EXPECT_EQ(held.Data()[kValueSize - 1], 0x42);
+
+    // Evicted values are still available from the embedder.
+    Blob reloaded = cache->Load(MakeKey(0));
+    ASSERT_EQ(reloaded.Size(), kValueSize);
+    EXPECT_EQ(reloaded.Data()[0], 0x42);
+}
+
+// Test that values larger than a shard's budget are not kept in memory.
+TEST_F(BlobCacheTests, LargeValueBypassesMemory) {
+    std::unique_ptr<BlobCache> cache = CreateBlobCache(1024);
+    cache->Store(MakeKey(0), MakeValue(4096, 0x1));
+
+    EXPECT_EQ(cache->GetMemoryCacheStats().entryCount, 0u);
+    EXPECT_EQ(cache->Load(MakeKey(0)).Size(), 4096u);
+    EXPECT_EQ(cache->GetMemoryCacheStats().entryCount, 0u);
+}
+
+// Test that a value stored through one cache is loaded from the shared cache by another.
+TEST_F(BlobCacheTests, SharedCacheServesOtherCaches) {
+    std::unique_ptr<BlobCache> shared = CreateMemoryOnlyBlobCache(1024 * 1024);
+    std::unique_ptr<BlobCache> cacheA = CreateMemoryOnlyBlobCache(0, shared.get());
+    std::unique_ptr<BlobCache> cacheB = CreateMemoryOnlyBlobCache(0, shared.get());
+
+    EXPECT_TRUE(cacheB->Load(MakeKey(0)).Empty());
+    cacheA->Store(MakeKey(0), MakeValue(16, 0xCD));
+
+    Blob blob = cacheB->Load(MakeKey(0));
+    ASSERT_EQ(blob.Size(), 16u);
+    EXPECT_EQ(blob.Data()[15], 0xCD);
+
+    BlobCache::MemoryCacheStats stats = shared->GetMemoryCacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entryCount, 1u);
+}
+
+// Test that values loaded from an embedder are added to the shared cache, and that the embedder and
+// the memory tier are checked before the shared cache.
+TEST_F(BlobCacheTests, SharedCacheIsCheckedLast) {
+    {
+        std::unique_ptr<BlobCache> cache = CreateBlobCache(0);
+        cache->Store(MakeKey(0), MakeValue(32, 0x34));
+    }
+
+    std::unique_ptr<BlobCache> shared = CreateMemoryOnlyBlobCache(1024 * 1024);
+    std::unique_ptr<BlobCache> cacheA = CreateBlobCache(1024 * 1024, shared.get());
+    EXPECT_EQ(cacheA->Load(MakeKey(0)).Size(), 32u);
+    EXPECT_EQ(cacheA->Load(MakeKey(0)).Size(), 32u);
+    EXPECT_EQ(mEmbedderCache.loadCount, 2u);
+    EXPECT_EQ(shared->GetMemoryCacheStats().hits, 0u);
+    EXPECT_EQ(shared->GetMemoryCacheStats().entryCount, 1u);
+
+    std::unique_ptr<BlobCache> cacheB = CreateMemoryOnlyBlobCache(0, shared.get());
+    Blob blob = cacheB->Load(MakeKey(0));
+    ASSERT_EQ(blob.Size(), 32u);
+    EXPECT_EQ(blob.Data()[0], 0x34);
+    EXPECT_EQ(shared->GetMemoryCacheStats().hits, 1u);
+}
+
+// Test that a value loaded from the shared cache is kept in the loading cache's memory tier after
+// it is evicted from the shared cache.
+TEST_F(BlobCacheTests, SharedCacheHitIsKeptInMemory) {
+    constexpr size_t kValueSize = 1024;
+    std::unique_ptr<BlobCache> shared = CreateMemoryOnlyBlobCache(16 * kValueSize);
+    std::unique_ptr<BlobCache> cacheA = CreateMemoryOnlyBlobCache(0, shared.get());
+    std::unique_ptr<BlobCache> cacheB = CreateMemoryOnlyBlobCache(1024 * 1024, shared.get());
+
+    cacheA->Store(MakeKey(0), MakeValue(kValueSize, 0x56));
+    EXPECT_EQ(cacheB->Load(MakeKey(0)).Size(), kValueSize);
+
+    for (uint32_t i = 1; i < 1000; ++i) {
+        cacheA->Store(MakeKey(i), MakeValue(kValueSize, static_cast<uint8_t>(i)));
+    }
+    EXPECT_GT(shared->GetMemoryCacheStats().evictions, 0u);
+    EXPECT_TRUE(cacheA->Load(MakeKey(0)).Empty());
+
+    Blob blob = cacheB->Load(MakeKey(0));
+    ASSERT_EQ(blob.Size(), kValueSize);
+    EXPECT_EQ(blob.Data()[0], 0x56);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
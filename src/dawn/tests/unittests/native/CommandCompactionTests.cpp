@@ -0,0 +1,243 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/native/CommandBuffer.h"
+#include "dawn/native/Commands.h"
+#include "dawn/native/Device.h"
+#include "dawn/tests/DawnNativeTest.h"
+#include "dawn/utils/ComboRenderBundleEncoderDescriptor.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native {
+namespace {
+
+class CommandCompactionTests : public DawnNativeTest {
+  protected:
+    void SetUp() override {
+        DawnNativeTest::SetUp();
+
+        const char* toggle = "remove_redundant_state_commands";
+        wgpu::DawnTogglesDescriptor deviceToggles;
+        deviceToggles.enabledToggles = &toggle;
+        deviceToggles.enabledToggleCount = 1;
+        wgpu::DeviceDescriptor deviceDesc;
+        deviceDesc.nextInChain = &deviceToggles;
+        deviceDesc.SetUncapturedErrorCallback(
+            [](const wgpu::Device&, wgpu::ErrorType, const char* message) {
+                FAIL() << "Unexpected error: " << message;
+            });
+        device = wgpu::Device::Acquire(adapter.CreateDevice(&deviceDesc));
+
+        renderPass = utils::CreateBasicRenderPass(device, 4, 4);
+
+        bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Compute,
+                      wgpu::BufferBindingType::Uniform, true}});
+
+        utils::ComboRenderPipelineDescriptor renderDesc;
+        renderDesc.layout = utils::MakePipelineLayout(device, {bgl});
+        renderDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> offset : vec4f;
+            @vertex fn main(@location(0) pos : vec4f) -> @builtin(position) vec4f {
+                return pos + offset;
+            })");
+        renderDesc.vertex.bufferCount = 1;
+        renderDesc.cBuffers[0].arrayStride = 4 * sizeof(float);
+        renderDesc.cBuffers[0].attributeCount = 1;
+        renderDesc.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+        renderDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4f {
+                return vec4f(0.0, 1.0, 0.0, 1.0);
+            })");
+        renderDesc.cTargets[0].format = renderPass.colorFormat;
+        renderPipeline = device.CreateRenderPipeline(&renderDesc);
+
+        wgpu::ComputePipelineDescriptor computeDesc;
+        computeDesc.layout = utils::MakePipelineLayout(device, {bgl});
+        computeDesc.compute.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> data : vec4f;
+            @compute @workgroup_size(1) fn main() { _ = data; }
+        )");
+        computePipeline = device.CreateComputePipeline(&computeDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 512;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Vertex;
+        buffer = device.CreateBuffer(&bufferDesc);
+        bindGroup = utils::MakeBindGroup(device, bgl, {{0, buffer, 0, 16}});
+    }
+
+    // Returns the ids of the commands of the command buffer.
+    std::vector<Command> GetCommandIds(const wgpu::CommandBuffer& commandBuffer) {
+        CommandIterator* commands = FromAPI(commandBuffer.Get())->GetCommandIteratorForTesting();
+        std::vector<Command> ids;
+        Command id;
+        while (commands->NextCommandId(&id)) {
+            ids.push_back(id);
+            SkipCommand(commands, id);
+        }
+        commands->Reset();
+        return ids;
+    }
+
+    uint64_t GetRemovedCommandCount() {
+        return FromAPI(device.Get())->GetCommandCompactionStats().removedCommandCount;
+    }
+
+    utils::BasicRenderPass renderPass;
+    wgpu::BindGroupLayout bgl;
+    wgpu::RenderPipeline renderPipeline;
+    wgpu::ComputePipeline computePipeline;
+    wgpu::Buffer buffer;
+    wgpu::BindGroup bindGroup;
+};
+
+// Test that setting the state to the value it already has is removed.
+TEST_F(CommandCompactionTests, RepeatedStateIsRemoved) {
+    uint32_t offset = 0;
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    for (uint32_t i = 0; i < 2; ++i) {
+        pass.SetPipeline(renderPipeline);
+        pass.SetBindGroup(0, bindGroup, 1, &offset);
+        pass.SetVertexBuffer(0, buffer);
+        pass.SetViewport(0, 0, 4, 4, 0, 1);
+        pass.Draw(3);
+    }
+    pass.End();
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    EXPECT_EQ(GetCommandIds(commandBuffer),
+              (std::vector<Command>{Command::BeginRenderPass, Command::SetRenderPipeline,
+                                    Command::SetBindGroup, Command::SetVertexBuffer,
+                                    Command::SetViewport, Command::Draw, Command::Draw,
+                                    Command::EndRenderPass}));
+    EXPECT_EQ(GetRemovedCommandCount(), 4u);
+}
+
+// Test that state that is overwritten or discarded before being used by a draw is removed.
+TEST_F(CommandCompactionTests, UnusedStateIsRemoved) {
+    uint32_t offset = 0;
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    pass.SetPipeline(renderPipeline);
+    pass.SetBindGroup(0, bindGroup, 1, &offset);
+    pass.SetVertexBuffer(0, buffer);
+    pass.SetScissorRect(0, 0, 1, 1);
+    pass.SetScissorRect(0, 0, 2, 2);
+    wgpu::Color blendConstant = {1.0, 1.0, 1.0, 1.0};
+    pass.SetBlendConstant(&blendConstant);
+    pass.Draw(3);
+    pass.SetStencilReference(1);
+    pass.End();
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    EXPECT_EQ(GetCommandIds(commandBuffer),
+              (std::vector<Command>{Command::BeginRenderPass, Command::SetRenderPipeline,
+                                    Command::SetBindGroup, Command::SetVertexBuffer,
+                                    Command::SetScissorRect, Command::SetBlendConstant,
+                                    Command::Draw, Command::EndRenderPass}));
+    EXPECT_EQ(GetRemovedCommandCount(), 2u);
+}
+
+// Test that state changes, including the ones back to a previous value, are kept.
+TEST_F(CommandCompactionTests, ChangedStateIsKept) {
+    uint32_t offsets[] = {0, 256, 0};
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(computePipeline);
+    for (uint32_t& offset : offsets) {
+        pass.SetBindGroup(0, bindGroup, 1, &offset);
+        pass.DispatchWorkgroups(1);
+    }
+    pass.End();
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    EXPECT_EQ(GetCommandIds(commandBuffer),
+              (std::vector<Command>{Command::BeginComputePass, Command::SetComputePipeline,
+                                    Command::SetBindGroup, Command::Dispatch, Command::SetBindGroup,
+                                    Command::Dispatch, Command::SetBindGroup, Command::Dispatch,
+                                    Command::EndComputePass}));
+    EXPECT_EQ(GetRemovedCommandCount(), 0u);
+}
+
+// Test that the state isn't assumed to be the same across passes.
+TEST_F(CommandCompactionTests, StateIsResetBetweenPasses) {
+    uint32_t offset = 0;
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < 2; ++i) {
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(computePipeline);
+        pass.SetBindGroup(0, bindGroup, 1, &offset);
+        pass.DispatchWorkgroups(1);
+        pass.End();
+    }
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    EXPECT_EQ(GetRemovedCommandCount(), 0u);
+}
+
+// Test that the state reset by executing render bundles is set again, and that the state they
+// use isn't removed.
+TEST_F(CommandCompactionTests, ExecuteBundles) {
+    utils::ComboRenderBundleEncoderDescriptor bundleDesc;
+    bundleDesc.colorFormatCount = 1;
+    bundleDesc.cColorFormats[0] = renderPass.colorFormat;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    wgpu::RenderBundle bundle = bundleEncoder.Finish();
+
+    uint32_t offset = 0;
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    pass.SetPipeline(renderPipeline);
+    pass.SetBindGroup(0, bindGroup, 1, &offset);
+    pass.SetVertexBuffer(0, buffer);
+    pass.Draw(3);
+    pass.SetPipeline(renderPipeline);
+    pass.SetViewport(0, 0, 2, 2, 0, 1);
+    pass.ExecuteBundles(1, &bundle);
+    pass.SetPipeline(renderPipeline);
+    pass.SetBindGroup(0, bindGroup, 1, &offset);
+    pass.SetVertexBuffer(0, buffer);
+    pass.Draw(3);
+    pass.End();
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    EXPECT_EQ(GetCommandIds(commandBuffer),
+              (std::vector<Command>{
+                  Command::BeginRenderPass, Command::SetRenderPipeline, Command::SetBindGroup,
+                  Command::SetVertexBuffer, Command::Draw, Command::SetViewport,
+                  Command::ExecuteBundles, Command::SetRenderPipeline, Command::SetBindGroup,
+                  Command::SetVertexBuffer, Command::Draw, Command::EndRenderPass}));
+    EXPECT_EQ(GetRemovedCommandCount(), 1u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
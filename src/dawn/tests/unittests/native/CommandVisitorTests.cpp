@@ -0,0 +1,165 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/MatchVariant.h"
+#include "dawn/native/CommandAllocator.h"
+#include "dawn/native/CommandVisitor.h"
+#include "dawn/native/Commands.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+namespace {
+
+// Records what was visited for the commands used in the tests.
+struct RecordingVisitor {
+    void operator()(DrawCmd* cmd) { visited.push_back("Draw " + std::to_string(cmd->vertexCount)); }
+    void operator()(SetBindGroupCmd* cmd, uint32_t* dynamicOffsets, size_t count) {
+        std::string result = "SetBindGroup";
+        for (size_t i = 0; i < count; ++i) {
+            result += " " + std::to_string(dynamicOffsets[i]);
+        }
+        visited.push_back(result);
+    }
+    void operator()(PushDebugGroupCmd* cmd, char* label, size_t count) {
+        visited.push_back("PushDebugGroup " + std::string(label, cmd->length));
+        EXPECT_EQ(count, cmd->length + 1);
+    }
+    void operator()(WriteBufferCmd* cmd, uint8_t* data, size_t count) {
+        visited.push_back("WriteBuffer " + std::to_string(count) + " " + std::to_string(data[0]));
+    }
+    template <typename T, typename... Data>
+    void operator()(T*, Data...) {
+        visited.push_back("Other");
+    }
+
+    std::vector<std::string> visited;
+};
+
+// Records one of each command used in the tests.
+CommandIterator RecordCommands() {
+    CommandAllocator allocator;
+
+    DrawCmd* draw = allocator.Allocate<DrawCmd>(Command::Draw);
+    draw->vertexCount = 3;
+
+    SetBindGroupCmd* setBindGroup = allocator.Allocate<SetBindGroupCmd>(Command::SetBindGroup);
+    setBindGroup->dynamicOffsetCount = 2;
+    uint32_t* dynamicOffsets = allocator.AllocateData<uint32_t>(2);
+    dynamicOffsets[0] = 256;
+    dynamicOffsets[1] = 512;
+
+    // SetBindGroup without dynamic offsets has no data.
+    setBindGroup = allocator.Allocate<SetBindGroupCmd>(Command::SetBindGroup);
+    setBindGroup->dynamicOffsetCount = 0;
+
+    PushDebugGroupCmd* push = allocator.Allocate<PushDebugGroupCmd>(Command::PushDebugGroup);
+    push->length = 5;
+    allocator.CopyAsNullTerminatedString("group");
+
+    WriteBufferCmd* write = allocator.Allocate<WriteBufferCmd>(Command::WriteBuffer);
+    write->size = 4;
+    memset(allocator.AllocateData<uint8_t>(4), 42, 4);
+
+    allocator.Allocate<PopDebugGroupCmd>(Command::PopDebugGroup);
+
+    return CommandIterator(std::move(allocator));
+}
+
+// Test that each command is visited with the overload for its type and its additional data.
+TEST(CommandVisitorTests, VisitsCommandsAndData) {
+    CommandIterator commands = RecordCommands();
+
+    RecordingVisitor visitor;
+    Command type;
+    while (commands.NextCommandId(&type)) {
+        VisitCommand(&commands, type, visitor);
+    }
+    EXPECT_EQ(visitor.visited, (std::vector<std::string>{
+                                   "Draw 3",
+                                   "SetBindGroup 256 512",
+                                   "SetBindGroup",
+                                   "PushDebugGroup group",
+                                   "WriteBuffer 4 42",
+                                   "Other",
+                               }));
+
+    FreeCommands(&commands);
+}
+
+// Test that SkipCommand skips the additional data of the commands.
+TEST(CommandVisitorTests, SkipCommand) {
+    CommandIterator commands = RecordCommands();
+
+    std::vector<Command> types;
+    Command type;
+    while (commands.NextCommandId(&type)) {
+        types.push_back(type);
+        SkipCommand(&commands, type);
+    }
+    EXPECT_EQ(types, (std::vector<Command>{Command::Draw, Command::SetBindGroup,
+                                           Command::SetBindGroup, Command::PushDebugGroup,
+                                           Command::WriteBuffer, Command::PopDebugGroup}));
+
+    FreeCommands(&commands);
+}
+
+// Test that VisitCommand returns the result of the visitor, and that an Overloaded set of lambdas
+// can fall back to a generic lambda for the commands it doesn't handle.
+TEST(CommandVisitorTests, ReturnsVisitorResult) {
+    CommandIterator commands = RecordCommands();
+
+    auto visitor = Overloaded{
+        [](DrawCmd*) { return std::string("Draw"); },
+        [](SetBindGroupCmd*, uint32_t*, size_t count) {
+            return "SetBindGroup " + std::to_string(count);
+        },
+        [](auto*, auto...) { return std::string("Other"); },
+    };
+    std::vector<std::string> results;
+    Command type;
+    while (commands.NextCommandId(&type)) {
+        results.push_back(VisitCommand(&commands, type, visitor));
+    }
+    EXPECT_EQ(results, (std::vector<std::string>{
+                           "Draw",
+                           "SetBindGroup 2",
+                           "SetBindGroup 0",
+                           "Other",
+                           "Other",
+                           "Other",
+                       }));
+
+    FreeCommands(&commands);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
@@ -0,0 +1,107 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/Buffer.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/DynamicUploader.h"
+#include "dawn/native/Queue.h"
+#include "dawn/tests/DawnNativeTest.h"
+
+namespace dawn::native {
+namespace {
+
+constexpr uint64_t kMiB = 1024 * 1024;
+
+class DynamicUploaderTests : public DawnNativeTest {
+  protected:
+    void Allocate(DynamicUploader* uploader, uint64_t size, ExecutionSerial serial) {
+        ResultOrError<UploadHandle> result = uploader->Allocate(size, serial, 4);
+        if (result.IsError()) {
+            AddFatalDawnFailure("uploader->Allocate", result.AcquireError().get());
+            return;
+        }
+        EXPECT_NE(result.AcquireSuccess().mappedBuffer, nullptr);
+    }
+};
+
+// Test that the peak and average usage per serial include the serial being recorded.
+TEST_F(DynamicUploaderTests, UsageStats) {
+    DeviceBase* deviceBase = FromAPI(device.Get());
+    auto deviceLock(deviceBase->GetScopedLock());
+    DynamicUploader uploader(deviceBase);
+
+    DynamicUploaderStats stats = uploader.GetStats();
+    EXPECT_EQ(stats.peakSerialUsage, 0u);
+    EXPECT_EQ(stats.averageSerialUsage, 0u);
+    EXPECT_EQ(stats.ringBufferSize, DynamicUploader::kMinRingBufferSize);
+
+    Allocate(&uploader, 1 * kMiB, ExecutionSerial(1));
+    Allocate(&uploader, 2 * kMiB, ExecutionSerial(1));
+    stats = uploader.GetStats();
+    EXPECT_EQ(stats.peakSerialUsage, 3 * kMiB);
+    EXPECT_EQ(stats.averageSerialUsage, 3 * kMiB);
+
+    Allocate(&uploader, 1 * kMiB, ExecutionSerial(2));
+    stats = uploader.GetStats();
+    EXPECT_EQ(stats.peakSerialUsage, 3 * kMiB);
+    EXPECT_EQ(stats.averageSerialUsage, 2 * kMiB);
+    // The ring buffer grew to hold two serials that use as much as the first one.
+    EXPECT_EQ(stats.ringBufferSize, 8 * kMiB);
+
+    Allocate(&uploader, 5 * kMiB, ExecutionSerial(3));
+    stats = uploader.GetStats();
+    EXPECT_EQ(stats.peakSerialUsage, 5 * kMiB);
+    EXPECT_EQ(stats.averageSerialUsage, 3 * kMiB);
+}
+
+// Test that large staging buffers go back to the pool once the GPU is done with them and that the
+// next allocation of the same size class reuses them.
+TEST_F(DynamicUploaderTests, LargeStagingBufferPoolStats) {
+    DeviceBase* deviceBase = FromAPI(device.Get());
+    auto deviceLock(deviceBase->GetScopedLock());
+    DynamicUploader uploader(deviceBase);
+    ExecutionSerial serial = deviceBase->GetQueue()->GetPendingCommandSerial();
+
+    Allocate(&uploader, 6 * kMiB, serial);
+    DynamicUploaderStats stats = uploader.GetStats();
+    EXPECT_EQ(stats.pooledStagingBufferCount, 0u);
+    EXPECT_EQ(stats.pooledStagingBufferHits, 0u);
+
+    uploader.Deallocate(serial);
+    stats = uploader.GetStats();
+    EXPECT_EQ(stats.pooledStagingBufferCount, 1u);
+    EXPECT_EQ(stats.pooledStagingBufferHits, 0u);
+
+    // 5 MiB is in the same size class as 6 MiB.
+    Allocate(&uploader, 5 * kMiB, serial);
+    stats = uploader.GetStats();
+    EXPECT_EQ(stats.pooledStagingBufferCount, 0u);
+    EXPECT_EQ(stats.pooledStagingBufferHits, 1u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
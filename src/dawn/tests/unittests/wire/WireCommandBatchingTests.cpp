@@ -0,0 +1,162 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/wire/ChunkedCommandSerializer.h"
+#include "dawn/wire/WireClient.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::InSequence;
+using testing::Return;
+using testing::StrEq;
+using testing::Truly;
+
+class WireCommandBatchingTests : public WireTest {
+  private:
+    bool UseCommandBatching() override { return true; }
+};
+
+// Test that batched commands are forwarded in order.
+TEST_F(WireCommandBatchingTests, CommandsForwardedInOrder) {
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.InsertDebugMarker("first");
+    encoder.InsertDebugMarker("second");
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    InSequence s;
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("first")));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("second")));
+    WGPUCommandBuffer apiCommands = api.GetNewCommandBuffer();
+    EXPECT_CALL(api, CommandEncoderFinish(apiEncoder, nullptr)).WillOnce(Return(apiCommands));
+
+    FlushClient();
+}
+
+// Test that batching more commands than fit in a single reservation forwards all of them.
+TEST_F(WireCommandBatchingTests, CommandsSpanningMultipleReservations) {
+    constexpr uint32_t kMarkerCount = 50000;
+    const std::string marker(64, 'm');
+
+    // The serializer flushes while the commands are recorded, so set up the expectations first.
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq(marker)))
+        .Times(kMarkerCount);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kMarkerCount; ++i) {
+        encoder.InsertDebugMarker(marker.c_str());
+    }
+
+    FlushClient();
+}
+
+// Test that a command too large for the serializer, which is sent in chunks, stays ordered with
+// respect to the batched commands around it.
+TEST_F(WireCommandBatchingTests, ChunkedCommandBetweenBatchedCommands) {
+    const std::string largeMarker(2'000'000, 'l');
+
+    InSequence s;
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("before")));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(
+                         apiEncoder, Truly([&](const char* label) {
+                             return std::string(label).size() == largeMarker.size();
+                         })));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("after")));
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.InsertDebugMarker("before");
+    encoder.InsertDebugMarker(largeMarker.c_str());
+    encoder.InsertDebugMarker("after");
+
+    FlushClient();
+}
+
+// A CommandSerializer that only supports batching, and whose reservations can be made to fail
+// like when flushing the previous commands fails.
+class ReservingCommandSerializer : public CommandSerializer {
+  public:
+    static constexpr size_t kReservationSize = 32;
+
+    size_t GetMaximumAllocationSize() const override { return kReservationSize; }
+    void* GetCmdSpace(size_t size) override {
+        ADD_FAILURE() << "Commands must be batched";
+        return nullptr;
+    }
+    bool Flush() override { return true; }
+
+    bool CanReserveCmdSpace() const override { return true; }
+    void* ReserveCmdSpace(size_t minSize, size_t* reservedSize) override {
+        if (failReservations) {
+            return nullptr;
+        }
+        *reservedSize = kReservationSize;
+        return mReservation;
+    }
+    void CommitCmdSpace(size_t size) override { committed.append(mReservation, size); }
+
+    bool failReservations = false;
+    std::string committed;
+
+  private:
+    char mReservation[kReservationSize];
+};
+
+// Test that a failure to reserve space only drops the command that needed it, and that batching
+// continues with the next reservation.
+TEST(WireCommandBatchingSerializerTests, ReservationFailureDropsOnlyOneCommand) {
+    ReservingCommandSerializer serializer;
+    ChunkedCommandSerializer chunkedSerializer(&serializer);
+    chunkedSerializer.SetBatchingEnabled(true);
+
+    const std::string a(16, 'a');
+    const std::string b(16, 'b');
+    const std::string c(16, 'c');
+    const std::string d(16, 'd');
+    chunkedSerializer.SerializeRawCommand(a.data(), a.size());
+    chunkedSerializer.SerializeRawCommand(b.data(), b.size());
+
+    // The reservation is full so the next command needs a new one.
+    serializer.failReservations = true;
+    chunkedSerializer.SerializeRawCommand(c.data(), c.size());
+    serializer.failReservations = false;
+
+    chunkedSerializer.SerializeRawCommand(d.data(), d.size());
+    ASSERT_TRUE(chunkedSerializer.Flush());
+    EXPECT_EQ(serializer.committed, a + b + d);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
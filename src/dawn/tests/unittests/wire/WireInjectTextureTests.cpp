@@ -93,6 +93,21 @@ TEST_F(WireInjectTextureTests, InjectExistingID) {
         GetWireServer()->InjectTexture(apiTexture, reservation.handle, reservation.deviceHandle));
 }
 
+// Test that injecting an id past the ones allocated so far fails when the client isn't
+// multithreaded.
+TEST_F(WireInjectTextureTests, InjectSkippedID) {
+    auto [reservation, texture] = ReserveTexture();
+
+    WGPUTexture apiTexture = api.GetNewTexture();
+    ReservedTexture skipped = reservation;
+    skipped.handle.id++;
+    ASSERT_FALSE(GetWireServer()->InjectTexture(apiTexture, skipped.handle, skipped.deviceHandle));
+
+    EXPECT_CALL(api, TextureAddRef(apiTexture));
+    ASSERT_TRUE(
+        GetWireServer()->InjectTexture(apiTexture, reservation.handle, reservation.deviceHandle));
+}
+
 // Test that injecting the same id without a destroy first fails.
 TEST_F(WireInjectTextureTests, ReuseIDAndGeneration) {
     // Do this loop multiple times since the first time, we can't test `generation - 1` since
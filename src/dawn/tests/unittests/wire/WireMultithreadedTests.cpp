@@ -0,0 +1,251 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "dawn/tests/unittests/wire/WireTest.h"
+#include "dawn/wire/ObjectHandle.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn::wire {
+namespace {
+
+using testing::_;
+using testing::AtMost;
+using testing::Invoke;
+using testing::NotNull;
+
+constexpr uint32_t kThreadCount = 8;
+
+class WireMultithreadedTests : public WireTest {
+  protected:
+    // Runs |f(threadIndex)| on kThreadCount threads concurrently.
+    template <typename F>
+    void RunOnThreads(F f) {
+        std::atomic<uint32_t> readyCount = 0;
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < kThreadCount; ++i) {
+            threads.emplace_back([&, i] {
+                // Wait for all the threads to be started to maximize the contention.
+                readyCount++;
+                while (readyCount < kThreadCount) {
+                    std::this_thread::yield();
+                }
+                f(i);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Injects a texture on the server with |handle|, as if a client thread had allocated it.
+    bool InjectTexture(ObjectHandle handle) {
+        if (!mDeviceHandle.IsValid()) {
+            wgpu::TextureDescriptor desc = {};
+            ReservedTexture reservation = GetWireClient()->ReserveTexture(
+                device.Get(), reinterpret_cast<const WGPUTextureDescriptor*>(&desc));
+            mDeviceHandle = reservation.deviceHandle;
+            GetWireClient()->ReclaimTextureReservation(reservation);
+        }
+        WGPUTexture apiTexture = api.GetNewTexture();
+        EXPECT_CALL(api, TextureAddRef(apiTexture)).Times(AtMost(1));
+        return GetWireServer()->InjectTexture(apiTexture, handle, mDeviceHandle);
+    }
+
+  private:
+    bool UseMultithreadedClient() override { return true; }
+
+    ObjectHandle mDeviceHandle;
+};
+
+// Test that the commands of each thread are forwarded in order when many threads encode
+// concurrently.
+TEST_F(WireMultithreadedTests, ConcurrentEncoding) {
+    constexpr uint32_t kMarkerCount = 500;
+
+    std::vector<wgpu::CommandBuffer> commandBuffers(kThreadCount);
+    RunOnThreads([&](uint32_t threadIndex) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t i = 0; i < kMarkerCount; ++i) {
+            std::string marker = std::to_string(threadIndex) + "-" + std::to_string(i);
+            encoder.InsertDebugMarker(marker.c_str());
+        }
+        commandBuffers[threadIndex] = encoder.Finish();
+    });
+
+    absl::flat_hash_map<WGPUCommandEncoder, std::vector<std::string>> markers;
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .Times(kThreadCount)
+        .WillRepeatedly(Invoke([&](WGPUDevice, const WGPUCommandEncoderDescriptor*) {
+            return api.GetNewCommandEncoder();
+        }));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(_, NotNull()))
+        .Times(kThreadCount * kMarkerCount)
+        .WillRepeatedly(Invoke([&](WGPUCommandEncoder encoder, const char* marker) {
+            markers[encoder].push_back(marker);
+        }));
+    EXPECT_CALL(api, CommandEncoderFinish(_, nullptr))
+        .Times(kThreadCount)
+        .WillRepeatedly(Invoke([&](WGPUCommandEncoder encoder, const WGPUCommandBufferDescriptor*) {
+            // All the markers of the encoder were forwarded before it is finished.
+            EXPECT_EQ(markers[encoder].size(), kMarkerCount);
+            return api.GetNewCommandBuffer();
+        }));
+    EXPECT_CALL(api, CommandEncoderRelease(_)).Times(kThreadCount);
+    FlushClient();
+
+    // Each encoder got the markers of a single thread, in order.
+    ASSERT_EQ(markers.size(), kThreadCount);
+    for (const auto& [_, encoderMarkers] : markers) {
+        std::string threadPrefix = encoderMarkers[0].substr(0, encoderMarkers[0].find('-') + 1);
+        for (uint32_t i = 0; i < kMarkerCount; ++i) {
+            EXPECT_EQ(encoderMarkers[i], threadPrefix + std::to_string(i));
+        }
+    }
+}
+
+// Test that objects created and released concurrently by many threads get unique handles, which
+// the server would reject otherwise.
+TEST_F(WireMultithreadedTests, ConcurrentCreationAndRelease) {
+    constexpr uint32_t kIterations = 1000;
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .Times(kThreadCount * kIterations)
+        .WillRepeatedly(Invoke([&](WGPUDevice, const WGPUCommandEncoderDescriptor*) {
+            return api.GetNewCommandEncoder();
+        }));
+    EXPECT_CALL(api, CommandEncoderRelease(_)).Times(kThreadCount * kIterations / 2);
+
+    std::vector<std::vector<wgpu::CommandEncoder>> kept(kThreadCount);
+    RunOnThreads([&](uint32_t threadIndex) {
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            // Keep half of the encoders alive and release the other half so that handles get
+            // recycled while new ones are reserved.
+            if (i % 2 == 0) {
+                kept[threadIndex].push_back(std::move(encoder));
+            }
+        }
+    });
+    FlushClient();
+}
+
+// Test that commands are forwarded in the order they were serialized across threads, such that
+// an object created by one thread can be used by another one.
+TEST_F(WireMultithreadedTests, CrossThreadDependencies) {
+    constexpr uint32_t kIterations = 200;
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .Times(kIterations)
+        .WillRepeatedly(Invoke([&](WGPUDevice, const WGPUCommandEncoderDescriptor*) {
+            return api.GetNewCommandEncoder();
+        }));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(_, NotNull())).Times(kIterations);
+
+    std::vector<wgpu::CommandEncoder> encoders;
+    for (uint32_t i = 0; i < kIterations; ++i) {
+        std::promise<wgpu::CommandEncoder> created;
+        std::thread producer([&] { created.set_value(device.CreateCommandEncoder()); });
+        std::thread consumer([&] {
+            wgpu::CommandEncoder encoder = created.get_future().get();
+            encoder.InsertDebugMarker("marker");
+            encoders.push_back(std::move(encoder));
+        });
+        producer.join();
+        consumer.join();
+    }
+    FlushClient();
+}
+
+// Test that objects can be created from many more threads than the client reserves blocks of IDs
+// for.
+TEST_F(WireMultithreadedTests, ManyThreads) {
+    constexpr uint32_t kManyThreadCount = 300;
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .Times(kManyThreadCount)
+        .WillRepeatedly(Invoke([&](WGPUDevice, const WGPUCommandEncoderDescriptor*) {
+            return api.GetNewCommandEncoder();
+        }));
+
+    std::vector<wgpu::CommandEncoder> encoders(kManyThreadCount);
+    for (uint32_t i = 0; i < kManyThreadCount; ++i) {
+        std::thread([&, i] { encoders[i] = device.CreateCommandEncoder(); }).join();
+    }
+    FlushClient();
+}
+
+// Test that the server lets IDs skipped by other threads be allocated later, but only once and with
+// the initial generation.
+TEST_F(WireMultithreadedTests, SkippedIdsAllocatedLater) {
+    ASSERT_TRUE(InjectTexture({10, 0}));
+
+    // Skipped IDs never had an object, so they must use the initial generation.
+    ASSERT_FALSE(InjectTexture({5, 1}));
+    ASSERT_TRUE(InjectTexture({5, 0}));
+    ASSERT_FALSE(InjectTexture({5, 0}));
+    ASSERT_TRUE(InjectTexture({1, 0}));
+    ASSERT_TRUE(InjectTexture({11, 0}));
+
+    // IDs skipped by an ID further away must use the initial generation too.
+    ASSERT_FALSE(InjectTexture({20, 1}));
+    ASSERT_TRUE(InjectTexture({20, 0}));
+}
+
+// Test that the server rejects IDs too far past the IDs allocated so far.
+TEST_F(WireMultithreadedTests, SkippedIdsGapIsBounded) {
+    ASSERT_FALSE(InjectTexture({kMaxObjectIdGap + 1, 0}));
+    ASSERT_TRUE(InjectTexture({kMaxObjectIdGap, 0}));
+}
+
+// Test that the server bounds the number of skipped IDs waiting to be allocated.
+TEST_F(WireMultithreadedTests, SkippedIdsCountIsBounded) {
+    // Skip IDs 1 to kMaxObjectIdGap - 1, then one ID at a time until the limit is reached.
+    ObjectId id = kMaxObjectIdGap;
+    ASSERT_TRUE(InjectTexture({id, 0}));
+    for (uint32_t unused = kMaxObjectIdGap - 1; unused < kMaxUnusedObjectIds; ++unused) {
+        id += 2;
+        ASSERT_TRUE(InjectTexture({id, 0}));
+    }
+    ASSERT_FALSE(InjectTexture({id + 2, 0}));
+
+    // Allocating a skipped ID lets another one be skipped.
+    ASSERT_TRUE(InjectTexture({1, 0}));
+    ASSERT_TRUE(InjectTexture({id + 2, 0}));
+    ASSERT_FALSE(InjectTexture({id + 4, 0}));
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
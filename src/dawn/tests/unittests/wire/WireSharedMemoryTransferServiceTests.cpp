@@ -0,0 +1,279 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/common/Platform.h"
+#include "dawn/wire/SharedMemory.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+#include "gtest/gtest.h"
+
+#if DAWN_PLATFORM_IS(LINUX_DESKTOP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace dawn::wire {
+namespace {
+
+using ClientReadHandle = client::MemoryTransferService::ReadHandle;
+using ClientWriteHandle = client::MemoryTransferService::WriteHandle;
+using ServerReadHandle = server::MemoryTransferService::ReadHandle;
+using ServerWriteHandle = server::MemoryTransferService::WriteHandle;
+
+constexpr size_t kBufferSize = 64 * 1024;
+
+class WireSharedMemoryTransferServiceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        // The file descriptors of the regions go through a socket pair, like they would between
+        // two processes.
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, mSockets), 0);
+        mHandleSender = client::CreateSocketSharedMemoryHandleSender(mSockets[0]);
+        mHandleReceiver = server::CreateSocketSharedMemoryHandleReceiver(mSockets[1]);
+        ASSERT_NE(mHandleSender, nullptr);
+        ASSERT_NE(mHandleReceiver, nullptr);
+
+        mClientService = client::CreateSharedMemoryTransferService(mHandleSender.get());
+        mServerService = server::CreateSharedMemoryTransferService(mHandleReceiver.get());
+        ASSERT_NE(mClientService, nullptr);
+        ASSERT_NE(mServerService, nullptr);
+    }
+
+    void TearDown() override {
+        mServerService = nullptr;
+        mClientService = nullptr;
+        mHandleReceiver = nullptr;
+        mHandleSender = nullptr;
+        close(mSockets[0]);
+        close(mSockets[1]);
+    }
+
+    std::vector<char> SerializeCreate(ClientReadHandle* handle) {
+        std::vector<char> createInfo(handle->SerializeCreateSize());
+        handle->SerializeCreate(createInfo.data());
+        return createInfo;
+    }
+    std::vector<char> SerializeCreate(ClientWriteHandle* handle) {
+        std::vector<char> createInfo(handle->SerializeCreateSize());
+        handle->SerializeCreate(createInfo.data());
+        return createInfo;
+    }
+
+    // Creates a client write handle and its server counterpart targeting |target|.
+    void CreateWriteHandles(std::vector<uint8_t>* target,
+                            std::unique_ptr<ClientWriteHandle>* clientHandle,
+                            std::unique_ptr<ServerWriteHandle>* serverHandle) {
+        clientHandle->reset(mClientService->CreateWriteHandle(target->size()));
+        ASSERT_NE(*clientHandle, nullptr);
+        std::vector<char> createInfo = SerializeCreate(clientHandle->get());
+
+        ServerWriteHandle* handle = nullptr;
+        ASSERT_TRUE(
+            mServerService->DeserializeWriteHandle(createInfo.data(), createInfo.size(), &handle));
+        serverHandle->reset(handle);
+        handle->SetTarget(target->data());
+        handle->SetDataLength(target->size());
+    }
+
+    // Serializes the data update of |clientHandle| for the range and deserializes it with
+    // |serverHandle|.
+    bool Flush(ClientWriteHandle* clientHandle,
+               ServerWriteHandle* serverHandle,
+               size_t offset,
+               size_t size) {
+        std::vector<char> update(clientHandle->SizeOfSerializeDataUpdate(offset, size));
+        clientHandle->SerializeDataUpdate(update.data(), offset, size);
+        return serverHandle->DeserializeDataUpdate(update.data(), update.size(), offset, size);
+    }
+
+    int mSockets[2] = {-1, -1};
+    std::unique_ptr<client::SharedMemoryHandleSender> mHandleSender;
+    std::unique_ptr<server::SharedMemoryHandleReceiver> mHandleReceiver;
+    std::unique_ptr<client::MemoryTransferService> mClientService;
+    std::unique_ptr<server::MemoryTransferService> mServerService;
+};
+
+// Test that write handles are zero-initialized and only flush the ranges returned by
+// GetMappedRange.
+TEST_F(WireSharedMemoryTransferServiceTests, WriteOnlyFlushesMappedRanges) {
+    std::vector<uint8_t> target(kBufferSize, 0xAA);
+    std::unique_ptr<ClientWriteHandle> clientHandle;
+    std::unique_ptr<ServerWriteHandle> serverHandle;
+    CreateWriteHandles(&target, &clientHandle, &serverHandle);
+
+    uint8_t* data = static_cast<uint8_t*>(clientHandle->GetData());
+    for (size_t i = 0; i < kBufferSize; ++i) {
+        ASSERT_EQ(data[i], 0u);
+    }
+
+    // Two adjacent ranges that are merged, and a disjoint one.
+    memset(data + 256, 1, 128);
+    clientHandle->OnGetMappedRange(256, 128);
+    memset(data + 384, 2, 128);
+    clientHandle->OnGetMappedRange(384, 128);
+    memset(data + 4096, 3, 64);
+    clientHandle->OnGetMappedRange(4096, 64);
+    // Not reported as written so it isn't transferred.
+    memset(data + 8192, 4, 64);
+
+    EXPECT_EQ(clientHandle->SizeOfSerializeDataUpdate(0, kBufferSize),
+              2 * sizeof(SharedMemoryDirtyRange));
+    ASSERT_TRUE(Flush(clientHandle.get(), serverHandle.get(), 0, kBufferSize));
+
+    for (size_t i = 0; i < kBufferSize; ++i) {
+        uint8_t expected = 0xAA;
+        if (i >= 256 && i < 384) {
+            expected = 1;
+        } else if (i >= 384 && i < 512) {
+            expected = 2;
+        } else if (i >= 4096 && i < 4160) {
+            expected = 3;
+        }
+        ASSERT_EQ(target[i], expected) << "at offset " << i;
+    }
+
+    // The written ranges are reset after each data update.
+    EXPECT_EQ(clientHandle->SizeOfSerializeDataUpdate(0, kBufferSize), 0u);
+}
+
+// Test that the written ranges are clamped to the flushed range.
+TEST_F(WireSharedMemoryTransferServiceTests, WriteClampsToFlushedRange) {
+    std::vector<uint8_t> target(kBufferSize, 0);
+    std::unique_ptr<ClientWriteHandle> clientHandle;
+    std::unique_ptr<ServerWriteHandle> serverHandle;
+    CreateWriteHandles(&target, &clientHandle, &serverHandle);
+
+    uint8_t* data = static_cast<uint8_t*>(clientHandle->GetData());
+    memset(data, 1, kBufferSize);
+    clientHandle->OnGetMappedRange(0, kBufferSize);
+
+    ASSERT_TRUE(Flush(clientHandle.get(), serverHandle.get(), 1024, 1024));
+    for (size_t i = 0; i < kBufferSize; ++i) {
+        ASSERT_EQ(target[i], (i >= 1024 && i < 2048) ? 1u : 0u) << "at offset " << i;
+    }
+}
+
+// Test that a data update with ranges outside of the flushed range is rejected.
+TEST_F(WireSharedMemoryTransferServiceTests, WriteRejectsOutOfBoundsRanges) {
+    std::vector<uint8_t> target(kBufferSize, 0);
+    std::unique_ptr<ClientWriteHandle> clientHandle;
+    std::unique_ptr<ServerWriteHandle> serverHandle;
+    CreateWriteHandles(&target, &clientHandle, &serverHandle);
+
+    SharedMemoryDirtyRange range = {kBufferSize - 4, 8};
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(&range, sizeof(range), 0, kBufferSize));
+
+    range = {0, 8};
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(&range, sizeof(range), 8, 8));
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(&range, sizeof(range) - 1, 0, 8));
+    EXPECT_TRUE(serverHandle->DeserializeDataUpdate(&range, sizeof(range), 0, 8));
+}
+
+// Test that the server writes read data directly in the shared memory.
+TEST_F(WireSharedMemoryTransferServiceTests, Read) {
+    std::unique_ptr<ClientReadHandle> clientHandle(mClientService->CreateReadHandle(kBufferSize));
+    ASSERT_NE(clientHandle, nullptr);
+    std::vector<char> createInfo = SerializeCreate(clientHandle.get());
+
+    ServerReadHandle* handle = nullptr;
+    ASSERT_TRUE(
+        mServerService->DeserializeReadHandle(createInfo.data(), createInfo.size(), &handle));
+    std::unique_ptr<ServerReadHandle> serverHandle(handle);
+
+    std::vector<uint8_t> mapped(kBufferSize / 2, 7);
+    EXPECT_EQ(serverHandle->SizeOfSerializeDataUpdate(kBufferSize / 2, kBufferSize / 2), 0u);
+    serverHandle->SerializeDataUpdate(mapped.data(), kBufferSize / 2, kBufferSize / 2, nullptr);
+    ASSERT_TRUE(clientHandle->DeserializeDataUpdate(nullptr, 0, kBufferSize / 2, kBufferSize / 2));
+
+    const uint8_t* data = static_cast<const uint8_t*>(clientHandle->GetData());
+    EXPECT_EQ(data[0], 0u);
+    EXPECT_EQ(data[kBufferSize / 2], 7u);
+    EXPECT_EQ(data[kBufferSize - 1], 7u);
+
+    EXPECT_FALSE(clientHandle->DeserializeDataUpdate(nullptr, 0, kBufferSize, 1));
+}
+
+// Test that the file descriptor of a region can only be used once.
+TEST_F(WireSharedMemoryTransferServiceTests, RegionOpenedOnce) {
+    std::unique_ptr<ClientReadHandle> clientHandle(mClientService->CreateReadHandle(kBufferSize));
+    ASSERT_NE(clientHandle, nullptr);
+    std::vector<char> createInfo = SerializeCreate(clientHandle.get());
+
+    ServerReadHandle* handle = nullptr;
+    ASSERT_TRUE(
+        mServerService->DeserializeReadHandle(createInfo.data(), createInfo.size(), &handle));
+    delete handle;
+    EXPECT_FALSE(
+        mServerService->DeserializeReadHandle(createInfo.data(), createInfo.size(), &handle));
+}
+
+// Test that invalid region descriptors are rejected.
+TEST_F(WireSharedMemoryTransferServiceTests, InvalidCreateInfo) {
+    ServerReadHandle* handle = nullptr;
+
+    // Only file descriptors sent by the client can be used.
+    SharedMemoryRegionInfo info = {kBufferSize, 1234};
+    EXPECT_FALSE(mServerService->DeserializeReadHandle(&info, sizeof(info), &handle));
+
+    // The create info must have the exact size of the descriptor.
+    std::unique_ptr<ClientReadHandle> clientHandle(mClientService->CreateReadHandle(kBufferSize));
+    ASSERT_NE(clientHandle, nullptr);
+    std::vector<char> createInfo = SerializeCreate(clientHandle.get());
+    EXPECT_FALSE(
+        mServerService->DeserializeReadHandle(createInfo.data(), createInfo.size() - 1, &handle));
+
+    // The region must be at least as large as described.
+    memcpy(&info, createInfo.data(), sizeof(info));
+    info.size = kBufferSize * 2;
+    EXPECT_FALSE(mServerService->DeserializeReadHandle(&info, sizeof(info), &handle));
+}
+
+// Test that regions that are not sealed against resizing are rejected, since the client could
+// shrink them while the server accesses them.
+TEST_F(WireSharedMemoryTransferServiceTests, UnsealedRegionIsRejected) {
+    int fd = memfd_create("unsealed", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, kBufferSize), 0);
+    // Sealing only against growing is not enough.
+    ASSERT_EQ(fcntl(fd, F_ADD_SEALS, F_SEAL_GROW), 0);
+    ASSERT_TRUE(SendSharedMemoryHandle(mSockets[0], 1234, fd));
+    close(fd);
+
+    ServerReadHandle* handle = nullptr;
+    SharedMemoryRegionInfo info = {kBufferSize, 1234};
+    EXPECT_FALSE(mServerService->DeserializeReadHandle(&info, sizeof(info), &handle));
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
+
+#endif  // DAWN_PLATFORM_IS(LINUX_DESKTOP)
@@ -57,6 +57,14 @@ dawn::wire::server::MemoryTransferService* WireTest::GetServerMemoryTransferServ
     return nullptr;
 }
 
+bool WireTest::UseCommandBatching() {
+    return false;
+}
+
+bool WireTest::UseMultithreadedClient() {
+    return false;
+}
+
 void WireTest::SetUp() {
     DawnProcTable mockProcs;
     api.GetProcTable(&mockProcs);
@@ -69,6 +77,7 @@ void WireTest::SetUp() {
     serverDesc.procs = &mockProcs;
     serverDesc.serializer = mS2cBuf.get();
     serverDesc.memoryTransferService = GetServerMemoryTransferService();
+    serverDesc.multithreadedClient = UseMultithreadedClient();
 
     mWireServer.reset(new dawn::wire::WireServer(serverDesc));
     mC2sBuf->SetHandler(mWireServer.get());
@@ -76,6 +85,8 @@ void WireTest::SetUp() {
     dawn::wire::WireClientDescriptor clientDesc = {};
     clientDesc.serializer = mC2sBuf.get();
     clientDesc.memoryTransferService = GetClientMemoryTransferService();
+    clientDesc.batchCommands = UseCommandBatching();
+    clientDesc.multithreaded = UseMultithreadedClient();
 
     mWireClient.reset(new dawn::wire::WireClient(clientDesc));
     mS2cBuf->SetHandler(mWireClient.get());
@@ -221,7 +232,10 @@ void WireTest::DefaultApiAdapterWasReleased() {
 }
 
 void WireTest::FlushClient(bool success) {
-    ASSERT_EQ(mC2sBuf->Flush(), success);
+    // Batched commands and the commands of each thread are only visible to the serializer once
+    // the client commits them.
+    bool clientFlush = UseCommandBatching() || UseMultithreadedClient();
+    ASSERT_EQ(clientFlush ? mWireClient->Flush() : mC2sBuf->Flush(), success);
 
     Mock::VerifyAndClearExpectations(&api);
     SetupIgnoredCallExpectations();
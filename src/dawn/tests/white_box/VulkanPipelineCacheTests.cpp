@@ -0,0 +1,134 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <memory>
+#include <string>
+
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/PipelineCacheVk.h"
+#include "dawn/tests/DawnTest.h"
+#include "dawn/tests/mocks/platform/CachingInterfaceMock.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+using ::testing::NiceMock;
+
+class VulkanMergedPipelineCacheTests : public DawnTest {
+  protected:
+    std::unique_ptr<platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnCachingMockPlatform>(&mMockCache);
+    }
+
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+
+    PipelineCache::MergedStats GetMergedStats(const wgpu::Device& device) {
+        PipelineCache* cache = ToBackend(FromAPI(device.Get()))->GetMergedPipelineCache();
+        EXPECT_NE(cache, nullptr);
+        return cache->GetMergedStats();
+    }
+
+    // Creates a compute pipeline that is different for each workgroup size.
+    void CreatePipeline(const wgpu::Device& device, uint32_t workgroupSize) {
+        wgpu::ComputePipelineDescriptor desc;
+        desc.compute.entryPoint = "main";
+        desc.compute.module = utils::CreateShaderModule(
+            device,
+            ("@compute @workgroup_size(" + std::to_string(workgroupSize) + ") fn main() {}")
+                .c_str());
+        device.CreateComputePipeline(&desc);
+    }
+
+    // The device is only ticked when it has work in flight, so submit some before ticking it to
+    // flush the merged cache.
+    void SubmitAndTick(const wgpu::Device& device) {
+        wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+        device.GetQueue().Submit(1, &commands);
+        device.Tick();
+    }
+
+    NiceMock<CachingInterfaceMock> mMockCache;
+};
+
+// Tests that all the pipelines of a device use the same cache, which is only written back when
+// pipelines were added to it.
+TEST_P(VulkanMergedPipelineCacheTests, PipelinesShareTheCache) {
+    wgpu::Device device = CreateDevice();
+    EXPECT_FALSE(GetMergedStats(device).loadHit);
+
+    CreatePipeline(device, 1);
+    CreatePipeline(device, 2);
+    EXPECT_EQ(GetMergedStats(device).pipelineCount, 2u);
+    EXPECT_EQ(GetMergedStats(device).flushCount, 0u);
+
+    SubmitAndTick(device);
+    EXPECT_EQ(GetMergedStats(device).flushCount, 1u);
+    EXPECT_EQ(GetMergedStats(device).mergeCount, 0u);
+
+    // Nothing new to write back.
+    SubmitAndTick(device);
+    EXPECT_EQ(GetMergedStats(device).flushCount, 1u);
+}
+
+// Tests that data stored by another device since the cache was loaded is merged in when the cache
+// is written back, and that later devices start from the merged data.
+TEST_P(VulkanMergedPipelineCacheTests, MergesDataStoredByOtherDevices) {
+    wgpu::Device deviceA = CreateDevice();
+    wgpu::Device deviceB = CreateDevice();
+
+    CreatePipeline(deviceA, 1);
+    SubmitAndTick(deviceA);
+    EXPECT_EQ(GetMergedStats(deviceA).flushCount, 1u);
+    EXPECT_EQ(GetMergedStats(deviceA).mergeCount, 0u);
+
+    // deviceB loaded its cache before deviceA stored its data, so it has to merge it.
+    CreatePipeline(deviceB, 2);
+    SubmitAndTick(deviceB);
+    EXPECT_EQ(GetMergedStats(deviceB).flushCount, 1u);
+    EXPECT_EQ(GetMergedStats(deviceB).mergeCount, 1u);
+
+    // deviceB's data is now stored, so writing it back again doesn't need a merge.
+    CreatePipeline(deviceB, 3);
+    SubmitAndTick(deviceB);
+    EXPECT_EQ(GetMergedStats(deviceB).mergeCount, 1u);
+
+    wgpu::Device deviceC = CreateDevice();
+    EXPECT_TRUE(GetMergedStats(deviceC).loadHit);
+    CreatePipeline(deviceC, 1);
+    CreatePipeline(deviceC, 2);
+    EXPECT_EQ(GetMergedStats(deviceC).pipelineCount, 2u);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanMergedPipelineCacheTests,
+                      VulkanBackend({"vulkan_merge_pipeline_caches"}));
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
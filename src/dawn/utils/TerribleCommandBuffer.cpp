@@ -61,6 +61,25 @@ void* TerribleCommandBuffer::GetCmdSpace(size_t size) {
     return result;
 }
 
+bool TerribleCommandBuffer::CanReserveCmdSpace() const {
+    return true;
+}
+
+void* TerribleCommandBuffer::ReserveCmdSpace(size_t minSize, size_t* reservedSize) {
+    // Make sure |minSize| bytes are available, then hand out the rest of the buffer.
+    if (GetCmdSpace(minSize) == nullptr) {
+        return nullptr;
+    }
+    mOffset -= minSize;
+    *reservedSize = sizeof(mBuffer) - mOffset;
+    return &mBuffer[mOffset];
+}
+
+void TerribleCommandBuffer::CommitCmdSpace(size_t size) {
+    DAWN_ASSERT(size <= sizeof(mBuffer) - mOffset);
+    mOffset += size;
+}
+
 bool TerribleCommandBuffer::Flush() {
     bool success = mHandler->HandleCommands(mBuffer, mOffset) != nullptr;
     mOffset = 0;
@@ -44,6 +44,9 @@ class TerribleCommandBuffer : public dawn::wire::CommandSerializer {
 
     void* GetCmdSpace(size_t size) override;
     bool Flush() override;
+    bool CanReserveCmdSpace() const override;
+    void* ReserveCmdSpace(size_t minSize, size_t* reservedSize) override;
+    void CommitCmdSpace(size_t size) override;
     bool Empty();
 
   private:
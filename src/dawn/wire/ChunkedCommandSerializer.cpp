@@ -27,13 +27,71 @@
 
 #include "dawn/wire/ChunkedCommandSerializer.h"
 
+#include "dawn/common/Assert.h"
+
 namespace dawn::wire {
 
 ChunkedCommandSerializer::ChunkedCommandSerializer(CommandSerializer* serializer)
     : mSerializer(serializer), mMaxAllocationSize(serializer->GetMaximumAllocationSize()) {}
 
+void ChunkedCommandSerializer::SerializeRawCommand(const char* command, size_t size) {
+    if (size > mMaxAllocationSize) {
+        SerializeChunkedCommand(command, size);
+        return;
+    }
+    char* dst = GetCmdSpace(size);
+    if (dst != nullptr) {
+        memcpy(dst, command, size);
+    }
+}
+
+void ChunkedCommandSerializer::SetBatchingEnabled(bool enabled) {
+    if (!enabled) {
+        CommitBatch();
+    }
+    mBatchingEnabled = enabled && mSerializer->CanReserveCmdSpace();
+}
+
+void ChunkedCommandSerializer::CommitBatch() {
+    if (mBatchCursor == nullptr) {
+        return;
+    }
+    mSerializer->CommitCmdSpace(mBatchUsedSize);
+    mBatchCursor = nullptr;
+    mBatchRemainingSize = 0;
+    mBatchUsedSize = 0;
+}
+
+bool ChunkedCommandSerializer::Flush() {
+    CommitBatch();
+    return mSerializer->Flush();
+}
+
+char* ChunkedCommandSerializer::ReserveBatchSpace(size_t size) {
+    DAWN_ASSERT(mBatchingEnabled);
+    // The space left in the current reservation is too small. Commit it and reserve new space,
+    // which may cause the CommandSerializer to flush the committed commands.
+    CommitBatch();
+
+    size_t reservedSize = 0;
+    char* space = static_cast<char*>(mSerializer->ReserveCmdSpace(size, &reservedSize));
+    if (space == nullptr) {
+        // Only this command is lost, the next one tries to reserve space again.
+        return nullptr;
+    }
+    DAWN_ASSERT(reservedSize >= size);
+
+    mBatchCursor = space + size;
+    mBatchRemainingSize = reservedSize - size;
+    mBatchUsedSize = size;
+    return space;
+}
+
 void ChunkedCommandSerializer::SerializeChunkedCommand(const char* allocatedBuffer,
                                                        size_t remainingSize) {
+    // Chunks are allocated directly from the CommandSerializer, after the batched commands.
+    CommitBatch();
+
     while (remainingSize > 0) {
         size_t chunkSize = std::min(remainingSize, mMaxAllocationSize);
         void* dst = mSerializer->GetCmdSpace(chunkSize);
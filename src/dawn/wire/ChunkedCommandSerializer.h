@@ -106,7 +106,37 @@ class ChunkedCommandSerializer {
             std::forward<Extensions>(extensions)...);
     }
 
+    // Serializes a command that was already serialized elsewhere, splitting it in chunks if it is
+    // too large for the CommandSerializer.
+    void SerializeRawCommand(const char* command, size_t size);
+
+    // Enables packing the commands in space reserved once with CommandSerializer::ReserveCmdSpace
+    // instead of calling CommandSerializer::GetCmdSpace for each of them. Batched commands are
+    // only visible to the CommandSerializer after CommitBatch() or Flush(). Has no effect if the
+    // CommandSerializer does not support reserving space.
+    void SetBatchingEnabled(bool enabled);
+    void CommitBatch();
+    // Commits the current batch, if any, and flushes the CommandSerializer.
+    bool Flush();
+
   private:
+    // Returns space for |size| bytes of commands, using a bump pointer in the reserved space
+    // when batching.
+    char* GetCmdSpace(size_t size) {
+        if (mBatchingEnabled) {
+            if (DAWN_LIKELY(size <= mBatchRemainingSize)) {
+                char* space = mBatchCursor.get();
+                mBatchCursor += size;
+                mBatchRemainingSize -= size;
+                mBatchUsedSize += size;
+                return space;
+            }
+            return ReserveBatchSpace(size);
+        }
+        return static_cast<char*>(mSerializer->GetCmdSpace(size));
+    }
+    char* ReserveBatchSpace(size_t size);
+
     template <typename Cmd, typename SerializeCmdFn, typename... Extensions>
     void SerializeCommandImpl(const Cmd& cmd,
                               SerializeCmdFn&& SerializeCmd,
@@ -115,7 +145,7 @@ class ChunkedCommandSerializer {
         size_t requiredSize = (Align(extensions.size, kWireBufferAlignment) + ... + commandSize);
 
         if (requiredSize <= mMaxAllocationSize) {
-            char* allocatedBuffer = static_cast<char*>(mSerializer->GetCmdSpace(requiredSize));
+            char* allocatedBuffer = GetCmdSpace(requiredSize);
             if (allocatedBuffer != nullptr) {
                 SerializeBuffer serializeBuffer(allocatedBuffer, requiredSize);
                 WireResult rCmd = SerializeCmd(cmd, requiredSize, &serializeBuffer);
@@ -146,6 +176,11 @@ class ChunkedCommandSerializer {
 
     raw_ptr<CommandSerializer> mSerializer;
     size_t mMaxAllocationSize;
+
+    bool mBatchingEnabled = false;
+    raw_ptr<char, AllowPtrArithmetic> mBatchCursor = nullptr;
+    size_t mBatchRemainingSize = 0;
+    size_t mBatchUsedSize = 0;
 };
 
 }  // namespace dawn::wire
@@ -39,6 +39,13 @@ namespace dawn::wire {
 using ObjectId = uint32_t;
 using ObjectGeneration = uint32_t;
 
+// Multithreaded clients reserve IDs in blocks for each thread, so new IDs can be allocated out of
+// order. This is how far past the IDs allocated so far a new ID is allowed to be, and how many of
+// the IDs skipped this way can be waiting to be allocated for each object type. Servers only
+// accept out of order IDs from clients that were created as multithreaded.
+static constexpr ObjectId kMaxObjectIdGap = 1 << 14;
+static constexpr ObjectId kMaxUnusedObjectIds = 1 << 14;
+
 // ObjectHandle identifies some WebGPU object in the wire.
 // An ObjectHandle will never be reused, so can be used to uniquely identify an object forever.
 struct ObjectHandle : public Handle {
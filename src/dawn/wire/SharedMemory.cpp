@@ -0,0 +1,230 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/SharedMemory.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(LINUX_DESKTOP)
+#define DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY 1
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY 0
+#endif
+
+namespace dawn::wire {
+
+namespace {
+
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+// Seals that every region must have. Without them, the other process could shrink the region
+// after it is mapped and make accesses to the mapping fault.
+constexpr int kRequiredSeals = F_SEAL_SHRINK | F_SEAL_GROW;
+
+void* MapRegion(int fd, size_t mappedSize) {
+    void* data = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return data == MAP_FAILED ? nullptr : data;
+}
+#endif  // DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+
+}  // anonymous namespace
+
+// static
+bool SharedMemoryRegion::IsSupported() {
+    return DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY;
+}
+
+// static
+std::unique_ptr<SharedMemoryRegion> SharedMemoryRegion::Create(size_t size) {
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+    // Zero-sized mappings are not allowed, so always map at least one byte.
+    size_t mappedSize = size > 0 ? size : 1;
+
+    int fd = memfd_create("dawn-wire", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return nullptr;
+    }
+    void* data = nullptr;
+    if (ftruncate(fd, static_cast<off_t>(mappedSize)) == 0 &&
+        fcntl(fd, F_ADD_SEALS, kRequiredSeals | F_SEAL_SEAL) == 0) {
+        data = MapRegion(fd, mappedSize);
+    }
+    if (data == nullptr) {
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryRegion>(new SharedMemoryRegion(data, size, mappedSize, fd));
+#else
+    return nullptr;
+#endif
+}
+
+// static
+std::unique_ptr<SharedMemoryRegion> SharedMemoryRegion::Open(int fd, uint64_t size) {
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+    if (fd < 0) {
+        return nullptr;
+    }
+    void* data = nullptr;
+    size_t mappedSize = 0;
+    if (size <= std::numeric_limits<size_t>::max()) {
+        mappedSize = size > 0 ? static_cast<size_t>(size) : 1;
+
+        // The size is only checked once the seals guarantee that it can't change anymore.
+        int seals = fcntl(fd, F_GET_SEALS);
+        struct stat stats;
+        if (seals >= 0 && (seals & kRequiredSeals) == kRequiredSeals && fstat(fd, &stats) == 0 &&
+            stats.st_size >= 0 && static_cast<uint64_t>(stats.st_size) >= mappedSize) {
+            data = MapRegion(fd, mappedSize);
+        }
+    }
+    close(fd);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryRegion>(
+        new SharedMemoryRegion(data, static_cast<size_t>(size), mappedSize, -1));
+#else
+    return nullptr;
+#endif
+}
+
+SharedMemoryRegion::SharedMemoryRegion(void* data, size_t size, size_t mappedSize, int fd)
+    : mData(data), mSize(size), mMappedSize(mappedSize), mFd(fd) {}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+    void* data = mData.get();
+    mData = nullptr;
+    munmap(data, mMappedSize);
+    CloseFd();
+#endif
+}
+
+void SharedMemoryRegion::CloseFd() {
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+    if (mFd >= 0) {
+        close(mFd);
+        mFd = -1;
+    }
+#endif
+}
+
+bool SendSharedMemoryHandle(int socketFd, uint64_t id, int fd) {
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+    struct iovec iov = {&id, sizeof(id)};
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+    struct msghdr message = {};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(header), &fd, sizeof(int));
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(socketFd, &message, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent == static_cast<ssize_t>(sizeof(id));
+#else
+    return false;
+#endif
+}
+
+bool ReceiveSharedMemoryHandle(int socketFd, uint64_t* id, int* fd) {
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+    struct iovec iov = {id, sizeof(*id)};
+    // Leave room for more descriptors than expected so that extra ones are received, and closed,
+    // instead of being discarded while still open.
+    alignas(struct cmsghdr) char control[CMSG_SPACE(4 * sizeof(int))] = {};
+
+    struct msghdr message = {};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        received = recvmsg(socketFd, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+    if (received <= 0) {
+        return false;
+    }
+
+    std::vector<int> fds;
+    for (struct cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr;
+         header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; ++i) {
+            int receivedFd;
+            memcpy(&receivedFd, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+            fds.push_back(receivedFd);
+        }
+    }
+
+    *fd = -1;
+    bool valid = received == static_cast<ssize_t>(sizeof(*id)) &&
+                 (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) == 0 && fds.size() == 1;
+    if (valid) {
+        *fd = fds[0];
+    } else {
+        for (int receivedFd : fds) {
+            close(receivedFd);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CloseSharedMemoryHandle(int fd) {
+#if DAWN_WIRE_HAS_MEMFD_SHARED_MEMORY
+    close(fd);
+#endif
+}
+
+}  // namespace dawn::wire
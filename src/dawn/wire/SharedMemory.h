@@ -0,0 +1,101 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_SHAREDMEMORY_H_
+#define SRC_DAWN_WIRE_SHAREDMEMORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire {
+
+// Descriptor of a shared memory region serialized by the shared memory MemoryTransferService
+// when creating a Read/WriteHandle. Only this descriptor goes through the wire: the file
+// descriptor of the region is sent out of band and the contents are accessed directly by both
+// the client and the server.
+struct SharedMemoryRegionInfo {
+    uint64_t size;
+    // Id under which the client sent the file descriptor of the region.
+    uint64_t handleId;
+};
+
+// A range of a shared memory region that was written and needs to be copied to its destination.
+struct SharedMemoryDirtyRange {
+    uint64_t offset;
+    uint64_t size;
+};
+
+// An anonymous shared memory region mapped in the current process. Regions are memfds sealed
+// against shrinking and growing, so that a mapping of one can never fault, whatever the other
+// process does with its file descriptor.
+class SharedMemoryRegion {
+  public:
+    // Returns whether shared memory regions are supported on this platform.
+    static bool IsSupported();
+
+    // Creates a new zero-initialized region. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemoryRegion> Create(size_t size);
+    // Maps the region of at least |size| bytes that another process created and sent as |fd|.
+    // Takes ownership of |fd|. Fails if the region isn't sealed against resizing or is too small.
+    // Returns nullptr on failure.
+    static std::unique_ptr<SharedMemoryRegion> Open(int fd, uint64_t size);
+
+    ~SharedMemoryRegion();
+
+    void* GetData() const { return mData; }
+    size_t GetSize() const { return mSize; }
+
+    // The file descriptor of a region created in this process, to send to the other process.
+    // It is -1 once closed.
+    int GetFd() const { return mFd; }
+    void CloseFd();
+
+  private:
+    SharedMemoryRegion(void* data, size_t size, size_t mappedSize, int fd);
+
+    raw_ptr<void> mData;
+    size_t mSize;
+    size_t mMappedSize;
+    int mFd;
+};
+
+// Sends |fd| tagged with |id| as a single message over the connected Unix domain socket
+// |socketFd|, using SCM_RIGHTS. Returns false on failure.
+bool SendSharedMemoryHandle(int socketFd, uint64_t id, int fd);
+// Receives a message sent by SendSharedMemoryHandle without blocking. Returns false if no message
+// is available. Otherwise returns true and sets |fd| to the received file descriptor, or to -1 if
+// the message was malformed.
+bool ReceiveSharedMemoryHandle(int socketFd, uint64_t* id, int* fd);
+// Closes a file descriptor received by ReceiveSharedMemoryHandle.
+void CloseSharedMemoryHandle(int fd);
+
+}  // namespace dawn::wire
+
+#endif  // SRC_DAWN_WIRE_SHAREDMEMORY_H_
@@ -34,6 +34,16 @@ CommandSerializer::~CommandSerializer() = default;
 
 void CommandSerializer::OnSerializeError() {}
 
+bool CommandSerializer::CanReserveCmdSpace() const {
+    return false;
+}
+
+void* CommandSerializer::ReserveCmdSpace(size_t minSize, size_t* reservedSize) {
+    return nullptr;
+}
+
+void CommandSerializer::CommitCmdSpace(size_t size) {}
+
 CommandHandler::CommandHandler() = default;
 CommandHandler::~CommandHandler() = default;
 
@@ -31,7 +31,13 @@
 namespace dawn::wire {
 
 WireClient::WireClient(const WireClientDescriptor& descriptor)
-    : mImpl(new client::Client(descriptor.serializer, descriptor.memoryTransferService)) {}
+    : mImpl(new client::Client(descriptor.serializer,
+                               descriptor.memoryTransferService,
+                               descriptor.multithreaded)) {
+    if (descriptor.batchCommands) {
+        mImpl->SetCommandBatchingEnabled(true);
+    }
+}
 
 WireClient::~WireClient() {
     mImpl.reset();
@@ -41,6 +47,10 @@ const volatile char* WireClient::HandleCommands(const volatile char* commands, s
     return mImpl->HandleCommands(commands, size);
 }
 
+bool WireClient::Flush() {
+    return mImpl->Flush();
+}
+
 ReservedBuffer WireClient::ReserveBuffer(WGPUDevice device,
                                          const WGPUBufferDescriptor* descriptor) {
     return mImpl->ReserveBuffer(device, descriptor);
@@ -101,6 +111,12 @@ MemoryTransferService::ReadHandle::~ReadHandle() = default;
 MemoryTransferService::WriteHandle::WriteHandle() = default;
 
 MemoryTransferService::WriteHandle::~WriteHandle() = default;
+
+void MemoryTransferService::WriteHandle::OnGetMappedRange(size_t offset, size_t size) {}
+
+SharedMemoryHandleSender::SharedMemoryHandleSender() = default;
+
+SharedMemoryHandleSender::~SharedMemoryHandleSender() = default;
 }  // namespace client
 
 }  // namespace dawn::wire
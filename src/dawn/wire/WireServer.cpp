@@ -33,7 +33,8 @@ namespace dawn::wire {
 WireServer::WireServer(const WireServerDescriptor& descriptor)
     : mImpl(server::Server::Create(*descriptor.procs,
                                    descriptor.serializer,
-                                   descriptor.memoryTransferService)) {}
+                                   descriptor.memoryTransferService,
+                                   descriptor.multithreadedClient)) {}
 
 WireServer::~WireServer() {
     mImpl.reset();
@@ -96,6 +97,10 @@ void MemoryTransferService::WriteHandle::SetTarget(void* data) {
 void MemoryTransferService::WriteHandle::SetDataLength(size_t dataLength) {
     mDataLength = dataLength;
 }
+
+SharedMemoryHandleReceiver::SharedMemoryHandleReceiver() = default;
+
+SharedMemoryHandleReceiver::~SharedMemoryHandleReceiver() = default;
 }  // namespace server
 
 }  // namespace dawn::wire
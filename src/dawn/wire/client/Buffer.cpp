@@ -621,6 +621,9 @@ void* Buffer::GetMappedRange(size_t offset, size_t size) {
     if (!IsMappedForWriting() || !CheckGetMappedRangeOffsetSize(offset, size)) {
         return nullptr;
     }
+    // Let the write handle know which ranges can be modified by the application.
+    size_t rangeSize = size == WGPU_WHOLE_MAP_SIZE ? mSize - offset : size;
+    mWriteHandle->OnGetMappedRange(offset, rangeSize);
     return static_cast<uint8_t*>(mMappedData) + offset;
 }
 
@@ -27,6 +27,8 @@
 
 #include "dawn/wire/client/Client.h"
 
+#include <vector>
+
 #include "dawn/common/Compiler.h"
 #include "dawn/wire/client/Device.h"
 
@@ -48,10 +50,21 @@ class NoopCommandSerializer final : public CommandSerializer {
     bool Flush() final { return false; }
 };
 
+std::atomic<uint64_t> gNextClientSerial = 1;
+
 }  // anonymous namespace
 
-Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
-    : ClientBase(), mSerializer(serializer), mMemoryTransferService(memoryTransferService) {
+Client::ThreadState::ThreadState(std::atomic<uint64_t>* nextCommandSerial)
+    : commands(nextCommandSerial), serializer(&commands) {}
+
+Client::Client(CommandSerializer* serializer,
+               MemoryTransferService* memoryTransferService,
+               bool multithreaded)
+    : ClientBase(),
+      mSerializer(serializer),
+      mMemoryTransferService(memoryTransferService),
+      mMultithreaded(multithreaded),
+      mClientSerial(gNextClientSerial.fetch_add(1)) {
     if (mMemoryTransferService == nullptr) {
         // If a MemoryTransferService is not provided, fall back to inline memory.
         mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -129,7 +142,10 @@ ReservedInstance Client::ReserveInstance(const WGPUInstanceDescriptor* descripto
     }
 
     // Reserve an EventManager for the given instance and make the association in the map.
-    mEventManagers.emplace(instance->GetWireHandle(), std::make_unique<EventManager>());
+    {
+        auto lock = LockObjectsIfMultithreaded();
+        mEventManagers.emplace(instance->GetWireHandle(), std::make_unique<EventManager>());
+    }
 
     ReservedInstance result;
     result.handle = instance->GetWireHandle();
@@ -158,14 +174,77 @@ void Client::ReclaimInstanceReservation(const ReservedInstance& reservation) {
 }
 
 EventManager& Client::GetEventManager(const ObjectHandle& instance) {
+    auto lock = LockObjectsIfMultithreaded();
     auto it = mEventManagers.find(instance);
     DAWN_ASSERT(it != mEventManagers.end());
     return *it->second;
 }
 
+void Client::SetCommandBatchingEnabled(bool enabled) {
+    mSerializer.SetBatchingEnabled(enabled);
+}
+
+bool Client::Flush() {
+    std::unique_lock<std::mutex> lock;
+    if (mMultithreaded) {
+        lock = std::unique_lock<std::mutex>(mThreadStatesMutex);
+        MergeThreadCommands();
+    }
+    return mSerializer.Flush();
+}
+
+Client::ThreadState* Client::GetThreadState() {
+    DAWN_ASSERT(mMultithreaded);
+
+    // Cache the state of the last client used by the thread, which is enough for applications
+    // using a single client. Client serials are never reused so the cache is never stale.
+    thread_local uint64_t tCachedClientSerial = 0;
+    thread_local ThreadState* tCachedState = nullptr;
+    if (DAWN_LIKELY(tCachedClientSerial == mClientSerial)) {
+        return tCachedState;
+    }
+
+    std::lock_guard<std::mutex> lock(mThreadStatesMutex);
+    std::unique_ptr<ThreadState>& state = mThreadStates[std::this_thread::get_id()];
+    if (state == nullptr) {
+        state = std::make_unique<ThreadState>(&mNextCommandSerial);
+    }
+    tCachedClientSerial = mClientSerial;
+    tCachedState = state.get();
+    return tCachedState;
+}
+
+void Client::MergeThreadCommands() {
+    // Swap the buffers of all the threads at once, so that every command serialized before the
+    // swap is merged now and every command serialized after it has a larger serial.
+    std::vector<ThreadCommandBuffer*> buffers;
+    std::vector<std::unique_lock<std::mutex>> locks;
+    buffers.reserve(mThreadStates.size());
+    locks.reserve(mThreadStates.size());
+    for (auto& [_, state] : mThreadStates) {
+        locks.emplace_back(state->mutex);
+        buffers.push_back(&state->commands);
+    }
+    for (ThreadCommandBuffer* buffer : buffers) {
+        buffer->SwapCommands();
+    }
+    locks.clear();
+
+    ThreadCommandBuffer::MergeSwappedCommands(buffers, &mSerializer);
+}
+
 void Client::Disconnect() {
     mDisconnected = true;
-    mSerializer = ChunkedCommandSerializer(NoopCommandSerializer::GetInstance());
+    // Commands serialized before disconnecting can still be sent.
+    {
+        std::unique_lock<std::mutex> lock;
+        if (mMultithreaded) {
+            lock = std::unique_lock<std::mutex>(mThreadStatesMutex);
+            MergeThreadCommands();
+        }
+        mSerializer.CommitBatch();
+        mSerializer = ChunkedCommandSerializer(NoopCommandSerializer::GetInstance());
+    }
 
     // Transition all event managers to ClientDropped state.
     for (auto& [_, eventManager] : mEventManagers) {
@@ -204,6 +283,12 @@ void Client::Unregister(ObjectBase* obj, ObjectType type) {
 }
 
 void Client::ReclaimReservation(ObjectBase* obj, ObjectType type) {
+    if (mMultithreaded) {
+        ObjectStore::ThreadHandleCache* cache = &GetThreadState()->handles[type];
+        std::lock_guard<std::mutex> lock(mObjectsMutex);
+        mObjects[type].Remove(obj, cache);
+        return;
+    }
     mObjects[type].Remove(obj);
 }
 
@@ -30,7 +30,10 @@
 
 #include <webgpu/webgpu.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
@@ -44,6 +47,7 @@
 #include "dawn/wire/client/ClientBase_autogen.h"
 #include "dawn/wire/client/EventManager.h"
 #include "dawn/wire/client/ObjectStore.h"
+#include "dawn/wire/client/ThreadCommandBuffer.h"
 #include "partition_alloc/pointers/raw_ptr.h"
 
 namespace dawn::wire::client {
@@ -54,7 +58,12 @@ class EventManager;
 
 class Client : public ClientBase {
   public:
-    Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService);
+    // When |multithreaded| is true, commands can be serialized and objects created concurrently
+    // from multiple threads. Each thread serializes its commands in a separate buffer and the
+    // buffers are merged by Flush().
+    Client(CommandSerializer* serializer,
+           MemoryTransferService* memoryTransferService,
+           bool multithreaded = false);
     ~Client() override;
 
     // Make<T>(arg1, arg2, arg3) creates a new T, calling a constructor of the form:
@@ -64,9 +73,13 @@ class Client : public ClientBase {
     Ref<T> Make(Args&&... args) {
         constexpr ObjectType type = ObjectTypeToTypeEnum<T>;
 
-        ObjectBaseParams params = {this, mObjects[type].ReserveHandle()};
+        ObjectHandle handle = mMultithreaded
+                                  ? mObjects[type].ReserveHandle(&GetThreadState()->handles[type])
+                                  : mObjects[type].ReserveHandle();
+        ObjectBaseParams params = {this, handle};
         Ref<T> object = AcquireRef(new T(params, std::forward<Args>(args)...));
 
+        auto lock = LockObjectsIfMultithreaded();
         mObjects[type].Insert(object.Get());
 
         return object;
@@ -76,6 +89,7 @@ class Client : public ClientBase {
 
     template <typename T>
     T* Get(ObjectId id) {
+        auto lock = LockObjectsIfMultithreaded();
         return static_cast<T*>(mObjects[ObjectTypeToTypeEnum<T>].Get(id));
     }
 
@@ -100,20 +114,61 @@ class Client : public ClientBase {
 
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
+        if (mMultithreaded) {
+            SerializeThreadCommand(cmd);
+            return;
+        }
         mSerializer.SerializeCommand(cmd, *this);
     }
 
     template <typename Cmd, typename... Extensions>
     void SerializeCommand(const Cmd& cmd, Extensions&&... es) {
+        if (mMultithreaded) {
+            SerializeThreadCommand(cmd, std::forward<Extensions>(es)...);
+            return;
+        }
         mSerializer.SerializeCommand(cmd, *this, std::forward<Extensions>(es)...);
     }
 
+    void SetCommandBatchingEnabled(bool enabled);
+    bool Flush();
+
     EventManager& GetEventManager(const ObjectHandle& instance);
 
     void Disconnect();
     bool IsDisconnected() const;
 
   private:
+    // The state of a thread using a multithreaded client.
+    struct ThreadState {
+        explicit ThreadState(std::atomic<uint64_t>* nextCommandSerial);
+
+        // Held while the thread serializes a command, and by Flush() while it swaps the buffers.
+        std::mutex mutex;
+        ThreadCommandBuffer commands;
+        ChunkedCommandSerializer serializer;
+        PerObjectType<ObjectStore::ThreadHandleCache> handles;
+    };
+    ThreadState* GetThreadState();
+
+    template <typename Cmd, typename... Extensions>
+    void SerializeThreadCommand(const Cmd& cmd, Extensions&&... es) {
+        if (mDisconnected) {
+            return;
+        }
+        ThreadState* state = GetThreadState();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->serializer.SerializeCommand(cmd, *this, std::forward<Extensions>(es)...);
+    }
+    // Serializes the commands of all the threads with mSerializer. Must be called with
+    // mThreadStatesMutex held.
+    void MergeThreadCommands();
+
+    std::unique_lock<std::mutex> LockObjectsIfMultithreaded() {
+        return mMultithreaded ? std::unique_lock<std::mutex>(mObjectsMutex)
+                              : std::unique_lock<std::mutex>();
+    }
+
     void UnregisterAllObjects();
     void ReclaimReservation(ObjectBase* obj, ObjectType type);
 
@@ -137,7 +192,17 @@ class Client : public ClientBase {
     // spontaneous mode callbacks outlive the instance. We also can't reuse the ObjectStore for the
     // EventManagers because we need to track old instance handles even after they are reclaimed.
     absl::flat_hash_map<ObjectHandle, std::unique_ptr<EventManager>> mEventManagers;
-    bool mDisconnected = false;
+    std::atomic<bool> mDisconnected = false;
+
+    const bool mMultithreaded;
+    // Unique among all the clients, used to find the ThreadState of the current thread.
+    const uint64_t mClientSerial;
+    // Protects mObjects and mEventManagers when the client is multithreaded.
+    std::mutex mObjectsMutex;
+    std::atomic<uint64_t> mNextCommandSerial = 0;
+    // Protects mThreadStates, and mSerializer when the client is multithreaded.
+    std::mutex mThreadStatesMutex;
+    absl::flat_hash_map<std::thread::id, std::unique_ptr<ThreadState>> mThreadStates;
 };
 
 std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
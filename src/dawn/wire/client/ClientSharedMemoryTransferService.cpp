@@ -0,0 +1,250 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/wire/SharedMemory.h"
+#include "dawn/wire/WireClient.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire::client {
+
+namespace {
+
+// Past this number of disjoint written ranges, they are coalesced into a single range to bound
+// the size of the data update.
+constexpr size_t kMaxDirtyRanges = 16;
+
+}  // anonymous namespace
+
+class SharedMemoryTransferService : public MemoryTransferService {
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        ReadHandleImpl(std::unique_ptr<SharedMemoryRegion> region, uint64_t handleId)
+            : mRegion(std::move(region)), mHandleId(handleId) {}
+
+        ~ReadHandleImpl() override = default;
+
+        size_t SerializeCreateSize() override { return sizeof(SharedMemoryRegionInfo); }
+
+        void SerializeCreate(void* serializePointer) override {
+            SharedMemoryRegionInfo info = {mRegion->GetSize(), mHandleId};
+            memcpy(serializePointer, &info, sizeof(info));
+        }
+
+        const void* GetData() override { return mRegion->GetData(); }
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            // The server wrote the data directly in the shared memory.
+            if (deserializeSize != 0) {
+                return false;
+            }
+            return offset <= mRegion->GetSize() && size <= mRegion->GetSize() - offset;
+        }
+
+      private:
+        std::unique_ptr<SharedMemoryRegion> mRegion;
+        uint64_t mHandleId;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        WriteHandleImpl(std::unique_ptr<SharedMemoryRegion> region, uint64_t handleId)
+            : mRegion(std::move(region)), mHandleId(handleId) {}
+
+        ~WriteHandleImpl() override = default;
+
+        size_t SerializeCreateSize() override { return sizeof(SharedMemoryRegionInfo); }
+
+        void SerializeCreate(void* serializePointer) override {
+            SharedMemoryRegionInfo info = {mRegion->GetSize(), mHandleId};
+            memcpy(serializePointer, &info, sizeof(info));
+        }
+
+        void* GetData() override { return mRegion->GetData(); }
+
+        void OnGetMappedRange(size_t offset, size_t size) override {
+            DAWN_ASSERT(offset <= mRegion->GetSize());
+            DAWN_ASSERT(size <= mRegion->GetSize() - offset);
+            if (size == 0) {
+                return;
+            }
+
+            // Insert the range, keeping the list sorted and merging overlapping or adjacent
+            // ranges.
+            uint64_t begin = offset;
+            uint64_t end = offset + size;
+            auto it = std::lower_bound(mDirtyRanges.begin(), mDirtyRanges.end(), begin,
+                                       [](const SharedMemoryDirtyRange& range, uint64_t value) {
+                                           return range.offset + range.size < value;
+                                       });
+            auto last = it;
+            while (last != mDirtyRanges.end() && last->offset <= end) {
+                begin = std::min(begin, last->offset);
+                end = std::max(end, last->offset + last->size);
+                ++last;
+            }
+            it = mDirtyRanges.erase(it, last);
+            mDirtyRanges.insert(it, {begin, end - begin});
+
+            if (mDirtyRanges.size() > kMaxDirtyRanges) {
+                uint64_t coalescedBegin = mDirtyRanges.front().offset;
+                uint64_t coalescedEnd = mDirtyRanges.back().offset + mDirtyRanges.back().size;
+                mDirtyRanges = {{coalescedBegin, coalescedEnd - coalescedBegin}};
+            }
+        }
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+            DAWN_ASSERT(offset <= mRegion->GetSize());
+            DAWN_ASSERT(size <= mRegion->GetSize() - offset);
+            return CountRangesIn(offset, size) * sizeof(SharedMemoryDirtyRange);
+        }
+
+        void SerializeDataUpdate(void* serializePointer, size_t offset, size_t size) override {
+            DAWN_ASSERT(offset <= mRegion->GetSize());
+            DAWN_ASSERT(size <= mRegion->GetSize() - offset);
+
+            // Only the descriptions of the written ranges, clamped to the flushed range, are
+            // serialized. The server copies their contents from the shared memory.
+            uint8_t* dst = static_cast<uint8_t*>(serializePointer);
+            uint64_t flushEnd = uint64_t(offset) + size;
+            for (const SharedMemoryDirtyRange& range : mDirtyRanges) {
+                uint64_t begin = std::max(range.offset, uint64_t(offset));
+                uint64_t end = std::min(range.offset + range.size, flushEnd);
+                if (begin >= end) {
+                    continue;
+                }
+                SharedMemoryDirtyRange clamped = {begin, end - begin};
+                memcpy(dst, &clamped, sizeof(clamped));
+                dst += sizeof(clamped);
+            }
+            mDirtyRanges.clear();
+        }
+
+      private:
+        size_t CountRangesIn(size_t offset, size_t size) const {
+            uint64_t flushEnd = uint64_t(offset) + size;
+            size_t count = 0;
+            for (const SharedMemoryDirtyRange& range : mDirtyRanges) {
+                if (range.offset < flushEnd && range.offset + range.size > offset) {
+                    count++;
+                }
+            }
+            return count;
+        }
+
+        std::unique_ptr<SharedMemoryRegion> mRegion;
+        uint64_t mHandleId;
+        // Sorted, disjoint and non-adjacent ranges written since the last data update.
+        std::vector<SharedMemoryDirtyRange> mDirtyRanges;
+    };
+
+  public:
+    explicit SharedMemoryTransferService(SharedMemoryHandleSender* handleSender)
+        : mHandleSender(handleSender) {}
+    ~SharedMemoryTransferService() override = default;
+
+    ReadHandle* CreateReadHandle(size_t size) override {
+        uint64_t handleId;
+        std::unique_ptr<SharedMemoryRegion> region = CreateAndSendRegion(size, &handleId);
+        if (region == nullptr) {
+            return nullptr;
+        }
+        return new ReadHandleImpl(std::move(region), handleId);
+    }
+
+    WriteHandle* CreateWriteHandle(size_t size) override {
+        // Shared memory regions are zero-initialized.
+        uint64_t handleId;
+        std::unique_ptr<SharedMemoryRegion> region = CreateAndSendRegion(size, &handleId);
+        if (region == nullptr) {
+            return nullptr;
+        }
+        return new WriteHandleImpl(std::move(region), handleId);
+    }
+
+  private:
+    // Creates a region and sends its file descriptor to the server, which happens before the
+    // handle creation is serialized.
+    std::unique_ptr<SharedMemoryRegion> CreateAndSendRegion(size_t size, uint64_t* handleId) {
+        std::unique_ptr<SharedMemoryRegion> region = SharedMemoryRegion::Create(size);
+        if (region == nullptr) {
+            return nullptr;
+        }
+        *handleId = mNextHandleId++;
+        if (!mHandleSender->SendHandle(*handleId, region->GetFd())) {
+            return nullptr;
+        }
+        // The mapping keeps the region alive, the file descriptor isn't needed anymore.
+        region->CloseFd();
+        return region;
+    }
+
+    raw_ptr<SharedMemoryHandleSender> mHandleSender;
+    // Handles can be created concurrently when the client is multithreaded.
+    std::atomic<uint64_t> mNextHandleId = 1;
+};
+
+class SocketSharedMemoryHandleSender : public SharedMemoryHandleSender {
+  public:
+    explicit SocketSharedMemoryHandleSender(int socketFd) : mSocketFd(socketFd) {}
+    ~SocketSharedMemoryHandleSender() override = default;
+
+    bool SendHandle(uint64_t id, int fd) override {
+        return SendSharedMemoryHandle(mSocketFd, id, fd);
+    }
+
+  private:
+    int mSocketFd;
+};
+
+std::unique_ptr<SharedMemoryHandleSender> CreateSocketSharedMemoryHandleSender(int socketFd) {
+    if (!SharedMemoryRegion::IsSupported()) {
+        return nullptr;
+    }
+    return std::make_unique<SocketSharedMemoryHandleSender>(socketFd);
+}
+
+std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService(
+    SharedMemoryHandleSender* handleSender) {
+    DAWN_ASSERT(handleSender != nullptr);
+    if (!SharedMemoryRegion::IsSupported()) {
+        return nullptr;
+    }
+    return std::make_unique<SharedMemoryTransferService>(handleSender);
+}
+
+}  // namespace dawn::wire::client
@@ -27,11 +27,41 @@
 
 #include "dawn/wire/client/ObjectStore.h"
 
+#include <algorithm>
 #include <limits>
+#include <optional>
 #include <utility>
 
 namespace dawn::wire::client {
 
+namespace {
+
+// The number of IDs a thread reserves at once, and the number of freed handles a thread keeps
+// for itself before returning them to the ObjectStore.
+constexpr uint32_t kThreadHandleBlockSize = 64;
+constexpr size_t kMaxThreadFreeHandles = 2 * kThreadHandleBlockSize;
+
+// The IDs left in the blocks of all the threads are seen as skipped by the server, and must fit
+// in kMaxUnusedObjectIds even if the threads never use them. Half of it is left for the IDs that
+// threads reserve one at a time once this many caches reserve blocks.
+constexpr uint32_t kMaxIdBlockCaches = kMaxUnusedObjectIds / (2 * kThreadHandleBlockSize);
+static_assert(kMaxUnusedObjectIds <= kMaxObjectIdGap);
+
+// Returns the handle to use next for |handle|'s ID, or std::nullopt if its generation would
+// overflow.
+std::optional<ObjectHandle> NextGenerationHandle(const ObjectHandle& handle) {
+    // The wire reuses ID for objects to keep them in a packed array starting from 0.
+    // To avoid issues with asynchronous server->client communication referring to an ID that's
+    // already reused, each handle also has a generation that's increment by one on each reuse.
+    // Avoid overflows by only reusing the ID if the increment of the generation won't overflow.
+    if (DAWN_UNLIKELY(handle.generation == std::numeric_limits<ObjectGeneration>::max())) {
+        return std::nullopt;
+    }
+    return ObjectHandle{handle.id, handle.generation + 1};
+}
+
+}  // anonymous namespace
+
 ObjectStore::ObjectStore() {
     // ID 0 is nullptr
     mObjects.emplace_back(nullptr);
@@ -40,38 +70,82 @@ ObjectStore::ObjectStore() {
 
 ObjectHandle ObjectStore::ReserveHandle() {
     if (mFreeHandles.empty()) {
-        return {mCurrentId++, 0};
+        return {mCurrentId.fetch_add(1, std::memory_order_relaxed), 0};
     }
     ObjectHandle handle = mFreeHandles.back();
     mFreeHandles.pop_back();
     return handle;
 }
 
+ObjectHandle ObjectStore::ReserveHandle(ThreadHandleCache* cache) {
+    if (!cache->freeHandles.empty()) {
+        ObjectHandle handle = cache->freeHandles.back();
+        cache->freeHandles.pop_back();
+        return handle;
+    }
+    if (cache->nextId != cache->endId) {
+        return {cache->nextId++, 0};
+    }
+
+    // The thread ran out of handles. Take back the handles returned by other threads if there
+    // are any, otherwise reserve a new block of IDs.
+    {
+        std::lock_guard<std::mutex> lock(mFreeHandlesMutex);
+        if (!mFreeHandles.empty()) {
+            size_t count = std::min<size_t>(mFreeHandles.size(), kThreadHandleBlockSize);
+            cache->freeHandles.assign(mFreeHandles.end() - count, mFreeHandles.end());
+            mFreeHandles.resize(mFreeHandles.size() - count);
+            return ReserveHandle(cache);
+        }
+    }
+    if (!cache->reservesIdBlocks.has_value()) {
+        cache->reservesIdBlocks =
+            mIdBlockCacheCount.fetch_add(1, std::memory_order_relaxed) < kMaxIdBlockCaches;
+    }
+    if (!*cache->reservesIdBlocks) {
+        return {mCurrentId.fetch_add(1, std::memory_order_relaxed), 0};
+    }
+    cache->nextId = mCurrentId.fetch_add(kThreadHandleBlockSize, std::memory_order_relaxed);
+    cache->endId = cache->nextId + kThreadHandleBlockSize;
+    return {cache->nextId++, 0};
+}
+
 void ObjectStore::Insert(ObjectBase* obj) {
     ObjectId id = obj->GetWireId();
 
     if (id >= mObjects.size()) {
-        DAWN_ASSERT(id == mObjects.size());
-        mObjects.emplace_back(obj);
-    } else {
-        // The generation should never overflow. We don't recycle ObjectIds that would
-        // overflow their next generation.
-        DAWN_ASSERT(obj->GetWireGeneration() != 0);
-        DAWN_ASSERT(mObjects[id] == nullptr);
-        mObjects[id] = obj;
+        // IDs are contiguous unless they were reserved by different threads, in which case
+        // the IDs reserved by other threads may not be inserted yet.
+        mObjects.resize(id + 1);
     }
+    DAWN_ASSERT(mObjects[id] == nullptr);
+    mObjects[id] = obj;
 }
 
 void ObjectStore::Remove(ObjectBase* obj) {
-    // The wire reuses ID for objects to keep them in a packed array starting from 0.
-    // To avoid issues with asynchronous server->client communication referring to an ID that's
-    // already reused, each handle also has a generation that's increment by one on each reuse.
-    // Avoid overflows by only reusing the ID if the increment of the generation won't overflow.
-    const ObjectHandle& currentHandle = obj->GetWireHandle();
-    if (DAWN_LIKELY(currentHandle.generation != std::numeric_limits<ObjectGeneration>::max())) {
-        mFreeHandles.push_back({currentHandle.id, currentHandle.generation + 1});
+    if (auto handle = NextGenerationHandle(obj->GetWireHandle())) {
+        mFreeHandles.push_back(*handle);
+    }
+    RemoveObject(obj);
+}
+
+void ObjectStore::Remove(ObjectBase* obj, ThreadHandleCache* cache) {
+    if (auto handle = NextGenerationHandle(obj->GetWireHandle())) {
+        cache->freeHandles.push_back(*handle);
     }
-    mObjects[currentHandle.id] = nullptr;
+    // Threads that free more objects than they create return their handles to the ObjectStore
+    // so that other threads can reuse them.
+    if (cache->freeHandles.size() > kMaxThreadFreeHandles) {
+        auto begin = cache->freeHandles.begin() + kThreadHandleBlockSize;
+        std::lock_guard<std::mutex> lock(mFreeHandlesMutex);
+        mFreeHandles.insert(mFreeHandles.end(), begin, cache->freeHandles.end());
+        cache->freeHandles.erase(begin, cache->freeHandles.end());
+    }
+    RemoveObject(obj);
+}
+
+void ObjectStore::RemoveObject(ObjectBase* obj) {
+    mObjects[obj->GetWireId()] = nullptr;
 }
 
 const std::vector<raw_ptr<ObjectBase>>& ObjectStore::GetAllObjects() const {
@@ -28,7 +28,10 @@
 #ifndef SRC_DAWN_WIRE_CLIENT_OBJECTSTORE_H_
 #define SRC_DAWN_WIRE_CLIENT_OBJECTSTORE_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 #include "dawn/wire/client/ObjectBase.h"
@@ -44,19 +47,41 @@ class Client;
 // Since the wire has one "ID" namespace per type of object, each ObjectStore should contain a
 // single type of objects. However no templates are used because Client wraps ObjectStore and is
 // type-generic, so ObjectStore is type-erased to only work on ObjectBase.
+//
+// When the client is multithreaded, each thread reserves and frees handles through its own
+// ThreadHandleCache instead, which hands out blocks of fresh IDs reserved with a single atomic
+// operation and keeps the handles freed by the thread for reuse. Insert, Remove and Get must then
+// be externally synchronized. The server bounds how many IDs may be skipped, so only a limited
+// number of caches reserve blocks of IDs and the others reserve fresh IDs one at a time.
 class ObjectStore {
   public:
+    struct ThreadHandleCache {
+        std::vector<ObjectHandle> freeHandles;
+        ObjectId nextId = 0;
+        ObjectId endId = 0;
+        // Set the first time the cache needs fresh IDs.
+        std::optional<bool> reservesIdBlocks;
+    };
+
     ObjectStore();
 
     ObjectHandle ReserveHandle();
+    ObjectHandle ReserveHandle(ThreadHandleCache* cache);
     void Insert(ObjectBase* obj);
     void Remove(ObjectBase* obj);
+    void Remove(ObjectBase* obj, ThreadHandleCache* cache);
 
     ObjectBase* Get(ObjectId id) const;
     const std::vector<raw_ptr<ObjectBase>>& GetAllObjects() const;
 
   private:
-    uint32_t mCurrentId;
+    void RemoveObject(ObjectBase* obj);
+
+    std::atomic<uint32_t> mCurrentId;
+    std::atomic<uint32_t> mIdBlockCacheCount = 0;
+    // Only accessed with mFreeHandlesMutex held when the handles are reserved with a
+    // ThreadHandleCache.
+    std::mutex mFreeHandlesMutex;
     std::vector<ObjectHandle> mFreeHandles;
     std::vector<raw_ptr<ObjectBase>> mObjects;
 };
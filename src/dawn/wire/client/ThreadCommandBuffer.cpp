@@ -0,0 +1,112 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/wire/client/ThreadCommandBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/wire/ChunkedCommandSerializer.h"
+
+namespace dawn::wire::client {
+
+ThreadCommandBuffer::ThreadCommandBuffer(std::atomic<uint64_t>* nextSerial)
+    : mNextSerial(nextSerial) {}
+
+ThreadCommandBuffer::~ThreadCommandBuffer() = default;
+
+size_t ThreadCommandBuffer::GetMaximumAllocationSize() const {
+    return std::numeric_limits<size_t>::max() - sizeof(RecordHeader) - alignof(RecordHeader);
+}
+
+void* ThreadCommandBuffer::GetCmdSpace(size_t size) {
+    size_t recordSize = sizeof(RecordHeader) + Align(size, alignof(RecordHeader));
+    if (mRecording.size() - mRecordingSize < recordSize) {
+        mRecording.resize(std::max(2 * mRecording.size(), mRecordingSize + recordSize));
+    }
+
+    char* record = mRecording.data() + mRecordingSize;
+    mRecordingSize += recordSize;
+
+    RecordHeader* header = reinterpret_cast<RecordHeader*>(record);
+    header->serial = mNextSerial->fetch_add(1);
+    header->size = size;
+    return record + sizeof(RecordHeader);
+}
+
+bool ThreadCommandBuffer::Flush() {
+    // The recorded commands are only sent by MergeSwappedCommands.
+    return true;
+}
+
+void ThreadCommandBuffer::SwapCommands() {
+    DAWN_ASSERT(mSwappedSize == 0);
+    std::swap(mRecording, mSwapped);
+    std::swap(mRecordingSize, mSwappedSize);
+}
+
+// static
+void ThreadCommandBuffer::MergeSwappedCommands(const std::vector<ThreadCommandBuffer*>& buffers,
+                                               ChunkedCommandSerializer* serializer) {
+    struct Cursor {
+        const char* current;
+        const char* end;
+    };
+    std::vector<Cursor> cursors;
+    for (ThreadCommandBuffer* buffer : buffers) {
+        if (buffer->mSwappedSize != 0) {
+            const char* begin = buffer->mSwapped.data();
+            cursors.push_back({begin, begin + buffer->mSwappedSize});
+        }
+        buffer->mSwappedSize = 0;
+    }
+
+    // The commands of each thread are sorted already, repeatedly serialize the command with the
+    // smallest serial among the threads. There are few threads so a linear search is enough.
+    while (!cursors.empty()) {
+        auto next = std::min_element(cursors.begin(), cursors.end(), [](const auto& a,
+                                                                         const auto& b) {
+            return reinterpret_cast<const RecordHeader*>(a.current)->serial <
+                   reinterpret_cast<const RecordHeader*>(b.current)->serial;
+        });
+
+        const RecordHeader* header = reinterpret_cast<const RecordHeader*>(next->current);
+        size_t size = static_cast<size_t>(header->size);
+        serializer->SerializeRawCommand(next->current + sizeof(RecordHeader), size);
+
+        next->current += sizeof(RecordHeader) + Align(size, alignof(RecordHeader));
+        if (next->current == next->end) {
+            cursors.erase(next);
+        }
+    }
+}
+
+}  // namespace dawn::wire::client
@@ -0,0 +1,85 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_WIRE_CLIENT_THREADCOMMANDBUFFER_H_
+#define SRC_DAWN_WIRE_CLIENT_THREADCOMMANDBUFFER_H_
+
+#include <atomic>
+#include <vector>
+
+#include "dawn/wire/Wire.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire {
+class ChunkedCommandSerializer;
+}  // namespace dawn::wire
+
+namespace dawn::wire::client {
+
+// A CommandSerializer recording the commands of a single thread when the client is
+// multithreaded. Each command is tagged with a serial taken from a counter shared by the buffers
+// of all the threads, so that their commands can be merged in the order they were serialized.
+// Commands that happen-before others, for example the creation of an object before its use by
+// another thread, then always reach the server first.
+class ThreadCommandBuffer final : public CommandSerializer {
+  public:
+    explicit ThreadCommandBuffer(std::atomic<uint64_t>* nextSerial);
+    ~ThreadCommandBuffer() override;
+
+    // Commands are never split in chunks while they are recorded. This happens when they are
+    // merged instead, so that the chunks of a command are never interleaved with other commands.
+    size_t GetMaximumAllocationSize() const override;
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+
+    // Moves the recorded commands aside so that they can be merged while the thread records new
+    // ones. All the buffers must be swapped while none of them is recording so that the merged
+    // commands contain every command with a smaller serial.
+    void SwapCommands();
+
+    // Serializes the commands swapped out of |buffers| with |serializer| in serial order.
+    static void MergeSwappedCommands(const std::vector<ThreadCommandBuffer*>& buffers,
+                                     ChunkedCommandSerializer* serializer);
+
+  private:
+    struct RecordHeader {
+        uint64_t serial;
+        uint64_t size;
+    };
+
+    raw_ptr<std::atomic<uint64_t>> mNextSerial;
+
+    std::vector<char> mRecording;
+    size_t mRecordingSize = 0;
+
+    std::vector<char> mSwapped;
+    size_t mSwappedSize = 0;
+};
+
+}  // namespace dawn::wire::client
+
+#endif  // SRC_DAWN_WIRE_CLIENT_THREADCOMMANDBUFFER_H_
@@ -216,7 +216,7 @@ class KnownObjectsBase {
     WireResult Allocate(Reserved<T>* result,
                         ObjectHandle handle,
                         AllocationState state = AllocationState::Allocated) {
-        if (handle.id == 0 || handle.id > mKnown.size()) {
+        if (handle.id == 0) {
             return WireResult::FatalError;
         }
 
@@ -225,6 +225,23 @@ class KnownObjectsBase {
         data.handle = nullptr;
 
         if (handle.id >= mKnown.size()) {
+            // Only multithreaded clients skip IDs, and each skipped ID is kept as a free entry
+            // until the client allocates it, so bound both the gap and the number of such entries.
+            size_t gap = handle.id - mKnown.size();
+            if (gap != 0 && (!mAllowOutOfOrderIds || gap >= kMaxObjectIdGap ||
+                             mUnusedIds.size() + gap > kMaxUnusedObjectIds)) {
+                return WireResult::FatalError;
+            }
+            // IDs that were never allocated must start at generation 0.
+            if (gap != 0 && handle.generation != 0) {
+                return WireResult::FatalError;
+            }
+            while (handle.id > mKnown.size()) {
+                mUnusedIds.insert(mKnown.size());
+                Data unused;
+                unused.state = AllocationState::Free;
+                mKnown.push_back(std::move(unused));
+            }
             mKnown.push_back(std::move(data));
             *result = {handle.id, &mKnown.back()};
             return WireResult::Success;
@@ -234,8 +251,14 @@ class KnownObjectsBase {
             return WireResult::FatalError;
         }
 
-        // The generation should be strictly increasing.
-        if (handle.generation <= mKnown[handle.id].generation) {
+        // The generation should be strictly increasing, except for skipped IDs that were never
+        // allocated, which the client allocates with the initial generation.
+        if (!mUnusedIds.empty() && mUnusedIds.contains(handle.id)) {
+            if (handle.generation != 0) {
+                return WireResult::FatalError;
+            }
+            mUnusedIds.erase(handle.id);
+        } else if (handle.generation <= mKnown[handle.id].generation) {
             return WireResult::FatalError;
         }
         // update the generation in the slot
@@ -247,6 +270,10 @@ class KnownObjectsBase {
         return WireResult::Success;
     }
 
+    // Lets the client allocate IDs out of order. Used for multithreaded clients, which reserve
+    // blocks of IDs for each thread.
+    void AllowOutOfOrderIds() { mAllowOutOfOrderIds = true; }
+
     // Marks an ID as deallocated
     void Free(ObjectId id) {
         DAWN_ASSERT(id < mKnown.size());
@@ -282,6 +309,8 @@ class KnownObjectsBase {
 
   protected:
     std::vector<Data> mKnown;
+    absl::flat_hash_set<ObjectId> mUnusedIds;
+    bool mAllowOutOfOrderIds = false;
 };
 
 template <typename T>
@@ -35,21 +35,27 @@ CallbackUserdata::CallbackUserdata(const std::weak_ptr<Server>& server) : server
 // static
 std::shared_ptr<Server> Server::Create(const DawnProcTable& procs,
                                        CommandSerializer* serializer,
-                                       MemoryTransferService* memoryTransferService) {
-    auto server = std::shared_ptr<Server>(new Server(procs, serializer, memoryTransferService));
+                                       MemoryTransferService* memoryTransferService,
+                                       bool multithreadedClient) {
+    auto server = std::shared_ptr<Server>(
+        new Server(procs, serializer, memoryTransferService, multithreadedClient));
     server->mSelf = server;
     return server;
 }
 
 Server::Server(const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService)
+               MemoryTransferService* memoryTransferService,
+               bool multithreadedClient)
     : mSerializer(serializer), mProcs(procs), mMemoryTransferService(memoryTransferService) {
     if (mMemoryTransferService == nullptr) {
         // If a MemoryTransferService is not provided, fallback to inline memory.
         mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
         mMemoryTransferService = mOwnedMemoryTransferService.get();
     }
+    if (multithreadedClient) {
+        AllowOutOfOrderObjectIds();
+    }
 }
 
 Server::~Server() {
@@ -192,7 +192,8 @@ class Server : public ServerBase {
   public:
     static std::shared_ptr<Server> Create(const DawnProcTable& procs,
                                           CommandSerializer* serializer,
-                                          MemoryTransferService* memoryTransferService);
+                                          MemoryTransferService* memoryTransferService,
+                                          bool multithreadedClient = false);
     ~Server() override;
 
     // ChunkedCommandHandler implementation
@@ -220,7 +221,8 @@ class Server : public ServerBase {
   private:
     Server(const DawnProcTable& procs,
            CommandSerializer* serializer,
-           MemoryTransferService* memoryTransferService);
+           MemoryTransferService* memoryTransferService,
+           bool multithreadedClient);
 
     template <typename Cmd>
     void SerializeCommand(const Cmd& cmd) {
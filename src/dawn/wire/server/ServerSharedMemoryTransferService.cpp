@@ -0,0 +1,219 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "dawn/common/Assert.h"
+#include "dawn/wire/SharedMemory.h"
+#include "dawn/wire/WireServer.h"
+#include "partition_alloc/pointers/raw_ptr.h"
+
+namespace dawn::wire::server {
+
+namespace {
+
+// Bound on the descriptors received ahead of the handle creations that use them, so that a
+// client can't make the server hold an unbounded number of file descriptors.
+constexpr size_t kMaxPendingHandles = 256;
+
+}  // anonymous namespace
+
+class SharedMemoryTransferService : public MemoryTransferService {
+  public:
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        explicit ReadHandleImpl(std::unique_ptr<SharedMemoryRegion> region)
+            : mRegion(std::move(region)) {}
+        ~ReadHandleImpl() override = default;
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override { return 0; }
+
+        void SerializeDataUpdate(const void* data,
+                                 size_t offset,
+                                 size_t size,
+                                 void* serializePointer) override {
+            if (size == 0) {
+                return;
+            }
+            DAWN_ASSERT(data != nullptr);
+            // The client validates the range when receiving the data update, skip the copy so
+            // that it can report the error.
+            if (offset > mRegion->GetSize() || size > mRegion->GetSize() - offset) {
+                return;
+            }
+            memcpy(static_cast<uint8_t*>(mRegion->GetData()) + offset, data, size);
+        }
+
+      private:
+        std::unique_ptr<SharedMemoryRegion> mRegion;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        explicit WriteHandleImpl(std::unique_ptr<SharedMemoryRegion> region)
+            : mRegion(std::move(region)) {}
+        ~WriteHandleImpl() override = default;
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            // The data update is the list of ranges written by the client.
+            if (deserializeSize % sizeof(SharedMemoryDirtyRange) != 0 || mTargetData == nullptr ||
+                (deserializeSize != 0 && deserializePointer == nullptr)) {
+                return false;
+            }
+            if (offset > mDataLength || size > mDataLength - offset ||
+                mDataLength > mRegion->GetSize()) {
+                return false;
+            }
+
+            const uint8_t* src = static_cast<const uint8_t*>(deserializePointer);
+            size_t rangeCount = deserializeSize / sizeof(SharedMemoryDirtyRange);
+            for (size_t i = 0; i < rangeCount; ++i) {
+                SharedMemoryDirtyRange range;
+                memcpy(&range, src + i * sizeof(range), sizeof(range));
+                if (range.offset < offset || range.offset - offset > size ||
+                    range.size > size - (range.offset - offset)) {
+                    return false;
+                }
+                memcpy(static_cast<uint8_t*>(mTargetData) + range.offset,
+                       static_cast<const uint8_t*>(mRegion->GetData()) + range.offset,
+                       static_cast<size_t>(range.size));
+            }
+            return true;
+        }
+
+      private:
+        std::unique_ptr<SharedMemoryRegion> mRegion;
+    };
+
+    explicit SharedMemoryTransferService(SharedMemoryHandleReceiver* handleReceiver)
+        : mHandleReceiver(handleReceiver) {}
+    ~SharedMemoryTransferService() override = default;
+
+    bool DeserializeReadHandle(const void* deserializePointer,
+                               size_t deserializeSize,
+                               ReadHandle** readHandle) override {
+        DAWN_ASSERT(readHandle != nullptr);
+        std::unique_ptr<SharedMemoryRegion> region =
+            OpenRegion(deserializePointer, deserializeSize);
+        if (region == nullptr) {
+            return false;
+        }
+        *readHandle = new ReadHandleImpl(std::move(region));
+        return true;
+    }
+
+    bool DeserializeWriteHandle(const void* deserializePointer,
+                                size_t deserializeSize,
+                                WriteHandle** writeHandle) override {
+        DAWN_ASSERT(writeHandle != nullptr);
+        std::unique_ptr<SharedMemoryRegion> region =
+            OpenRegion(deserializePointer, deserializeSize);
+        if (region == nullptr) {
+            return false;
+        }
+        *writeHandle = new WriteHandleImpl(std::move(region));
+        return true;
+    }
+
+  private:
+    // Maps the region described by the create info. The file descriptor of the region is only
+    // ever looked up among the ones the client sent, never by name.
+    std::unique_ptr<SharedMemoryRegion> OpenRegion(const void* deserializePointer,
+                                                   size_t deserializeSize) {
+        if (deserializePointer == nullptr || deserializeSize != sizeof(SharedMemoryRegionInfo)) {
+            return nullptr;
+        }
+        SharedMemoryRegionInfo info;
+        memcpy(&info, deserializePointer, sizeof(info));
+        return SharedMemoryRegion::Open(mHandleReceiver->TakeHandle(info.handleId), info.size);
+    }
+
+    raw_ptr<SharedMemoryHandleReceiver> mHandleReceiver;
+};
+
+class SocketSharedMemoryHandleReceiver : public SharedMemoryHandleReceiver {
+  public:
+    explicit SocketSharedMemoryHandleReceiver(int socketFd) : mSocketFd(socketFd) {}
+
+    ~SocketSharedMemoryHandleReceiver() override {
+        for (auto& [id, fd] : mPendingHandles) {
+            CloseSharedMemoryHandle(fd);
+        }
+    }
+
+    int TakeHandle(uint64_t id) override {
+        // The client sends each descriptor before serializing the command that uses it, so it is
+        // either pending already or still queued on the socket.
+        while (!mPendingHandles.contains(id)) {
+            uint64_t receivedId;
+            int fd;
+            if (!ReceiveSharedMemoryHandle(mSocketFd, &receivedId, &fd)) {
+                return -1;
+            }
+            if (fd < 0) {
+                continue;
+            }
+            if (mPendingHandles.size() >= kMaxPendingHandles ||
+                !mPendingHandles.emplace(receivedId, fd).second) {
+                CloseSharedMemoryHandle(fd);
+            }
+        }
+
+        auto it = mPendingHandles.find(id);
+        int fd = it->second;
+        mPendingHandles.erase(it);
+        return fd;
+    }
+
+  private:
+    int mSocketFd;
+    absl::flat_hash_map<uint64_t, int> mPendingHandles;
+};
+
+std::unique_ptr<SharedMemoryHandleReceiver> CreateSocketSharedMemoryHandleReceiver(int socketFd) {
+    if (!SharedMemoryRegion::IsSupported()) {
+        return nullptr;
+    }
+    return std::make_unique<SocketSharedMemoryHandleReceiver>(socketFd);
+}
+
+std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService(
+    SharedMemoryHandleReceiver* handleReceiver) {
+    DAWN_ASSERT(handleReceiver != nullptr);
+    if (!SharedMemoryRegion::IsSupported()) {
+        return nullptr;
+    }
+    return std::make_unique<SharedMemoryTransferService>(handleReceiver);
+}
+
+}  // namespace dawn::wire::server
@@ -104,9 +104,16 @@ if(TINT_BUILD_SPV_WRITER AND TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_READER AN
   )
 endif(TINT_BUILD_SPV_WRITER AND TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_READER AND TINT_BUILD_WGSL_WRITER)
 
+if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER AND TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_WRITER)
+  tint_target_add_dependencies(tint_cmd_bench_bench_cmd bench_cmd
+    tint_lang_wgsl_ls_bench
+  )
+endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER AND TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_WRITER)
+
 if(TINT_BUILD_WGSL_READER AND TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_WRITER)
   tint_target_add_dependencies(tint_cmd_bench_bench_cmd bench_cmd
     tint_lang_wgsl_reader_bench
+    tint_lang_wgsl_resolver_bench
   )
 endif(TINT_BUILD_WGSL_READER AND TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_WRITER)
 
@@ -193,12 +193,16 @@ ProgramInfo LoadProgramInfo(const LoadProgramOptions& opts) {
                 options.allowed_features = tint::wgsl::AllowedFeatures::Everything();
                 options.mode = opts.mode;
 
+                // The file refers to the data, which is moved into the ProgramInfo with it.
                 auto file = std::make_unique<tint::Source::File>(
-                    opts.filename, std::string(data.begin(), data.end()));
+                    opts.filename,
+                    std::string_view(reinterpret_cast<const char*>(data.data()), data.size()),
+                    tint::Source::kBorrow);
 
                 return ProgramInfo{
                     /* program */ tint::wgsl::reader::Parse(file.get(), options),
                     /* source_file */ std::move(file),
+                    /* source_data */ std::move(data),
                 };
 #else
                 std::cerr << "Tint not built with the WGSL reader enabled\n";
@@ -215,6 +219,7 @@ ProgramInfo LoadProgramInfo(const LoadProgramOptions& opts) {
                 return ProgramInfo{
                     /* program */ ReadSpirv(data, opts),
                     /* source_file */ nullptr,
+                    /* source_data */ {},
                 };
 #else
                 std::cerr << "Tint not built with the SPIR-V reader enabled\n";
@@ -245,6 +250,7 @@ ProgramInfo LoadProgramInfo(const LoadProgramOptions& opts) {
                 return ProgramInfo{
                     /* program */ ReadSpirv(data, opts),
                     /* source_file */ std::move(file),
+                    /* source_data */ {},
                 };
 #else
                 std::cerr << "Tint not built with the SPIR-V reader enabled\n";
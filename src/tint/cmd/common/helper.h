@@ -55,6 +55,8 @@ struct ProgramInfo {
     tint::Program program;
     /// The source file information
     std::unique_ptr<tint::Source::File> source_file;
+    /// The content of the source file, if #source_file refers to it without a copy
+    std::vector<uint8_t> source_data;
 };
 
 /// Reporter callback for internal tint errors
@@ -87,6 +87,7 @@ tint_target_add_dependencies(tint_cmd_test_test_cmd test_cmd
   tint_utils_rtti_test
   tint_utils_strconv_test
   tint_utils_symbol_test
+  tint_utils_system_test
   tint_utils_text_test
   tint_utils_traits_test
 )
@@ -27,6 +27,7 @@
 
 #include <charconv>
 #include <cstdio>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -189,6 +190,7 @@ struct Options {
     bool validate = false;
     bool compatibility_mode = false;
     bool print_hash = false;
+    bool print_transform_stats = false;
     bool dump_inspector_bindings = false;
     bool enable_robustness = false;
     bool emit_single_entry_point = false;
@@ -416,6 +418,12 @@ violations that may be produced)",
                                                Default{false});
     TINT_DEFER(opts->print_hash = *print_hash.value);
 
+    auto& print_transform_stats = options.Add<BoolOption>(
+        "print-transform-stats",
+        "Print the time spent and the nodes allocated by each AST transform to stderr",
+        Default{false});
+    TINT_DEFER(opts->print_transform_stats = *print_transform_stats.value);
+
     auto& transforms =
         options.Add<StringOption>("transform", R"(Runs transforms, name list is comma separated
 Available transforms:
@@ -1194,6 +1202,22 @@ bool DumpIR([[maybe_unused]] const tint::Program& program,
 #endif
 }
 
+/// Prints the AST transform statistics to stderr
+/// @param statistics the statistics to print
+void PrintTransformStatistics(const tint::ast::transform::Manager::Statistics& statistics) {
+    std::cerr << std::left << std::setw(48) << "transform" << std::right << std::setw(6)
+              << "runs" << std::setw(7) << "skips" << std::setw(11) << "time (ms)"
+              << std::setw(11) << "ast nodes" << std::setw(11) << "sem nodes"
+              << "\n";
+    for (auto& stats : statistics.transforms) {
+        double ms = std::chrono::duration<double, std::milli>(stats.duration).count();
+        std::cerr << std::left << std::setw(48) << stats.type->name << std::right << std::setw(6)
+                  << stats.runs << std::setw(7) << stats.skips << std::setw(11) << std::fixed
+                  << std::setprecision(3) << ms << std::setw(11) << stats.ast_nodes
+                  << std::setw(11) << stats.sem_nodes << "\n";
+    }
+}
+
 }  // namespace
 
 int main(int argc, const char** argv) {
@@ -1418,6 +1442,13 @@ int main(int argc, const char** argv) {
         transform_inputs.Add<tint::ast::transform::SingleEntryPoint::Config>(options.ep_name);
     }
 
+    // Records the statistics of the transforms run here and by the backends.
+    tint::ast::transform::Manager::Statistics transform_stats;
+    std::optional<tint::ast::transform::Manager::StatisticsScope> transform_stats_scope;
+    if (options.print_transform_stats) {
+        transform_stats_scope.emplace(transform_stats);
+    }
+
     tint::ast::transform::DataMap outputs;
     auto program = transform_manager.Run(info.program, std::move(transform_inputs), outputs);
     if (!program.IsValid()) {
@@ -1453,6 +1484,11 @@ int main(int argc, const char** argv) {
             std::cerr << "Unknown output format specified\n";
             return 1;
     }
+
+    if (options.print_transform_stats) {
+        PrintTransformStatistics(transform_stats);
+    }
+
     if (!success) {
         return 1;
     }
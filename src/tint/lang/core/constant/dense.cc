@@ -0,0 +1,48 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/constant/dense.h"
+
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::DenseBase);
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::Dense<tint::core::AInt>);
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::Dense<tint::core::AFloat>);
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::Dense<tint::core::i32>);
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::Dense<tint::core::u32>);
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::Dense<tint::core::f16>);
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::Dense<tint::core::f32>);
+TINT_INSTANTIATE_TYPEINFO(tint::core::constant::Dense<bool>);
+
+namespace tint::core::constant {
+
+DenseBase::DenseBase(const core::type::Type* t, bool all_0, bool any_0)
+    : type(t), el_type(t->Elements().type), all_zero(all_0), any_zero(any_0) {
+    TINT_ASSERT(el_type);
+}
+
+DenseBase::~DenseBase() = default;
+
+}  // namespace tint::core::constant
@@ -0,0 +1,246 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_CORE_CONSTANT_DENSE_H_
+#define SRC_TINT_LANG_CORE_CONSTANT_DENSE_H_
+
+#include <mutex>
+#include <type_traits>
+
+#include "src/tint/lang/core/constant/manager.h"
+#include "src/tint/lang/core/constant/scalar.h"
+#include "src/tint/lang/core/constant/value.h"
+#include "src/tint/lang/core/number.h"
+#include "src/tint/lang/core/type/type.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/containers/vector.h"
+#include "src/tint/utils/ice/ice.h"
+#include "src/tint/utils/math/hash.h"
+#include "src/tint/utils/memory/block_allocator.h"
+#include "src/tint/utils/rtti/castable.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::core::constant {
+
+/// DenseBase is the base class of all Dense<T> specializations.
+/// Used for querying whether a value is a dense array.
+class DenseBase : public Castable<DenseBase, Value> {
+  public:
+    /// Constructor
+    /// @param t the array type
+    /// @param all_0 true if all elements are 0
+    /// @param any_0 true if any element is 0
+    DenseBase(const core::type::Type* t, bool all_0, bool any_0);
+    ~DenseBase() override;
+
+    /// @copydoc Value::Type()
+    const core::type::Type* Type() const override { return type; }
+
+    /// @copydoc Value::AllZero()
+    bool AllZero() const override { return all_zero; }
+
+    /// @copydoc Value::AnyZero()
+    bool AnyZero() const override { return any_zero; }
+
+    /// @param mgr the constant manager that owns the returned scalar
+    /// @param i the index of the element
+    /// @returns the element with index @p i as a scalar owned by @p mgr, or nullptr if the index
+    /// is out of bounds. Unlike Index(), equal elements of different constants return the same
+    /// pointer.
+    virtual const ScalarBase* ScalarAt(Manager& mgr, size_t i) const = 0;
+
+    /// @param other a dense array of the same type as this array
+    /// @returns true if the elements of this array are equal to the elements of @p other
+    virtual bool ElementsEqual(const DenseBase* other) const = 0;
+
+    /// The array type
+    core::type::Type const* const type;
+    /// The array element type
+    core::type::Type const* const el_type;
+    /// True if all elements are zero
+    const bool all_zero;
+    /// True if any element is zero
+    const bool any_zero;
+
+  protected:
+    /// @copydoc Value::InternalValue()
+    std::variant<std::monostate, AInt, AFloat> InternalValue() const override { return {}; }
+
+    /// Guards the lazily created elements of the Dense<T> specializations.
+    mutable std::mutex mutex_;
+};
+
+/// Dense holds the elements of an array of scalars in a contiguous buffer of values.
+///
+/// Dense is used for large arrays of mixed values whose elements would otherwise each need a
+/// separate Scalar, such as a lookup table of abstract-floats and its conversion to f32. The
+/// Scalar returned by Index() is created on first use. Use Manager::Composite() or
+/// Manager::Dense() to create the appropriate constant.
+template <typename T>
+class Dense : public Castable<Dense<T>, DenseBase> {
+  public:
+    /// Constructor
+    /// @param t the array type
+    /// @param v the element values
+    Dense(const core::type::Type* t, VectorRef<T> v)
+        : Castable<Dense<T>, DenseBase>(t, AllZero(v), AnyZero(v)),
+          values(std::move(v)),
+          hash(CalcHash()) {
+        TINT_ASSERT(values.Length() == t->Elements().count);
+    }
+    ~Dense() override = default;
+
+    /// @copydoc Value::Index()
+    /// @note each call takes a lock. The first call for the index @p i allocates a Scalar that is
+    /// owned by this Dense and kept until it is destructed, so calling Index() for every element
+    /// costs about as much memory as a Composite. The Scalar is not uniqued by the Manager. Use
+    /// ForEachElement() to visit the elements, or ScalarAt() for a uniqued Scalar.
+    const Value* Index(size_t i) const override {
+        if (i >= values.Length()) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        return elements_.GetOrAdd(i, [&] {
+            return element_allocator_.template Create<Scalar<T>>(this->el_type, values[i]);
+        });
+    }
+
+    /// @copydoc Value::NumElements()
+    size_t NumElements() const override { return values.Length(); }
+
+    /// @copydoc Value::Hash()
+    HashCode Hash() const override { return hash; }
+
+    /// @copydoc DenseBase::ScalarAt()
+    const ScalarBase* ScalarAt(Manager& mgr, size_t i) const override {
+        return i < values.Length() ? mgr.Get<Scalar<T>>(this->el_type, values[i]) : nullptr;
+    }
+
+    /// @copydoc DenseBase::ElementsEqual()
+    bool ElementsEqual(const DenseBase* other) const override {
+        auto* o = other->As<Dense<T>>();
+        if (!o || o->values.Length() != values.Length()) {
+            return false;
+        }
+        for (size_t i = 0; i < values.Length(); i++) {
+            if (!(values[i] == o->values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Clones the constant into the provided context
+    /// @param ctx the clone context
+    /// @returns the cloned node
+    const Dense* Clone(CloneContext& ctx) const override {
+        auto* ty = this->type->Clone(ctx.type_ctx);
+        return ctx.dst.Get<Dense<T>>(ty, values);
+    }
+
+    /// The element values
+    const Vector<T, 0> values;
+    /// The hash of the array
+    const HashCode hash;
+
+  private:
+    /// @returns true if @p v is zero. For floating point -0.0 equals 0.0, according to IEEE 754.
+    static bool IsZero(T v) {
+        using N = UnwrapNumber<T>;
+        return Number<N>(v) == Number<N>(0);
+    }
+    /// @returns true if all the values of @p v are zero
+    static bool AllZero(VectorRef<T> v) {
+        for (auto el : v) {
+            if (!IsZero(el)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /// @returns true if any of the values of @p v are zero
+    static bool AnyZero(VectorRef<T> v) {
+        for (auto el : v) {
+            if (IsZero(el)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    /// @returns the hash of the array. This is equal to the hash of a Composite of the same type
+    /// and elements.
+    HashCode CalcHash() const {
+        auto h = tint::Hash(this->type, this->all_zero, this->any_zero);
+        for (auto el : values) {
+            if constexpr (std::is_same_v<UnwrapNumber<T>, T>) {
+                h = HashCombine(h, tint::Hash(this->el_type, el));
+            } else {
+                h = HashCombine(h, tint::Hash(this->el_type, el.value));
+            }
+        }
+        return h;
+    }
+
+    /// The elements returned by Index(), keyed by index. Guarded by DenseBase::mutex_.
+    mutable Hashmap<size_t, const Scalar<T>*, 4> elements_;
+    /// The allocator of the elements returned by Index(). Guarded by DenseBase::mutex_.
+    mutable BlockAllocator<Scalar<T>> element_allocator_;
+};
+
+/// Calls @p f with the index and value of each element of @p dense in order, until @p f returns
+/// false. Each element is passed as a temporary Scalar that is only valid for the duration of the
+/// call, so unlike Index() this does not lock, allocate or keep anything.
+/// @param dense the dense array
+/// @param f the function to call, with the signature `bool(size_t index, const Value* element)`
+/// @returns false if @p f returned false, otherwise true
+template <typename F>
+bool ForEachElement(const DenseBase* dense, F&& f) {
+    auto each = [&](auto* d) {
+        using T = std::decay_t<decltype(d->values[0])>;
+        for (size_t i = 0; i < d->values.Length(); i++) {
+            const Scalar<T> el(d->el_type, d->values[i]);
+            if (!f(i, static_cast<const Value*>(&el))) {
+                return false;
+            }
+        }
+        return true;
+    };
+    return Switch(
+        dense,                                             //
+        [&](const Dense<AInt>* d) { return each(d); },     //
+        [&](const Dense<AFloat>* d) { return each(d); },   //
+        [&](const Dense<i32>* d) { return each(d); },      //
+        [&](const Dense<u32>* d) { return each(d); },      //
+        [&](const Dense<f32>* d) { return each(d); },      //
+        [&](const Dense<f16>* d) { return each(d); },      //
+        [&](const Dense<bool>* d) { return each(d); },     //
+        TINT_ICE_ON_NO_MATCH);
+}
+
+}  // namespace tint::core::constant
+
+#endif  // SRC_TINT_LANG_CORE_CONSTANT_DENSE_H_
@@ -0,0 +1,213 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/core/constant/dense.h"
+
+#include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/helper_test.h"
+#include "src/tint/lang/core/constant/scalar.h"
+#include "src/tint/lang/core/constant/splat.h"
+#include "src/tint/lang/core/fluent_types.h"
+#include "src/tint/lang/core/type/abstract_float.h"
+#include "src/tint/lang/core/type/array.h"
+
+using namespace tint::core::number_suffixes;  // NOLINT
+using namespace tint::core::fluent_types;     // NOLINT
+
+namespace tint::core::constant {
+namespace {
+
+constexpr uint32_t kN = Manager::kMinDenseElements;
+
+class ConstantTest_Dense : public TestHelper {
+  protected:
+    /// @returns the array type of @p n abstract-floats, as made by the resolver
+    const core::type::Array* AbstractFloatArray(uint32_t n) {
+        return constants.types.Get<core::type::Array>(
+            constants.types.AFloat(), constants.types.Get<core::type::ConstantArrayCount>(n), 0u,
+            0u, 0u, 0u);
+    }
+
+    /// @returns the scalars `0, 1, ... n-1` of type T
+    template <typename T>
+    Vector<const Value*, 0> Ramp(uint32_t n) {
+        Vector<const Value*, 0> elements;
+        for (uint32_t i = 0; i < n; i++) {
+            elements.Push(constants.Get(T(static_cast<float>(i))));
+        }
+        return elements;
+    }
+
+    /// @returns the values `0, 1, ... n-1` of type f32
+    Vector<f32, 0> RampValues(uint32_t n) {
+        Vector<f32, 0> values;
+        for (uint32_t i = 0; i < n; i++) {
+            values.Push(f32(static_cast<float>(i)));
+        }
+        return values;
+    }
+};
+
+TEST_F(ConstantTest_Dense, CompositeOfAbstractReturnsDense) {
+    auto* arr = AbstractFloatArray(kN);
+    auto* c = constants.Composite(arr, Ramp<AFloat>(kN));
+    ASSERT_TRUE(c->Is<Dense<AFloat>>());
+    EXPECT_EQ(c->Type(), arr);
+    EXPECT_EQ(c->NumElements(), kN);
+}
+
+TEST_F(ConstantTest_Dense, CompositeOfConcreteReturnsComposite) {
+    // The element Scalars already exist, so a Dense would only add a copy of the values.
+    auto* arr = constants.types.array(constants.types.f32(), kN);
+    EXPECT_TRUE(constants.Composite(arr, Ramp<f32>(kN))->Is<Composite>());
+}
+
+TEST_F(ConstantTest_Dense, CompositeBelowThreshold) {
+    auto* arr = AbstractFloatArray(kN - 1);
+    EXPECT_TRUE(constants.Composite(arr, Ramp<AFloat>(kN - 1))->Is<Composite>());
+}
+
+TEST_F(ConstantTest_Dense, CompositeOfVectors) {
+    auto* vec2f = constants.types.vec2(constants.types.f32());
+    auto* arr = constants.types.array(vec2f, kN);
+    Vector<const Value*, 0> elements;
+    for (uint32_t i = 0; i < kN; i++) {
+        auto* el = constants.Get(f32(static_cast<float>(i)));
+        elements.Push(constants.Composite(vec2f, Vector{el, constants.Get(0_f)}));
+    }
+    EXPECT_TRUE(constants.Composite(arr, std::move(elements))->Is<Composite>());
+}
+
+TEST_F(ConstantTest_Dense, CompositeSplat) {
+    auto* arr = AbstractFloatArray(kN);
+    Vector<const Value*, 0> elements;
+    elements.Resize(kN, constants.Get(1.0_a));
+    EXPECT_TRUE(constants.Composite(arr, std::move(elements))->Is<Splat>());
+}
+
+TEST_F(ConstantTest_Dense, ManagerDense) {
+    auto* arr = constants.types.array(constants.types.i32(), kN);
+    Vector<i32, 0> values;
+    for (uint32_t i = 0; i < kN; i++) {
+        values.Push(i32(static_cast<int32_t>(i)));
+    }
+    auto* a = constants.Dense<i32>(arr, values);
+    auto* b = constants.Dense<i32>(arr, values);
+    ASSERT_TRUE(a->Is<Dense<i32>>());
+    EXPECT_EQ(a, b);
+
+    auto* small = constants.types.array(constants.types.i32(), 2u);
+    EXPECT_TRUE(constants.Dense<i32>(small, Vector{1_i, 2_i})->Is<Composite>());
+    EXPECT_TRUE(constants.Dense<i32>(small, Vector{3_i, 3_i})->Is<Splat>());
+}
+
+TEST_F(ConstantTest_Dense, Index) {
+    auto* arr = constants.types.array(constants.types.f32(), kN);
+    auto* c = constants.Dense<f32>(arr, RampValues(kN))->As<Dense<f32>>();
+    ASSERT_NE(c, nullptr);
+
+    for (uint32_t i = 0; i < kN; i++) {
+        auto* el = c->Index(i);
+        ASSERT_TRUE(el->Is<Scalar<f32>>());
+        EXPECT_EQ(el->Type(), constants.types.f32());
+        EXPECT_EQ(el->ValueAs<f32>(), f32(static_cast<float>(i)));
+        // The element is created once.
+        EXPECT_EQ(c->Index(i), el);
+    }
+    EXPECT_EQ(c->Index(kN), nullptr);
+}
+
+TEST_F(ConstantTest_Dense, ScalarAt) {
+    auto* arr = constants.types.array(constants.types.f32(), kN);
+    auto* c = constants.Dense<f32>(arr, RampValues(kN))->As<DenseBase>();
+    ASSERT_NE(c, nullptr);
+
+    EXPECT_EQ(c->ScalarAt(constants, 3), constants.Get(3_f));
+    EXPECT_EQ(c->ScalarAt(constants, kN), nullptr);
+}
+
+TEST_F(ConstantTest_Dense, Hash) {
+    auto* arr = constants.types.array(constants.types.f32(), kN);
+    auto* dense = constants.Dense<f32>(arr, RampValues(kN));
+    ASSERT_TRUE(dense->Is<Dense<f32>>());
+
+    // A Composite of the same elements hashes the same, so that the two compare as equal in the
+    // constant manager.
+    Composite composite(arr, Ramp<f32>(kN), false, true);
+    EXPECT_EQ(dense->Hash(), composite.Hash());
+    EXPECT_TRUE(dense->Equal(&composite));
+    EXPECT_TRUE(composite.Equal(dense));
+}
+
+TEST_F(ConstantTest_Dense, Equal) {
+    auto* arr = constants.types.array(constants.types.f32(), kN);
+    auto* a = constants.Dense<f32>(arr, RampValues(kN));
+
+    constant::Manager mgr;
+    auto* b = mgr.Dense<f32>(arr, RampValues(kN));
+    auto values = RampValues(kN);
+    values[kN - 1] = 100_f;
+    auto* c = constants.Dense<f32>(arr, std::move(values));
+
+    EXPECT_TRUE(a->Equal(b));
+    EXPECT_FALSE(a->Equal(c));
+}
+
+TEST_F(ConstantTest_Dense, AllZeroAnyZero) {
+    auto* arr = constants.types.array(constants.types.f32(), kN);
+    auto* ramp = constants.Dense<f32>(arr, RampValues(kN));
+    EXPECT_FALSE(ramp->AllZero());
+    EXPECT_TRUE(ramp->AnyZero());
+
+    auto values = RampValues(kN);
+    values[0] = -1_f;
+    auto* no_zero = constants.Dense<f32>(arr, std::move(values));
+    ASSERT_TRUE(no_zero->Is<Dense<f32>>());
+    EXPECT_FALSE(no_zero->AllZero());
+    EXPECT_FALSE(no_zero->AnyZero());
+}
+
+TEST_F(ConstantTest_Dense, Clone) {
+    auto* arr = constants.types.array(constants.types.f32(), kN);
+    auto* dense = constants.Dense<f32>(arr, RampValues(kN))->As<Dense<f32>>();
+    ASSERT_NE(dense, nullptr);
+
+    constant::Manager mgr;
+    constant::CloneContext ctx{core::type::CloneContext{{nullptr}, {nullptr, &mgr.types}}, mgr};
+
+    auto* r = dense->Clone(ctx);
+    ASSERT_NE(r, nullptr);
+    EXPECT_NE(r, dense);
+    EXPECT_TRUE(r->type->Is<core::type::Array>());
+    EXPECT_FALSE(r->all_zero);
+    EXPECT_TRUE(r->any_zero);
+    ASSERT_EQ(r->values.Length(), kN);
+    EXPECT_EQ(r->values[5], 5_f);
+}
+
+}  // namespace
+}  // namespace tint::core::constant
@@ -36,6 +36,7 @@
 #include <utility>
 
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/constant/value.h"
@@ -327,6 +328,40 @@ const ScalarBase* ScalarConvert(const Scalar<T>* scalar,
     TINT_END_DISABLE_WARNING(UNREACHABLE_CODE);
 }
 
+/// Converts the elements of the dense array to the element type of the array type `target_ty`,
+/// without creating a Scalar for each element.
+/// @returns the converted array, or nullptr if an element cannot be converted exactly. In this case
+/// the elements should be converted with ScalarConvert(), which reports the conversion errors.
+template <typename FROM>
+const Value* DenseConvert(const Dense<FROM>* dense,
+                          const core::type::Type* target_ty,
+                          ConvertContext& ctx) {
+    if (target_ty == dense->type) {
+        // If the types are identical, then no conversion is needed.
+        return dense;
+    }
+    auto* target_el_ty = target_ty->Elements().type;
+    return ZeroTypeDispatch(target_el_ty, [&](auto zero_to) -> const Value* {
+        using TO = std::decay_t<decltype(zero_to)>;
+        Vector<TO, 0> values;
+        values.Reserve(dense->values.Length());
+        for (auto& value : dense->values) {
+            if constexpr (std::is_same_v<TO, bool>) {
+                // [x -> bool]
+                values.Push(!(value == FROM(0)));
+            } else if constexpr (std::is_same_v<FROM, bool>) {
+                // [bool -> x]
+                values.Push(TO(value ? 1 : 0));
+            } else if (auto conv = CheckedConvert<TO>(value); conv == Success) {
+                values.Push(conv.Get());
+            } else {
+                return nullptr;
+            }
+        }
+        return ctx.mgr.Dense<TO>(target_ty, std::move(values));
+    });
+}
+
 /// Converts the constant value to the target type.
 /// @returns the converted value, or nullptr on error.
 const Value* ConvertInternal(const Value* root_value,
@@ -378,6 +413,34 @@ const Value* ConvertInternal(const Value* root_value,
 
         auto* convert = std::get_if<ActionConvert>(&next);
 
+        // Converts each of the elements of the composite value, then builds the new composite from
+        // the converted elements.
+        auto convert_elements = [&](const Value* composite) {
+            const size_t el_count = composite->NumElements();
+
+            // Build the new composite from the converted element types.
+            pending.Push(ActionBuildComposite{el_count, convert->target_ty});
+
+            if (auto* str = convert->target_ty->As<core::type::Struct>()) {
+                if (TINT_UNLIKELY(str->Members().Length() != el_count)) {
+                    TINT_ICE()
+                        << "const-eval conversion of structure has mismatched element counts";
+                }
+                // Struct composites can have different types for each member.
+                auto members = str->Members();
+                for (size_t i = 0; i < el_count; i++) {
+                    pending.Push(ActionConvert{composite->Index(i), members[i]->Type()});
+                }
+            } else {
+                // Non-struct composites have the same type for all elements.
+                auto* el_ty = convert->target_ty->Elements(convert->target_ty).type;
+                for (size_t i = 0; i < el_count; i++) {
+                    auto* el = composite->Index(i);
+                    pending.Push(ActionConvert{el, el_ty});
+                }
+            }
+        };
+
         bool ok = Switch(
             convert->value,
             [&](const ScalarBase* scalar) {
@@ -435,31 +498,28 @@ const Value* ConvertInternal(const Value* root_value,
                 pending.Push(ActionConvert{splat->el, target_el_ty});
                 return true;
             },
-            [&](const Composite* composite) {
-                const size_t el_count = composite->NumElements();
-
-                // Build the new composite from the converted element types.
-                pending.Push(ActionBuildComposite{el_count, convert->target_ty});
-
-                if (auto* str = convert->target_ty->As<core::type::Struct>()) {
-                    if (TINT_UNLIKELY(str->Members().Length() != el_count)) {
-                        TINT_ICE()
-                            << "const-eval conversion of structure has mismatched element counts";
-                    }
-                    // Struct composites can have different types for each member.
-                    auto members = str->Members();
-                    for (size_t i = 0; i < el_count; i++) {
-                        pending.Push(ActionConvert{composite->Index(i), members[i]->Type()});
-                    }
-                } else {
-                    // Non-struct composites have the same type for all elements.
-                    auto* el_ty = convert->target_ty->Elements(convert->target_ty).type;
-                    for (size_t i = 0; i < el_count; i++) {
-                        auto* el = composite->Index(i);
-                        pending.Push(ActionConvert{el, el_ty});
-                    }
+            [&](const DenseBase* dense) {
+                auto* converted = Switch(
+                    dense,  //
+                    [&](const Dense<AFloat>* d) {
+                        return DenseConvert(d, convert->target_ty, ctx);
+                    },
+                    [&](const Dense<AInt>* d) { return DenseConvert(d, convert->target_ty, ctx); },
+                    [&](const Dense<u32>* d) { return DenseConvert(d, convert->target_ty, ctx); },
+                    [&](const Dense<i32>* d) { return DenseConvert(d, convert->target_ty, ctx); },
+                    [&](const Dense<f32>* d) { return DenseConvert(d, convert->target_ty, ctx); },
+                    [&](const Dense<f16>* d) { return DenseConvert(d, convert->target_ty, ctx); },
+                    [&](const Dense<bool>* d) { return DenseConvert(d, convert->target_ty, ctx); });
+                if (converted) {
+                    value_stack.Push(converted);
+                    return true;
                 }
-
+                // An element could not be converted. Convert each element to report the error.
+                convert_elements(dense);
+                return true;
+            },
+            [&](const Composite* composite) {
+                convert_elements(composite);
                 return true;
             });
         if (!ok) {
@@ -28,6 +28,7 @@
 #include "src/tint/lang/core/constant/manager.h"
 
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/invalid.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
@@ -49,6 +50,42 @@
 
 namespace tint::core::constant {
 
+namespace {
+
+/// @returns a constant::Dense of the array type @p type holding the values of the scalars
+/// @p elements, or nullptr if the elements are not of the scalar type `Scalar<T>`.
+template <typename T>
+const constant::Value* DenseFromScalars(Manager& mgr,
+                                        const core::type::Type* type,
+                                        VectorRef<const constant::Value*> elements) {
+    Vector<T, 0> values;
+    values.Reserve(elements.Length());
+    for (auto* el : elements) {
+        auto* scalar = el->As<Scalar<T>>();
+        if (TINT_UNLIKELY(!scalar)) {
+            return nullptr;
+        }
+        values.Push(scalar->value);
+    }
+    return mgr.Get<constant::Dense<T>>(type, std::move(values));
+}
+
+/// @returns a constant::Dense of the array type @p type holding the values of the scalars
+/// @p elements, or nullptr if the array element type is not abstract.
+const constant::Value* DenseFromScalars(Manager& mgr,
+                                        const core::type::Array* type,
+                                        VectorRef<const constant::Value*> elements) {
+    return Switch(
+        type->ElemType(),  //
+        [&](const core::type::AbstractInt*) { return DenseFromScalars<AInt>(mgr, type, elements); },
+        [&](const core::type::AbstractFloat*) {
+            return DenseFromScalars<AFloat>(mgr, type, elements);
+        },
+        [&](Default) -> const constant::Value* { return nullptr; });
+}
+
+}  // namespace
+
 Manager::Manager() = default;
 
 Manager::Manager(Manager&&) = default;
@@ -85,9 +122,56 @@ const constant::Value* Manager::Composite(const core::type::Type* type,
         return Splat(type, elements.Front());
     }
 
+    // Arrays of abstract scalars are held densely, so that converting them to a concrete type
+    // builds the converted array from the values, without a Scalar for each element. The Scalars
+    // of the elements already exist, so a Dense of a concrete type would only copy the values.
+    if (elements.Length() >= kMinDenseElements) {
+        if (auto* arr = type->As<core::type::Array>()) {
+            if (auto* dense = DenseFromScalars(*this, arr, elements)) {
+                return dense;
+            }
+        }
+    }
+
     return Get<constant::Composite>(type, std::move(elements), all_zero, any_zero);
 }
 
+template <typename T>
+const constant::Value* Manager::Dense(const core::type::Type* type, VectorRef<T> values) {
+    if (values.IsEmpty()) {
+        return nullptr;
+    }
+
+    bool all_equal = true;
+    for (auto& value : values) {
+        if (!(value == values.Front())) {
+            all_equal = false;
+            break;
+        }
+    }
+    if (all_equal) {
+        return Splat(type, Get(values.Front()));
+    }
+
+    if (values.Length() < kMinDenseElements) {
+        Vector<const constant::Value*, kMinDenseElements> elements;
+        for (auto& value : values) {
+            elements.Push(Get(value));
+        }
+        return Composite(type, std::move(elements));
+    }
+
+    return Get<constant::Dense<T>>(type, std::move(values));
+}
+
+template const constant::Value* Manager::Dense(const core::type::Type*, VectorRef<AInt>);
+template const constant::Value* Manager::Dense(const core::type::Type*, VectorRef<AFloat>);
+template const constant::Value* Manager::Dense(const core::type::Type*, VectorRef<i32>);
+template const constant::Value* Manager::Dense(const core::type::Type*, VectorRef<u32>);
+template const constant::Value* Manager::Dense(const core::type::Type*, VectorRef<f16>);
+template const constant::Value* Manager::Dense(const core::type::Type*, VectorRef<f32>);
+template const constant::Value* Manager::Dense(const core::type::Type*, VectorRef<bool>);
+
 const constant::Splat* Manager::Splat(const core::type::Type* type,
                                       const constant::Value* element) {
     return Get<constant::Splat>(type, element);
@@ -97,8 +97,9 @@ class Manager final {
 
     /// Constructs a constant of a vector, matrix or array type.
     ///
-    /// Examines the element values and will return either a constant::Composite or a
-    /// constant::Splat, depending on the element types and values.
+    /// Examines the element values and will return either a constant::Composite, a
+    /// constant::Splat, or a constant::Dense for large arrays of abstract scalars, depending on the
+    /// element types and values.
     ///
     /// @param type the composite type
     /// @param elements the composite elements
@@ -106,6 +107,18 @@ class Manager final {
     const constant::Value* Composite(const core::type::Type* type,
                                      VectorRef<const constant::Value*> elements);
 
+    /// Constructs a constant of an array of scalars type from the element values.
+    ///
+    /// Examines the element values and will return either a constant::Dense, a constant::Composite
+    /// or a constant::Splat. Unlike Composite(), a constant::Dense is returned for arrays of any
+    /// scalar type with at least kMinDenseElements elements, as no Scalar is created for them.
+    ///
+    /// @param type the array type
+    /// @param values the element values
+    /// @returns the value pointer
+    template <typename T>
+    const constant::Value* Dense(const core::type::Type* type, VectorRef<T> values);
+
     /// Constructs a splat constant.
     /// @param type the splat type
     /// @param element the splat element
@@ -160,6 +173,10 @@ class Manager final {
     /// The type manager
     core::type::Manager types;
 
+    /// The minimum number of elements of an array of scalars for Composite() and Dense() to return
+    /// a constant::Dense.
+    static constexpr size_t kMinDenseElements = 16;
+
   private:
     /// A specialization of Hasher for constant::Value
     struct Hasher {
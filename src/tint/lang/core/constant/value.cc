@@ -27,6 +27,7 @@
 
 #include "src/tint/lang/core/constant/value.h"
 
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/type/array.h"
 #include "src/tint/lang/core/type/invalid.h"
@@ -60,6 +61,13 @@ bool Value::Equal(const constant::Value* b) const {
             return true;
         }
 
+        // Compare the values of dense arrays directly, instead of creating their elements
+        if (auto* a_dense = As<DenseBase>()) {
+            if (auto* b_dense = b->As<DenseBase>()) {
+                return a_dense->ElementsEqual(b_dense);
+            }
+        }
+
         // Avoid per-element comparisons if the constants are splats
         bool a_is_splat = Is<Splat>();
         bool b_is_splat = b->Is<Splat>();
@@ -33,6 +33,7 @@
 #include "src/tint/lang/core/builtin_fn.h"
 #include "src/tint/lang/core/builtin_value.h"
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/ir/access.h"
@@ -604,6 +605,9 @@ struct Encoder {
                 [&](const core::constant::Composite* composite) {
                     ConstantValueComposite(*constant_out.mutable_composite(), composite);
                 },
+                [&](const core::constant::DenseBase* dense) {
+                    ConstantValueDense(*constant_out.mutable_composite(), dense);
+                },
                 [&](const core::constant::Splat* splat) {
                     ConstantValueSplat(*constant_out.mutable_splat(), splat);
                 },
@@ -622,6 +626,14 @@ struct Encoder {
         }
     }
 
+    void ConstantValueDense(pb::ConstantValueComposite& composite_out,
+                            const core::constant::DenseBase* dense_in) {
+        composite_out.set_type(Type(dense_in->type));
+        for (size_t i = 0, n = dense_in->NumElements(); i < n; i++) {
+            composite_out.add_elements(ConstantValue(dense_in->Index(i)));
+        }
+    }
+
     void ConstantValueSplat(pb::ConstantValueSplat& splat_out,
                             const core::constant::Splat* splat_in) {
         splat_out.set_type(Type(splat_in->type));
@@ -35,6 +35,7 @@
 #include "src//tint/lang/core/ir/unary.h"
 #include "src/tint/lang/core/binary_op.h"
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/ir/binary.h"
@@ -442,6 +443,16 @@ void Disassembler::EmitValue(const Value* val) {
                             }
                             out_ << ")";
                         },
+                        [&](const core::constant::DenseBase* dense) {
+                            out_ << NameOf(dense->Type()) << "(";
+                            for (size_t i = 0; i < dense->NumElements(); i++) {
+                                if (i > 0) {
+                                    out_ << ", ";
+                                }
+                                emit(dense->Index(i));
+                            }
+                            out_ << ")";
+                        },
                         TINT_ICE_ON_NO_MATCH);
                 };
             emit(constant->Value());
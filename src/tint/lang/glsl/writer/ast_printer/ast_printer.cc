@@ -35,6 +35,7 @@
 #include <utility>
 #include <vector>
 
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/constant/value.h"
 #include "src/tint/lang/core/fluent_types.h"
@@ -2293,6 +2294,18 @@ void ASTPrinter::EmitConstant(StringStream& out, const core::constant::Value* co
                 return;
             }
 
+            if (auto* dense = constant->As<core::constant::DenseBase>()) {
+                core::constant::ForEachElement(
+                    dense, [&](size_t i, const core::constant::Value* el) {
+                        if (i > 0) {
+                            out << ", ";
+                        }
+                        EmitConstant(out, el);
+                        return true;
+                    });
+                return;
+            }
+
             for (size_t i = 0; i < count; i++) {
                 if (i > 0) {
                     out << ", ";
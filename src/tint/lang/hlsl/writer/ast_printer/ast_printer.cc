@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "src/tint/api/common/binding_point.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/constant/value.h"
 #include "src/tint/lang/core/fluent_types.h"
@@ -3747,6 +3748,16 @@ bool ASTPrinter::EmitConstant(StringStream& out,
                 return false;
             }
 
+            if (auto* dense = constant->As<core::constant::DenseBase>()) {
+                return core::constant::ForEachElement(
+                    dense, [&](size_t i, const core::constant::Value* el) {
+                        if (i > 0) {
+                            out << ", ";
+                        }
+                        return EmitConstant(out, el, is_variable_initializer);
+                    });
+            }
+
             for (size_t i = 0; i < count; i++) {
                 if (i > 0) {
                     out << ", ";
@@ -39,6 +39,7 @@
 #include "src/tint/lang/core/access.h"
 #include "src/tint/lang/core/address_space.h"
 #include "src/tint/lang/core/builtin_value.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/constant/value.h"
 #include "src/tint/lang/core/fluent_types.h"
@@ -1149,6 +1150,18 @@ class Printer : public tint::TextGenerator {
         auto count = a->ConstantCount();
         TINT_ASSERT(count.has_value() && count.value() > 0);
 
+        if (auto* dense = c->As<core::constant::DenseBase>()) {
+            core::constant::ForEachElement(dense, [&](size_t i, const core::constant::Value* el) {
+                if (i > 0) {
+                    out << ", ";
+                }
+                EmitConstant(out, el);
+                return true;
+            });
+            out << "}";
+            return;
+        }
+
         for (size_t i = 0; i < count; i++) {
             if (i > 0) {
                 out << ", ";
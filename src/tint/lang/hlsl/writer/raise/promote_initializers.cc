@@ -27,6 +27,7 @@
 
 #include "src/tint/lang/hlsl/writer/raise/promote_initializers.h"
 
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/ir/builder.h"
 #include "src/tint/lang/core/ir/validator.h"
 
@@ -187,6 +188,10 @@ struct State {
             for (auto v : const_val->elements) {
                 args.Push(b.Constant(v));
             }
+        } else if (auto* dense_val = val->Value()->As<core::constant::DenseBase>()) {
+            for (size_t i = 0; i < dense_val->NumElements(); i++) {
+                args.Push(b.Constant(dense_val->ScalarAt(ir.constant_values, i)));
+            }
         } else if (auto* splat_val = val->Value()->As<core::constant::Splat>()) {
             for (uint32_t i = 0; i < splat_val->NumElements(); i++) {
                 args.Push(b.Constant(splat_val->el));
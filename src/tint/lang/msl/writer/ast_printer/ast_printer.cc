@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "src/tint/api/common/binding_point.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/constant/value.h"
 #include "src/tint/lang/core/fluent_types.h"
@@ -1850,6 +1851,16 @@ bool ASTPrinter::EmitConstant(StringStream& out, const core::constant::Value* co
                 return false;
             }
 
+            if (auto* dense = constant->As<core::constant::DenseBase>()) {
+                return core::constant::ForEachElement(
+                    dense, [&](size_t i, const core::constant::Value* el) {
+                        if (i > 0) {
+                            out << ", ";
+                        }
+                        return EmitConstant(out, el);
+                    });
+            }
+
             for (size_t i = 0; i < count; i++) {
                 if (i > 0) {
                     out << ", ";
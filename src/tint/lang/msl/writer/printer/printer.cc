@@ -34,6 +34,7 @@
 #include <utility>
 
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/fluent_types.h"
 #include "src/tint/lang/core/ir/access.h"
@@ -1531,6 +1532,17 @@ class Printer : public tint::TextGenerator {
                 if (!count) {
                     TINT_IR_ICE(ir_) << core::type::Array::kErrExpectedConstantCount;
                 }
+                if (auto* dense = c->As<core::constant::DenseBase>()) {
+                    core::constant::ForEachElement(
+                        dense, [&](size_t i, const core::constant::Value* el) {
+                            if (i > 0) {
+                                out << ", ";
+                            }
+                            EmitConstant(out, el);
+                            return true;
+                        });
+                    return;
+                }
                 emit_values(*count);
             },
             [&](const core::type::Struct* s) {
@@ -208,6 +208,7 @@ tint_target_add_dependencies(tint_lang_spirv_writer_bench bench
 
 tint_target_add_external_dependencies(tint_lang_spirv_writer_bench bench
   "google-benchmark"
+  "thread"
 )
 
 if(TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_READER AND TINT_BUILD_WGSL_WRITER)
@@ -38,8 +38,12 @@ Function::Function(const Instruction& declaration,
 
 Function::Function(const Function& other) = default;
 
+Function::Function(Function&& other) = default;
+
 Function& Function::operator=(const Function& other) = default;
 
+Function& Function::operator=(Function&& other) = default;
+
 Function::~Function() = default;
 
 void Function::iterate(std::function<void(const Instruction&)> cb) const {
@@ -61,4 +65,23 @@ void Function::iterate(std::function<void(const Instruction&)> cb) const {
     cb(Instruction{spv::Op::OpFunctionEnd, {}});
 }
 
+void Function::iterate_mutable(std::function<void(Instruction&)> cb) {
+    cb(declaration_);
+
+    for (auto& param : params_) {
+        cb(param);
+    }
+
+    Instruction label{spv::Op::OpLabel, {label_op_}};
+    cb(label);
+    label_op_ = label.operands()[0];
+
+    for (auto& var : vars_) {
+        cb(var);
+    }
+    for (auto& inst : instructions_) {
+        cb(inst);
+    }
+}
+
 }  // namespace tint::spirv::writer
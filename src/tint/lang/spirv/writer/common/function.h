@@ -51,10 +51,17 @@ class Function {
     /// Copy constructor
     /// @param other the function to copy
     Function(const Function& other);
+    /// Move constructor
+    /// @param other the function to move
+    Function(Function&& other);
     /// Copy assignment operator
     /// @param other the function to copy
     /// @returns the new Function
     Function& operator=(const Function& other);
+    /// Move assignment operator
+    /// @param other the function to move
+    /// @returns the new Function
+    Function& operator=(Function&& other);
     /// Destructor
     ~Function();
 
@@ -62,6 +69,11 @@ class Function {
     /// @param cb the callback to call
     void iterate(std::function<void(const Instruction&)> cb) const;
 
+    /// Iterates over the function calling the cb on each instruction, allowing the cb to modify the
+    /// instruction operands. The entry block label is passed to the cb as an OpLabel instruction.
+    /// @param cb the callback to call
+    void iterate_mutable(std::function<void(Instruction&)> cb);
+
     /// @returns the declaration
     const Instruction& declaration() const { return declaration_; }
 
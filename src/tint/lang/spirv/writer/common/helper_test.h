@@ -136,6 +136,20 @@ class SpirvWriterTestHelperBase : public BASE {
             return false;
         }
 
+        // Emitting the functions on multiple threads must produce identical SPIR-V.
+        auto parallel = PrintModule(mod, zero_init_workgroup_memory, 4);
+        if (parallel != Success) {
+            err_ = parallel.Failure().reason.Str();
+            return false;
+        }
+        if (parallel->Code() != spirv->Code()) {
+            err_ = "SPIR-V differs when functions are emitted on multiple threads:\n" +
+                   Disassemble(parallel->Code(), SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES |
+                                                     SPV_BINARY_TO_TEXT_OPTION_INDENT |
+                                                     SPV_BINARY_TO_TEXT_OPTION_COMMENT);
+            return false;
+        }
+
         spirv_ = std::move(spirv.Get());
         return true;
     }
@@ -57,6 +57,9 @@ class Instruction {
     /// @returns the instructions operands
     const OperandList& operands() const { return operands_; }
 
+    /// @returns the instructions operands
+    OperandList& operands() { return operands_; }
+
     /// @returns the number of uint32_t's needed to hold the instruction
     uint32_t word_length() const;
 
@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/tint/lang/spirv/writer/common/function.h"
@@ -170,6 +171,10 @@ class Module {
     /// @param func the function to add
     void PushFunction(const Function& func) { functions_.push_back(func); }
 
+    /// Add a function to the module.
+    /// @param func the function to add
+    void PushFunction(Function&& func) { functions_.push_back(std::move(func)); }
+
     /// @returns the functions
     const std::vector<Function>& Functions() const { return functions_; }
 
@@ -178,6 +178,10 @@ struct Options {
     /// Set to `true` to disable the polyfills on integer division and modulo.
     bool disable_polyfill_integer_div_mod = false;
 
+    /// The number of threads to use to emit the module's functions. Values less than 2 emit all
+    /// functions on the calling thread. The generated SPIR-V does not depend on this value.
+    uint32_t function_emission_threads = 0;
+
     /// Reflect the fields of this class so that it can be used by tint::ForeachField()
     TINT_REFLECT(Options,
                  bindings,
@@ -193,7 +197,8 @@ struct Options {
                  pass_matrix_by_pointer,
                  experimental_require_subgroup_uniform_control_flow,
                  polyfill_dot_4x8_packed,
-                 disable_polyfill_integer_div_mod);
+                 disable_polyfill_integer_div_mod,
+                 function_emission_threads);
 };
 
 }  // namespace tint::spirv::writer
@@ -72,6 +72,7 @@ tint_target_add_dependencies(tint_lang_spirv_writer_printer lib
   tint_utils_result
   tint_utils_rtti
   tint_utils_symbol
+  tint_utils_system
   tint_utils_text
   tint_utils_traits
 )
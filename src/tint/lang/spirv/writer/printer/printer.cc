@@ -27,7 +27,13 @@
 
 #include "src/tint/lang/spirv/writer/printer/printer.h"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "spirv/unified1/GLSL.std.450.h"
 #include "spirv/unified1/spirv.h"
@@ -35,6 +41,7 @@
 #include "src/tint/lang/core/access.h"
 #include "src/tint/lang/core/address_space.h"
 #include "src/tint/lang/core/builtin_value.h"
+#include "src/tint/lang/core/constant/dense.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/constant/value.h"
@@ -106,10 +113,12 @@
 #include "src/tint/utils/containers/hashmap.h"
 #include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/diagnostic/diagnostic.h"
+#include "src/tint/utils/macros/defer.h"
 #include "src/tint/utils/macros/scoped_assignment.h"
 #include "src/tint/utils/result/result.h"
 #include "src/tint/utils/rtti/switch.h"
 #include "src/tint/utils/symbol/symbol.h"
+#include "src/tint/utils/system/parallel_for.h"
 
 using namespace tint::core::fluent_types;     // NOLINT
 using namespace tint::core::number_suffixes;  // NOLINT
@@ -119,6 +128,204 @@ namespace {
 
 constexpr uint32_t kWriterVersion = 1;
 
+/// The first result ID used by a function emitted on a worker thread. IDs from this value upwards
+/// are local to the function, and are replaced with module IDs when the function is merged into the
+/// module.
+constexpr uint32_t kLocalIdBase = 0x80000000u;
+
+/// @returns true if the operand at @p index of an instruction with the opcode @p op is a literal
+/// number according to the SPIR-V grammar, or std::nullopt if @p op is not classified here.
+/// Literal numbers may hold any 32-bit value, and so must not be treated as local result IDs. The
+/// other operands are IDs, strings, or enumerants and masks, which are always less than
+/// kLocalIdBase. Functions that use an opcode that is not classified are not emitted in parallel.
+std::optional<bool> IsLiteralOperand(spv::Op op, size_t index) {
+    switch (op) {
+        case spv::Op::OpConstant:
+        case spv::Op::OpSpecConstant:
+            return index >= 2;
+        case spv::Op::OpSwitch:
+            return index >= 2 && index % 2 == 0;
+        case spv::Op::OpTypeInt:
+        case spv::Op::OpTypeFloat:
+            return index >= 1;
+        case spv::Op::OpDecorate:
+        case spv::Op::OpExecutionMode:
+        case spv::Op::OpTypeVector:
+        case spv::Op::OpTypeMatrix:
+            return index >= 2;
+        case spv::Op::OpTypeImage:
+            return index >= 3 && index <= 6;
+        case spv::Op::OpMemberName:
+            return index == 1;
+        case spv::Op::OpMemberDecorate:
+            return index == 1 || index >= 3;
+        case spv::Op::OpArrayLength:
+        case spv::Op::OpExtInst:
+            return index == 3;
+        case spv::Op::OpBranchConditional:
+        case spv::Op::OpCompositeExtract:
+        case spv::Op::OpLoopMerge:
+            return index >= 3;
+        case spv::Op::OpCompositeInsert:
+        case spv::Op::OpVectorShuffle:
+            return index >= 4;
+
+        case spv::Op::OpAccessChain:
+        case spv::Op::OpAll:
+        case spv::Op::OpAny:
+        case spv::Op::OpAtomicAnd:
+        case spv::Op::OpAtomicCompareExchange:
+        case spv::Op::OpAtomicExchange:
+        case spv::Op::OpAtomicIAdd:
+        case spv::Op::OpAtomicISub:
+        case spv::Op::OpAtomicLoad:
+        case spv::Op::OpAtomicOr:
+        case spv::Op::OpAtomicSMax:
+        case spv::Op::OpAtomicSMin:
+        case spv::Op::OpAtomicStore:
+        case spv::Op::OpAtomicUMax:
+        case spv::Op::OpAtomicUMin:
+        case spv::Op::OpAtomicXor:
+        case spv::Op::OpBitCount:
+        case spv::Op::OpBitFieldInsert:
+        case spv::Op::OpBitFieldSExtract:
+        case spv::Op::OpBitFieldUExtract:
+        case spv::Op::OpBitReverse:
+        case spv::Op::OpBitcast:
+        case spv::Op::OpBitwiseAnd:
+        case spv::Op::OpBitwiseOr:
+        case spv::Op::OpBitwiseXor:
+        case spv::Op::OpBranch:
+        case spv::Op::OpCapability:
+        case spv::Op::OpCompositeConstruct:
+        case spv::Op::OpConstantComposite:
+        case spv::Op::OpConstantFalse:
+        case spv::Op::OpConstantNull:
+        case spv::Op::OpConstantTrue:
+        case spv::Op::OpControlBarrier:
+        case spv::Op::OpConvertFToS:
+        case spv::Op::OpConvertFToU:
+        case spv::Op::OpConvertSToF:
+        case spv::Op::OpConvertUToF:
+        case spv::Op::OpDPdx:
+        case spv::Op::OpDPdxCoarse:
+        case spv::Op::OpDPdxFine:
+        case spv::Op::OpDPdy:
+        case spv::Op::OpDPdyCoarse:
+        case spv::Op::OpDPdyFine:
+        case spv::Op::OpDot:
+        case spv::Op::OpEntryPoint:
+        case spv::Op::OpExtInstImport:
+        case spv::Op::OpExtension:
+        case spv::Op::OpFAdd:
+        case spv::Op::OpFConvert:
+        case spv::Op::OpFDiv:
+        case spv::Op::OpFMul:
+        case spv::Op::OpFNegate:
+        case spv::Op::OpFOrdEqual:
+        case spv::Op::OpFOrdGreaterThan:
+        case spv::Op::OpFOrdGreaterThanEqual:
+        case spv::Op::OpFOrdLessThan:
+        case spv::Op::OpFOrdLessThanEqual:
+        case spv::Op::OpFOrdNotEqual:
+        case spv::Op::OpFRem:
+        case spv::Op::OpFSub:
+        case spv::Op::OpFUnordNotEqual:
+        case spv::Op::OpFunction:
+        case spv::Op::OpFunctionCall:
+        case spv::Op::OpFunctionEnd:
+        case spv::Op::OpFunctionParameter:
+        case spv::Op::OpFwidth:
+        case spv::Op::OpFwidthCoarse:
+        case spv::Op::OpFwidthFine:
+        case spv::Op::OpGroupNonUniformBallot:
+        case spv::Op::OpGroupNonUniformBroadcast:
+        case spv::Op::OpGroupNonUniformFAdd:
+        case spv::Op::OpGroupNonUniformFMul:
+        case spv::Op::OpGroupNonUniformIAdd:
+        case spv::Op::OpGroupNonUniformIMul:
+        case spv::Op::OpIAdd:
+        case spv::Op::OpIEqual:
+        case spv::Op::OpIMul:
+        case spv::Op::OpINotEqual:
+        case spv::Op::OpISub:
+        case spv::Op::OpImageDrefGather:
+        case spv::Op::OpImageFetch:
+        case spv::Op::OpImageGather:
+        case spv::Op::OpImageQueryLevels:
+        case spv::Op::OpImageQuerySamples:
+        case spv::Op::OpImageQuerySize:
+        case spv::Op::OpImageQuerySizeLod:
+        case spv::Op::OpImageRead:
+        case spv::Op::OpImageSampleDrefExplicitLod:
+        case spv::Op::OpImageSampleDrefImplicitLod:
+        case spv::Op::OpImageSampleExplicitLod:
+        case spv::Op::OpImageSampleImplicitLod:
+        case spv::Op::OpImageWrite:
+        case spv::Op::OpKill:
+        case spv::Op::OpLabel:
+        case spv::Op::OpLoad:
+        case spv::Op::OpLogicalAnd:
+        case spv::Op::OpLogicalEqual:
+        case spv::Op::OpLogicalNot:
+        case spv::Op::OpLogicalNotEqual:
+        case spv::Op::OpLogicalOr:
+        case spv::Op::OpMatrixTimesMatrix:
+        case spv::Op::OpMatrixTimesScalar:
+        case spv::Op::OpMatrixTimesVector:
+        case spv::Op::OpMemoryModel:
+        case spv::Op::OpName:
+        case spv::Op::OpNop:
+        case spv::Op::OpNot:
+        case spv::Op::OpPhi:
+        case spv::Op::OpQuantizeToF16:
+        case spv::Op::OpReturn:
+        case spv::Op::OpReturnValue:
+        case spv::Op::OpSDiv:
+        case spv::Op::OpSDot:
+        case spv::Op::OpSGreaterThan:
+        case spv::Op::OpSGreaterThanEqual:
+        case spv::Op::OpSLessThan:
+        case spv::Op::OpSLessThanEqual:
+        case spv::Op::OpSNegate:
+        case spv::Op::OpSRem:
+        case spv::Op::OpSampledImage:
+        case spv::Op::OpSelect:
+        case spv::Op::OpSelectionMerge:
+        case spv::Op::OpShiftLeftLogical:
+        case spv::Op::OpShiftRightArithmetic:
+        case spv::Op::OpShiftRightLogical:
+        case spv::Op::OpStore:
+        case spv::Op::OpTranspose:
+        case spv::Op::OpTypeArray:
+        case spv::Op::OpTypeBool:
+        case spv::Op::OpTypeFunction:
+        case spv::Op::OpTypePointer:
+        case spv::Op::OpTypeRuntimeArray:
+        case spv::Op::OpTypeSampledImage:
+        case spv::Op::OpTypeSampler:
+        case spv::Op::OpTypeStruct:
+        case spv::Op::OpTypeVoid:
+        case spv::Op::OpUDiv:
+        case spv::Op::OpUDot:
+        case spv::Op::OpUGreaterThan:
+        case spv::Op::OpUGreaterThanEqual:
+        case spv::Op::OpULessThan:
+        case spv::Op::OpULessThanEqual:
+        case spv::Op::OpUMod:
+        case spv::Op::OpUndef:
+        case spv::Op::OpUnreachable:
+        case spv::Op::OpVariable:
+        case spv::Op::OpVectorExtractDynamic:
+        case spv::Op::OpVectorTimesMatrix:
+        case spv::Op::OpVectorTimesScalar:
+            return false;
+
+        default:
+            return std::nullopt;
+    }
+}
+
 SpvStorageClass StorageClass(core::AddressSpace addrspace) {
     switch (addrspace) {
         case core::AddressSpace::kHandle:
@@ -190,8 +397,14 @@ class Printer {
     /// @param module the Tint IR module to generate
     /// @param zero_init_workgroup_memory `true` to initialize all the variables in the Workgroup
     ///                                   storage class with OpConstantNull
-    Printer(core::ir::Module& module, bool zero_init_workgroup_memory)
-        : ir_(module), b_(module), zero_init_workgroup_memory_(zero_init_workgroup_memory) {}
+    /// @param function_emission_threads the number of threads to use to emit functions
+    Printer(core::ir::Module& module,
+            bool zero_init_workgroup_memory,
+            uint32_t function_emission_threads)
+        : ir_(module),
+          b_(module),
+          zero_init_workgroup_memory_(zero_init_workgroup_memory),
+          function_emission_threads_(function_emission_threads) {}
 
     /// @returns the generated SPIR-V code on success, or failure
     Result<std::vector<uint32_t>> Code() {
@@ -291,6 +504,82 @@ class Printer {
 
     bool zero_init_workgroup_memory_ = false;
 
+    /// The number of threads to use to emit functions.
+    uint32_t function_emission_threads_ = 0;
+
+    /// The kinds of entity that a result ID can be allocated for.
+    enum class IdKind : uint8_t {
+        /// An ID that is only used by the function that allocated it.
+        kLocal,
+        /// A type, keyed by the deduplicated core::type::Type.
+        kType,
+        /// A constant, keyed by its core::constant::Value.
+        kConstant,
+        /// An OpConstantNull, keyed by its core::type::Type.
+        kConstantNull,
+        /// An OpUndef, keyed by its core::type::Type.
+        kUndef,
+        /// A function or module-scope variable, keyed by its core::ir::Value.
+        kValue,
+        /// A function type, keyed by an index into WorkerState::function_types.
+        kFunctionType,
+        /// An extended instruction set import, keyed by its name.
+        kImport,
+    };
+
+    /// The entity that a local result ID was allocated for.
+    struct IdOrigin {
+        /// The kind of entity.
+        IdKind kind = IdKind::kLocal;
+        /// The key of the entity in its map, for all kinds except kLocal and kFunctionType.
+        const void* key = nullptr;
+        /// The index of the key, for kFunctionType.
+        uint32_t index = 0;
+    };
+
+    /// The state of a printer that emits a single function on a worker thread.
+    /// The function is emitted with local result IDs, starting at kLocalIdBase, into a module that
+    /// only contains the declarations that the function uses. The main printer then replays the ID
+    /// allocations in function order, which produces the same IDs as serial emission, drops the
+    /// declarations that an earlier function has already made, and remaps the local IDs.
+    struct WorkerState {
+        /// The result of emitting the function.
+        Result<SuccessType> result = Success;
+        /// The emitted function.
+        Function function;
+        /// The origin of each local result ID, indexed by the ID minus kLocalIdBase.
+        Vector<IdOrigin, 64> id_origins;
+        /// The keys of the function types declared by the function.
+        Vector<FunctionType, 4> function_types;
+        /// The declaration that owns the module instructions that are currently being emitted, or
+        /// 0 if they are not part of a declaration.
+        uint32_t owner = 0;
+        /// The owners of the enclosing declarations.
+        Vector<uint32_t, 8> owner_stack;
+        /// The owner of each instruction of the module's extended instruction imports.
+        Vector<uint32_t, 4> ext_import_owners;
+        /// The owner of each instruction of the module's debug instructions.
+        Vector<uint32_t, 32> debug_owners;
+        /// The owner of each instruction of the module's type declarations.
+        Vector<uint32_t, 32> type_owners;
+        /// The owner of each instruction of the module's annotations.
+        Vector<uint32_t, 32> annot_owners;
+        /// The module ID of each local result ID, filled in when the function is merged.
+        Vector<uint32_t, 64> module_ids;
+        /// True for each local result ID of a declaration that an earlier function already made.
+        Vector<bool, 64> redundant;
+        /// True if the function or its declarations use an opcode whose operands are not
+        /// classified by IsLiteralOperand(), so their local IDs can't be remapped reliably.
+        bool has_unclassified_opcode = false;
+    };
+
+    /// The worker state, if this printer is emitting a single function on a worker thread.
+    std::unique_ptr<WorkerState> worker_;
+
+    /// The mutex that guards the creation of types and constants in the IR module, if functions
+    /// are being emitted on multiple threads.
+    std::mutex* ir_mutex_ = nullptr;
+
     /// Builds the SPIR-V from the IR
     Result<SuccessType> Generate() {
         auto valid = core::ir::ValidateAndDumpIfNeeded(ir_, "SPIR-V writer");
@@ -306,6 +595,9 @@ class Printer {
         EmitRootBlock(ir_.root_block);
 
         // Emit functions.
+        if (function_emission_threads_ > 1 && ir_.functions.Length() > 1) {
+            return EmitFunctionsInParallel();
+        }
         for (core::ir::Function* func : ir_.functions) {
             auto res = EmitFunction(func);
             if (res != Success) {
@@ -316,6 +608,262 @@ class Printer {
         return Success;
     }
 
+    /// Emits each function into its own module on a worker thread, and then merges the functions
+    /// into the module in order. The generated SPIR-V is identical to serial emission.
+    Result<SuccessType> EmitFunctionsInParallel() {
+        const size_t count = ir_.functions.Length();
+        std::mutex ir_mutex;
+        std::vector<std::unique_ptr<Printer>> workers(count);
+        ParallelFor(count, function_emission_threads_, [&](size_t i) {
+            auto worker = std::make_unique<Printer>(ir_, zero_init_workgroup_memory_, 0);
+            worker->worker_ = std::make_unique<WorkerState>();
+            worker->ir_mutex_ = &ir_mutex;
+            worker->worker_->result = worker->EmitFunction(ir_.functions[i]);
+            worker->worker_->has_unclassified_opcode = worker->HasUnclassifiedOpcode();
+            workers[i] = std::move(worker);
+        });
+
+        bool has_unclassified_opcode = false;
+        for (auto& worker : workers) {
+            if (worker->worker_->result != Success) {
+                return worker->worker_->result;
+            }
+            has_unclassified_opcode |= worker->worker_->has_unclassified_opcode;
+        }
+        if (has_unclassified_opcode) {
+            // The local IDs could be confused with literal numbers, emit the functions serially.
+            for (core::ir::Function* func : ir_.functions) {
+                auto res = EmitFunction(func);
+                if (res != Success) {
+                    return res;
+                }
+            }
+            return Success;
+        }
+
+        // Module IDs are allocated by replaying each function in order.
+        for (auto& worker : workers) {
+            MergeDeclarations(*worker->worker_, worker->module_);
+        }
+
+        ParallelFor(count, function_emission_threads_, [&](size_t i) {
+            auto& state = *workers[i]->worker_;
+            state.function.iterate_mutable([&](Instruction& inst) { RemapIds(inst, state); });
+        });
+        for (auto& worker : workers) {
+            module_.PushFunction(std::move(worker->worker_->function));
+        }
+        return Success;
+    }
+
+    /// Allocates module IDs for the local result IDs of a function emitted on a worker thread, and
+    /// adds the declarations made by the function that are not already in the module.
+    /// @param state the state of the worker that emitted the function
+    /// @param module the module that the worker emitted the function's declarations into
+    void MergeDeclarations(WorkerState& state, const writer::Module& module) {
+        state.module_ids.Reserve(state.id_origins.Length());
+        state.redundant.Reserve(state.id_origins.Length());
+        for (auto& origin : state.id_origins) {
+            uint32_t id = 0;
+            bool redundant = false;
+            auto get_or_add = [&](auto& map, auto key) {
+                if (auto existing = map.Get(key)) {
+                    id = *existing;
+                    redundant = true;
+                } else {
+                    id = module_.NextId();
+                    map.Add(key, id);
+                }
+            };
+            switch (origin.kind) {
+                case IdKind::kLocal:
+                    id = module_.NextId();
+                    break;
+                case IdKind::kType:
+                    get_or_add(types_, static_cast<const core::type::Type*>(origin.key));
+                    break;
+                case IdKind::kConstant:
+                    get_or_add(constants_, static_cast<const core::constant::Value*>(origin.key));
+                    break;
+                case IdKind::kConstantNull:
+                    get_or_add(constant_nulls_, static_cast<const core::type::Type*>(origin.key));
+                    break;
+                case IdKind::kUndef:
+                    get_or_add(undef_values_, static_cast<const core::type::Type*>(origin.key));
+                    break;
+                case IdKind::kValue:
+                    get_or_add(values_, static_cast<const core::ir::Value*>(origin.key));
+                    break;
+                case IdKind::kFunctionType: {
+                    // The key holds the local IDs of types, which have already been allocated.
+                    FunctionType function_type = state.function_types[origin.index];
+                    function_type.return_type_id = state.module_ids[function_type.return_type_id -
+                                                                    kLocalIdBase];
+                    for (auto& param_type_id : function_type.param_type_ids) {
+                        param_type_id = state.module_ids[param_type_id - kLocalIdBase];
+                    }
+                    get_or_add(function_types_, function_type);
+                    break;
+                }
+                case IdKind::kImport:
+                    get_or_add(imports_, std::string_view(static_cast<const char*>(origin.key)));
+                    break;
+            }
+            state.module_ids.Push(id);
+            state.redundant.Push(redundant);
+        }
+
+        // Copies the instructions that are not part of a redundant declaration.
+        auto merge = [&](const InstructionList& insts, const auto& owners, auto&& push) {
+            for (size_t i = 0; i < insts.size(); i++) {
+                if (i < owners.Length() && owners[i] != 0 &&
+                    state.redundant[owners[i] - kLocalIdBase]) {
+                    continue;
+                }
+                Instruction inst = insts[i];
+                RemapIds(inst, state);
+                push(inst.opcode(), inst.operands());
+            }
+        };
+        merge(module.ExtImports(), state.ext_import_owners,
+              [&](spv::Op op, const OperandList& operands) { module_.PushExtImport(op, operands); });
+        merge(module.Debug(), state.debug_owners,
+              [&](spv::Op op, const OperandList& operands) { module_.PushDebug(op, operands); });
+        merge(module.Types(), state.type_owners,
+              [&](spv::Op op, const OperandList& operands) { module_.PushType(op, operands); });
+        merge(module.Annots(), state.annot_owners,
+              [&](spv::Op op, const OperandList& operands) { module_.PushAnnot(op, operands); });
+        Vector<uint32_t, 1> no_owners;
+        merge(module.EntryPoints(), no_owners, [&](spv::Op op, const OperandList& operands) {
+            module_.PushEntryPoint(op, operands);
+        });
+        merge(module.ExecutionModes(), no_owners, [&](spv::Op op, const OperandList& operands) {
+            module_.PushExecutionMode(op, operands);
+        });
+
+        // Capabilities and extensions are deduplicated by the module.
+        for (auto& inst : module.Capabilities()) {
+            module_.PushCapability(std::get<uint32_t>(inst.operands()[0]));
+        }
+        for (auto& inst : module.Extensions()) {
+            module_.PushExtension(std::get<std::string>(inst.operands()[0]).c_str());
+        }
+    }
+
+    /// @returns true if the instructions emitted by this worker use an opcode that is not
+    /// classified by IsLiteralOperand()
+    bool HasUnclassifiedOpcode() const {
+        auto unclassified = [](const Instruction& inst) {
+            return !IsLiteralOperand(inst.opcode(), 0).has_value();
+        };
+        auto any_unclassified = [&](const InstructionList& insts) {
+            return std::any_of(insts.begin(), insts.end(), unclassified);
+        };
+        bool result = any_unclassified(module_.ExtImports()) || any_unclassified(module_.Debug()) ||
+                      any_unclassified(module_.Types()) || any_unclassified(module_.Annots()) ||
+                      any_unclassified(module_.EntryPoints()) ||
+                      any_unclassified(module_.ExecutionModes());
+        worker_->function.iterate([&](const Instruction& inst) { result |= unclassified(inst); });
+        return result;
+    }
+
+    /// Replaces the local result IDs used by an instruction with module IDs.
+    /// @param inst the instruction
+    /// @param state the state of the worker that emitted the instruction
+    static void RemapIds(Instruction& inst, const WorkerState& state) {
+        auto& operands = inst.operands();
+        for (size_t i = 0; i < operands.size(); i++) {
+            auto* id = std::get_if<uint32_t>(&operands[i]);
+            if (!id || *id < kLocalIdBase || *id - kLocalIdBase >= state.module_ids.Length()) {
+                continue;
+            }
+            // Functions with unclassified opcodes are emitted serially, so the operand is an ID
+            // unless the grammar says it is a literal number.
+            if (!IsLiteralOperand(inst.opcode(), i).value_or(false)) {
+                *id = state.module_ids[*id - kLocalIdBase];
+            }
+        }
+    }
+
+    /// @returns a new result ID
+    /// @param kind the kind of entity that the ID is for
+    /// @param key the key of the entity, if it is not local to the function
+    /// @param index the index of the key, for function types
+    uint32_t NextId(IdKind kind = IdKind::kLocal, const void* key = nullptr, uint32_t index = 0) {
+        if (!worker_) {
+            return module_.NextId();
+        }
+        auto id = kLocalIdBase + static_cast<uint32_t>(worker_->id_origins.Length());
+        worker_->id_origins.Push(IdOrigin{kind, key, index});
+        return id;
+    }
+
+    /// Allocates the result ID of a module-scope declaration. The module instructions emitted until
+    /// the matching call to EndDeclaration() are part of the declaration.
+    /// @param kind the kind of entity that is being declared
+    /// @param key the key of the entity
+    /// @param index the index of the key, for function types
+    /// @returns the result ID of the declaration
+    uint32_t BeginDeclaration(IdKind kind, const void* key, uint32_t index = 0) {
+        auto id = NextId(kind, key, index);
+        if (worker_) {
+            SyncOwners();
+            worker_->owner_stack.Push(worker_->owner);
+            worker_->owner = id;
+        }
+        return id;
+    }
+
+    /// Ends the declaration started by the last call to BeginDeclaration().
+    void EndDeclaration() {
+        if (worker_) {
+            SyncOwners();
+            worker_->owner = worker_->owner_stack.Pop();
+        }
+    }
+
+    /// Records the current owner for the module instructions emitted since the last call.
+    void SyncOwners() {
+        auto sync = [&](auto& owners, const InstructionList& insts) {
+            while (owners.Length() < insts.size()) {
+                owners.Push(worker_->owner);
+            }
+        };
+        sync(worker_->ext_import_owners, module_.ExtImports());
+        sync(worker_->debug_owners, module_.Debug());
+        sync(worker_->type_owners, module_.Types());
+        sync(worker_->annot_owners, module_.Annots());
+    }
+
+    /// Calls @p fn, holding the IR module lock if functions are being emitted on multiple threads.
+    /// @param fn the function that creates types or constants in the IR module
+    /// @returns the result of @p fn
+    template <typename F>
+    auto LockIR(F&& fn) {
+        if (!ir_mutex_) {
+            return fn();
+        }
+        std::lock_guard<std::mutex> lock(*ir_mutex_);
+        return fn();
+    }
+
+    /// @returns the constant value for @p value, creating it in the IR module if necessary
+    /// @param value the value
+    template <typename T>
+    const core::constant::Value* ConstantValue(T value) {
+        return LockIR([&] { return b_.ConstantValue(value); });
+    }
+
+    /// @returns true if @p value can be referenced by more than one function
+    /// @param value the value
+    bool IsModuleScope(const core::ir::Value* value) {
+        if (value->Is<core::ir::Function>()) {
+            return true;
+        }
+        auto* result = value->As<core::ir::InstructionResult>();
+        return result && result->Instruction()->Block() == ir_.root_block;
+    }
+
     /// Convert a builtin to the corresponding SPIR-V enum value, taking into account the target
     /// address space. Adds any capabilities needed for the builtin.
     /// @param builtin the builtin to convert
@@ -399,7 +947,8 @@ class Printer {
                 return ConstantNull(ty);
             }
 
-            auto id = module_.NextId();
+            auto id = BeginDeclaration(IdKind::kConstant, constant);
+            TINT_DEFER(EndDeclaration());
             Switch(
                 ty,  //
                 [&](const core::type::Bool*) {
@@ -439,8 +988,17 @@ class Printer {
                 [&](const core::type::Array* arr) {
                     TINT_ASSERT(arr->ConstantCount());
                     OperandList operands = {Type(ty), id};
+                    // Dense arrays create their elements on demand, so use the uniqued scalars
+                    // instead so that equal elements share a declaration.
+                    auto* dense = constant->As<core::constant::DenseBase>();
                     for (uint32_t i = 0; i < arr->ConstantCount(); i++) {
-                        operands.push_back(Constant(constant->Index(i)));
+                        const core::constant::Value* el = nullptr;
+                        if (dense) {
+                            el = LockIR([&] { return dense->ScalarAt(ir_.constant_values, i); });
+                        } else {
+                            el = constant->Index(i);
+                        }
+                        operands.push_back(Constant(el));
                     }
                     module_.PushType(spv::Op::OpConstantComposite, operands);
                 },
@@ -461,7 +1019,8 @@ class Printer {
     /// @returns the result ID of the OpConstantNull instruction
     uint32_t ConstantNull(const core::type::Type* type) {
         return constant_nulls_.GetOrAdd(type, [&] {
-            auto id = module_.NextId();
+            auto id = BeginDeclaration(IdKind::kConstantNull, type);
+            TINT_DEFER(EndDeclaration());
             module_.PushType(spv::Op::OpConstantNull, {Type(type), id});
             return id;
         });
@@ -472,7 +1031,8 @@ class Printer {
     /// @returns the result ID of the instruction
     uint32_t Undef(const core::type::Type* type) {
         return undef_values_.GetOrAdd(type, [&] {
-            auto id = module_.NextId();
+            auto id = BeginDeclaration(IdKind::kUndef, type);
+            TINT_DEFER(EndDeclaration());
             module_.PushType(spv::Op::OpUndef, {Type(type), id});
             return id;
         });
@@ -482,9 +1042,17 @@ class Printer {
     /// @param ty the type to get the ID for
     /// @returns the result ID of the type
     uint32_t Type(const core::type::Type* ty) {
-        ty = DedupType(ty, ir_.Types());
+        if (ir_mutex_) {
+            // Avoid taking the IR module lock for types that have already been emitted. The keys
+            // are already deduplicated, and deduplicating them again returns the same type.
+            if (auto id = types_.Get(ty)) {
+                return *id;
+            }
+        }
+        ty = LockIR([&] { return DedupType(ty, ir_.Types()); });
         return types_.GetOrAdd(ty, [&] {
-            auto id = module_.NextId();
+            auto id = BeginDeclaration(IdKind::kType, ty);
+            TINT_DEFER(EndDeclaration());
             Switch(
                 ty,  //
                 [&](const core::type::Void*) { module_.PushType(spv::Op::OpTypeVoid, {id}); },
@@ -513,7 +1081,7 @@ class Printer {
                 },
                 [&](const core::type::Array* arr) {
                     if (arr->ConstantCount()) {
-                        auto* count = b_.ConstantValue(u32(arr->ConstantCount().value()));
+                        auto* count = ConstantValue(u32(arr->ConstantCount().value()));
                         module_.PushType(spv::Op::OpTypeArray,
                                          {id, Type(arr->ElemType()), Constant(count)});
                     } else {
@@ -552,7 +1120,10 @@ class Printer {
             value,  //
             [&](core::ir::Constant* constant) { return Constant(constant); },
             [&](core::ir::Value*) {
-                return values_.GetOrAdd(value, [&] { return module_.NextId(); });
+                return values_.GetOrAdd(value, [&] {
+                    return worker_ && IsModuleScope(value) ? NextId(IdKind::kValue, value)
+                                                           : NextId();
+                });
             });
     }
 
@@ -560,7 +1131,7 @@ class Printer {
     /// @param block the block to get the label ID for
     /// @returns the ID of the block's label
     uint32_t Label(const core::ir::Block* block) {
-        return block_labels_.GetOrAdd(block, [&] { return module_.NextId(); });
+        return block_labels_.GetOrAdd(block, [&] { return NextId(); });
     }
 
     /// Emit a struct type.
@@ -738,7 +1309,13 @@ class Printer {
 
         // Get the ID for the function type (creating it if needed).
         auto function_type_id = function_types_.GetOrAdd(function_type, [&] {
-            auto func_ty_id = module_.NextId();
+            uint32_t index = 0;
+            if (worker_) {
+                index = static_cast<uint32_t>(worker_->function_types.Length());
+                worker_->function_types.Push(function_type);
+            }
+            auto func_ty_id = BeginDeclaration(IdKind::kFunctionType, nullptr, index);
+            TINT_DEFER(EndDeclaration());
             OperandList operands = {func_ty_id, return_type_id};
             operands.insert(operands.end(), function_type.param_type_ids.begin(),
                             function_type.param_type_ids.end());
@@ -752,7 +1329,7 @@ class Printer {
             {return_type_id, id, U32Operand(SpvFunctionControlMaskNone), function_type_id}};
 
         // Create a function that we will add instructions to.
-        auto entry_block = module_.NextId();
+        auto entry_block = NextId();
         current_function_ = Function(decl, entry_block, std::move(params));
         TINT_DEFER(current_function_ = Function());
 
@@ -760,7 +1337,11 @@ class Printer {
         EmitBlock(func->Block());
 
         // Add the function to the module.
-        module_.PushFunction(current_function_);
+        if (worker_) {
+            worker_->function = std::move(current_function_);
+        } else {
+            module_.PushFunction(std::move(current_function_));
+        }
 
         return Success;
     }
@@ -1060,7 +1641,7 @@ class Printer {
                 // OpCompositeExtract, creating a new result ID for the resulting vector.
                 auto vec_id = Value(access->Object());
                 if (operands.size() > 3) {
-                    vec_id = module_.NextId();
+                    vec_id = NextId();
                     operands[0] = Type(source_ty);
                     operands[1] = vec_id;
                     current_function_.push_inst(spv::Op::OpCompositeExtract, std::move(operands));
@@ -1402,7 +1983,8 @@ class Printer {
             op = spv::Op::OpExtInst;
             operands.push_back(imports_.GetOrAdd(kGLSLstd450, [&] {
                 // Import the instruction set the first time it is requested.
-                auto import = module_.NextId();
+                auto import = BeginDeclaration(IdKind::kImport, kGLSLstd450);
+                TINT_DEFER(EndDeclaration());
                 module_.PushExtImport(spv::Op::OpExtInstImport, {import, Operand(kGLSLstd450)});
                 return import;
             }));
@@ -1642,49 +2224,49 @@ class Printer {
             case core::BuiltinFn::kStorageBarrier:
                 op = spv::Op::OpControlBarrier;
                 operands.clear();
-                operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
-                operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Workgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Workgroup))));
                 operands.push_back(
-                    Constant(b_.ConstantValue(u32(spv::MemorySemanticsMask::UniformMemory |
+                    Constant(ConstantValue(u32(spv::MemorySemanticsMask::UniformMemory |
                                                   spv::MemorySemanticsMask::AcquireRelease))));
                 break;
             case core::BuiltinFn::kSubgroupAdd:
                 module_.PushCapability(SpvCapabilityGroupNonUniformArithmetic);
                 op = result_ty->is_integer_scalar_or_vector() ? spv::Op::OpGroupNonUniformIAdd
                                                               : spv::Op::OpGroupNonUniformFAdd;
-                operands.push_back(Constant(ir_.constant_values.Get(u32(spv::Scope::Subgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Subgroup))));
                 operands.push_back(U32Operand(u32(spv::GroupOperation::Reduce)));
                 break;
             case core::BuiltinFn::kSubgroupExclusiveAdd:
                 module_.PushCapability(SpvCapabilityGroupNonUniformArithmetic);
                 op = result_ty->is_integer_scalar_or_vector() ? spv::Op::OpGroupNonUniformIAdd
                                                               : spv::Op::OpGroupNonUniformFAdd;
-                operands.push_back(Constant(ir_.constant_values.Get(u32(spv::Scope::Subgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Subgroup))));
                 operands.push_back(U32Operand(u32(spv::GroupOperation::ExclusiveScan)));
                 break;
             case core::BuiltinFn::kSubgroupMul:
                 module_.PushCapability(SpvCapabilityGroupNonUniformArithmetic);
                 op = result_ty->is_integer_scalar_or_vector() ? spv::Op::OpGroupNonUniformIMul
                                                               : spv::Op::OpGroupNonUniformFMul;
-                operands.push_back(Constant(ir_.constant_values.Get(u32(spv::Scope::Subgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Subgroup))));
                 operands.push_back(U32Operand(u32(spv::GroupOperation::Reduce)));
                 break;
             case core::BuiltinFn::kSubgroupExclusiveMul:
                 module_.PushCapability(SpvCapabilityGroupNonUniformArithmetic);
                 op = result_ty->is_integer_scalar_or_vector() ? spv::Op::OpGroupNonUniformIMul
                                                               : spv::Op::OpGroupNonUniformFMul;
-                operands.push_back(Constant(ir_.constant_values.Get(u32(spv::Scope::Subgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Subgroup))));
                 operands.push_back(U32Operand(u32(spv::GroupOperation::ExclusiveScan)));
                 break;
             case core::BuiltinFn::kSubgroupBallot:
                 module_.PushCapability(SpvCapabilityGroupNonUniformBallot);
                 op = spv::Op::OpGroupNonUniformBallot;
-                operands.push_back(Constant(ir_.constant_values.Get(u32(spv::Scope::Subgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Subgroup))));
                 break;
             case core::BuiltinFn::kSubgroupBroadcast:
                 module_.PushCapability(SpvCapabilityGroupNonUniformBallot);
                 op = spv::Op::OpGroupNonUniformBroadcast;
-                operands.push_back(Constant(ir_.constant_values.Get(u32(spv::Scope::Subgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Subgroup))));
                 break;
             case core::BuiltinFn::kTan:
                 glsl_ext_inst(GLSLstd450Tan);
@@ -1695,10 +2277,10 @@ class Printer {
             case core::BuiltinFn::kTextureBarrier:
                 op = spv::Op::OpControlBarrier;
                 operands.clear();
-                operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
-                operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Workgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Workgroup))));
                 operands.push_back(
-                    Constant(b_.ConstantValue(u32(spv::MemorySemanticsMask::ImageMemory |
+                    Constant(ConstantValue(u32(spv::MemorySemanticsMask::ImageMemory |
                                                   spv::MemorySemanticsMask::AcquireRelease))));
                 break;
             case core::BuiltinFn::kTextureNumLevels:
@@ -1733,10 +2315,10 @@ class Printer {
             case core::BuiltinFn::kWorkgroupBarrier:
                 op = spv::Op::OpControlBarrier;
                 operands.clear();
-                operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
-                operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Workgroup))));
+                operands.push_back(Constant(ConstantValue(u32(spv::Scope::Workgroup))));
                 operands.push_back(
-                    Constant(b_.ConstantValue(u32(spv::MemorySemanticsMask::WorkgroupMemory |
+                    Constant(ConstantValue(u32(spv::MemorySemanticsMask::WorkgroupMemory |
                                                   spv::MemorySemanticsMask::AcquireRelease))));
                 break;
             default:
@@ -1819,31 +2401,33 @@ class Printer {
             // Select between constant one and zero, splatting them to vectors if necessary.
             core::ir::Constant* one = nullptr;
             core::ir::Constant* zero = nullptr;
-            Switch(
-                res_ty->DeepestElement(),  //
-                [&](const core::type::F32*) {
-                    one = b_.Constant(1_f);
-                    zero = b_.Constant(0_f);
-                },
-                [&](const core::type::F16*) {
-                    one = b_.Constant(1_h);
-                    zero = b_.Constant(0_h);
-                },
-                [&](const core::type::I32*) {
-                    one = b_.Constant(1_i);
-                    zero = b_.Constant(0_i);
-                },
-                [&](const core::type::U32*) {
-                    one = b_.Constant(1_u);
-                    zero = b_.Constant(0_u);
-                });
-            TINT_ASSERT(one && zero);
-
-            if (auto* vec = res_ty->As<core::type::Vector>()) {
-                // Splat the scalars into vectors.
-                one = b_.Splat(vec, one);
-                zero = b_.Splat(vec, zero);
-            }
+            LockIR([&] {
+                Switch(
+                    res_ty->DeepestElement(),  //
+                    [&](const core::type::F32*) {
+                        one = b_.Constant(1_f);
+                        zero = b_.Constant(0_f);
+                    },
+                    [&](const core::type::F16*) {
+                        one = b_.Constant(1_h);
+                        zero = b_.Constant(0_h);
+                    },
+                    [&](const core::type::I32*) {
+                        one = b_.Constant(1_i);
+                        zero = b_.Constant(0_i);
+                    },
+                    [&](const core::type::U32*) {
+                        one = b_.Constant(1_u);
+                        zero = b_.Constant(0_u);
+                    });
+                TINT_ASSERT(one && zero);
+
+                if (auto* vec = res_ty->As<core::type::Vector>()) {
+                    // Splat the scalars into vectors.
+                    one = b_.Splat(vec, one);
+                    zero = b_.Splat(vec, zero);
+                }
+            });
 
             op = spv::Op::OpSelect;
             operands.push_back(Constant(b_.ConstantValue(one)));
@@ -1867,8 +2451,9 @@ class Printer {
     void EmitLoadVectorElement(core::ir::LoadVectorElement* load) {
         auto* vec_ptr_ty = load->From()->Type()->As<core::type::Pointer>();
         auto* el_ty = load->Result(0)->Type();
-        auto* el_ptr_ty = ir_.Types().ptr(vec_ptr_ty->AddressSpace(), el_ty, vec_ptr_ty->Access());
-        auto el_ptr_id = module_.NextId();
+        auto* el_ptr_ty = LockIR(
+            [&] { return ir_.Types().ptr(vec_ptr_ty->AddressSpace(), el_ty, vec_ptr_ty->Access()); });
+        auto el_ptr_id = NextId();
         current_function_.push_inst(
             spv::Op::OpAccessChain,
             {Type(el_ptr_ty), el_ptr_id, Value(load->From()), Value(load->Index())});
@@ -1883,7 +2468,7 @@ class Printer {
         auto body_label = Label(loop->Body());
         auto continuing_label = Label(loop->Continuing());
 
-        auto header_label = module_.NextId();
+        auto header_label = NextId();
         TINT_SCOPED_ASSIGNMENT(loop_header_label_, header_label);
 
         auto merge_label = GetMergeLabel(loop);
@@ -1996,8 +2581,9 @@ class Printer {
     void EmitStoreVectorElement(core::ir::StoreVectorElement* store) {
         auto* vec_ptr_ty = store->To()->Type()->As<core::type::Pointer>();
         auto* el_ty = store->Value()->Type();
-        auto* el_ptr_ty = ir_.Types().ptr(vec_ptr_ty->AddressSpace(), el_ty, vec_ptr_ty->Access());
-        auto el_ptr_id = module_.NextId();
+        auto* el_ptr_ty = LockIR(
+            [&] { return ir_.Types().ptr(vec_ptr_ty->AddressSpace(), el_ty, vec_ptr_ty->Access()); });
+        auto el_ptr_id = NextId();
         current_function_.push_inst(
             spv::Op::OpAccessChain,
             {Type(el_ptr_ty), el_ptr_id, Value(store->To()), Value(store->Index())});
@@ -2259,7 +2845,7 @@ class Printer {
     /// @param ci the control instruction to get the merge label for
     /// @returns the label ID
     uint32_t GetMergeLabel(core::ir::ControlInstruction* ci) {
-        return merge_block_labels_.GetOrAdd(ci, [&] { return module_.NextId(); });
+        return merge_block_labels_.GetOrAdd(ci, [&] { return NextId(); });
     }
 
     /// Get the ID of the label of the block that will contain a terminator instruction.
@@ -2336,12 +2922,15 @@ class Printer {
 }  // namespace
 
 tint::Result<std::vector<uint32_t>> Print(core::ir::Module& module,
-                                          bool zero_init_workgroup_memory) {
-    return Printer{module, zero_init_workgroup_memory}.Code();
+                                          bool zero_init_workgroup_memory,
+                                          uint32_t function_emission_threads) {
+    return Printer{module, zero_init_workgroup_memory, function_emission_threads}.Code();
 }
 
-tint::Result<Module> PrintModule(core::ir::Module& module, bool zero_init_workgroup_memory) {
-    return Printer{module, zero_init_workgroup_memory}.Module();
+tint::Result<Module> PrintModule(core::ir::Module& module,
+                                 bool zero_init_workgroup_memory,
+                                 uint32_t function_emission_threads) {
+    return Printer{module, zero_init_workgroup_memory, function_emission_threads}.Module();
 }
 
 }  // namespace tint::spirv::writer
@@ -45,14 +45,21 @@ namespace tint::spirv::writer {
 /// @param module the Tint IR module to generate
 /// @param zero_init_workgroup_memory `true` to initialize all the variables in the Workgroup
 ///                                   storage class with OpConstantNull
+/// @param function_emission_threads the number of threads to use to emit functions. Values less
+///                                  than 2 emit all functions on the calling thread.
 tint::Result<std::vector<uint32_t>> Print(core::ir::Module& module,
-                                          bool zero_init_workgroup_memory);
+                                          bool zero_init_workgroup_memory,
+                                          uint32_t function_emission_threads = 0);
 
 /// @returns the generated SPIR-V module on success, or failure
 /// @param module the Tint IR module to generate
 /// @param zero_init_workgroup_memory `true` to initialize all the variables in the Workgroup
 ///                                   storage class with OpConstantNull
-tint::Result<Module> PrintModule(core::ir::Module& module, bool zero_init_workgroup_memory);
+/// @param function_emission_threads the number of threads to use to emit functions. Values less
+///                                  than 2 emit all functions on the calling thread.
+tint::Result<Module> PrintModule(core::ir::Module& module,
+                                 bool zero_init_workgroup_memory,
+                                 uint32_t function_emission_threads = 0);
 
 }  // namespace tint::spirv::writer
 
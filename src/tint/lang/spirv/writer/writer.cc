@@ -59,7 +59,7 @@ Result<Output> Generate(core::ir::Module& ir, const Options& options) {
     }
 
     // Generate the SPIR-V code.
-    auto spirv = Print(ir, zero_initialize_workgroup_memory);
+    auto spirv = Print(ir, zero_initialize_workgroup_memory, options.function_emission_threads);
     if (spirv != Success) {
         return std::move(spirv.Failure());
     }
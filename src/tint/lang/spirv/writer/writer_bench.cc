@@ -26,6 +26,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
+#include <thread>
 
 #include "src/tint/cmd/bench/bench.h"
 #include "src/tint/lang/spirv/writer/writer.h"
@@ -42,7 +43,9 @@
 namespace tint::spirv::writer {
 namespace {
 
-void GenerateSPIRV(benchmark::State& state, std::string input_name) {
+void GenerateSPIRVWithOptions(benchmark::State& state,
+                               std::string input_name,
+                               const Options& options) {
     auto res = bench::GetWgslProgram(input_name);
     if (res != Success) {
         state.SkipWithError(res.Failure().reason.Str());
@@ -56,14 +59,25 @@ void GenerateSPIRV(benchmark::State& state, std::string input_name) {
             return;
         }
 
-        auto gen_res = Generate(ir.Get(), {});
+        auto gen_res = Generate(ir.Get(), options);
         if (gen_res != Success) {
             state.SkipWithError(gen_res.Failure().reason.Str());
         }
     }
 }
 
+void GenerateSPIRV(benchmark::State& state, std::string input_name) {
+    GenerateSPIRVWithOptions(state, input_name, {});
+}
+
+void GenerateSPIRVParallel(benchmark::State& state, std::string input_name) {
+    Options options;
+    options.function_emission_threads = std::thread::hardware_concurrency();
+    GenerateSPIRVWithOptions(state, input_name, options);
+}
+
 TINT_BENCHMARK_PROGRAMS(GenerateSPIRV);
+TINT_BENCHMARK_PROGRAMS(GenerateSPIRVParallel);
 
 }  // namespace
 }  // namespace tint::spirv::writer
@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <string>
+
 #include "src/tint/lang/spirv/writer/common/helper_test.h"
 
 #include "gmock/gmock.h"
@@ -32,6 +34,7 @@
 namespace tint::spirv::writer {
 namespace {
 
+using namespace tint::core::fluent_types;     // NOLINT
 using namespace tint::core::number_suffixes;  // NOLINT
 
 TEST_F(SpirvWriterTest, ModuleHeader) {
@@ -105,5 +108,46 @@ TEST_F(SpirvWriterTest, TooManyFunctionParameters) {
                     "Function 'foo' has more than 255 parameters after running Tint transforms"));
 }
 
+TEST_F(SpirvWriterTest, FunctionEmissionThreads) {
+    auto* v = b.Var("v", ty.ptr<private_, vec4<f32>>());
+    mod.root_block->Append(v);
+
+    // Functions that share types, constants and function types, and call each other.
+    Vector<core::ir::Function*, 8> funcs;
+    for (uint32_t i = 0; i < 8; i++) {
+        auto* param = b.FunctionParam("p", ty.vec4<f32>());
+        auto* func = b.Function("f" + std::to_string(i), ty.vec4<f32>());
+        func->SetParams({param});
+        b.Append(func->Block(), [&] {
+            core::ir::Value* sum =
+                b.Add(ty.vec4<f32>(), param, b.Splat(ty.vec4<f32>(), f32(i)))->Result(0);
+            auto* arr = b.Var("arr", ty.ptr<function, array<vec4<f32>, 4>>());
+            b.Store(b.Access(ty.ptr<function, vec4<f32>>(), arr, u32(i % 4)), sum);
+            if (!funcs.IsEmpty()) {
+                sum = b.Call(funcs.Back(), sum)->Result(0);
+            }
+            b.Store(v, sum);
+            b.Return(func, sum);
+        });
+        funcs.Push(func);
+    }
+    auto* ep = b.Function("main", ty.void_(), core::ir::Function::PipelineStage::kCompute,
+                          {{1, 1, 1}});
+    b.Append(ep->Block(), [&] {
+        b.Call(funcs.Back(), b.Load(v));
+        b.Return(ep);
+    });
+
+    ASSERT_TRUE(Generate()) << Error() << output_;
+
+    auto serial = PrintModule(mod, false);
+    ASSERT_EQ(serial, Success) << serial.Failure().reason.Str();
+    for (uint32_t threads : {2u, 3u, 8u}) {
+        auto parallel = PrintModule(mod, false, threads);
+        ASSERT_EQ(parallel, Success) << parallel.Failure().reason.Str();
+        EXPECT_EQ(parallel->Code(), serial->Code()) << "threads: " << threads;
+    }
+}
+
 }  // namespace
 }  // namespace tint::spirv::writer
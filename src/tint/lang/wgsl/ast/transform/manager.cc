@@ -44,6 +44,33 @@
 
 namespace tint::ast::transform {
 
+namespace {
+
+/// The statistics of the innermost StatisticsScope of the current thread, if any.
+thread_local Manager::Statistics* current_statistics = nullptr;
+
+}  // namespace
+
+Manager::TransformStatistics& Manager::Statistics::Get(const tint::TypeInfo& type) {
+    for (auto& stats : transforms) {
+        if (stats.type == &type) {
+            return stats;
+        }
+    }
+    auto& stats = transforms.emplace_back();
+    stats.type = &type;
+    return stats;
+}
+
+Manager::StatisticsScope::StatisticsScope(Statistics& statistics)
+    : previous_(current_statistics) {
+    current_statistics = &statistics;
+}
+
+Manager::StatisticsScope::~StatisticsScope() {
+    current_statistics = previous_;
+}
+
 Manager::Manager() = default;
 Manager::~Manager() = default;
 
@@ -70,8 +97,25 @@ Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap&
 
     TINT_IF_PRINT_PROGRAM(print_program("Input of", nullptr));
 
+    Statistics* statistics = current_statistics;
+
     for (const auto& transform : transforms_) {
-        if (auto result = transform->Apply(*program, inputs, outputs)) {
+        auto start = statistics ? std::chrono::steady_clock::now()
+                                : std::chrono::steady_clock::time_point{};
+        auto result = transform->Apply(*program, inputs, outputs);
+        if (statistics) {
+            auto& stats = statistics->Get(transform->TypeInfo());
+            stats.duration += std::chrono::steady_clock::now() - start;
+            if (result) {
+                stats.runs++;
+                stats.ast_nodes += result->ASTNodes().Count();
+                stats.sem_nodes += result->SemNodes().Count();
+            } else {
+                stats.skips++;
+            }
+        }
+
+        if (result) {
             output.emplace(std::move(result.value()));
             program = &output.value();
 
@@ -28,6 +28,7 @@
 #ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_MANAGER_H_
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_MANAGER_H_
 
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -44,6 +45,48 @@ namespace tint::ast::transform {
 /// the error can be retrieved with the Output's diagnostics.
 class Manager {
   public:
+    /// Statistics about the runs of a single transform type.
+    struct TransformStatistics {
+        /// The type of the transform
+        const tint::TypeInfo* type = nullptr;
+        /// The number of times the transform produced a new program
+        size_t runs = 0;
+        /// The number of times the transform was skipped without cloning the program
+        size_t skips = 0;
+        /// The total time spent in the transform's Apply(), including the skipped runs
+        std::chrono::nanoseconds duration{0};
+        /// The total number of AST nodes allocated by the programs produced by the transform
+        size_t ast_nodes = 0;
+        /// The total number of semantic nodes allocated by the programs produced by the transform
+        size_t sem_nodes = 0;
+    };
+
+    /// Statistics about the transforms run by all the managers that ran while a StatisticsScope
+    /// was alive.
+    struct Statistics {
+        /// The statistics of each transform type, in the order they first ran
+        std::vector<TransformStatistics> transforms;
+
+        /// @param type the transform type
+        /// @returns the statistics for the transform type @p type, adding them if needed
+        TransformStatistics& Get(const tint::TypeInfo& type);
+    };
+
+    /// StatisticsScope records the statistics of all the Manager::Run() calls made on the
+    /// current thread for its lifetime. Scopes can be nested, in which case the innermost scope
+    /// receives the statistics.
+    class StatisticsScope {
+      public:
+        /// Constructor
+        /// @param statistics the statistics to add to
+        explicit StatisticsScope(Statistics& statistics);
+        /// Destructor
+        ~StatisticsScope();
+
+      private:
+        Statistics* const previous_;
+    };
+
     /// Constructor
     Manager();
     ~Manager();
@@ -40,13 +40,13 @@ namespace {
 
 using TransformManagerTest = testing::Test;
 
-class AST_NoOp final : public ast::transform::Transform {
+class AST_NoOp final : public Castable<AST_NoOp, ast::transform::Transform> {
     ApplyResult Apply(const Program&, const DataMap&, DataMap&) const override {
         return SkipTransform;
     }
 };
 
-class AST_AddFunction final : public ast::transform::Transform {
+class AST_AddFunction final : public Castable<AST_AddFunction, ast::transform::Transform> {
     ApplyResult Apply(const Program& src, const DataMap&, DataMap&) const override {
         ProgramBuilder b;
         program::CloneContext ctx{&b, &src};
@@ -77,5 +77,45 @@ TEST_F(TransformManagerTest, AST_AlwaysClone) {
     EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "main");
 }
 
+TEST_F(TransformManagerTest, Statistics) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    manager.Add<AST_NoOp>();
+    manager.Add<AST_AddFunction>();
+
+    Manager::Statistics statistics;
+    {
+        Manager::StatisticsScope scope(statistics);
+        for (size_t i = 0; i < 2; i++) {
+            DataMap outputs;
+            auto result = manager.Run(ast, {}, outputs);
+            EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+        }
+    }
+
+    // Runs outside of the scope are not recorded.
+    DataMap outputs;
+    manager.Run(ast, {}, outputs);
+
+    ASSERT_EQ(statistics.transforms.size(), 2u);
+
+    auto& no_op = statistics.transforms[0];
+    EXPECT_EQ(no_op.type, &TypeInfo::Of<AST_NoOp>());
+    EXPECT_EQ(no_op.runs, 0u);
+    EXPECT_EQ(no_op.skips, 2u);
+    EXPECT_EQ(no_op.ast_nodes, 0u);
+
+    auto& add_function = statistics.transforms[1];
+    EXPECT_EQ(add_function.type, &TypeInfo::Of<AST_AddFunction>());
+    EXPECT_EQ(add_function.runs, 2u);
+    EXPECT_EQ(add_function.skips, 0u);
+    EXPECT_GT(add_function.ast_nodes, 0u);
+    EXPECT_GT(add_function.sem_nodes, 0u);
+}
+
 }  // namespace
 }  // namespace tint::ast::transform
+
+TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::AST_NoOp);
+TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::AST_AddFunction);
@@ -64,6 +64,8 @@ tint_add_target(tint_lang_wgsl_ls lib
   lang/wgsl/ls/set_trace.cc
   lang/wgsl/ls/signature_help.cc
   lang/wgsl/ls/symbols.cc
+  lang/wgsl/ls/text_buffer.cc
+  lang/wgsl/ls/text_buffer.h
   lang/wgsl/ls/utils.cc
   lang/wgsl/ls/utils.h
 )
@@ -124,6 +126,7 @@ tint_add_target(tint_lang_wgsl_ls_test test
   lang/wgsl/ls/completions_test.cc
   lang/wgsl/ls/definition_test.cc
   lang/wgsl/ls/diagnostics_test.cc
+  lang/wgsl/ls/document_test.cc
   lang/wgsl/ls/helpers_test.cc
   lang/wgsl/ls/helpers_test.h
   lang/wgsl/ls/hover_test.cc
@@ -133,6 +136,7 @@ tint_add_target(tint_lang_wgsl_ls_test test
   lang/wgsl/ls/sem_tokens_test.cc
   lang/wgsl/ls/signature_help_test.cc
   lang/wgsl/ls/symbols_test.cc
+  lang/wgsl/ls/text_buffer_test.cc
 )
 
 tint_target_add_dependencies(tint_lang_wgsl_ls_test test
@@ -174,4 +178,43 @@ if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
   )
 endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
 
+endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+################################################################################
+# Target:    tint_lang_wgsl_ls_bench
+# Kind:      bench
+# Condition: TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER
+################################################################################
+tint_add_target(tint_lang_wgsl_ls_bench bench
+  lang/wgsl/ls/document_bench.cc
+)
+
+tint_target_add_dependencies(tint_lang_wgsl_ls_bench bench
+  tint_utils_containers
+  tint_utils_diagnostic
+  tint_utils_ice
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+  tint_utils_rtti
+  tint_utils_text
+  tint_utils_traits
+)
+
+tint_target_add_external_dependencies(tint_lang_wgsl_ls_bench bench
+  "google-benchmark"
+)
+
+if(TINT_BUILD_TINTD)
+  tint_target_add_external_dependencies(tint_lang_wgsl_ls_bench bench
+    "langsvr"
+  )
+endif(TINT_BUILD_TINTD)
+
+if(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+  tint_target_add_dependencies(tint_lang_wgsl_ls_bench bench
+    tint_lang_wgsl_ls
+  )
+endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
+
 endif(TINT_BUILD_TINTD AND TINT_BUILD_WGSL_READER)
\ No newline at end of file
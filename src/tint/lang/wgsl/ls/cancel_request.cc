@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <string>
+
 #include "langsvr/lsp/lsp.h"
 #include "src/tint/lang/wgsl/ls/server.h"
 
@@ -33,7 +35,18 @@ namespace lsp = langsvr::lsp;
 namespace tint::wgsl::ls {
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(const lsp::CancelRequestNotification&) {
+    // Requests are handled in the order they are received, so a cancelled request has already been
+    // answered. The analyses that requests wait for are cancelled when the document changes.
     return langsvr::Success;
 }
 
+void Server::CancelAnalysis(const std::string& uri) {
+    if (auto analysis = analyses_.Get(uri)) {
+        // The analysis is skipped if it has not started yet, and its result is discarded by
+        // ApplyFinishedAnalyses() as it is no longer in analyses_.
+        (*analysis)->cancelled = true;
+        analyses_.Remove(uri);
+    }
+}
+
 }  // namespace tint::wgsl::ls
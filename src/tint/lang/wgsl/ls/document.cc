@@ -25,6 +25,12 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "src/tint/lang/wgsl/ls/server.h"
 
 #include "src/tint/lang/wgsl/reader/reader.h"
@@ -33,63 +39,175 @@ namespace lsp = langsvr::lsp;
 
 namespace tint::wgsl::ls {
 
-namespace {
-
-/// @returns the byte offsets of the start of all the lines in @p str.
-std::vector<size_t> LineOffsets(std::string_view str) {
-    std::vector<size_t> offsets;
-    offsets.push_back(0);
-    for (size_t i = 0, n = str.length(); i < n; i++) {
-        if (str[i] == '\n') {
-            offsets.push_back(i + 1);
-        }
-    }
-    return offsets;
-}
-
-}  // namespace
-
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidOpenNotification& n) {
-    wgsl::reader::Options options;
-    options.allowed_features = wgsl::AllowedFeatures::Everything();
-    auto source = std::make_unique<Source::File>(n.text_document.uri, n.text_document.text);
-    auto program = wgsl::reader::Parse(source.get(), options);
-    auto file =
-        std::make_shared<File>(std::move(source), n.text_document.version, std::move(program));
-    files_.Add(n.text_document.uri, file);
-    return PublishDiagnostics(*file);
+    pending_changes_.Remove(n.text_document.uri);
+    StartAnalysis(n.text_document.uri, n.text_document.text, n.text_document.version);
+    return langsvr::Success;
 }
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidCloseNotification& n) {
+    pending_changes_.Remove(n.text_document.uri);
+    CancelAnalysis(n.text_document.uri);
     files_.Remove(n.text_document.uri);
     return langsvr::Success;
 }
 
 langsvr::Result<langsvr::SuccessType> Server::Handle(
     const lsp::TextDocumentDidChangeNotification& n) {
-    auto file = files_.Get(n.text_document.uri);
-    if (!file) {
-        return langsvr::Failure{"document not found"};
+    // The edits are applied to the latest text of the document, which is only analyzed by
+    // AnalyzePendingChanges(). The latest text is the pending change if there is one, otherwise
+    // the text being analyzed, otherwise the analyzed text.
+    const std::string& uri = n.text_document.uri;
+    if (!pending_changes_.Contains(uri)) {
+        std::shared_ptr<PendingChange> latest;
+        if (auto analysis = analyses_.Get(uri)) {
+            latest = std::make_shared<PendingChange>(
+                PendingChange{TextBuffer{(*analysis)->text}, (*analysis)->version});
+        } else if (auto file = files_.Get(uri)) {
+            TextBuffer text{std::string((*file)->source->content.data)};
+            latest = std::make_shared<PendingChange>(
+                PendingChange{std::move(text), (*file)->version});
+        } else {
+            return langsvr::Failure{"document not found"};
+        }
+        pending_changes_.Add(uri, std::move(latest));
+    }
+
+    PendingChange& change = **pending_changes_.Get(uri);
+    for (auto& content_change : n.content_changes) {
+        if (auto* edit = content_change.Get<lsp::TextDocumentContentChangePartial>()) {
+            change.text.Edit(edit->range, edit->text);
+        } else if (auto* whole =
+                       content_change.Get<lsp::TextDocumentContentChangeWholeDocument>()) {
+            change.text = TextBuffer{whole->text};
+        }
+    }
+    change.version = n.text_document.version;
+    return langsvr::Success;
+}
+
+langsvr::Result<langsvr::SuccessType> Server::AnalyzePendingChanges() {
+    auto changes = std::move(pending_changes_);
+    pending_changes_.Clear();
+    for (auto& it : changes) {
+        const std::string& uri = it.key.Value();
+        PendingChange& change = *it.value;
+        auto file = files_.Get(uri);
+        if (file && (*file)->source->content.data == change.text.Text()) {
+            // The edits restored the analyzed text, for example an edit followed by an undo, so the
+            // analysis can be reused.
+            CancelAnalysis(uri);
+            (*file)->version = change.version;
+            if (auto res = PublishDiagnostics(**file); res != langsvr::Success) {
+                return res;
+            }
+        } else {
+            StartAnalysis(uri, std::string(change.text.Text()), change.version);
+        }
+    }
+    return langsvr::Success;
+}
+
+langsvr::Result<langsvr::SuccessType> Server::ApplyFinishedAnalyses() {
+    std::vector<std::shared_ptr<Analysis>> finished;
+    {
+        std::lock_guard<std::mutex> lock(analysis_mutex_);
+        std::swap(finished, finished_analyses_);
+    }
+    // Every finished analysis is applied and published, even if publishing an earlier one failed,
+    // as they were removed from finished_analyses_.
+    langsvr::Result<langsvr::SuccessType> result = langsvr::Success;
+    for (auto& analysis : finished) {
+        // Only apply the analysis of the current version of the document. The analyses of
+        // versions that were changed since, or of documents that were closed, were cancelled and
+        // removed from analyses_.
+        auto current = analyses_.Get(analysis->uri);
+        if (!current || *current != analysis) {
+            continue;
+        }
+        analyses_.Remove(analysis->uri);
+        files_.Replace(analysis->uri, analysis->file);
+        if (auto res = PublishDiagnostics(*analysis->file);
+            res != langsvr::Success && result == langsvr::Success) {
+            result = res;
+        }
     }
+    return result;
+}
 
-    auto utf8 = (*file)->source->content.data;
-    for (auto& change : n.content_changes) {
-        if (auto* edit = change.Get<lsp::TextDocumentContentChangePartial>()) {
-            auto range = (*file)->Conv(edit->range);
-            std::vector<size_t> line_offsets = LineOffsets(utf8);
-            size_t utf8_start = line_offsets[range.begin.line - 1] + range.begin.column - 1;
-            size_t utf8_end = line_offsets[range.end.line - 1] + range.end.column - 1;
-            utf8 = utf8.substr(0, utf8_start) + edit->text + utf8.substr(utf8_end);
+langsvr::Result<langsvr::SuccessType> Server::FinishAnalyses() {
+    {
+        std::unique_lock<std::mutex> lock(analysis_mutex_);
+        analysis_cv_.wait(lock, [&] {
+            for (auto& it : analyses_) {
+                if (!it.value->done) {
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+    return ApplyFinishedAnalyses();
+}
+
+void Server::SetAnalysisFinishedCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(analysis_mutex_);
+    analysis_finished_callback_ = std::move(callback);
+}
+
+void Server::StartAnalysis(const std::string& uri, std::string text, int64_t version) {
+    CancelAnalysis(uri);
+    auto analysis = std::make_shared<Analysis>();
+    analysis->uri = uri;
+    analysis->text = std::move(text);
+    analysis->version = version;
+    analyses_.Add(uri, analysis);
+    {
+        std::lock_guard<std::mutex> lock(analysis_mutex_);
+        analysis_queue_.push_back(std::move(analysis));
+    }
+    analysis_cv_.notify_all();
+}
+
+void Server::RunAnalyses() {
+    std::unique_lock<std::mutex> lock(analysis_mutex_);
+    while (true) {
+        analysis_cv_.wait(lock, [&] { return stop_analyses_ || !analysis_queue_.empty(); });
+        if (stop_analyses_) {
+            return;
+        }
+        auto analysis = std::move(analysis_queue_.front());
+        analysis_queue_.pop_front();
+
+        if (!analysis->cancelled) {
+            lock.unlock();
+            auto file = Analyze(analysis->uri, analysis->text, analysis->version);
+            lock.lock();
+            analysis->file = std::move(file);
+        }
+        analysis->done = true;
+        finished_analyses_.push_back(std::move(analysis));
+        auto callback = analysis_finished_callback_;
+
+        lock.unlock();
+        analysis_cv_.notify_all();
+        if (callback) {
+            callback();
         }
+        lock.lock();
     }
+}
+
+std::shared_ptr<File> Server::Analyze(std::string_view uri,
+                                      std::string_view text,
+                                      int64_t version) {
     wgsl::reader::Options options;
     options.allowed_features = wgsl::AllowedFeatures::Everything();
-    auto source = std::make_unique<Source::File>(n.text_document.uri, utf8);
+    auto source = std::make_unique<Source::File>(std::string(uri), text);
     auto program = wgsl::reader::Parse(source.get(), options);
-    *file = std::make_shared<File>(std::move(source), n.text_document.version, std::move(program));
-    return PublishDiagnostics(**file);
+    return std::make_shared<File>(std::move(source), version, std::move(program));
 }
 
 }  // namespace tint::wgsl::ls
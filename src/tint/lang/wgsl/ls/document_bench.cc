@@ -0,0 +1,123 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "langsvr/lsp/lsp.h"
+#include "langsvr/session.h"
+#include "src/tint/lang/wgsl/ls/server.h"
+
+namespace tint::wgsl::ls {
+namespace {
+
+namespace lsp = langsvr::lsp;
+
+/// @returns a generated shader with at least @p lines lines
+std::string GenerateDocument(size_t lines) {
+    std::string wgsl = "const scale = 1.0f;\n\n";
+    for (size_t i = 0; i * 6 < lines; i++) {
+        std::string n = std::to_string(i);
+        wgsl += "fn f" + n + "(v : vec4<f32>) -> vec4<f32> {\n";
+        wgsl += "    var r = v * scale;\n";
+        wgsl += "    r += vec4<f32>(" + n + ".0f);\n";
+        wgsl += "    return r;\n";
+        wgsl += "}\n\n";
+    }
+    return wgsl;
+}
+
+/// Opens a generated document in a language server, then measures the time taken to handle edits
+/// of the first line of the document, and publish the diagnostics of the edited document.
+/// @param edits_per_analysis the number of edits made before the document is analyzed, emulating
+/// the edits made by a user typing before the server's analysis delay has passed.
+void EditDocument(benchmark::State& state, int edits_per_analysis) {
+    langsvr::Session server_session;
+    langsvr::Session client_session;
+    server_session.SetSender([&](std::string_view msg) { return client_session.Receive(msg); });
+    client_session.SetSender([&](std::string_view msg) { return server_session.Receive(msg); });
+
+    size_t diagnostics = 0;
+    client_session.Register([&](const lsp::TextDocumentPublishDiagnosticsNotification&) {
+        diagnostics++;
+        return langsvr::Success;
+    });
+
+    Server server(server_session);
+
+    lsp::TextDocumentDidOpenNotification open{};
+    open.text_document.uri = "document.wgsl";
+    open.text_document.text = GenerateDocument(static_cast<size_t>(state.range(0)));
+    if (client_session.Send(open) != langsvr::Success ||
+        server.FinishAnalyses() != langsvr::Success) {
+        state.SkipWithError("failed to open document");
+        return;
+    }
+
+    // Each edit changes the integer digit of 'scale'. The digit cycles through 7 values so that the
+    // text analyzed after a burst of edits differs from the previously analyzed text.
+    lsp::TextDocumentDidChangeNotification change{};
+    change.text_document.uri = open.text_document.uri;
+    lsp::TextDocumentContentChangePartial edit{};
+    edit.range = lsp::Range{{0, 14}, {0, 15}};
+    change.content_changes.push_back(edit);
+
+    int64_t version = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < edits_per_analysis; i++) {
+            version++;
+            edit.text = std::to_string(version % 7);
+            change.content_changes[0] = edit;
+            change.text_document.version = version;
+            if (client_session.Send(change) != langsvr::Success) {
+                state.SkipWithError("failed to change document");
+                return;
+            }
+        }
+        if (server.AnalyzePendingChanges() != langsvr::Success ||
+            server.FinishAnalyses() != langsvr::Success) {
+            state.SkipWithError("failed to analyze document");
+            return;
+        }
+    }
+    benchmark::DoNotOptimize(diagnostics);
+}
+
+void EditAndAnalyze(benchmark::State& state) {
+    EditDocument(state, 1);
+}
+
+void EditBurstAndAnalyze(benchmark::State& state) {
+    EditDocument(state, 10);
+}
+
+BENCHMARK(EditAndAnalyze)->Arg(1000)->Arg(10000);
+BENCHMARK(EditBurstAndAnalyze)->Arg(1000)->Arg(10000);
+
+}  // namespace
+}  // namespace tint::wgsl::ls
@@ -0,0 +1,194 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "langsvr/lsp/lsp.h"
+#include "langsvr/lsp/primitives.h"
+#include "langsvr/lsp/printer.h"
+#include "src/tint/lang/wgsl/ls/helpers_test.h"
+
+namespace tint::wgsl::ls {
+namespace {
+
+namespace lsp = langsvr::lsp;
+
+class LsDocumentTest : public LsTest {
+  protected:
+    /// Sends a langsvr::lsp::TextDocumentDidChangeNotification that replaces the ranges of the
+    /// document @p uri with the given text.
+    void ChangeDocument(std::string_view uri,
+                        int64_t version,
+                        std::vector<std::pair<lsp::Range, std::string_view>> edits) {
+        lsp::TextDocumentDidChangeNotification notification{};
+        notification.text_document.uri = uri;
+        notification.text_document.version = version;
+        for (auto& edit : edits) {
+            lsp::TextDocumentContentChangePartial change{};
+            change.range = edit.first;
+            change.text = edit.second;
+            notification.content_changes.push_back(change);
+        }
+        EXPECT_EQ(client_session_.Send(notification), langsvr::Success);
+    }
+
+    /// @returns the messages of the diagnostics of the last diagnostics notification
+    std::vector<std::string> LastDiagnostics() {
+        std::vector<std::string> messages;
+        if (!diagnostics_.IsEmpty()) {
+            for (auto& d : diagnostics_.Back().diagnostics) {
+                messages.push_back(d.message);
+            }
+        }
+        return messages;
+    }
+};
+
+TEST_F(LsDocumentTest, ChangeIsAnalyzedLazily) {
+    auto uri = OpenDocument("const a = 1;\n");
+    ASSERT_EQ(diagnostics_.Length(), 1u);
+    EXPECT_FALSE(server_.HasPendingChanges());
+
+    ChangeDocument(uri, 1, {{lsp::Range{{0, 10}, {0, 11}}, "x"}});
+    EXPECT_EQ(diagnostics_.Length(), 1u);
+    EXPECT_TRUE(server_.HasPendingChanges());
+
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+    EXPECT_FALSE(server_.HasPendingChanges());
+    EXPECT_TRUE(server_.IsAnalyzing());
+
+    EXPECT_EQ(server_.FinishAnalyses(), langsvr::Success);
+    EXPECT_FALSE(server_.IsAnalyzing());
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    EXPECT_THAT(LastDiagnostics(), testing::ElementsAre("unresolved value 'x'"));
+}
+
+TEST_F(LsDocumentTest, MultipleChanges) {
+    auto uri = OpenDocument("const a = 1;\nconst b = 2;\n");
+
+    // Each edit is relative to the text produced by the previous edits.
+    ChangeDocument(uri, 1,
+                   {
+                       {lsp::Range{{0, 0}, {0, 0}}, "const c = b;\n"},
+                       {lsp::Range{{2, 6}, {2, 7}}, "d"},
+                   });
+    ChangeDocument(uri, 2, {{lsp::Range{{0, 10}, {0, 11}}, "d"}});
+    EXPECT_EQ(diagnostics_.Length(), 1u);
+
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+    EXPECT_EQ(server_.FinishAnalyses(), langsvr::Success);
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    EXPECT_THAT(LastDiagnostics(), testing::IsEmpty());
+}
+
+TEST_F(LsDocumentTest, RequestAnalyzesPendingChanges) {
+    auto uri = OpenDocument("const a = 1;\n");
+    ChangeDocument(uri, 1, {{lsp::Range{{1, 0}, {1, 0}}, "const b = a;\n"}});
+    EXPECT_EQ(diagnostics_.Length(), 1u);
+
+    lsp::TextDocumentDocumentSymbolRequest req{};
+    req.text_document.uri = uri;
+    auto future = client_session_.Send(req);
+    ASSERT_EQ(future, langsvr::Success);
+    auto res = future->get();
+    ASSERT_TRUE(res.Is<std::vector<lsp::DocumentSymbol>>());
+    EXPECT_EQ(res.Get<std::vector<lsp::DocumentSymbol>>()->size(), 2u);
+
+    EXPECT_FALSE(server_.HasPendingChanges());
+    EXPECT_FALSE(server_.IsAnalyzing());
+    EXPECT_EQ(diagnostics_.Length(), 2u);
+}
+
+TEST_F(LsDocumentTest, UndoReusesAnalysis) {
+    auto uri = OpenDocument("const a = 1;\n");
+    ChangeDocument(uri, 1, {{lsp::Range{{0, 10}, {0, 11}}, "x"}});
+    ChangeDocument(uri, 2, {{lsp::Range{{0, 10}, {0, 11}}, "1"}});
+
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+    EXPECT_FALSE(server_.IsAnalyzing());
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    EXPECT_THAT(LastDiagnostics(), testing::IsEmpty());
+}
+
+TEST_F(LsDocumentTest, StaleAnalysisIsDiscarded) {
+    auto uri = OpenDocument("const a = 1;\n");
+    ChangeDocument(uri, 1, {{lsp::Range{{0, 10}, {0, 11}}, "x"}});
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+
+    // The second change is made while the first one may still be analyzed. Only the analysis of
+    // the latest version is published.
+    ChangeDocument(uri, 2, {{lsp::Range{{0, 10}, {0, 11}}, "y"}});
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+    EXPECT_EQ(server_.FinishAnalyses(), langsvr::Success);
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    EXPECT_THAT(LastDiagnostics(), testing::ElementsAre("unresolved value 'y'"));
+}
+
+TEST_F(LsDocumentTest, ChangeDuringAnalysis) {
+    auto uri = OpenDocument("const a = 1;\n");
+    ChangeDocument(uri, 1, {{lsp::Range{{0, 10}, {0, 11}}, "x"}});
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+
+    // The change is applied to the text being analyzed, not to the last analyzed text.
+    ChangeDocument(uri, 2, {{lsp::Range{{0, 11}, {0, 11}}, "y"}});
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+    EXPECT_EQ(server_.FinishAnalyses(), langsvr::Success);
+    ASSERT_EQ(diagnostics_.Length(), 2u);
+    EXPECT_THAT(LastDiagnostics(), testing::ElementsAre("unresolved value 'xy'"));
+}
+
+TEST_F(LsDocumentTest, CloseCancelsAnalysis) {
+    auto uri = OpenDocument("const a = 1;\n");
+    ChangeDocument(uri, 1, {{lsp::Range{{0, 10}, {0, 11}}, "x"}});
+    EXPECT_EQ(server_.AnalyzePendingChanges(), langsvr::Success);
+
+    lsp::TextDocumentDidCloseNotification notification{};
+    notification.text_document.uri = uri;
+    EXPECT_EQ(client_session_.Send(notification), langsvr::Success);
+    EXPECT_FALSE(server_.IsAnalyzing());
+
+    EXPECT_EQ(server_.FinishAnalyses(), langsvr::Success);
+    EXPECT_EQ(diagnostics_.Length(), 1u);
+}
+
+TEST_F(LsDocumentTest, CloseDiscardsPendingChanges) {
+    auto uri = OpenDocument("const a = 1;\n");
+    ChangeDocument(uri, 1, {{lsp::Range{{0, 10}, {0, 11}}, "x"}});
+
+    lsp::TextDocumentDidCloseNotification notification{};
+    notification.text_document.uri = uri;
+    EXPECT_EQ(client_session_.Send(notification), langsvr::Success);
+    EXPECT_FALSE(server_.HasPendingChanges());
+}
+
+}  // namespace
+}  // namespace tint::wgsl::ls
@@ -201,8 +201,9 @@ Source::Location File::Conv(langsvr::lsp::Position pos) const {
     loc.column = 0;
 
     // Convert utf-16 code points -> utf-8 code points
-    if (pos.line < source->content.lines.size()) {
-        std::string_view utf8 = source->content.lines[pos.line];
+    auto& lines = source->content.Lines();
+    if (pos.line < lines.size()) {
+        std::string_view utf8 = lines[pos.line];
         for (langsvr::lsp::Uinteger i = 0; i < pos.character;) {
             const auto [code_point, n] = utf8::Decode(utf8.substr(loc.column));
             if (n == 0) {
@@ -223,8 +224,9 @@ langsvr::lsp::Position File::Conv(Source::Location loc) const {
     pos.character = 0;
 
     // Convert utf-8 code points -> utf-16 code points
-    if (pos.line < source->content.lines.size()) {
-        std::string_view utf8 = source->content.lines[pos.line];
+    auto& lines = source->content.Lines();
+    if (pos.line < lines.size()) {
+        std::string_view utf8 = lines[pos.line];
         for (uint32_t i = 0; i < loc.column - 1;) {
             const auto [code_point, n] = utf8::Decode(utf8.substr(i));
             if (n == 0) {
@@ -65,9 +65,9 @@ class LsTestImpl : public BASE {
 
     /// Constructs a langsvr::lsp::TextDocumentDidOpenNotification from @p wgsl and a new, unique
     /// URI, and sends this to the server via the #client_session_. Once the server has finished
-    /// processing the notification, the server will respond with a
+    /// analyzing the document, the server will respond with a
     /// langsvr::lsp::TextDocumentPublishDiagnosticsNotification, which is handled by the
-    /// #client_session_ and placed into #diagnostics_.
+    /// #client_session_ and placed into #diagnostics_. OpenDocument() waits for the analysis.
     std::string OpenDocument(std::string_view wgsl) {
         std::string uri = "document-" + std::to_string(next_document_id_++) + ".wgsl";
         langsvr::lsp::TextDocumentDidOpenNotification notification{};
@@ -75,6 +75,7 @@ class LsTestImpl : public BASE {
         notification.text_document.uri = uri;
         auto res = client_session_.Send(notification);
         EXPECT_EQ(res, langsvr::Success);
+        EXPECT_EQ(server_.FinishAnalyses(), langsvr::Success);
         return uri;
     }
 
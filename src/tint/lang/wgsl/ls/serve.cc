@@ -28,7 +28,14 @@
 #include "src/tint/lang/wgsl/ls/serve.h"
 
 #include <stdio.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 
 #include "langsvr/content_stream.h"
 #include "langsvr/lsp/lsp.h"
@@ -46,7 +53,6 @@
 
 #if WAIT_FOR_DEBUGGER
 #include <unistd.h>
-#include <thread>
 #endif
 
 #if LOG_TO_FILE
@@ -75,6 +81,21 @@ void TintInternalCompilerErrorReporter(const tint::InternalCompilerError& err) {
 }
 #endif
 
+/// The time to wait for further messages after a document change, before analyzing the changed
+/// documents. This avoids re-analyzing the document for each key press while the user is typing.
+constexpr auto kAnalysisDelay = std::chrono::milliseconds(100);
+
+/// MessageQueue holds the messages read by the reader thread, until they are handled by the server.
+struct MessageQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<langsvr::Result<std::string>> messages;
+    /// True when analyses have finished on the analysis thread, and need to be applied.
+    bool analyses_finished = false;
+    /// True when the server has stopped handling messages, and the reader thread must stop.
+    bool closed = false;
+};
+
 }  // namespace
 
 Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer) {
@@ -89,20 +110,94 @@ Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer) {
     std::this_thread::sleep_for(std::chrono::seconds(10));
 #endif
 
+    // The queue is shared with the reader thread, as the thread is detached if the server stops on
+    // an error.
+    auto queue = std::make_shared<MessageQueue>();
+
     langsvr::Session session;
+    Server server(session);
+    server.SetAnalysisFinishedCallback([queue] {
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->analyses_finished = true;
+        }
+        queue->cv.notify_one();
+    });
+
     session.SetSender([&](std::string_view response) {  //
         LOG("<< %s", std::string(response).c_str());
+        if (server.ShuttingDown()) {
+            // This is the response to the shutdown request, after which the client only sends the
+            // 'exit' notification. Close the queue before the client can receive the response, so
+            // that the reader thread stops once it has read the 'exit' notification.
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->closed = true;
+        }
         return langsvr::WriteContent(writer, response);
     });
 
-    Server server(session);
-
     LOG("Running...");
 
+    // Messages are read on a separate thread so that the changed documents can be analyzed once
+    // the client has stopped sending changes. The thread stops after the first message read once
+    // the queue is closed, which is the 'exit' notification after a shutdown.
+    std::thread reader_thread([queue, &reader] {
+        while (true) {
+            auto msg = langsvr::ReadContent(reader);
+            bool ok = msg == langsvr::Success;
+            {
+                std::lock_guard<std::mutex> lock(queue->mutex);
+                queue->messages.push_back(std::move(msg));
+                ok = ok && !queue->closed;
+            }
+            queue->cv.notify_one();
+            if (!ok) {
+                return;
+            }
+        }
+    });
+
+    bool failed = false;
     while (!server.ShuttingDown()) {
-        auto msg = langsvr::ReadContent(reader);
+        langsvr::Result<std::string> msg = langsvr::Failure{};
+        bool analyses_finished = false;
+        {
+            std::unique_lock<std::mutex> lock(queue->mutex);
+            auto ready = [&] { return !queue->messages.empty() || queue->analyses_finished; };
+            if (server.HasPendingChanges()) {
+                if (!queue->cv.wait_for(lock, kAnalysisDelay, ready)) {
+                    lock.unlock();
+                    if (auto res = server.AnalyzePendingChanges(); res != langsvr::Success) {
+                        LOG("ERROR: %s", res.Failure().reason.c_str());
+                        failed = true;
+                        break;
+                    }
+                    continue;
+                }
+            } else {
+                queue->cv.wait(lock, ready);
+            }
+            if (queue->analyses_finished) {
+                queue->analyses_finished = false;
+                analyses_finished = true;
+            } else {
+                msg = std::move(queue->messages.front());
+                queue->messages.pop_front();
+            }
+        }
+
+        if (analyses_finished) {
+            if (auto res = server.ApplyFinishedAnalyses(); res != langsvr::Success) {
+                LOG("ERROR: %s", res.Failure().reason.c_str());
+                failed = true;
+                break;
+            }
+            continue;
+        }
+
         if (msg != langsvr::Success) {
             LOG("ERROR: %s", msg.Failure().reason.c_str());
+            failed = true;
             break;
         }
         LOG(">> %s", msg.Get().c_str());
@@ -110,12 +205,24 @@ Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer) {
         auto res = session.Receive(msg.Get());
         if (res != langsvr::Success) {
             LOG("ERROR: %s", res.Failure().reason.c_str());
+            failed = true;
             break;
         }
 
         LOG("----------------");
     }
 
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->closed = true;
+    }
+    if (failed) {
+        // The reader thread may be blocked reading a message that the client never sends.
+        reader_thread.detach();
+    } else {
+        reader_thread.join();
+    }
+
     LOG("Shutting down");
     return Success;
 }
@@ -36,6 +36,8 @@ namespace tint::wgsl::ls {
 
 /// Serve creates a WGSL language server that reads from @p reader and writes to @p writer.
 /// Blocks until the server is shutdown by the client.
+/// @note @p reader is read from a separate thread. If the server stops on an error, the thread is
+/// detached and may still be blocked reading from @p reader when Serve() returns.
 Result<SuccessType> Serve(langsvr::Reader& reader, langsvr::Writer& writer);
 
 }  // namespace tint::wgsl::ls
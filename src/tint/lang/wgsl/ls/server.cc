@@ -98,22 +98,34 @@ Server::Server(langsvr::Session& session) : session_(session) {
         [&](const lsp::WorkspaceDidChangeConfigurationNotification& n) { return Handle(n); });
 
     // Request handlers
-    session.Register([&](const lsp::TextDocumentCompletionRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentDefinitionRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentDocumentSymbolRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentHoverRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentInlayHintRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentPrepareRenameRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentReferencesRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentRenameRequest& r) { return Handle(r); });
+    session.Register([&](const lsp::TextDocumentCompletionRequest& r) { return HandleRequest(r); });
+    session.Register([&](const lsp::TextDocumentDefinitionRequest& r) { return HandleRequest(r); });
     session.Register(
-        [&](const lsp::TextDocumentSemanticTokensFullRequest& r) { return Handle(r); });
-    session.Register([&](const lsp::TextDocumentSignatureHelpRequest& r) { return Handle(r); });
+        [&](const lsp::TextDocumentDocumentSymbolRequest& r) { return HandleRequest(r); });
+    session.Register([&](const lsp::TextDocumentHoverRequest& r) { return HandleRequest(r); });
+    session.Register([&](const lsp::TextDocumentInlayHintRequest& r) { return HandleRequest(r); });
+    session.Register(
+        [&](const lsp::TextDocumentPrepareRenameRequest& r) { return HandleRequest(r); });
+    session.Register([&](const lsp::TextDocumentReferencesRequest& r) { return HandleRequest(r); });
+    session.Register([&](const lsp::TextDocumentRenameRequest& r) { return HandleRequest(r); });
+    session.Register(
+        [&](const lsp::TextDocumentSemanticTokensFullRequest& r) { return HandleRequest(r); });
+    session.Register(
+        [&](const lsp::TextDocumentSignatureHelpRequest& r) { return HandleRequest(r); });
     session.Register(
         [&](const lsp::WorkspaceDidChangeWatchedFilesNotification& n) { return Handle(n); });
+
+    analysis_thread_ = std::thread([this] { RunAnalyses(); });
 }
 
-Server::~Server() = default;
+Server::~Server() {
+    {
+        std::lock_guard<std::mutex> lock(analysis_mutex_);
+        stop_analyses_ = true;
+    }
+    analysis_cv_.notify_all();
+    analysis_thread_.join();
+}
 
 Server::Logger::~Logger() {
     lsp::WindowLogMessageNotification n;
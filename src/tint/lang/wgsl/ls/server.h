@@ -28,14 +28,22 @@
 #ifndef SRC_TINT_LANG_WGSL_LS_SERVER_H_
 #define SRC_TINT_LANG_WGSL_LS_SERVER_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "langsvr/lsp/lsp.h"
 #include "langsvr/session.h"
 
 #include "src/tint/lang/wgsl/ls/file.h"
+#include "src/tint/lang/wgsl/ls/text_buffer.h"
 #include "src/tint/utils/containers/hashmap.h"
 #include "src/tint/utils/text/string_stream.h"
 
@@ -54,6 +62,37 @@ class Server {
     /// @returns true if the server has been requested to shut down.
     bool ShuttingDown() const { return shutting_down_; }
 
+    /// @returns true if documents have changed since they were last analyzed.
+    bool HasPendingChanges() const { return !pending_changes_.IsEmpty(); }
+
+    /// @returns true if documents are being analyzed on the analysis thread.
+    bool IsAnalyzing() const { return !analyses_.IsEmpty(); }
+
+    /// Starts analyzing the documents that have changed since they were last analyzed.
+    /// Document changes are not analyzed when they are received, so that a burst of edits is only
+    /// analyzed once. The server analyzes them before handling any request, and the caller should
+    /// call AnalyzePendingChanges() once the client stops sending messages.
+    /// The documents are parsed and resolved on the analysis thread. A change to a document
+    /// cancels its analysis that is still in progress.
+    /// @returns the result of publishing the diagnostics of the documents that did not need to be
+    /// analyzed again
+    langsvr::Result<langsvr::SuccessType> AnalyzePendingChanges();
+
+    /// Replaces the documents that have finished being analyzed, and publishes their diagnostics.
+    /// Analyses of document versions that are no longer current are discarded.
+    /// Does not block.
+    /// @returns the first failure to publish the diagnostics of a document, or success
+    langsvr::Result<langsvr::SuccessType> ApplyFinishedAnalyses();
+
+    /// Waits for all the documents being analyzed, then calls ApplyFinishedAnalyses().
+    /// @returns the result of publishing the diagnostics
+    langsvr::Result<langsvr::SuccessType> FinishAnalyses();
+
+    /// Sets the function called on the analysis thread each time an analysis finishes, so that
+    /// the caller can call ApplyFinishedAnalyses() on the server thread.
+    /// @param callback the function to call
+    void SetAnalysisFinishedCallback(std::function<void()> callback);
+
   private:
     ////////////////////////////////////////////////////////////////////////////
     // Requests
@@ -135,6 +174,39 @@ class Server {
     langsvr::Result<langsvr::SuccessType>  //
     Handle(const langsvr::lsp::WorkspaceDidChangeWatchedFilesNotification&);
 
+    /// Analyzes the pending changes and waits for the analyses, then calls the handler for the
+    /// request @p r, so that requests always see the latest version of the documents.
+    template <typename REQUEST>
+    auto HandleRequest(const REQUEST& r) -> decltype(Handle(r)) {
+        if (auto res = AnalyzePendingChanges(); res != langsvr::Success) {
+            return res.Failure();
+        }
+        if (auto res = FinishAnalyses(); res != langsvr::Success) {
+            return res.Failure();
+        }
+        return Handle(r);
+    }
+
+    /// Parses and resolves the WGSL document @p text.
+    /// Does not use the server state, so it can be called from any thread.
+    /// @param uri the URI of the document
+    /// @param text the WGSL text
+    /// @param version the version of the document
+    /// @returns the analyzed File
+    static std::shared_ptr<File> Analyze(std::string_view uri,
+                                         std::string_view text,
+                                         int64_t version);
+
+    /// Queues the analysis of the version @p version of the document @p uri, with the text
+    /// @p text. The analysis replaces any analysis of the document that is in progress.
+    void StartAnalysis(const std::string& uri, std::string text, int64_t version);
+
+    /// Cancels the analysis of the document @p uri that is in progress, if any.
+    void CancelAnalysis(const std::string& uri);
+
+    /// The function run by the analysis thread.
+    void RunAnalyses();
+
     /// Publishes the tint::Program diagnostics to the server via a
     /// TextDocumentPublishDiagnosticsNotification.
     langsvr::Result<langsvr::SuccessType>  //
@@ -168,6 +240,52 @@ class Server {
     langsvr::Session& session_;
     /// Map of URI to File.
     Hashmap<std::string, std::shared_ptr<File>, 8> files_;
+
+    /// The latest text of a document that has changed since it was last analyzed.
+    struct PendingChange {
+        /// The edited text
+        TextBuffer text;
+        /// The version of the document
+        int64_t version = 0;
+    };
+    /// Map of URI to the changes that have not been analyzed yet.
+    Hashmap<std::string, std::shared_ptr<PendingChange>, 8> pending_changes_;
+
+    /// The analysis of a version of a document, run on the analysis thread.
+    struct Analysis {
+        /// The URI of the document
+        std::string uri;
+        /// The text of the document
+        std::string text;
+        /// The version of the document
+        int64_t version = 0;
+        /// True if the analysis is no longer needed. Analyses that are cancelled before they start
+        /// are skipped.
+        std::atomic<bool> cancelled = false;
+        /// True once the analysis thread is done with the analysis. Guarded by analysis_mutex_.
+        bool done = false;
+        /// The analyzed file, or null if the analysis was cancelled. Guarded by analysis_mutex_.
+        std::shared_ptr<File> file;
+    };
+    /// Map of URI to the analysis in progress of the latest version of the document.
+    /// Only used by the server thread.
+    Hashmap<std::string, std::shared_ptr<Analysis>, 8> analyses_;
+
+    /// The mutex guarding the state shared with the analysis thread.
+    std::mutex analysis_mutex_;
+    /// Notified when an analysis is queued or finished, and when the analysis thread must stop.
+    std::condition_variable analysis_cv_;
+    /// The analyses waiting for the analysis thread.
+    std::deque<std::shared_ptr<Analysis>> analysis_queue_;
+    /// The analyses finished by the analysis thread, which have not been applied yet.
+    std::vector<std::shared_ptr<Analysis>> finished_analyses_;
+    /// The function called by the analysis thread when an analysis finishes.
+    std::function<void()> analysis_finished_callback_;
+    /// True when the analysis thread must stop.
+    bool stop_analyses_ = false;
+    /// The thread running the analyses.
+    std::thread analysis_thread_;
+
     /// True if the server has been asked to shutdown.
     bool shutting_down_ = false;
 };
@@ -73,7 +73,7 @@ size_t CalcParamIndex(const File& file,
     auto range = file.Conv(call_source.range);
     auto start = range.start;
     auto end = std::min(range.end, file.Conv(position));
-    auto& lines = call_source.file->content.lines;
+    auto& lines = call_source.file->content.Lines();
 
     for (auto line_idx = start.line; line_idx <= end.line; line_idx++) {
         auto& line = lines[line_idx];
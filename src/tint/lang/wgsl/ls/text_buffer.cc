@@ -0,0 +1,101 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/wgsl/ls/text_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "src/tint/utils/text/unicode.h"
+
+namespace tint::wgsl::ls {
+
+namespace {
+
+/// Appends the byte offsets of the lines starting in @p str to @p offsets.
+/// @param str the text to scan
+/// @param base the byte offset of @p str in the whole text
+/// @param offsets the line offsets to append to
+void AppendLineOffsets(std::string_view str, size_t base, std::vector<size_t>& offsets) {
+    for (size_t i = str.find('\n'); i != std::string_view::npos; i = str.find('\n', i + 1)) {
+        offsets.push_back(base + i + 1);
+    }
+}
+
+}  // namespace
+
+TextBuffer::TextBuffer(std::string text) : text_(std::move(text)) {
+    line_offsets_.push_back(0);
+    AppendLineOffsets(text_, 0, line_offsets_);
+}
+
+size_t TextBuffer::Offset(langsvr::lsp::Position pos) const {
+    if (pos.line >= line_offsets_.size()) {
+        return text_.size();
+    }
+    size_t offset = line_offsets_[pos.line];
+    size_t line_end =
+        pos.line + 1 < line_offsets_.size() ? line_offsets_[pos.line + 1] - 1 : text_.size();
+
+    // Convert utf-16 code units -> utf-8 code units
+    std::string_view line = std::string_view(text_).substr(offset, line_end - offset);
+    size_t column = 0;
+    for (langsvr::lsp::Uinteger i = 0; i < pos.character;) {
+        const auto [code_point, n] = utf8::Decode(line.substr(column));
+        if (n == 0) {
+            break;
+        }
+        column += n;
+        i += utf16::Encode(code_point, nullptr);
+    }
+    return offset + column;
+}
+
+void TextBuffer::Edit(langsvr::lsp::Range range, std::string_view text) {
+    size_t start = Offset(range.start);
+    size_t end = std::max(start, Offset(range.end));
+
+    // The lines that start within the replaced text are replaced by the lines of the new text.
+    // The lines after it are shifted by the difference in size.
+    auto first = std::upper_bound(line_offsets_.begin(), line_offsets_.end(), start);
+    auto last = std::upper_bound(first, line_offsets_.end(), end);
+    std::vector<size_t> inserted;
+    AppendLineOffsets(text, start, inserted);
+    size_t first_index = static_cast<size_t>(first - line_offsets_.begin());
+    first = line_offsets_.erase(first, last);
+    line_offsets_.insert(first, inserted.begin(), inserted.end());
+
+    size_t delta_added = text.size();
+    size_t delta_removed = end - start;
+    for (size_t i = first_index + inserted.size(); i < line_offsets_.size(); i++) {
+        line_offsets_[i] = line_offsets_[i] + delta_added - delta_removed;
+    }
+
+    text_.replace(start, end - start, text);
+}
+
+}  // namespace tint::wgsl::ls
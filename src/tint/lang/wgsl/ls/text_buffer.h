@@ -0,0 +1,76 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_TINT_LANG_WGSL_LS_TEXT_BUFFER_H_
+#define SRC_TINT_LANG_WGSL_LS_TEXT_BUFFER_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "langsvr/lsp/lsp.h"
+
+namespace tint::wgsl::ls {
+
+/// TextBuffer holds the UTF-8 text of a document that is being edited, along with the byte offsets
+/// of the start of its lines. The line offsets are patched by each edit, instead of being
+/// recomputed by scanning the whole text.
+class TextBuffer {
+  public:
+    /// Constructor
+    /// @param text the initial text
+    explicit TextBuffer(std::string text);
+
+    /// @returns the current text
+    const std::string& Text() const { return text_; }
+
+    /// @returns the number of lines in the text
+    size_t LineCount() const { return line_offsets_.size(); }
+
+    /// @returns the byte offset of the start of the zero-based line @p line
+    size_t LineOffset(size_t line) const { return line_offsets_[line]; }
+
+    /// @returns the byte offset of the zero-based position @p pos, in utf-16 code units, clamped
+    /// to the end of its line and to the end of the text.
+    size_t Offset(langsvr::lsp::Position pos) const;
+
+    /// Replaces the text in the range @p range, in utf-16 code units, with @p text.
+    /// @param range the range to replace
+    /// @param text the replacement text
+    void Edit(langsvr::lsp::Range range, std::string_view text);
+
+  private:
+    /// The UTF-8 text
+    std::string text_;
+    /// The byte offsets of the start of each line of #text_
+    std::vector<size_t> line_offsets_;
+};
+
+}  // namespace tint::wgsl::ls
+
+#endif  // SRC_TINT_LANG_WGSL_LS_TEXT_BUFFER_H_
@@ -0,0 +1,143 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/lang/wgsl/ls/text_buffer.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace tint::wgsl::ls {
+namespace {
+
+namespace lsp = langsvr::lsp;
+
+/// @returns the byte offsets of the start of all the lines in @p str, by scanning the whole text.
+std::vector<size_t> ScanLineOffsets(std::string_view str) {
+    std::vector<size_t> offsets{0};
+    for (size_t i = 0; i < str.size(); i++) {
+        if (str[i] == '\n') {
+            offsets.push_back(i + 1);
+        }
+    }
+    return offsets;
+}
+
+/// Checks that the line offsets of @p buffer match those of its text.
+void ExpectLineOffsets(const TextBuffer& buffer) {
+    auto expect = ScanLineOffsets(buffer.Text());
+    ASSERT_EQ(buffer.LineCount(), expect.size()) << buffer.Text();
+    for (size_t i = 0; i < expect.size(); i++) {
+        EXPECT_EQ(buffer.LineOffset(i), expect[i]) << "line: " << i << "\n" << buffer.Text();
+    }
+}
+
+lsp::Range Range(lsp::Uinteger start_line,
+                 lsp::Uinteger start_character,
+                 lsp::Uinteger end_line,
+                 lsp::Uinteger end_character) {
+    return lsp::Range{{start_line, start_character}, {end_line, end_character}};
+}
+
+TEST(LsTextBufferTest, LineOffsets) {
+    TextBuffer buffer{"ab\n\ncd\n"};
+    ASSERT_EQ(buffer.LineCount(), 4u);
+    EXPECT_EQ(buffer.LineOffset(0), 0u);
+    EXPECT_EQ(buffer.LineOffset(1), 3u);
+    EXPECT_EQ(buffer.LineOffset(2), 4u);
+    EXPECT_EQ(buffer.LineOffset(3), 7u);
+}
+
+TEST(LsTextBufferTest, Offset) {
+    TextBuffer buffer{"ab\ncd"};
+    EXPECT_EQ(buffer.Offset({0, 0}), 0u);
+    EXPECT_EQ(buffer.Offset({0, 2}), 2u);
+    EXPECT_EQ(buffer.Offset({1, 1}), 4u);
+    // Clamped to the end of the line
+    EXPECT_EQ(buffer.Offset({0, 10}), 2u);
+    // Clamped to the end of the text
+    EXPECT_EQ(buffer.Offset({1, 10}), 5u);
+    EXPECT_EQ(buffer.Offset({5, 0}), 5u);
+}
+
+TEST(LsTextBufferTest, OffsetUTF16) {
+    // 'é' is 2 utf-8 code units and 1 utf-16 code unit.
+    // '𝓌' is 4 utf-8 code units and 2 utf-16 code units.
+    TextBuffer buffer{"é𝓌x"};
+    EXPECT_EQ(buffer.Offset({0, 1}), 2u);
+    EXPECT_EQ(buffer.Offset({0, 3}), 6u);
+    EXPECT_EQ(buffer.Offset({0, 4}), 7u);
+}
+
+TEST(LsTextBufferTest, EditInsert) {
+    TextBuffer buffer{"ab\ncd"};
+    buffer.Edit(Range(0, 1, 0, 1), "X");
+    EXPECT_EQ(buffer.Text(), "aXb\ncd");
+    ExpectLineOffsets(buffer);
+}
+
+TEST(LsTextBufferTest, EditInsertLines) {
+    TextBuffer buffer{"ab\ncd\nef"};
+    buffer.Edit(Range(1, 1, 1, 1), "1\n2\n3");
+    EXPECT_EQ(buffer.Text(), "ab\nc1\n2\n3d\nef");
+    ExpectLineOffsets(buffer);
+}
+
+TEST(LsTextBufferTest, EditRemoveLines) {
+    TextBuffer buffer{"ab\ncd\nef\ngh"};
+    buffer.Edit(Range(0, 1, 2, 1), "");
+    EXPECT_EQ(buffer.Text(), "af\ngh");
+    ExpectLineOffsets(buffer);
+}
+
+TEST(LsTextBufferTest, EditReplaceLines) {
+    TextBuffer buffer{"ab\ncd\nef\ngh"};
+    buffer.Edit(Range(1, 0, 2, 0), "1\n2\n3\n");
+    EXPECT_EQ(buffer.Text(), "ab\n1\n2\n3\nef\ngh");
+    ExpectLineOffsets(buffer);
+}
+
+TEST(LsTextBufferTest, EditEnd) {
+    TextBuffer buffer{"ab\n"};
+    buffer.Edit(Range(1, 0, 1, 0), "cd\n");
+    EXPECT_EQ(buffer.Text(), "ab\ncd\n");
+    ExpectLineOffsets(buffer);
+}
+
+TEST(LsTextBufferTest, EditSequence) {
+    TextBuffer buffer{"fn f() {\n}\n"};
+    buffer.Edit(Range(0, 8, 0, 8), "\n  let a = 1;");
+    buffer.Edit(Range(1, 10, 1, 11), "2\n  let b = a");
+    buffer.Edit(Range(0, 0, 0, 0), "// comment\n");
+    buffer.Edit(Range(2, 0, 3, 0), "");
+    EXPECT_EQ(buffer.Text(), "// comment\nfn f() {\n  let b = a;\n}\n");
+    ExpectLineOffsets(buffer);
+}
+
+}  // namespace
+}  // namespace tint::wgsl::ls
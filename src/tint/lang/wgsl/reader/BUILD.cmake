@@ -175,6 +175,7 @@ endif(TINT_BUILD_SPV_READER AND TINT_BUILD_WGSL_READER AND TINT_BUILD_WGSL_WRITE
 if(TINT_BUILD_WGSL_READER)
   tint_target_add_dependencies(tint_lang_wgsl_reader_bench bench
     tint_lang_wgsl_reader
+    tint_lang_wgsl_reader_parser
   )
 endif(TINT_BUILD_WGSL_READER)
 
@@ -28,6 +28,8 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_OPTIONS_H_
 #define SRC_TINT_LANG_WGSL_READER_OPTIONS_H_
 
+#include <cstdint>
+
 #include "src/tint/lang/wgsl/common/allowed_features.h"
 #include "src/tint/lang/wgsl/common/validation_mode.h"
 #include "src/tint/utils/reflection/reflection.h"
@@ -42,8 +44,12 @@ struct Options {
     /// The validation mode to use.
     ValidationMode mode = ValidationMode::kFull;
 
+    /// The number of threads used to resolve function bodies. Values less than 2 resolve all
+    /// function bodies on the calling thread.
+    uint32_t function_resolution_threads = 0;
+
     /// Reflect the fields of this class so that it can be used by tint::ForeachField().
-    TINT_REFLECT(Options, allowed_features, mode);
+    TINT_REFLECT(Options, allowed_features, mode, function_resolution_threads);
 };
 
 }  // namespace tint::wgsl::reader
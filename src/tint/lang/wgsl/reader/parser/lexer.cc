@@ -43,6 +43,18 @@
 #include "src/tint/utils/strconv/parse_num.h"
 #include "src/tint/utils/text/unicode.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define TINT_WGSL_LEXER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define TINT_WGSL_LEXER_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 using namespace tint::core::fluent_types;  // NOLINT
 
 namespace tint::wgsl::reader {
@@ -86,6 +98,138 @@ bool read_blankspace(std::string_view str,
     return true;
 }
 
+/// Classes of ASCII characters that the lexer skips over in bulk.
+enum class CharClass {
+    /// ' ' and '\t', the ASCII blankspace characters that are not line breaks.
+    kBlankspace,
+    /// '0' to '9'.
+    kDigit,
+    /// The ASCII XID_Continue characters: letters, digits and '_'.
+    kIdentifier,
+    /// Characters without meaning inside a block comment, i.e. anything but '/', '*' and '\0'.
+    kBlockComment,
+};
+
+/// @returns true if @p c is not part of a multi-byte UTF-8 sequence
+bool is_ascii(char c) {
+    return static_cast<uint8_t>(c) < 0x80;
+}
+
+/// @returns true if @p c is an ASCII letter
+bool is_ascii_alpha(char c) {
+    char lower = static_cast<char>(c | 0x20);
+    return lower >= 'a' && lower <= 'z';
+}
+
+/// @returns true if @p c belongs to the character class @p kClass
+template <CharClass kClass>
+bool is_in_class(char c) {
+    if constexpr (kClass == CharClass::kBlankspace) {
+        return c == ' ' || c == '\t';
+    } else if constexpr (kClass == CharClass::kDigit) {
+        return c >= '0' && c <= '9';
+    } else if constexpr (kClass == CharClass::kIdentifier) {
+        return is_ascii_alpha(c) || (c >= '0' && c <= '9') || c == '_';
+    } else {
+        return c != '/' && c != '*' && c != '\0';
+    }
+}
+
+#if defined(TINT_WGSL_LEXER_SSE2) || defined(TINT_WGSL_LEXER_NEON)
+/// @returns the number of trailing zero bits of @p value, which must not be zero
+uint32_t count_trailing_zeros(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;  // NOLINT(runtime/int)
+    _BitScanForward64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+#endif
+
+#if defined(TINT_WGSL_LEXER_SSE2)
+/// @returns a mask with the bytes of @p v that belong to the character class @p kClass set to 0xff
+template <CharClass kClass>
+__m128i match_class(__m128i v) {
+    // Bytes are compared as signed integers. Bytes of multi-byte UTF-8 sequences are negative,
+    // so they never fall in the ASCII ranges.
+    auto in_range = [](__m128i x, char lo, char hi) {
+        return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                             _mm_cmplt_epi8(x, _mm_set1_epi8(static_cast<char>(hi + 1))));
+    };
+    if constexpr (kClass == CharClass::kBlankspace) {
+        return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                            _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+    } else if constexpr (kClass == CharClass::kDigit) {
+        return in_range(v, '0', '9');
+    } else if constexpr (kClass == CharClass::kIdentifier) {
+        __m128i alpha = in_range(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+        __m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+        return _mm_or_si128(_mm_or_si128(alpha, in_range(v, '0', '9')), underscore);
+    } else {
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('/')),
+                                       _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(v, _mm_setzero_si128()));
+        return _mm_andnot_si128(special, _mm_set1_epi8(-1));
+    }
+}
+#elif defined(TINT_WGSL_LEXER_NEON)
+/// @returns a mask with the bytes of @p v that belong to the character class @p kClass set to 0xff
+template <CharClass kClass>
+uint8x16_t match_class(uint8x16_t v) {
+    auto in_range = [](uint8x16_t x, char lo, char hi) {
+        return vandq_u8(vcgeq_u8(x, vdupq_n_u8(static_cast<uint8_t>(lo))),
+                        vcleq_u8(x, vdupq_n_u8(static_cast<uint8_t>(hi))));
+    };
+    if constexpr (kClass == CharClass::kBlankspace) {
+        return vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t')));
+    } else if constexpr (kClass == CharClass::kDigit) {
+        return in_range(v, '0', '9');
+    } else if constexpr (kClass == CharClass::kIdentifier) {
+        uint8x16_t alpha = in_range(vorrq_u8(v, vdupq_n_u8(0x20)), 'a', 'z');
+        uint8x16_t underscore = vceqq_u8(v, vdupq_n_u8('_'));
+        return vorrq_u8(vorrq_u8(alpha, in_range(v, '0', '9')), underscore);
+    } else {
+        uint8x16_t special = vorrq_u8(vceqq_u8(v, vdupq_n_u8('/')), vceqq_u8(v, vdupq_n_u8('*')));
+        special = vorrq_u8(special, vceqq_u8(v, vdupq_n_u8(0)));
+        return vmvnq_u8(special);
+    }
+}
+#endif
+
+/// @returns the position of the first character at or after @p pos in @p str that doesn't belong
+/// to the character class @p kClass, or the size of @p str if there is none
+template <CharClass kClass>
+uint32_t skip_class(std::string_view str, uint32_t pos) {
+    const char* data = str.data();
+    const size_t size = str.size();
+    size_t i = pos;
+#if defined(TINT_WGSL_LEXER_SSE2)
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t matches = static_cast<uint32_t>(_mm_movemask_epi8(match_class<kClass>(v)));
+        if (matches != 0xffff) {
+            return static_cast<uint32_t>(i + count_trailing_zeros(~matches));
+        }
+    }
+#elif defined(TINT_WGSL_LEXER_NEON)
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        // Narrow the byte mask to 4 bits per byte to extract it as a 64-bit integer.
+        uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(match_class<kClass>(v)), 4);
+        uint64_t matches = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        if (matches != ~uint64_t(0)) {
+            return static_cast<uint32_t>(i + count_trailing_zeros(~matches) / 4);
+        }
+    }
+#endif
+    while (i < size && is_in_class<kClass>(data[i])) {
+        i++;
+    }
+    return static_cast<uint32_t>(i);
+}
+
 uint32_t dec_value(char c) {
     if (c >= '0' && c <= '9') {
         return static_cast<uint32_t>(c - '0');
@@ -108,7 +252,11 @@ uint32_t hex_value(char c) {
 
 }  // namespace
 
-Lexer::Lexer(const Source::File* file) : file_(file), location_{1, 1} {}
+Lexer::Lexer(const Source::File* file) : file_(file), location_{1, 1} {
+    auto line_break = FindLineBreak(file_->content.data, 0);
+    line_end_ = line_break.offset;
+    next_line_start_ = line_break.offset + line_break.size;
+}
 
 Lexer::~Lexer() = default;
 
@@ -135,11 +283,7 @@ std::vector<Token> Lexer::Lex() {
 }
 
 std::string_view Lexer::line() const {
-    if (file_->content.lines.size() == 0) {
-        static const char* empty_string = "";
-        return empty_string;
-    }
-    return file_->content.lines[location_.line - 1];
+    return file_->content.data.substr(line_start_, line_end_ - line_start_);
 }
 
 uint32_t Lexer::pos() const {
@@ -176,10 +320,14 @@ void Lexer::set_pos(uint32_t pos) {
 void Lexer::advance_line() {
     location_.line++;
     location_.column = 1;
+    auto line_break = FindLineBreak(file_->content.data, next_line_start_);
+    line_start_ = next_line_start_;
+    line_end_ = line_break.offset;
+    next_line_start_ = line_break.offset + line_break.size;
 }
 
 bool Lexer::is_eof() const {
-    return location_.line >= file_->content.lines.size() && pos() >= length();
+    return next_line_start_ >= file_->content.data.size() && pos() >= length();
 }
 
 bool Lexer::is_eol() const {
@@ -191,6 +339,23 @@ Token Lexer::next() {
         return std::move(t.value());
     }
 
+    // Only try the kinds of tokens that can start with the current character. Non-ASCII
+    // characters can only start identifiers.
+    const char c = at(pos());
+    if (is_ascii_alpha(c) || c == '_' || !is_ascii(c)) {
+        if (auto t = try_ident(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
+        return {Token::Type::kError, begin_source(), "invalid character found"};
+    }
+    if (!is_digit(c) && c != '.') {
+        if (auto t = try_punctuation(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
+        return {Token::Type::kError, begin_source(),
+                (is_null() ? "null character found" : "invalid character found")};
+    }
+
     if (auto t = try_hex_float(); t.has_value() && !t->IsUninitialized()) {
         return std::move(t.value());
     }
@@ -236,10 +401,10 @@ bool Lexer::is_null() const {
 }
 
 bool Lexer::is_digit(char ch) const {
-    return std::isdigit(static_cast<unsigned char>(ch));
+    return ch >= '0' && ch <= '9';
 }
 bool Lexer::is_hex(char ch) const {
-    return std::isxdigit(static_cast<unsigned char>(ch));
+    return is_digit(ch) || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F');
 }
 
 bool Lexer::matches(uint32_t pos, std::string_view sub_string) {
@@ -265,6 +430,16 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
                 continue;
             }
 
+            // Fast path for ASCII blankspace. Other ASCII characters are never blankspace.
+            auto l = line();
+            if (auto end = skip_class<CharClass::kBlankspace>(l, pos()); end != pos()) {
+                set_pos(end);
+                continue;
+            }
+            if (is_ascii(l[pos()])) {
+                break;
+            }
+
             bool is_blankspace;
             uint32_t blankspace_size;
             if (!read_blankspace(line(), pos(), &is_blankspace, &blankspace_size)) {
@@ -298,12 +473,11 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
 std::optional<Token> Lexer::skip_comment() {
     if (matches(pos(), "//")) {
         // Line comment: ignore everything until the end of line.
-        while (!is_eol()) {
-            if (is_null()) {
-                return Token{Token::Type::kError, begin_source(), "null character found"};
-            }
-            advance();
+        if (auto null = line().substr(pos()).find('\0'); null != std::string_view::npos) {
+            advance(static_cast<uint32_t>(null));
+            return Token{Token::Type::kError, begin_source(), "null character found"};
         }
+        set_pos(length());
         return {};
     }
 
@@ -332,8 +506,9 @@ std::optional<Token> Lexer::skip_comment() {
             } else if (is_null()) {
                 return Token{Token::Type::kError, begin_source(), "null character found"};
             } else {
-                // Anything else: skip and update source location.
-                advance();
+                // Anything else: skip it, and all the following characters that can't start or
+                // end a block comment.
+                set_pos(skip_class<CharClass::kBlockComment>(line(), pos() + 1));
             }
         }
         if (depth > 0) {
@@ -351,14 +526,31 @@ std::optional<Token> Lexer::try_float() {
     bool has_mantissa_digits = false;
 
     std::optional<size_t> first_significant_digit_position;
-    while (end < length() && is_digit(at(end))) {
-        if (!first_significant_digit_position.has_value() && (at(end) != '0')) {
-            first_significant_digit_position = end;
+    // Consumes a run of decimal digits, recording the position of the first non-zero digit.
+    // @returns the number of leading zeros in the run, before any significant digit.
+    auto consume_digits = [&] {
+        const auto l = line();
+        const auto digits_end = skip_class<CharClass::kDigit>(l, end);
+        if (digits_end == end) {
+            return size_t(0);
         }
-
         has_mantissa_digits = true;
-        end++;
-    }
+        size_t zeros = 0;
+        if (!first_significant_digit_position.has_value()) {
+            auto non_zero = end;
+            while (non_zero < digits_end && l[non_zero] == '0') {
+                non_zero++;
+            }
+            if (non_zero < digits_end) {
+                first_significant_digit_position = non_zero;
+            }
+            zeros = non_zero - end;
+        }
+        end = digits_end;
+        return zeros;
+    };
+
+    consume_digits();
 
     std::optional<size_t> dot_position;
     if (end < length() && matches(end, '.')) {
@@ -366,19 +558,7 @@ std::optional<Token> Lexer::try_float() {
         end++;
     }
 
-    size_t zeros_before_digit = 0;
-    while (end < length() && is_digit(at(end))) {
-        if (!first_significant_digit_position.has_value()) {
-            if (at(end) == '0') {
-                zeros_before_digit += 1;
-            } else {
-                first_significant_digit_position = end;
-            }
-        }
-
-        has_mantissa_digits = true;
-        end++;
-    }
+    size_t zeros_before_digit = consume_digits();
 
     if (!has_mantissa_digits) {
         return {};
@@ -395,11 +575,9 @@ std::optional<Token> Lexer::try_float() {
         }
         exponent_value_position = end;
 
-        bool has_digits = false;
-        while (end < length() && isdigit(at(end))) {
-            has_digits = true;
-            end++;
-        }
+        const auto digits_end = skip_class<CharClass::kDigit>(line(), end);
+        bool has_digits = digits_end != end;
+        end = digits_end;
 
         // If an 'e' or 'E' was present, then the number part must also be present.
         if (!has_digits) {
@@ -984,7 +1162,13 @@ std::optional<Token> Lexer::try_ident() {
     auto start = pos();
 
     // Must begin with an XID_Source unicode character, or underscore
-    {
+    if (const char c = at(pos()); is_ascii(c)) {
+        // The only ASCII XID_Start characters are the letters.
+        if (!is_ascii_alpha(c) && c != '_') {
+            return {};
+        }
+        advance();
+    } else {
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, length() - pos());
         if (n == 0) {
@@ -999,6 +1183,12 @@ std::optional<Token> Lexer::try_ident() {
     }
 
     while (!is_eol()) {
+        // Fast path for ASCII characters, where XID_Continue is letters, digits and underscore.
+        set_pos(skip_class<CharClass::kIdentifier>(line(), pos()));
+        if (is_eol() || is_ascii(at(pos()))) {
+            break;
+        }
+
         // Must continue with an XID_Continue unicode character
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, line().size() - pos());
@@ -122,6 +122,12 @@ class Lexer {
     Source::File const* const file_;
     /// The current location within the input
     Source::Location location_;
+    /// The byte offset of the current line within the input
+    size_t line_start_ = 0;
+    /// The byte offset of the end of the current line, excluding the line break
+    size_t line_end_ = 0;
+    /// The byte offset of the line following the current line
+    size_t next_line_start_ = 0;
 };
 
 }  // namespace tint::wgsl::reader
@@ -372,6 +372,40 @@ TEST_F(LexerTest, Null_InBlockComment_IsError) {
     EXPECT_EQ(t.to_str(), "null character found");
 }
 
+TEST_F(LexerTest, Null_InLongBlockComment_IsError) {
+    std::string src = "/* a block comment that spans more than sixteen characters ";
+    src += '\0';
+    src += " and more text after the null character */";
+    Source::File file("", src);
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(1u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsError());
+    EXPECT_EQ(t.source().range.begin.line, 1u);
+    EXPECT_EQ(t.source().range.begin.column, 60u);
+    EXPECT_EQ(t.to_str(), "null character found");
+}
+
+TEST_F(LexerTest, Skips_Blankspace_LongRunWithUnicode) {
+    // A long run of ASCII blankspace, interrupted by a left-to-right mark (U+200E).
+    Source::File file("",
+                      "                    \xE2\x80\x8E"
+                      "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\tident");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(2u, list.size());
+
+    auto& t = list[0];
+    EXPECT_TRUE(t.IsIdentifier());
+    EXPECT_EQ(t.source().range.begin.line, 1u);
+    EXPECT_EQ(t.source().range.begin.column, 42u);
+    EXPECT_EQ(t.to_str(), "ident");
+}
+
 TEST_F(LexerTest, Null_InIdentifier_IsError) {
     // Try inserting a null in an identifier. Other valid token
     // kinds will behave similarly, so use the identifier case
@@ -696,6 +730,10 @@ INSTANTIATE_TEST_SUITE_P(
                     "\xf0\x9d\x96\x99\xf0\x9d\x96\x8e\xf0\x9d\x96\x8b\xf0\x9d\x96\x8e"
                     "\xf0\x9d\x96\x8a\xf0\x9d\x96\x97\x31\x32\x33",
                     43},
+        UnicodeCase{// "the_quick_brown_fox_ｉｄ_jumps_over"
+                    "the_quick_brown_fox_\xef\xbd\x89\xef\xbd\x84_jumps_over", 37},
+        UnicodeCase{// "ｉdentifier_with_a_long_ascii_tail_0123456789"
+                    "\xef\xbd\x89" "dentifier_with_a_long_ascii_tail_0123456789", 46},
     }));
 
 using InvalidUnicodeIdentifierTest = testing::TestWithParam<const char*>;
@@ -25,9 +25,11 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <memory>
 #include <string>
 
 #include "src/tint/cmd/bench/bench.h"
+#include "src/tint/lang/wgsl/reader/parser/lexer.h"
 #include "src/tint/lang/wgsl/reader/reader.h"
 
 namespace tint::wgsl::reader {
@@ -47,7 +49,156 @@ void ParseWGSL(benchmark::State& state, std::string input_name) {
     }
 }
 
+void LexWGSL(benchmark::State& state, std::string input_name) {
+    auto res = bench::GetWgslFile(input_name);
+    if (res != Success) {
+        state.SkipWithError(res.Failure().reason.Str());
+        return;
+    }
+    for (auto _ : state) {
+        Lexer lexer(&res.Get());
+        auto tokens = lexer.Lex();
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(res->content.data.size()));
+}
+
+/// @returns a generated shader of at least @p size bytes, heavy with comments, indentation,
+/// long identifiers and numeric literals.
+std::string GenerateLexerInput(size_t size) {
+    std::string wgsl;
+    for (size_t i = 0; wgsl.size() < size; i++) {
+        std::string n = std::to_string(i);
+        wgsl += "// Generated function " + n + ", computing a long chain of values.\n";
+        wgsl += "/* Block comment describing the inputs\n   of generated_function_" + n + " */\n";
+        wgsl += "fn generated_function_" + n +
+                "(input_value : vec4<f32>, scale : f32) -> vec4<f32> {\n";
+        wgsl += "    var accumulated_result : vec4<f32> = input_value * 0.5f;\n";
+        wgsl += "    for (var index_" + n + " : i32 = 0i; index_" + n + " < 16i; index_" + n +
+                "++) {\n";
+        wgsl += "        accumulated_result += vec4<f32>(1.25e-3, 42.0, 0x1Fu, scale) * f32(index_" +
+                n + ");\n";
+        wgsl += "    }\n";
+        wgsl += "    return accumulated_result;\n";
+        wgsl += "}\n\n";
+    }
+    return wgsl;
+}
+
+void LexGeneratedWGSL(benchmark::State& state) {
+    auto wgsl = GenerateLexerInput(static_cast<size_t>(state.range(0)));
+    Source::File file("generated.wgsl", wgsl);
+    for (auto _ : state) {
+        Lexer lexer(&file);
+        auto tokens = lexer.Lex();
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(wgsl.size()));
+}
+
+/// @returns a generated, valid shader of at least @p size bytes.
+std::string GenerateParserInput(size_t size) {
+    std::string wgsl;
+    for (size_t i = 0; wgsl.size() < size; i++) {
+        std::string n = std::to_string(i);
+        wgsl += "// Generated function " + n + "\n";
+        wgsl += "fn generated_function_" + n + "(v : vec4<f32>, scale : f32) -> vec4<f32> {\n";
+        wgsl += "    var result = v * 0.5f;\n";
+        wgsl += "    for (var i = 0i; i < 16i; i++) {\n";
+        wgsl += "        result += vec4<f32>(1.25e-3, 42.0, f32(0x1Fu), scale) * f32(i);\n";
+        wgsl += "    }\n";
+        wgsl += "    return result;\n";
+        wgsl += "}\n\n";
+    }
+    return wgsl;
+}
+
+void ParseGeneratedWGSL(benchmark::State& state) {
+    auto wgsl = GenerateParserInput(static_cast<size_t>(state.range(0)));
+    const bool borrow = state.range(1) != 0;
+    for (auto _ : state) {
+        auto file = borrow ? std::make_unique<Source::File>("generated.wgsl", wgsl, Source::kBorrow)
+                           : std::make_unique<Source::File>("generated.wgsl", wgsl);
+        auto program = Parse(file.get());
+        if (program.Diagnostics().ContainsErrors()) {
+            state.SkipWithError(program.Diagnostics().Str());
+            return;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(wgsl.size()));
+    // The number of bytes of source copied into each Source::File.
+    state.counters["copied_bytes"] = borrow ? 0.0 : static_cast<double>(wgsl.size());
+}
+
+void ParseGeneratedWGSLThreaded(benchmark::State& state) {
+    auto wgsl = GenerateParserInput(static_cast<size_t>(state.range(0)));
+    Source::File file("generated.wgsl", wgsl);
+    Options options;
+    options.function_resolution_threads = static_cast<uint32_t>(state.range(1));
+    for (auto _ : state) {
+        auto program = Parse(&file, options);
+        if (program.Diagnostics().ContainsErrors()) {
+            state.SkipWithError(program.Diagnostics().Str());
+            return;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(wgsl.size()));
+}
+
+/// @returns a generated shader that declares a `const` lookup table of @p count distinct f32
+/// values, and a `var<private>` that is initialized with it. If @p abstract is true, the elements
+/// of the table are abstract-floats, which are converted to f32 by the initializer.
+std::string GenerateTableInput(size_t count, bool abstract) {
+    std::string wgsl = abstract ? "const table = array("
+                                : "const table = array<f32, " + std::to_string(count) + ">(";
+    for (size_t i = 0; i < count; i++) {
+        wgsl += (i > 0 ? ", " : "") + std::to_string(i) + (abstract ? ".5" : ".5f");
+    }
+    wgsl += ");\n";
+    wgsl += "var<private> lut = table;\n";
+    wgsl += "@compute @workgroup_size(1)\n";
+    wgsl += "fn main() {\n";
+    wgsl += "    lut[0] = table[" + std::to_string(count - 1) + "];\n";
+    wgsl += "}\n";
+    return wgsl;
+}
+
+void ParseConstTable(benchmark::State& state) {
+    auto wgsl = GenerateTableInput(static_cast<size_t>(state.range(0)), state.range(1) != 0);
+    Source::File file("table.wgsl", wgsl);
+    size_t num_constants = 0;
+    for (auto _ : state) {
+        auto program = Parse(&file);
+        if (program.Diagnostics().ContainsErrors()) {
+            state.SkipWithError(program.Diagnostics().Str());
+            return;
+        }
+        num_constants = 0;
+        for ([[maybe_unused]] auto* c : program.Constants()) {
+            num_constants++;
+        }
+    }
+    // The number of constant nodes held by the program, as a proxy for the memory used by them.
+    state.counters["constants"] = static_cast<double>(num_constants);
+}
+
 TINT_BENCHMARK_PROGRAMS(ParseWGSL);
+TINT_BENCHMARK_PROGRAMS(LexWGSL);
+BENCHMARK(LexGeneratedWGSL)->Arg(16 << 10)->Arg(256 << 10)->Arg(4 << 20);
+BENCHMARK(ParseGeneratedWGSL)
+    ->ArgNames({"size", "borrow"})
+    ->ArgsProduct({{256 << 10, 1 << 20}, {0, 1}});
+BENCHMARK(ParseGeneratedWGSLThreaded)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{1 << 20}, {0, 2, 4, 8}})
+    ->UseRealTime();
+BENCHMARK(ParseConstTable)
+    ->ArgNames({"count", "abstract"})
+    ->ArgsProduct({{1 << 10, 16 << 10}, {0, 1}});
 
 }  // namespace
 }  // namespace tint::wgsl::reader
@@ -186,6 +186,10 @@ struct DependencyGraph {
     /// the same symbol, and X is declared in a sub-scope of the scope that
     /// declares Y.
     Hashmap<const ast::Variable*, const ast::Node*, 16> shadows;
+
+    /// Map of ast::Function to the functions that it calls. Functions that do not call any other
+    /// function have no entry.
+    Hashmap<const ast::Function*, Vector<const ast::Function*, 4>, 16> called_functions;
 };
 
 }  // namespace tint::resolver
@@ -35,8 +35,9 @@ namespace tint::resolver {
 
 Program Resolve(ProgramBuilder& builder,
                 const wgsl::AllowedFeatures& allowed_features,
-                wgsl::ValidationMode mode) {
-    Resolver resolver(&builder, std::move(allowed_features), mode);
+                wgsl::ValidationMode mode,
+                uint32_t function_resolution_threads) {
+    Resolver resolver(&builder, std::move(allowed_features), mode, function_resolution_threads);
     resolver.Resolve();
     return Program(std::move(builder));
 }
@@ -28,6 +28,8 @@
 #ifndef SRC_TINT_LANG_WGSL_RESOLVER_RESOLVE_H_
 #define SRC_TINT_LANG_WGSL_RESOLVER_RESOLVE_H_
 
+#include <cstdint>
+
 #include "src/tint/lang/wgsl/common/allowed_features.h"
 #include "src/tint/lang/wgsl/common/validation_mode.h"
 
@@ -41,10 +43,12 @@ namespace tint::resolver {
 /// Performs semantic analysis and validation on the program builder @p builder
 /// @param allowed_features the extensions and features that are allowed to be used
 /// @param mode the validation mode to uses
+/// @param function_resolution_threads the number of threads to use to resolve function bodies
 /// @returns the resolved Program. Program.Diagnostics() may contain validation errors.
 Program Resolve(ProgramBuilder& builder,
                 const wgsl::AllowedFeatures& allowed_features = wgsl::AllowedFeatures::Everything(),
-                wgsl::ValidationMode mode = wgsl::ValidationMode::kFull);
+                wgsl::ValidationMode mode = wgsl::ValidationMode::kFull,
+                uint32_t function_resolution_threads = 0);
 
 }  // namespace tint::resolver
 
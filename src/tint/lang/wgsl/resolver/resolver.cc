@@ -110,6 +110,7 @@
 #include "src/tint/utils/macros/defer.h"
 #include "src/tint/utils/macros/scoped_assignment.h"
 #include "src/tint/utils/math/math.h"
+#include "src/tint/utils/system/parallel_for.h"
 #include "src/tint/utils/text/string.h"
 #include "src/tint/utils/text/string_stream.h"
 #include "src/tint/utils/text/styled_text.h"
@@ -134,23 +135,72 @@ constexpr size_t kMaxNestDepthOfCompositeType = 255;
 
 Resolver::Resolver(ProgramBuilder* builder,
                    const wgsl::AllowedFeatures& allowed_features,
-                   wgsl::ValidationMode mode)
+                   wgsl::ValidationMode mode,
+                   uint32_t function_resolution_threads)
     : b(*builder),
       diagnostics_(builder->Diagnostics()),
       const_eval_(builder->constants, diagnostics_),
       intrinsic_table_{builder->Types(), builder->Symbols()},
-      sem_(builder),
+      dependencies_(dependency_graph_),
+      sem_(builder, diagnostics_),
       validator_(builder,
+                 diagnostics_,
                  sem_,
                  enabled_extensions_,
                  allowed_features_,
                  mode,
                  atomic_composite_info_,
                  valid_type_storage_layouts_),
-      allowed_features_(allowed_features) {}
+      allowed_features_(allowed_features),
+      function_resolution_threads_(function_resolution_threads) {}
+
+Resolver::Resolver(Resolver& parent, diag::List& diagnostics, std::recursive_mutex& mutex)
+    : b(parent.b),
+      diagnostics_(diagnostics),
+      const_eval_(b.constants, diagnostics_),
+      intrinsic_table_{b.Types(), b.Symbols()},
+      dependencies_(parent.dependencies_),
+      sem_(&b, diagnostics_),
+      validator_(&b,
+                 diagnostics_,
+                 sem_,
+                 enabled_extensions_,
+                 allowed_features_,
+                 parent.validator_.Mode(),
+                 atomic_composite_info_,
+                 valid_type_storage_layouts_),
+      allowed_features_(parent.allowed_features_),
+      enabled_extensions_(parent.enabled_extensions_),
+      atomic_composite_info_(parent.atomic_composite_info_),
+      parent_(&parent),
+      mutex_(&mutex),
+      worker_(std::make_unique<WorkerState>()) {
+    // Start with the module-scope diagnostic filters of the parent.
+    for (auto itr : parent.validator_.DiagnosticFilters().Top()) {
+        validator_.DiagnosticFilters().Set(itr.key, itr.value);
+    }
+}
 
 Resolver::~Resolver() = default;
 
+Resolver& Resolver::Root() {
+    return parent_ ? *parent_ : *this;
+}
+
+template <typename F>
+auto Resolver::Locked(F&& fn) {
+    if (!mutex_) {
+        return fn();
+    }
+    std::lock_guard<std::recursive_mutex> lock(*mutex_);
+    return fn();
+}
+
+template <typename T, typename... ARGS>
+auto* Resolver::Create(ARGS&&... args) {
+    return Locked([&] { return b.create<T>(std::forward<ARGS>(args)...); });
+}
+
 bool Resolver::Resolve() {
     if (diagnostics_.ContainsErrors()) {
         return false;
@@ -176,7 +226,7 @@ bool Resolver::Resolve() {
     }
 
     // Create the semantic module. Don't be tempted to std::move() these, they're used below.
-    auto* mod = b.create<sem::Module>(dependencies_.ordered_globals, enabled_extensions_);
+    auto* mod = Create<sem::Module>(dependencies_.ordered_globals, enabled_extensions_);
     ApplyDiagnosticSeverities(mod);
     b.Sem().SetModule(mod);
 
@@ -212,10 +262,17 @@ bool Resolver::ResolveInternal() {
                 [&](const ast::Variable* var) { return GlobalVariable(var); },
                 [&](const ast::ConstAssert* ca) { return ConstAssert(ca); },  //
                 TINT_ICE_ON_NO_MATCH)) {
+            // Resolve the function bodies declared before the failing declaration, so that their
+            // diagnostics are raised before those of the failing declaration.
+            ResolveFunctionBodies();
             return false;
         }
     }
 
+    if (!ResolveFunctionBodies()) {
+        return false;
+    }
+
     if (!AllocateOverridableConstantIds()) {
         return false;
     }
@@ -247,6 +304,129 @@ bool Resolver::ResolveInternal() {
     return result;
 }
 
+bool Resolver::ResolveFunctionBodies() {
+    if (deferred_bodies_.IsEmpty()) {
+        return true;
+    }
+
+    // Group the function bodies into waves. A function body is resolved in a later wave than the
+    // bodies of the functions that it calls, as resolving a call uses the semantic information
+    // gathered from the body of the callee.
+    Hashmap<const ast::Function*, size_t, 32> body_indices;
+    Vector<Vector<size_t, 16>, 8> waves;
+    for (size_t i = 0; i < deferred_bodies_.Length(); i++) {
+        auto& body = deferred_bodies_[i];
+        auto* decl = body.func->Declaration();
+        if (auto callees = dependencies_.called_functions.Get(decl)) {
+            for (auto* callee : *callees) {
+                if (auto callee_index = body_indices.Get(callee)) {
+                    body.wave = std::max(body.wave, deferred_bodies_[*callee_index].wave + 1);
+                }
+            }
+        }
+        body_indices.Add(decl, i);
+        if (body.wave >= waves.Length()) {
+            waves.Resize(body.wave + 1);
+        }
+        waves[body.wave].Push(i);
+    }
+
+    std::recursive_mutex mutex;
+    for (auto& wave : waves) {
+        ParallelFor(wave.Length(), function_resolution_threads_, [&](size_t i) {
+            auto& body = deferred_bodies_[wave[i]];
+            if (auto callees = dependencies_.called_functions.Get(body.func->Declaration())) {
+                for (auto* callee : *callees) {
+                    auto callee_index = body_indices.Get(callee);
+                    if (callee_index && !deferred_bodies_[*callee_index].resolved) {
+                        return;  // A callee failed to resolve, so this body is not reported.
+                    }
+                }
+            }
+            body.worker = std::unique_ptr<Resolver>(new Resolver(*this, body.diagnostics, mutex));
+            body.resolved = body.worker->WorkerFunctionBody(body.func);
+        });
+
+        // Apply the changes that the next wave depends on, in declaration order.
+        for (size_t index : wave) {
+            auto& body = deferred_bodies_[index];
+            if (!body.worker) {
+                continue;
+            }
+            auto& worker = *body.worker;
+            for (auto* node : worker.worker_->marked) {
+                Mark(node);
+            }
+            alias_analysis_infos_[body.func] = std::move(worker.alias_analysis_infos_[body.func]);
+            for (auto& [callee, texture, sampler] : worker.worker_->callee_texture_sampler_pairs) {
+                callee->AddTextureSamplerPair(texture, sampler);
+            }
+        }
+    }
+
+    // Merge the diagnostics of the function bodies with those of the module-scope declarations,
+    // and apply the remaining changes in declaration order.
+    const diag::List module_diagnostics(std::move(diagnostics_));
+    diagnostics_ = diag::List{};
+    size_t count = 0;
+    auto next = module_diagnostics.begin();
+    auto take = [&](size_t end) {
+        for (; count < end; count++, next++) {
+            diagnostics_.Add(*next);
+        }
+    };
+    bool ok = true;
+    for (auto& body : deferred_bodies_) {
+        take(body.diagnostics_offset);
+        diagnostics_.Add(body.diagnostics);
+        if (!body.resolved) {
+            ok = false;
+            break;
+        }
+        auto& state = *body.worker->worker_;
+        for (auto& [callee, call] : state.call_sites) {
+            callee->AddCallSite(call);
+        }
+        for (auto& [variable, user] : state.global_users) {
+            variable->AddUser(user);
+        }
+        if (body.func->Declaration()->IsEntryPoint()) {
+            for (auto* f : body.func->TransitivelyCalledFunctions()) {
+                const_cast<sem::Function*>(f)->AddAncestorEntryPoint(body.func);
+            }
+        }
+    }
+    if (ok) {
+        take(module_diagnostics.Count());
+    }
+    deferred_bodies_.Clear();
+    return ok;
+}
+
+bool Resolver::WorkerFunctionBody(sem::Function* func) {
+    current_function_ = func;
+    on_transitively_reference_global_.Push([func](const sem::GlobalVariable* ref) {  //
+        func->AddDirectlyReferencedGlobal(ref);
+    });
+    validator_.DiagnosticFilters().Push();
+    for (auto itr : func->DiagnosticSeverities()) {
+        validator_.DiagnosticFilters().Set(itr.key, itr.value);
+    }
+
+    // The alias analysis of a call uses the information gathered from the body of the callee.
+    if (auto callees = dependencies_.called_functions.Get(func->Declaration())) {
+        for (auto* callee : *callees) {
+            auto* target = b.Sem().Get(callee);
+            auto it = parent_->alias_analysis_infos_.find(target);
+            if (it != parent_->alias_analysis_infos_.end()) {
+                alias_analysis_infos_[target] = it->second;
+            }
+        }
+    }
+
+    return FunctionBody(func);
+}
+
 sem::Variable* Resolver::Variable(const ast::Variable* v, bool is_global) {
     Mark(v->name);
 
@@ -260,7 +440,7 @@ sem::Variable* Resolver::Variable(const ast::Variable* v, bool is_global) {
 }
 
 sem::Variable* Resolver::Let(const ast::Let* v) {
-    auto* sem = b.create<sem::LocalVariable>(v, current_statement_);
+    auto* sem = Create<sem::LocalVariable>(v, current_statement_);
     sem->SetStage(core::EvaluationStage::kRuntime);
     b.Sem().Add(v, sem);
 
@@ -319,7 +499,7 @@ sem::Variable* Resolver::Let(const ast::Let* v) {
 }
 
 sem::Variable* Resolver::Override(const ast::Override* v) {
-    auto* sem = b.create<sem::GlobalVariable>(v);
+    auto* sem = Create<sem::GlobalVariable>(v);
     b.Sem().Add(v, sem);
     sem->SetStage(core::EvaluationStage::kOverride);
 
@@ -431,10 +611,10 @@ sem::Variable* Resolver::Const(const ast::Const* c, bool is_global) {
     sem::Variable* sem = nullptr;
     sem::GlobalVariable* global = nullptr;
     if (is_global) {
-        global = b.create<sem::GlobalVariable>(c);
+        global = Create<sem::GlobalVariable>(c);
         sem = global;
     } else {
-        sem = b.create<sem::LocalVariable>(c, current_statement_);
+        sem = Create<sem::LocalVariable>(c, current_statement_);
     }
     b.Sem().Add(c, sem);
 
@@ -509,10 +689,10 @@ sem::Variable* Resolver::Var(const ast::Var* var, bool is_global) {
     sem::Variable* sem = nullptr;
     sem::GlobalVariable* global = nullptr;
     if (is_global) {
-        global = b.create<sem::GlobalVariable>(var);
+        global = Create<sem::GlobalVariable>(var);
         sem = global;
     } else {
-        sem = b.create<sem::LocalVariable>(var, current_statement_);
+        sem = Create<sem::LocalVariable>(var, current_statement_);
     }
     sem->SetStage(core::EvaluationStage::kRuntime);
     b.Sem().Add(var, sem);
@@ -601,7 +781,7 @@ sem::Variable* Resolver::Var(const ast::Var* var, bool is_global) {
         sem->SetAccess(DefaultAccessForAddressSpace(sem->AddressSpace()));
     }
 
-    sem->SetType(b.create<core::type::Reference>(sem->AddressSpace(), storage_ty, sem->Access()));
+    sem->SetType(Create<core::type::Reference>(sem->AddressSpace(), storage_ty, sem->Access()));
 
     if (sem->Initializer() &&
         !validator_.VariableInitializer(var, storage_ty, sem->Initializer())) {
@@ -750,7 +930,7 @@ sem::Parameter* Resolver::Parameter(const ast::Parameter* param,
                                     uint32_t index) {
     Mark(param->name);
 
-    auto* sem = b.create<sem::Parameter>(param, index);
+    auto* sem = Create<sem::Parameter>(param, index);
     b.Sem().Add(param, sem);
 
     auto add_note = [&] {
@@ -989,7 +1169,7 @@ sem::Statement* Resolver::ConstAssert(const ast::ConstAssert* assertion) {
         AddError(assertion->source) << "const assertion failed";
         return nullptr;
     }
-    auto* sem = b.create<sem::Statement>(assertion, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(assertion, current_compound_statement_, current_function_);
     b.Sem().Add(assertion, sem);
     return sem;
 }
@@ -997,7 +1177,7 @@ sem::Statement* Resolver::ConstAssert(const ast::ConstAssert* assertion) {
 sem::Function* Resolver::Function(const ast::Function* decl) {
     Mark(decl->name);
 
-    auto* func = b.create<sem::Function>(decl);
+    auto* func = Create<sem::Function>(decl);
     b.Sem().Add(decl, func);
     TINT_SCOPED_ASSIGNMENT(current_function_, func);
 
@@ -1085,7 +1265,7 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
             return nullptr;
         }
     } else {
-        return_type = b.create<core::type::Void>();
+        return_type = Create<core::type::Void>();
     }
     func->SetReturnType(return_type);
 
@@ -1196,16 +1376,34 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
         entry_points_.Push(func);
     }
 
+    if (function_resolution_threads_ > 1 && decl->body) {
+        // The body is resolved by ResolveFunctionBodies(), after the module-scope declarations.
+        DeferredBody deferred;
+        deferred.func = func;
+        deferred.diagnostics_offset = diagnostics_.Count();
+        deferred_bodies_.Push(std::move(deferred));
+        return func;
+    }
+
+    if (!FunctionBody(func)) {
+        return nullptr;
+    }
+
+    return func;
+}
+
+bool Resolver::FunctionBody(sem::Function* func) {
+    auto* decl = func->Declaration();
     if (decl->body) {
         Mark(decl->body);
         if (TINT_UNLIKELY(current_compound_statement_)) {
             ICE(decl->body->source)
                 << "Resolver::Function() called with a current compound statement";
         }
-        auto* body = StatementScope(decl->body, b.create<sem::FunctionBlockStatement>(func),
+        auto* body = StatementScope(decl->body, Create<sem::FunctionBlockStatement>(func),
                                     [&] { return Statements(decl->body->statements); });
         if (!body) {
-            return nullptr;
+            return false;
         }
         func->Behaviors() = body->Behaviors();
         if (func->Behaviors().Contains(sem::Behavior::kReturn)) {
@@ -1219,24 +1417,24 @@ sem::Function* Resolver::Function(const ast::Function* decl) {
     }
 
     if (!validator_.NoDuplicateAttributes(decl->return_type_attributes)) {
-        return nullptr;
+        return false;
     }
 
     auto stage = current_function_ ? current_function_->Declaration()->PipelineStage()
                                    : ast::PipelineStage::kNone;
     if (!validator_.Function(func, stage)) {
-        return nullptr;
+        return false;
     }
 
     // If this is an entry point, mark all transitively called functions as being
-    // used by this entry point.
-    if (decl->IsEntryPoint()) {
+    // used by this entry point. Worker threads leave this to ResolveFunctionBodies().
+    if (decl->IsEntryPoint() && !worker_) {
         for (auto* f : func->TransitivelyCalledFunctions()) {
             const_cast<sem::Function*>(f)->AddAncestorEntryPoint(func);
         }
     }
 
-    return func;
+    return true;
 }
 
 bool Resolver::Statements(VectorRef<const ast::Statement*> stmts) {
@@ -1305,7 +1503,7 @@ sem::Statement* Resolver::Statement(const ast::Statement* stmt) {
 
 sem::CaseStatement* Resolver::CaseStatement(const ast::CaseStatement* stmt,
                                             const core::type::Type* ty) {
-    auto* sem = b.create<sem::CaseStatement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::CaseStatement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         sem->Selectors().reserve(stmt->selectors.Length());
         for (auto* sel : stmt->selectors) {
@@ -1333,7 +1531,7 @@ sem::CaseStatement* Resolver::CaseStatement(const ast::CaseStatement* stmt,
                 }
             }
 
-            sem->Selectors().emplace_back(b.create<sem::CaseSelector>(sel, const_value));
+            sem->Selectors().emplace_back(Create<sem::CaseSelector>(sel, const_value));
         }
 
         Mark(stmt->body);
@@ -1348,7 +1546,7 @@ sem::CaseStatement* Resolver::CaseStatement(const ast::CaseStatement* stmt,
 }
 
 sem::IfStatement* Resolver::IfStatement(const ast::IfStatement* stmt) {
-    auto* sem = b.create<sem::IfStatement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::IfStatement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto* cond = Load(ValueExpression(stmt->condition));
         if (!cond) {
@@ -1359,8 +1557,8 @@ sem::IfStatement* Resolver::IfStatement(const ast::IfStatement* stmt) {
         sem->Behaviors().Remove(sem::Behavior::kNext);
 
         Mark(stmt->body);
-        auto* body = b.create<sem::BlockStatement>(stmt->body, current_compound_statement_,
-                                                   current_function_);
+        auto* body = Create<sem::BlockStatement>(stmt->body, current_compound_statement_,
+                                                 current_function_);
         if (!StatementScope(stmt->body, body, [&] { return Statements(stmt->body->statements); })) {
             return false;
         }
@@ -1385,18 +1583,18 @@ sem::IfStatement* Resolver::IfStatement(const ast::IfStatement* stmt) {
 }
 
 sem::BlockStatement* Resolver::BlockStatement(const ast::BlockStatement* stmt) {
-    auto* sem = b.create<sem::BlockStatement>(stmt->As<ast::BlockStatement>(),
-                                              current_compound_statement_, current_function_);
+    auto* sem = Create<sem::BlockStatement>(stmt->As<ast::BlockStatement>(),
+                                            current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] { return Statements(stmt->statements); });
 }
 
 sem::LoopStatement* Resolver::LoopStatement(const ast::LoopStatement* stmt) {
-    auto* sem = b.create<sem::LoopStatement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::LoopStatement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         Mark(stmt->body);
 
-        auto* body = b.create<sem::LoopBlockStatement>(stmt->body, current_compound_statement_,
-                                                       current_function_);
+        auto* body = Create<sem::LoopBlockStatement>(stmt->body, current_compound_statement_,
+                                                     current_function_);
         return StatementScope(stmt->body, body, [&] {
             if (!Statements(stmt->body->statements)) {
                 return false;
@@ -1408,7 +1606,7 @@ sem::LoopStatement* Resolver::LoopStatement(const ast::LoopStatement* stmt) {
                 Mark(stmt->continuing);
                 auto* continuing = StatementScope(
                     stmt->continuing,
-                    b.create<sem::LoopContinuingBlockStatement>(
+                    Create<sem::LoopContinuingBlockStatement>(
                         stmt->continuing, current_compound_statement_, current_function_),
                     [&] { return Statements(stmt->continuing->statements); });
                 if (!continuing) {
@@ -1430,8 +1628,7 @@ sem::LoopStatement* Resolver::LoopStatement(const ast::LoopStatement* stmt) {
 }
 
 sem::ForLoopStatement* Resolver::ForLoopStatement(const ast::ForLoopStatement* stmt) {
-    auto* sem =
-        b.create<sem::ForLoopStatement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::ForLoopStatement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto& behaviors = sem->Behaviors();
         if (auto* initializer = stmt->initializer) {
@@ -1463,8 +1660,8 @@ sem::ForLoopStatement* Resolver::ForLoopStatement(const ast::ForLoopStatement* s
 
         Mark(stmt->body);
 
-        auto* body = b.create<sem::LoopBlockStatement>(stmt->body, current_compound_statement_,
-                                                       current_function_);
+        auto* body = Create<sem::LoopBlockStatement>(stmt->body, current_compound_statement_,
+                                                     current_function_);
         if (!StatementScope(stmt->body, body, [&] { return Statements(stmt->body->statements); })) {
             return false;
         }
@@ -1482,7 +1679,7 @@ sem::ForLoopStatement* Resolver::ForLoopStatement(const ast::ForLoopStatement* s
 }
 
 sem::WhileStatement* Resolver::WhileStatement(const ast::WhileStatement* stmt) {
-    auto* sem = b.create<sem::WhileStatement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::WhileStatement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto& behaviors = sem->Behaviors();
 
@@ -1495,8 +1692,8 @@ sem::WhileStatement* Resolver::WhileStatement(const ast::WhileStatement* stmt) {
 
         Mark(stmt->body);
 
-        auto* body = b.create<sem::LoopBlockStatement>(stmt->body, current_compound_statement_,
-                                                       current_function_);
+        auto* body = Create<sem::LoopBlockStatement>(stmt->body, current_compound_statement_,
+                                                     current_function_);
         if (!StatementScope(stmt->body, body, [&] { return Statements(stmt->body->statements); })) {
             return false;
         }
@@ -1556,11 +1753,11 @@ sem::Expression* Resolver::Expression(const ast::Expression* root) {
             [&](const ast::MemberAccessorExpression* member) { return MemberAccessor(member); },
             [&](const ast::UnaryOpExpression* unary) { return UnaryOp(unary); },
             [&](const ast::PhonyExpression*) {
-                return b.create<sem::ValueExpression>(expr, b.create<core::type::Void>(),
-                                                      core::EvaluationStage::kRuntime,
-                                                      current_statement_,
-                                                      /* constant_value */ nullptr,
-                                                      /* has_side_effects */ false);
+                return Create<sem::ValueExpression>(expr, Create<core::type::Void>(),
+                                                    core::EvaluationStage::kRuntime,
+                                                    current_statement_,
+                                                    /* constant_value */ nullptr,
+                                                    /* has_side_effects */ false);
             },  //
             TINT_ICE_ON_NO_MATCH);
         if (!sem_expr) {
@@ -1805,12 +2002,12 @@ bool Resolver::AliasAnalysis(const sem::Call* call) {
 const core::type::Type* Resolver::ConcreteType(const core::type::Type* ty,
                                                const core::type::Type* target_ty,
                                                const Source& source) {
-    auto i32 = [&] { return b.create<core::type::I32>(); };
-    auto f32 = [&] { return b.create<core::type::F32>(); };
-    auto i32v = [&](uint32_t width) { return b.create<core::type::Vector>(i32(), width); };
-    auto f32v = [&](uint32_t width) { return b.create<core::type::Vector>(f32(), width); };
+    auto i32 = [&] { return Create<core::type::I32>(); };
+    auto f32 = [&] { return Create<core::type::F32>(); };
+    auto i32v = [&](uint32_t width) { return Create<core::type::Vector>(i32(), width); };
+    auto f32v = [&](uint32_t width) { return Create<core::type::Vector>(f32(), width); };
     auto f32m = [&](uint32_t columns, uint32_t rows) {
-        return b.create<core::type::Matrix>(f32v(rows), columns);
+        return Create<core::type::Matrix>(f32v(rows), columns);
     };
 
     return Switch(
@@ -1862,7 +2059,7 @@ const sem::ValueExpression* Resolver::Load(const sem::ValueExpression* expr) {
         return expr;
     }
 
-    auto* load = b.create<sem::Load>(expr, current_statement_, expr->Stage());
+    auto* load = Create<sem::Load>(expr, current_statement_, expr->Stage());
     load->Behaviors() = expr->Behaviors();
     b.Sem().Replace(expr->Declaration(), load);
 
@@ -1900,7 +2097,7 @@ const sem::ValueExpression* Resolver::Materialize(
                               << ") called on expression with no constant value";
         }
 
-        auto val = const_eval_.Convert(concrete_ty, expr_val, decl->source);
+        auto val = Locked([&] { return const_eval_.Convert(concrete_ty, expr_val, decl->source); });
         if (val != Success) {
             // Convert() has already failed and raised an diagnostic error.
             return nullptr;
@@ -1912,7 +2109,7 @@ const sem::ValueExpression* Resolver::Materialize(
         }
     }
 
-    auto* m = b.create<sem::Materialize>(expr, current_statement_, concrete_ty, materialized_val);
+    auto* m = Create<sem::Materialize>(expr, current_statement_, concrete_ty, materialized_val);
     m->Behaviors() = expr->Behaviors();
     b.Sem().Replace(decl, m);
     return m;
@@ -1949,7 +2146,7 @@ bool Resolver::ShouldMaterializeArgument(const core::type::Type* parameter_ty) c
 bool Resolver::Convert(const core::constant::Value*& c,
                        const core::type::Type* target_ty,
                        const Source& source) {
-    auto r = const_eval_.Convert(target_ty, c, source);
+    auto r = Locked([&] { return const_eval_.Convert(target_ty, c, source); });
     if (r != Success) {
         return false;
     }
@@ -2005,7 +2202,7 @@ sem::ValueExpression* Resolver::IndexAccessor(const ast::IndexAccessorExpression
         [&](const sem::Array* arr) { return arr->ElemType(); },
         [&](const core::type::Vector* vec) { return vec->type(); },
         [&](const core::type::Matrix* mat) {
-            return b.create<core::type::Vector>(mat->type(), mat->rows());
+            return Create<core::type::Vector>(mat->type(), mat->rows());
         },
         [&](Default) {
             AddError(expr->source) << "cannot index type '" << sem_.TypeNameOf(storage_ty) << "'";
@@ -2024,8 +2221,7 @@ sem::ValueExpression* Resolver::IndexAccessor(const ast::IndexAccessorExpression
 
     // If we're extracting from a memory view, we return a reference.
     if (memory_view) {
-        ty =
-            b.create<core::type::Reference>(memory_view->AddressSpace(), ty, memory_view->Access());
+        ty = Create<core::type::Reference>(memory_view->AddressSpace(), ty, memory_view->Access());
     }
 
     const core::constant::Value* val = nullptr;
@@ -2034,8 +2230,10 @@ sem::ValueExpression* Resolver::IndexAccessor(const ast::IndexAccessorExpression
         stage = core::EvaluationStage::kNotEvaluated;
     } else {
         if (auto* idx_val = idx->ConstantValue()) {
-            auto res = const_eval_.Index(obj->ConstantValue(), obj->Type(), idx_val,
+            auto res = Locked([&] {
+                return const_eval_.Index(obj->ConstantValue(), obj->Type(), idx_val,
                                          idx->Declaration()->source);
+            });
             if (res != Success) {
                 return nullptr;
             }
@@ -2043,9 +2241,9 @@ sem::ValueExpression* Resolver::IndexAccessor(const ast::IndexAccessorExpression
         }
     }
     bool has_side_effects = idx->HasSideEffects() || obj->HasSideEffects();
-    auto* sem = b.create<sem::IndexAccessorExpression>(expr, ty, stage, obj, idx,
-                                                       current_statement_, std::move(val),
-                                                       has_side_effects, obj->RootIdentifier());
+    auto* sem = Create<sem::IndexAccessorExpression>(expr, ty, stage, obj, idx,
+                                                     current_statement_, std::move(val),
+                                                     has_side_effects, obj->RootIdentifier());
     sem->Behaviors() = idx->Behaviors() + obj->Behaviors();
     return sem;
 }
@@ -2086,7 +2284,9 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
     auto ctor_or_conv = [&](CtorConvIntrinsic ty,
                             VectorRef<const core::type::Type*> template_args) -> sem::Call* {
         auto arg_tys = tint::Transform(args, [](auto* arg) { return arg->Type()->UnwrapRef(); });
-        auto match = intrinsic_table_.Lookup(ty, template_args, arg_tys, args_stage);
+        auto match = Locked([&] {
+            return intrinsic_table_.Lookup(ty, template_args, arg_tys, args_stage);
+        });
         if (match != Success) {
             AddError(expr->source) << match.Failure();
             return nullptr;
@@ -2100,20 +2300,24 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
         // Is this overload a constructor or conversion?
         if (match->info->flags.Contains(OverloadFlag::kIsConstructor)) {
             // Type constructor
-            target_sem = constructors_.GetOrAdd(match.Get(), [&] {
-                auto params = Transform(match->parameters, [&](auto& p, size_t i) {
-                    return b.create<sem::Parameter>(nullptr, static_cast<uint32_t>(i), p.type,
-                                                    p.usage);
+            target_sem = Locked([&] {
+                return Root().constructors_.GetOrAdd(match.Get(), [&] {
+                    auto params = Transform(match->parameters, [&](auto& p, size_t i) {
+                        return Create<sem::Parameter>(nullptr, static_cast<uint32_t>(i), p.type,
+                                                      p.usage);
+                    });
+                    return Create<sem::ValueConstructor>(match->return_type, std::move(params),
+                                                         overload_stage);
                 });
-                return b.create<sem::ValueConstructor>(match->return_type, std::move(params),
-                                                       overload_stage);
             });
         } else {
             // Type conversion
-            target_sem = converters_.GetOrAdd(match.Get(), [&] {
-                auto* param = b.create<sem::Parameter>(nullptr, 0u, match->parameters[0].type,
-                                                       match->parameters[0].usage);
-                return b.create<sem::ValueConversion>(match->return_type, param, overload_stage);
+            target_sem = Locked([&] {
+                return Root().converters_.GetOrAdd(match.Get(), [&] {
+                    auto* param = Create<sem::Parameter>(nullptr, 0u, match->parameters[0].type,
+                                                         match->parameters[0].usage);
+                    return Create<sem::ValueConversion>(match->return_type, param, overload_stage);
+                });
             });
         }
 
@@ -2132,15 +2336,17 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
                 return nullptr;
             }
             auto const_eval_fn = match->const_eval_fn;
-            auto r = (const_eval_.*const_eval_fn)(target_sem->ReturnType(), const_args.Get(),
-                                                  expr->source);
+            auto r = Locked([&] {
+                return (const_eval_.*const_eval_fn)(target_sem->ReturnType(), const_args.Get(),
+                                                    expr->source);
+            });
             if (r != Success) {
                 return nullptr;
             }
             value = r.Get();
         }
-        return b.create<sem::Call>(expr, target_sem, stage, std::move(args), current_statement_,
-                                   value, has_side_effects);
+        return Create<sem::Call>(expr, target_sem, stage, std::move(args), current_statement_,
+                                 value, has_side_effects);
     };
 
     // arr_or_str_init is a helper for building a sem::ValueConstructor for an array or structure
@@ -2157,7 +2363,9 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
             if (const_args != Success) {
                 return nullptr;
             }
-            auto r = const_eval_.ArrayOrStructCtor(ty, std::move(const_args.Get()));
+            auto r = Locked([&] {
+                return const_eval_.ArrayOrStructCtor(ty, std::move(const_args.Get()));
+            });
             if (r != Success) {
                 return nullptr;
             }
@@ -2172,8 +2380,8 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
             }
         }
 
-        return b.create<sem::Call>(expr, call_target, stage, std::move(args), current_statement_,
-                                   value, has_side_effects);
+        return Create<sem::Call>(expr, call_target, stage, std::move(args), current_statement_,
+                                 value, has_side_effects);
     };
 
     auto ty_init_or_conv = [&](const core::type::Type* type) {
@@ -2200,16 +2408,19 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
                                     Vector{m->type()});
             },
             [&](const sem::Array* arr) -> sem::Call* {
-                auto* call_target = array_ctors_.GetOrAdd(
-                    ArrayConstructorSig{{arr, args.Length(), args_stage}},
-                    [&]() -> sem::ValueConstructor* {
-                        auto params = tint::Transform(args, [&](auto, size_t i) {
-                            return b.create<sem::Parameter>(nullptr,  // declaration
-                                                            static_cast<uint32_t>(i),  // index
-                                                            arr->ElemType());
+                auto* call_target = Locked([&] {
+                    return Root().array_ctors_.GetOrAdd(
+                        ArrayConstructorSig{{arr, args.Length(), args_stage}},
+                        [&]() -> sem::ValueConstructor* {
+                            auto params = tint::Transform(args, [&](auto, size_t i) {
+                                return Create<sem::Parameter>(nullptr,  // declaration
+                                                              static_cast<uint32_t>(i),  // index
+                                                              arr->ElemType());
+                            });
+                            return Create<sem::ValueConstructor>(arr, std::move(params),
+                                                                 args_stage);
                         });
-                        return b.create<sem::ValueConstructor>(arr, std::move(params), args_stage);
-                    });
+                });
 
                 if (TINT_UNLIKELY(!MaybeMaterializeAndLoadArguments(args, call_target))) {
                     return nullptr;
@@ -2222,19 +2433,22 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
                 return arr_or_str_init(arr, call_target);
             },
             [&](const core::type::Struct* str) -> sem::Call* {
-                auto* call_target = struct_ctors_.GetOrAdd(
-                    StructConstructorSig{{str, args.Length(), args_stage}},
-                    [&]() -> sem::ValueConstructor* {
-                        Vector<sem::Parameter*, 8> params;
-                        params.Resize(std::min(args.Length(), str->Members().Length()));
-                        for (size_t i = 0, n = params.Length(); i < n; i++) {
-                            params[i] =
-                                b.create<sem::Parameter>(nullptr,                     // declaration
-                                                         static_cast<uint32_t>(i),    // index
-                                                         str->Members()[i]->Type());  // type
-                        }
-                        return b.create<sem::ValueConstructor>(str, std::move(params), args_stage);
-                    });
+                auto* call_target = Locked([&] {
+                    return Root().struct_ctors_.GetOrAdd(
+                        StructConstructorSig{{str, args.Length(), args_stage}},
+                        [&]() -> sem::ValueConstructor* {
+                            Vector<sem::Parameter*, 8> params;
+                            params.Resize(std::min(args.Length(), str->Members().Length()));
+                            for (size_t i = 0, n = params.Length(); i < n; i++) {
+                                params[i] = Create<sem::Parameter>(
+                                    nullptr,                     // declaration
+                                    static_cast<uint32_t>(i),    // index
+                                    str->Members()[i]->Type());  // type
+                            }
+                            return Create<sem::ValueConstructor>(str, std::move(params),
+                                                                 args_stage);
+                        });
+                });
 
                 if (TINT_UNLIKELY(!MaybeMaterializeAndLoadArguments(args, call_target))) {
                     return nullptr;
@@ -2282,7 +2496,7 @@ sem::Call* Resolver::Call(const ast::CallExpression* expr) {
                 return ctor_or_conv(CtorConvIntrinsic::kMat4x4, Empty);
             case core::BuiltinType::kArray: {
                 auto el_count =
-                    b.create<core::type::ConstantArrayCount>(static_cast<uint32_t>(args.Length()));
+                    Create<core::type::ConstantArrayCount>(static_cast<uint32_t>(args.Length()));
                 auto arg_tys =
                     tint::Transform(args, [](auto* arg) { return arg->Type()->UnwrapRef(); });
                 auto el_ty = core::type::Type::Common(arg_tys);
@@ -2368,32 +2582,36 @@ sem::Call* Resolver::BuiltinCall(const ast::CallExpression* expr,
     }
 
     auto arg_tys = tint::Transform(args, [](auto* arg) { return arg->Type()->UnwrapRef(); });
-    auto overload = intrinsic_table_.Lookup(fn, tmpl_args, arg_tys, arg_stage);
+    auto overload = Locked([&] {
+        return intrinsic_table_.Lookup(fn, tmpl_args, arg_tys, arg_stage);
+    });
     if (overload != Success) {
         AddError(expr->source) << overload.Failure();
         return nullptr;
     }
 
     // De-duplicate builtins that are identical.
-    auto* target = builtins_.GetOrAdd(std::make_pair(overload.Get(), fn), [&] {
-        auto params = Transform(overload->parameters, [&](auto& p, size_t i) {
-            return b.create<sem::Parameter>(nullptr, static_cast<uint32_t>(i), p.type, p.usage);
+    auto* target = Locked([&] {
+        return Root().builtins_.GetOrAdd(std::make_pair(overload.Get(), fn), [&] {
+            auto params = Transform(overload->parameters, [&](auto& p, size_t i) {
+                return Create<sem::Parameter>(nullptr, static_cast<uint32_t>(i), p.type, p.usage);
+            });
+            sem::PipelineStageSet supported_stages;
+            auto flags = overload->info->flags;
+            if (flags.Contains(OverloadFlag::kSupportsVertexPipeline)) {
+                supported_stages.Add(ast::PipelineStage::kVertex);
+            }
+            if (flags.Contains(OverloadFlag::kSupportsFragmentPipeline)) {
+                supported_stages.Add(ast::PipelineStage::kFragment);
+            }
+            if (flags.Contains(OverloadFlag::kSupportsComputePipeline)) {
+                supported_stages.Add(ast::PipelineStage::kCompute);
+            }
+            auto eval_stage = overload->const_eval_fn ? core::EvaluationStage::kConstant
+                                                      : core::EvaluationStage::kRuntime;
+            return Create<sem::BuiltinFn>(fn, overload->return_type, std::move(params), eval_stage,
+                                          supported_stages, *overload->info);
         });
-        sem::PipelineStageSet supported_stages;
-        auto flags = overload->info->flags;
-        if (flags.Contains(OverloadFlag::kSupportsVertexPipeline)) {
-            supported_stages.Add(ast::PipelineStage::kVertex);
-        }
-        if (flags.Contains(OverloadFlag::kSupportsFragmentPipeline)) {
-            supported_stages.Add(ast::PipelineStage::kFragment);
-        }
-        if (flags.Contains(OverloadFlag::kSupportsComputePipeline)) {
-            supported_stages.Add(ast::PipelineStage::kCompute);
-        }
-        auto eval_stage = overload->const_eval_fn ? core::EvaluationStage::kConstant
-                                                  : core::EvaluationStage::kRuntime;
-        return b.create<sem::BuiltinFn>(fn, overload->return_type, std::move(params), eval_stage,
-                                        supported_stages, *overload->info);
     });
 
     if (fn == wgsl::BuiltinFn::kTintMaterialize) {
@@ -2425,7 +2643,10 @@ sem::Call* Resolver::BuiltinCall(const ast::CallExpression* expr,
             return nullptr;
         }
         auto const_eval_fn = overload->const_eval_fn;
-        auto r = (const_eval_.*const_eval_fn)(target->ReturnType(), const_args.Get(), expr->source);
+        auto r = Locked([&] {
+            return (const_eval_.*const_eval_fn)(target->ReturnType(), const_args.Get(),
+                                                expr->source);
+        });
         if (r != Success) {
             return nullptr;
         }
@@ -2435,8 +2656,8 @@ sem::Call* Resolver::BuiltinCall(const ast::CallExpression* expr,
     bool has_side_effects =
         target->HasSideEffects() ||
         std::any_of(args.begin(), args.end(), [](auto* e) { return e->HasSideEffects(); });
-    auto* call = b.create<sem::Call>(expr, target, stage, std::move(args), current_statement_,
-                                     value, has_side_effects);
+    auto* call = Create<sem::Call>(expr, target, stage, std::move(args), current_statement_,
+                                   value, has_side_effects);
 
     if (current_function_) {
         current_function_->AddDirectlyCalledBuiltin(target);
@@ -2508,7 +2729,7 @@ core::type::Type* Resolver::BuiltinType(core::BuiltinType builtin_ty,
 
     switch (builtin_ty) {
         case core::BuiltinType::kBool:
-            return check_no_tmpl_args(b.create<core::type::Bool>());
+            return check_no_tmpl_args(Create<core::type::Bool>());
         case core::BuiltinType::kI32:
             return check_no_tmpl_args(I32());
         case core::BuiltinType::kU32:
@@ -2516,7 +2737,7 @@ core::type::Type* Resolver::BuiltinType(core::BuiltinType builtin_ty,
         case core::BuiltinType::kF16:
             return check_no_tmpl_args(F16(ident));
         case core::BuiltinType::kF32:
-            return check_no_tmpl_args(b.create<core::type::F32>());
+            return check_no_tmpl_args(Create<core::type::F32>());
         case core::BuiltinType::kVec2:
             return VecT(ident, builtin_ty, 2);
         case core::BuiltinType::kVec3:
@@ -2609,10 +2830,10 @@ core::type::Type* Resolver::BuiltinType(core::BuiltinType builtin_ty,
             return Ptr(ident);
         case core::BuiltinType::kSampler:
             return check_no_tmpl_args(
-                b.create<core::type::Sampler>(core::type::SamplerKind::kSampler));
+                Create<core::type::Sampler>(core::type::SamplerKind::kSampler));
         case core::BuiltinType::kSamplerComparison:
             return check_no_tmpl_args(
-                b.create<core::type::Sampler>(core::type::SamplerKind::kComparisonSampler));
+                Create<core::type::Sampler>(core::type::SamplerKind::kComparisonSampler));
         case core::BuiltinType::kTexture1D:
             return SampledTexture(ident, core::type::TextureDimension::k1d);
         case core::BuiltinType::kTexture2D:
@@ -2627,21 +2848,21 @@ core::type::Type* Resolver::BuiltinType(core::BuiltinType builtin_ty,
             return SampledTexture(ident, core::type::TextureDimension::kCubeArray);
         case core::BuiltinType::kTextureDepth2D:
             return check_no_tmpl_args(
-                b.create<core::type::DepthTexture>(core::type::TextureDimension::k2d));
+                Create<core::type::DepthTexture>(core::type::TextureDimension::k2d));
         case core::BuiltinType::kTextureDepth2DArray:
             return check_no_tmpl_args(
-                b.create<core::type::DepthTexture>(core::type::TextureDimension::k2dArray));
+                Create<core::type::DepthTexture>(core::type::TextureDimension::k2dArray));
         case core::BuiltinType::kTextureDepthCube:
             return check_no_tmpl_args(
-                b.create<core::type::DepthTexture>(core::type::TextureDimension::kCube));
+                Create<core::type::DepthTexture>(core::type::TextureDimension::kCube));
         case core::BuiltinType::kTextureDepthCubeArray:
             return check_no_tmpl_args(
-                b.create<core::type::DepthTexture>(core::type::TextureDimension::kCubeArray));
+                Create<core::type::DepthTexture>(core::type::TextureDimension::kCubeArray));
         case core::BuiltinType::kTextureDepthMultisampled2D:
             return check_no_tmpl_args(
-                b.create<core::type::DepthMultisampledTexture>(core::type::TextureDimension::k2d));
+                Create<core::type::DepthMultisampledTexture>(core::type::TextureDimension::k2d));
         case core::BuiltinType::kTextureExternal:
-            return check_no_tmpl_args(b.create<core::type::ExternalTexture>());
+            return check_no_tmpl_args(Create<core::type::ExternalTexture>());
         case core::BuiltinType::kTextureMultisampled2D:
             return MultisampledTexture(ident, core::type::TextureDimension::k2d);
         case core::BuiltinType::kTextureStorage1D:
@@ -2716,23 +2937,23 @@ core::type::Type* Resolver::BuiltinType(core::BuiltinType builtin_ty,
 }
 
 core::type::AbstractFloat* Resolver::AF() {
-    return b.create<core::type::AbstractFloat>();
+    return Create<core::type::AbstractFloat>();
 }
 
 core::type::F32* Resolver::F32() {
-    return b.create<core::type::F32>();
+    return Create<core::type::F32>();
 }
 
 core::type::I32* Resolver::I32() {
-    return b.create<core::type::I32>();
+    return Create<core::type::I32>();
 }
 
 core::type::U32* Resolver::U32() {
-    return b.create<core::type::U32>();
+    return Create<core::type::U32>();
 }
 
 core::type::F16* Resolver::F16(const ast::Identifier* ident) {
-    return validator_.CheckF16Enabled(ident->source) ? b.create<core::type::F16>() : nullptr;
+    return validator_.CheckF16Enabled(ident->source) ? Create<core::type::F16>() : nullptr;
 }
 
 core::type::Vector* Resolver::Vec(const ast::Identifier* ident, core::type::Type* el, uint32_t n) {
@@ -2742,7 +2963,7 @@ core::type::Vector* Resolver::Vec(const ast::Identifier* ident, core::type::Type
     if (TINT_UNLIKELY(!validator_.Vector(el, ident->source))) {
         return nullptr;
     }
-    return b.create<core::type::Vector>(el, n);
+    return Create<core::type::Vector>(el, n);
 }
 
 core::type::Type* Resolver::VecT(const ast::Identifier* ident,
@@ -2751,7 +2972,7 @@ core::type::Type* Resolver::VecT(const ast::Identifier* ident,
     auto* tmpl_ident = ident->As<ast::TemplatedIdentifier>();
     if (!tmpl_ident) {
         // 'vecN' has no template arguments, so return an incomplete type.
-        return b.create<IncompleteType>(builtin);
+        return Create<IncompleteType>(builtin);
     }
 
     if (TINT_UNLIKELY(!CheckTemplatedIdentifierArgs(tmpl_ident, 1))) {
@@ -2780,7 +3001,7 @@ core::type::Matrix* Resolver::Mat(const ast::Identifier* ident,
     if (!column) {
         return nullptr;
     }
-    return b.create<core::type::Matrix>(column, num_columns);
+    return Create<core::type::Matrix>(column, num_columns);
 }
 
 core::type::Type* Resolver::MatT(const ast::Identifier* ident,
@@ -2790,7 +3011,7 @@ core::type::Type* Resolver::MatT(const ast::Identifier* ident,
     auto* tmpl_ident = ident->As<ast::TemplatedIdentifier>();
     if (!tmpl_ident) {
         // 'vecN' has no template arguments, so return an incomplete type.
-        return b.create<IncompleteType>(builtin);
+        return Create<IncompleteType>(builtin);
     }
 
     if (TINT_UNLIKELY(!CheckTemplatedIdentifierArgs(tmpl_ident, 1))) {
@@ -2809,7 +3030,7 @@ core::type::Type* Resolver::Array(const ast::Identifier* ident) {
     auto* tmpl_ident = ident->As<ast::TemplatedIdentifier>();
     if (!tmpl_ident) {
         // 'array' has no template arguments, so return an incomplete type.
-        return b.create<IncompleteType>(core::BuiltinType::kArray);
+        return Create<IncompleteType>(core::BuiltinType::kArray);
     }
 
     if (TINT_UNLIKELY(!CheckTemplatedIdentifierArgs(tmpl_ident, 1, 2))) {
@@ -2824,7 +3045,7 @@ core::type::Type* Resolver::Array(const ast::Identifier* ident) {
     }
 
     const core::type::ArrayCount* el_count =
-        ast_count ? ArrayCount(ast_count) : b.create<core::type::RuntimeArrayCount>();
+        ast_count ? ArrayCount(ast_count) : Create<core::type::RuntimeArrayCount>();
     if (!el_count) {
         return nullptr;
     }
@@ -2865,7 +3086,7 @@ core::type::Atomic* Resolver::Atomic(const ast::Identifier* ident) {
         return nullptr;
     }
 
-    auto* out = b.create<core::type::Atomic>(el_ty);
+    auto* out = Create<core::type::Atomic>(el_ty);
     if (TINT_UNLIKELY(!validator_.Atomic(tmpl_ident, out))) {
         return nullptr;
     }
@@ -2898,7 +3119,7 @@ core::type::Pointer* Resolver::Ptr(const ast::Identifier* ident) {
         access = DefaultAccessForAddressSpace(address_space);
     }
 
-    auto* out = b.create<core::type::Pointer>(address_space, store_ty, access);
+    auto* out = Create<core::type::Pointer>(address_space, store_ty, access);
     if (TINT_UNLIKELY(!validator_.Pointer(tmpl_ident, out))) {
         return nullptr;
     }
@@ -2922,7 +3143,7 @@ core::type::SampledTexture* Resolver::SampledTexture(const ast::Identifier* iden
         return nullptr;
     }
 
-    auto* out = b.create<core::type::SampledTexture>(dim, ty_expr);
+    auto* out = Create<core::type::SampledTexture>(dim, ty_expr);
     return validator_.SampledTexture(out, ident->source) ? out : nullptr;
 }
 
@@ -2938,7 +3159,7 @@ core::type::MultisampledTexture* Resolver::MultisampledTexture(const ast::Identi
         return nullptr;
     }
 
-    auto* out = b.create<core::type::MultisampledTexture>(dim, ty_expr);
+    auto* out = Create<core::type::MultisampledTexture>(dim, ty_expr);
     return validator_.MultisampledTexture(out, ident->source) ? out : nullptr;
 }
 
@@ -2960,7 +3181,7 @@ core::type::StorageTexture* Resolver::StorageTexture(const ast::Identifier* iden
     }
 
     auto* subtype = core::type::StorageTexture::SubtypeFor(format, b.Types());
-    auto* tex = b.create<core::type::StorageTexture>(dim, format, access, subtype);
+    auto* tex = Create<core::type::StorageTexture>(dim, format, access, subtype);
     if (!validator_.StorageTexture(tex, ident->source)) {
         return nullptr;
     }
@@ -2979,7 +3200,7 @@ core::type::InputAttachment* Resolver::InputAttachment(const ast::Identifier* id
         return nullptr;
     }
 
-    auto* out = b.create<core::type::InputAttachment>(ty_expr);
+    auto* out = Create<core::type::InputAttachment>(ty_expr);
     return validator_.InputAttachment(out, ident->source) ? out : nullptr;
 }
 
@@ -2997,7 +3218,7 @@ core::type::Vector* Resolver::PackedVec3T(const ast::Identifier* ident) {
     if (TINT_UNLIKELY(!validator_.Vector(el_ty, ident->source))) {
         return nullptr;
     }
-    return b.create<core::type::Vector>(el_ty, 3u, true);
+    return Create<core::type::Vector>(el_ty, 3u, true);
 }
 
 const ast::TemplatedIdentifier* Resolver::TemplatedIdentifier(const ast::Identifier* ident,
@@ -3041,16 +3262,18 @@ bool Resolver::CheckTemplatedIdentifierArgs(const ast::TemplatedIdentifier* iden
     return ident;
 }
 
-size_t Resolver::NestDepth(const core::type::Type* ty) const {
+size_t Resolver::NestDepth(const core::type::Type* ty) {
     return Switch(
         ty,  //
         [](const core::type::Vector*) { return size_t{1}; },
         [](const core::type::Matrix*) { return size_t{2}; },
         [&](Default) {
-            if (auto d = nest_depth_.Get(ty)) {
-                return *d;
-            }
-            return size_t{0};
+            return Locked([&] {
+                if (auto d = Root().nest_depth_.Get(ty)) {
+                    return *d;
+                }
+                return size_t{0};
+            });
         });
 }
 
@@ -3098,10 +3321,14 @@ sem::Call* Resolver::FunctionCall(const ast::CallExpression* expr,
 
     // TODO(crbug.com/tint/1420): For now, assume all function calls have side effects.
     bool has_side_effects = true;
-    auto* call = b.create<sem::Call>(expr, target, stage, std::move(args), current_statement_,
-                                     /* constant_value */ nullptr, has_side_effects);
+    auto* call = Create<sem::Call>(expr, target, stage, std::move(args), current_statement_,
+                                   /* constant_value */ nullptr, has_side_effects);
 
-    target->AddCallSite(call);
+    if (worker_) {
+        worker_->call_sites.Push(std::make_pair(target, call));
+    } else {
+        target->AddCallSite(call);
+    }
 
     call->Behaviors() = arg_behaviors + target->Behaviors();
 
@@ -3172,7 +3399,7 @@ void Resolver::CollectTextureSamplerPairs(sem::Function* func,
             auto* texture = user->Variable();
             if (!texture_sampler_set.Contains(texture)) {
                 current_function_->AddTextureSamplerPair(texture, nullptr);
-                func->AddTextureSamplerPair(param, nullptr);
+                AddCalleeTextureSamplerPair(func, param, nullptr);
                 texture_sampler_set.Add(texture);
             }
         } else if (param->Type()->Is<core::type::Sampler>()) {
@@ -3180,40 +3407,50 @@ void Resolver::CollectTextureSamplerPairs(sem::Function* func,
             auto* sampler = user->Variable();
             if (!texture_sampler_set.Contains(sampler)) {
                 current_function_->AddTextureSamplerPair(nullptr, sampler);
-                func->AddTextureSamplerPair(nullptr, param);
+                AddCalleeTextureSamplerPair(func, nullptr, param);
                 texture_sampler_set.Add(sampler);
             }
         }
     }
 }
 
+void Resolver::AddCalleeTextureSamplerPair(sem::Function* func,
+                                           const sem::Variable* texture,
+                                           const sem::Variable* sampler) const {
+    if (worker_) {
+        worker_->callee_texture_sampler_pairs.Push(std::make_tuple(func, texture, sampler));
+    } else {
+        func->AddTextureSamplerPair(texture, sampler);
+    }
+}
+
 sem::ValueExpression* Resolver::Literal(const ast::LiteralExpression* literal) {
     auto* ty = Switch(
         literal,
         [&](const ast::IntLiteralExpression* i) -> core::type::Type* {
             switch (i->suffix) {
                 case ast::IntLiteralExpression::Suffix::kNone:
-                    return b.create<core::type::AbstractInt>();
+                    return Create<core::type::AbstractInt>();
                 case ast::IntLiteralExpression::Suffix::kI:
-                    return b.create<core::type::I32>();
+                    return Create<core::type::I32>();
                 case ast::IntLiteralExpression::Suffix::kU:
-                    return b.create<core::type::U32>();
+                    return Create<core::type::U32>();
             }
             TINT_UNREACHABLE() << "Unhandled integer literal suffix: " << i->suffix;
         },
         [&](const ast::FloatLiteralExpression* f) -> core::type::Type* {
             switch (f->suffix) {
                 case ast::FloatLiteralExpression::Suffix::kNone:
-                    return b.create<core::type::AbstractFloat>();
+                    return Create<core::type::AbstractFloat>();
                 case ast::FloatLiteralExpression::Suffix::kF:
-                    return b.create<core::type::F32>();
+                    return Create<core::type::F32>();
                 case ast::FloatLiteralExpression::Suffix::kH:
-                    return validator_.CheckF16Enabled(literal->source) ? b.create<core::type::F16>()
+                    return validator_.CheckF16Enabled(literal->source) ? Create<core::type::F16>()
                                                                        : nullptr;
             }
             TINT_UNREACHABLE() << "Unhandled float literal suffix: " << f->suffix;
         },
-        [&](const ast::BoolLiteralExpression*) { return b.create<core::type::Bool>(); },  //
+        [&](const ast::BoolLiteralExpression*) { return Create<core::type::Bool>(); },  //
         TINT_ICE_ON_NO_MATCH);
 
     if (ty == nullptr) {
@@ -3226,34 +3463,36 @@ sem::ValueExpression* Resolver::Literal(const ast::LiteralExpression* literal) {
         stage = core::EvaluationStage::kNotEvaluated;
     }
     if (stage == core::EvaluationStage::kConstant) {
-        val = Switch(
-            literal,
-            [&](const ast::BoolLiteralExpression* lit) { return b.constants.Get(lit->value); },
-            [&](const ast::IntLiteralExpression* lit) -> const core::constant::Value* {
-                switch (lit->suffix) {
-                    case ast::IntLiteralExpression::Suffix::kNone:
-                        return b.constants.Get(AInt(lit->value));
-                    case ast::IntLiteralExpression::Suffix::kI:
-                        return b.constants.Get(i32(lit->value));
-                    case ast::IntLiteralExpression::Suffix::kU:
-                        return b.constants.Get(u32(lit->value));
-                }
-                return nullptr;
-            },
-            [&](const ast::FloatLiteralExpression* lit) -> const core::constant::Value* {
-                switch (lit->suffix) {
-                    case ast::FloatLiteralExpression::Suffix::kNone:
-                        return b.constants.Get(AFloat(lit->value));
-                    case ast::FloatLiteralExpression::Suffix::kF:
-                        return b.constants.Get(f32(lit->value));
-                    case ast::FloatLiteralExpression::Suffix::kH:
-                        return b.constants.Get(f16(lit->value));
-                }
-                return nullptr;
-            });
+        val = Locked([&] {
+            return Switch(
+                literal,
+                [&](const ast::BoolLiteralExpression* lit) { return b.constants.Get(lit->value); },
+                [&](const ast::IntLiteralExpression* lit) -> const core::constant::Value* {
+                    switch (lit->suffix) {
+                        case ast::IntLiteralExpression::Suffix::kNone:
+                            return b.constants.Get(AInt(lit->value));
+                        case ast::IntLiteralExpression::Suffix::kI:
+                            return b.constants.Get(i32(lit->value));
+                        case ast::IntLiteralExpression::Suffix::kU:
+                            return b.constants.Get(u32(lit->value));
+                    }
+                    return nullptr;
+                },
+                [&](const ast::FloatLiteralExpression* lit) -> const core::constant::Value* {
+                    switch (lit->suffix) {
+                        case ast::FloatLiteralExpression::Suffix::kNone:
+                            return b.constants.Get(AFloat(lit->value));
+                        case ast::FloatLiteralExpression::Suffix::kF:
+                            return b.constants.Get(f32(lit->value));
+                        case ast::FloatLiteralExpression::Suffix::kH:
+                            return b.constants.Get(f16(lit->value));
+                    }
+                    return nullptr;
+                });
+        });
     }
-    return b.create<sem::ValueExpression>(literal, ty, stage, current_statement_, std::move(val),
-                                          /* has_side_effects */ false);
+    return Create<sem::ValueExpression>(literal, ty, stage, current_statement_, std::move(val),
+                                        /* has_side_effects */ false);
 }
 
 sem::Expression* Resolver::Identifier(const ast::IdentifierExpression* expr) {
@@ -3283,7 +3522,7 @@ sem::Expression* Resolver::Identifier(const ast::IdentifierExpression* expr) {
                     value = nullptr;
                 }
                 auto* user =
-                    b.create<sem::VariableUser>(expr, stage, current_statement_, value, variable);
+                    Create<sem::VariableUser>(expr, stage, current_statement_, value, variable);
 
                 if (current_statement_) {
                     // Check all parent continuing blocks to make sure that this is not a reference
@@ -3332,7 +3571,11 @@ sem::Expression* Resolver::Identifier(const ast::IdentifierExpression* expr) {
                     }
                 }
 
-                variable->AddUser(user);
+                if (worker_ && variable->Is<sem::GlobalVariable>()) {
+                    worker_->global_users.Push(std::make_pair(variable, user));
+                } else {
+                    variable->AddUser(user);
+                }
                 return user;
             },
             [&](const core::type::Type* ty) -> sem::TypeExpression* {
@@ -3350,51 +3593,51 @@ sem::Expression* Resolver::Identifier(const ast::IdentifierExpression* expr) {
                     }
                 }
 
-                return b.create<sem::TypeExpression>(expr, current_statement_, ty);
+                return Create<sem::TypeExpression>(expr, current_statement_, ty);
             },
             [&](const sem::Function* fn) -> sem::FunctionExpression* {
                 if (!TINT_LIKELY(CheckNotTemplated("function", ident))) {
                     return nullptr;
                 }
-                return b.create<sem::FunctionExpression>(expr, current_statement_, fn);
+                return Create<sem::FunctionExpression>(expr, current_statement_, fn);
             });
     }
 
     if (auto builtin_ty = resolved->BuiltinType(); builtin_ty != core::BuiltinType::kUndefined) {
-        auto* ty = BuiltinType(builtin_ty, ident);
+        auto* ty = Locked([&] { return BuiltinType(builtin_ty, ident); });
         if (!ty) {
             return nullptr;
         }
-        return b.create<sem::TypeExpression>(expr, current_statement_, ty);
+        return Create<sem::TypeExpression>(expr, current_statement_, ty);
     }
 
     if (auto fn = resolved->BuiltinFn(); fn != wgsl::BuiltinFn::kNone) {
-        return b.create<sem::BuiltinEnumExpression<wgsl::BuiltinFn>>(expr, current_statement_, fn);
+        return Create<sem::BuiltinEnumExpression<wgsl::BuiltinFn>>(expr, current_statement_, fn);
     }
 
     if (auto access = resolved->Access(); access != core::Access::kUndefined) {
         return CheckNotTemplated("access", ident)
-                   ? b.create<sem::BuiltinEnumExpression<core::Access>>(expr, current_statement_,
-                                                                        access)
+                   ? Create<sem::BuiltinEnumExpression<core::Access>>(expr, current_statement_,
+                                                                      access)
                    : nullptr;
     }
 
     if (auto addr = resolved->AddressSpace(); addr != core::AddressSpace::kUndefined) {
         return CheckNotTemplated("address space", ident)
-                   ? b.create<sem::BuiltinEnumExpression<core::AddressSpace>>(
+                   ? Create<sem::BuiltinEnumExpression<core::AddressSpace>>(
                          expr, current_statement_, addr)
                    : nullptr;
     }
 
     if (auto fmt = resolved->TexelFormat(); fmt != core::TexelFormat::kUndefined) {
         return CheckNotTemplated("texel format", ident)
-                   ? b.create<sem::BuiltinEnumExpression<core::TexelFormat>>(
+                   ? Create<sem::BuiltinEnumExpression<core::TexelFormat>>(
                          expr, current_statement_, fmt)
                    : nullptr;
     }
 
     if (resolved->Unresolved()) {
-        return b.create<UnresolvedIdentifier>(expr, current_statement_);
+        return Create<UnresolvedIdentifier>(expr, current_statement_);
     }
 
     TINT_UNREACHABLE() << "unhandled resolved identifier: " << resolved->String();
@@ -3452,16 +3695,16 @@ sem::ValueExpression* Resolver::MemberAccessor(const ast::MemberAccessorExpressi
 
             // If we're extracting from a memory view, we return a reference.
             if (memory_view) {
-                ty = b.create<core::type::Reference>(memory_view->AddressSpace(), ty,
-                                                     memory_view->Access());
+                ty = Create<core::type::Reference>(memory_view->AddressSpace(), ty,
+                                                   memory_view->Access());
             }
 
             const core::constant::Value* val = nullptr;
             if (auto* obj_val = object->ConstantValue()) {
                 val = obj_val->Index(static_cast<size_t>(member->Index()));
             }
-            return b.create<sem::StructMemberAccess>(expr, ty, current_statement_, val, object,
-                                                     member, has_side_effects, root_ident);
+            return Create<sem::StructMemberAccess>(expr, ty, current_statement_, val, object,
+                                                   member, has_side_effects, root_ident);
         },
 
         [&](const core::type::Vector* vec) -> sem::ValueExpression* {
@@ -3522,13 +3765,13 @@ sem::ValueExpression* Resolver::MemberAccessor(const ast::MemberAccessorExpressi
                 ty = vec->type();
                 // If we're extracting from a memory view, we return a reference.
                 if (memory_view) {
-                    ty = b.create<core::type::Reference>(memory_view->AddressSpace(), ty,
-                                                         memory_view->Access());
+                    ty = Create<core::type::Reference>(memory_view->AddressSpace(), ty,
+                                                       memory_view->Access());
                 }
             } else {
                 // The vector will have a number of components equal to the length of
                 // the swizzle.
-                ty = b.create<core::type::Vector>(vec->type(), static_cast<uint32_t>(size));
+                ty = Create<core::type::Vector>(vec->type(), static_cast<uint32_t>(size));
 
                 if (obj_expr->Type()->Is<core::type::Pointer>()) {
                     // If the LHS is a pointer, the load rule is invoked. We special case this
@@ -3536,8 +3779,7 @@ sem::ValueExpression* Resolver::MemberAccessor(const ast::MemberAccessorExpressi
                     // reference type. This expression also has an implicit dereference before the
                     // load, but we have no way of representing that, so we create the load directly
                     // from the pointer expression.
-                    auto* load =
-                        b.create<sem::Load>(obj_expr, current_statement_, obj_expr->Stage());
+                    auto* load = Create<sem::Load>(obj_expr, current_statement_, obj_expr->Stage());
                     load->Behaviors() = obj_expr->Behaviors();
                     b.Sem().Replace(obj_expr->Declaration(), load);
 
@@ -3552,14 +3794,14 @@ sem::ValueExpression* Resolver::MemberAccessor(const ast::MemberAccessorExpressi
             }
             const core::constant::Value* val = nullptr;
             if (auto* obj_val = object->ConstantValue()) {
-                auto res = const_eval_.Swizzle(ty, obj_val, swizzle);
+                auto res = Locked([&] { return const_eval_.Swizzle(ty, obj_val, swizzle); });
                 if (res != Success) {
                     return nullptr;
                 }
                 val = res.Get();
             }
-            return b.create<sem::Swizzle>(expr, ty, current_statement_, val, obj_expr,
-                                          std::move(swizzle), has_side_effects, root_ident);
+            return Create<sem::Swizzle>(expr, ty, current_statement_, val, obj_expr,
+                                        std::move(swizzle), has_side_effects, root_ident);
         },
 
         [&](Default) {
@@ -3587,8 +3829,10 @@ sem::ValueExpression* Resolver::Binary(const ast::BinaryExpression* expr) {
     }
 
     auto stage = core::EarliestStage(lhs->Stage(), rhs->Stage());
-    auto overload = intrinsic_table_.Lookup(expr->op, lhs->Type()->UnwrapRef(),
-                                            rhs->Type()->UnwrapRef(), stage, false);
+    auto overload = Locked([&] {
+        return intrinsic_table_.Lookup(expr->op, lhs->Type()->UnwrapRef(),
+                                       rhs->Type()->UnwrapRef(), stage, false);
+    });
     if (overload != Success) {
         AddError(expr->source) << overload.Failure();
         return nullptr;
@@ -3640,7 +3884,9 @@ sem::ValueExpression* Resolver::Binary(const ast::BinaryExpression* expr) {
             if (!Convert(const_args[1], rhs_ty, rhs->Declaration()->source)) {
                 return nullptr;
             }
-            auto r = (const_eval_.*const_eval_fn)(res_ty, const_args, expr->source);
+            auto r = Locked([&] {
+                return (const_eval_.*const_eval_fn)(res_ty, const_args, expr->source);
+            });
             if (r != Success) {
                 return nullptr;
             }
@@ -3653,8 +3899,8 @@ sem::ValueExpression* Resolver::Binary(const ast::BinaryExpression* expr) {
     }
 
     bool has_side_effects = lhs->HasSideEffects() || rhs->HasSideEffects();
-    auto* sem = b.create<sem::ValueExpression>(expr, res_ty, stage, current_statement_, value,
-                                               has_side_effects);
+    auto* sem = Create<sem::ValueExpression>(expr, res_ty, stage, current_statement_, value,
+                                             has_side_effects);
     sem->Behaviors() = lhs->Behaviors() + rhs->Behaviors();
 
     return sem;
@@ -3692,8 +3938,8 @@ sem::ValueExpression* Resolver::UnaryOp(const ast::UnaryOpExpression* unary) {
                     return nullptr;
                 }
 
-                ty = b.create<core::type::Pointer>(ref->AddressSpace(), ref->StoreType(),
-                                                   ref->Access());
+                ty = Create<core::type::Pointer>(ref->AddressSpace(), ref->StoreType(),
+                                                 ref->Access());
 
                 root_ident = expr->RootIdentifier();
             } else {
@@ -3705,8 +3951,8 @@ sem::ValueExpression* Resolver::UnaryOp(const ast::UnaryOpExpression* unary) {
 
         case core::UnaryOp::kIndirection:
             if (auto* ptr = expr_ty->As<core::type::Pointer>()) {
-                ty = b.create<core::type::Reference>(ptr->AddressSpace(), ptr->StoreType(),
-                                                     ptr->Access());
+                ty = Create<core::type::Reference>(ptr->AddressSpace(), ptr->StoreType(),
+                                                   ptr->Access());
                 root_ident = expr->RootIdentifier();
             } else {
                 AddError(unary->expr->source) << "cannot dereference expression of type "
@@ -3717,7 +3963,9 @@ sem::ValueExpression* Resolver::UnaryOp(const ast::UnaryOpExpression* unary) {
 
         default: {
             stage = expr->Stage();
-            auto overload = intrinsic_table_.Lookup(unary->op, expr_ty->UnwrapRef(), stage);
+            auto overload = Locked([&] {
+                return intrinsic_table_.Lookup(unary->op, expr_ty->UnwrapRef(), stage);
+            });
             if (overload != Success) {
                 AddError(unary->source) << overload.Failure();
                 return nullptr;
@@ -3740,8 +3988,10 @@ sem::ValueExpression* Resolver::UnaryOp(const ast::UnaryOpExpression* unary) {
             stage = expr->Stage();
             if (stage == core::EvaluationStage::kConstant) {
                 if (auto const_eval_fn = overload->const_eval_fn) {
-                    auto r = (const_eval_.*const_eval_fn)(ty, Vector{expr->ConstantValue()},
-                                                          expr->Declaration()->source);
+                    auto r = Locked([&] {
+                        return (const_eval_.*const_eval_fn)(ty, Vector{expr->ConstantValue()},
+                                                            expr->Declaration()->source);
+                    });
                     if (r != Success) {
                         return nullptr;
                     }
@@ -3754,8 +4004,8 @@ sem::ValueExpression* Resolver::UnaryOp(const ast::UnaryOpExpression* unary) {
         }
     }
 
-    auto* sem = b.create<sem::ValueExpression>(unary, ty, stage, current_statement_, value,
-                                               expr->HasSideEffects(), root_ident);
+    auto* sem = Create<sem::ValueExpression>(unary, ty, stage, current_statement_, value,
+                                             expr->HasSideEffects(), root_ident);
     sem->Behaviors() = expr->Behaviors();
     return sem;
 }
@@ -3960,7 +4210,7 @@ tint::Result<sem::WorkgroupSize> Resolver::WorkgroupAttribute(const ast::Workgro
 
     // If all arguments are abstract-integers, then materialize to i32.
     if (common_ty->Is<core::type::AbstractInt>()) {
-        common_ty = b.create<core::type::I32>();
+        common_ty = Create<core::type::I32>();
     }
 
     for (size_t i = 0; i < args.Length(); i++) {
@@ -4112,17 +4362,17 @@ const core::type::ArrayCount* Resolver::ArrayCount(const ast::Expression* count_
             // Happens in expressions like:
             //    false && array<T, N>()[i]
             // The end result will not be used, so just make N=1.
-            return b.create<core::type::ConstantArrayCount>(static_cast<uint32_t>(1));
+            return Create<core::type::ConstantArrayCount>(static_cast<uint32_t>(1));
 
         case core::EvaluationStage::kOverride: {
             // array count is an override expression.
             // Is the count a named 'override'?
             if (auto* user = count_sem->UnwrapMaterialize()->As<sem::VariableUser>()) {
                 if (auto* global = user->Variable()->As<sem::GlobalVariable>()) {
-                    return b.create<sem::NamedOverrideArrayCount>(global);
+                    return Create<sem::NamedOverrideArrayCount>(global);
                 }
             }
-            return b.create<sem::UnnamedOverrideArrayCount>(count_sem);
+            return Create<sem::UnnamedOverrideArrayCount>(count_sem);
         }
 
         case core::EvaluationStage::kConstant: {
@@ -4141,7 +4391,7 @@ const core::type::ArrayCount* Resolver::ArrayCount(const ast::Expression* count_
                 return nullptr;
             }
 
-            return b.create<core::type::ConstantArrayCount>(static_cast<uint32_t>(count));
+            return Create<core::type::ConstantArrayCount>(static_cast<uint32_t>(count));
         }
 
         default: {
@@ -4212,8 +4462,8 @@ sem::Array* Resolver::Array(const Source& array_source,
         size = stride;
     }
     auto* out =
-        b.create<sem::Array>(el_ty, el_count, el_align, static_cast<uint32_t>(size),
-                             static_cast<uint32_t>(stride), static_cast<uint32_t>(implicit_stride));
+        Create<sem::Array>(el_ty, el_count, el_align, static_cast<uint32_t>(size),
+                           static_cast<uint32_t>(stride), static_cast<uint32_t>(implicit_stride));
 
     // Maximum nesting depth of composite types
     //  https://gpuweb.github.io/gpuweb/wgsl/#limits
@@ -4223,7 +4473,7 @@ sem::Array* Resolver::Array(const Source& array_source,
                                << kMaxNestDepthOfCompositeType;
         return nullptr;
     }
-    nest_depth_.Add(out, nest_depth);
+    Locked([&] { Root().nest_depth_.Add(out, nest_depth); });
 
     if (!validator_.Array(out, el_source)) {
         return nullptr;
@@ -4506,7 +4756,7 @@ sem::Struct* Resolver::Structure(const ast::Struct* str) {
             return nullptr;
         }
 
-        auto* sem_member = b.create<sem::StructMember>(
+        auto* sem_member = Create<sem::StructMember>(
             member, member->name->symbol, type, static_cast<uint32_t>(sem_members.Length()),
             static_cast<uint32_t>(offset), static_cast<uint32_t>(align),
             static_cast<uint32_t>(size), attributes);
@@ -4529,7 +4779,7 @@ sem::Struct* Resolver::Structure(const ast::Struct* str) {
         ICE(str->source) << "calculated struct stride exceeds uint32";
     }
 
-    auto* out = b.create<sem::Struct>(
+    auto* out = Create<sem::Struct>(
         str, str->name->symbol, std::move(sem_members), static_cast<uint32_t>(struct_align),
         static_cast<uint32_t>(struct_size), static_cast<uint32_t>(size_no_padding));
 
@@ -4569,7 +4819,7 @@ sem::Struct* Resolver::Structure(const ast::Struct* str) {
 }
 
 sem::Statement* Resolver::ReturnStatement(const ast::ReturnStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto& behaviors = current_statement_->Behaviors();
         behaviors = sem::Behavior::kReturn;
@@ -4590,7 +4840,7 @@ sem::Statement* Resolver::ReturnStatement(const ast::ReturnStatement* stmt) {
 
             value_ty = expr->Type();
         } else {
-            value_ty = b.create<core::type::Void>();
+            value_ty = Create<core::type::Void>();
         }
 
         // Validate after processing the return value expression so that its type
@@ -4601,8 +4851,7 @@ sem::Statement* Resolver::ReturnStatement(const ast::ReturnStatement* stmt) {
 }
 
 sem::SwitchStatement* Resolver::SwitchStatement(const ast::SwitchStatement* stmt) {
-    auto* sem =
-        b.create<sem::SwitchStatement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::SwitchStatement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto& behaviors = sem->Behaviors();
 
@@ -4634,7 +4883,7 @@ sem::SwitchStatement* Resolver::SwitchStatement(const ast::SwitchStatement* stmt
         if (!common_ty || !common_ty->is_integer_scalar()) {
             // No common type found or the common type was abstract.
             // Pick i32 and let validation deal with any mismatches.
-            common_ty = b.create<core::type::I32>();
+            common_ty = Create<core::type::I32>();
         }
         cond = Materialize(cond, common_ty);
         if (!cond) {
@@ -4685,7 +4934,7 @@ sem::SwitchStatement* Resolver::SwitchStatement(const ast::SwitchStatement* stmt
 }
 
 sem::Statement* Resolver::VariableDeclStatement(const ast::VariableDeclStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         Mark(stmt->variable);
 
@@ -4705,7 +4954,7 @@ sem::Statement* Resolver::VariableDeclStatement(const ast::VariableDeclStatement
 }
 
 sem::Statement* Resolver::AssignmentStatement(const ast::AssignmentStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto* lhs = ValueExpression(stmt->lhs);
         if (!lhs) {
@@ -4746,7 +4995,7 @@ sem::Statement* Resolver::AssignmentStatement(const ast::AssignmentStatement* st
 }
 
 sem::Statement* Resolver::BreakStatement(const ast::BreakStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         sem->Behaviors() = sem::Behavior::kBreak;
 
@@ -4755,8 +5004,7 @@ sem::Statement* Resolver::BreakStatement(const ast::BreakStatement* stmt) {
 }
 
 sem::Statement* Resolver::BreakIfStatement(const ast::BreakIfStatement* stmt) {
-    auto* sem =
-        b.create<sem::BreakIfStatement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::BreakIfStatement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto* cond = Load(ValueExpression(stmt->condition));
         if (!cond) {
@@ -4771,7 +5019,7 @@ sem::Statement* Resolver::BreakIfStatement(const ast::BreakIfStatement* stmt) {
 }
 
 sem::Statement* Resolver::CallStatement(const ast::CallStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         if (auto* expr = ValueExpression(stmt->expr)) {
             sem->Behaviors() = expr->Behaviors();
@@ -4783,7 +5031,7 @@ sem::Statement* Resolver::CallStatement(const ast::CallStatement* stmt) {
 
 sem::Statement* Resolver::CompoundAssignmentStatement(
     const ast::CompoundAssignmentStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto* lhs = ValueExpression(stmt->lhs);
         if (!lhs) {
@@ -4801,8 +5049,10 @@ sem::Statement* Resolver::CompoundAssignmentStatement(
 
         auto stage = core::EarliestStage(lhs->Stage(), rhs->Stage());
 
-        auto overload = intrinsic_table_.Lookup(stmt->op, lhs->Type()->UnwrapRef(),
-                                                rhs->Type()->UnwrapRef(), stage, true);
+        auto overload = Locked([&] {
+            return intrinsic_table_.Lookup(stmt->op, lhs->Type()->UnwrapRef(),
+                                           rhs->Type()->UnwrapRef(), stage, true);
+        });
         if (overload != Success) {
             AddError(stmt->source) << overload.Failure();
             return false;
@@ -4819,7 +5069,7 @@ sem::Statement* Resolver::CompoundAssignmentStatement(
 }
 
 sem::Statement* Resolver::ContinueStatement(const ast::ContinueStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         sem->Behaviors() = sem::Behavior::kContinue;
 
@@ -4836,7 +5086,7 @@ sem::Statement* Resolver::ContinueStatement(const ast::ContinueStatement* stmt)
 }
 
 sem::Statement* Resolver::DiscardStatement(const ast::DiscardStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         current_function_->SetDiscardStatement(sem);
         return true;
@@ -4845,7 +5095,7 @@ sem::Statement* Resolver::DiscardStatement(const ast::DiscardStatement* stmt) {
 
 sem::Statement* Resolver::IncrementDecrementStatement(
     const ast::IncrementDecrementStatement* stmt) {
-    auto* sem = b.create<sem::Statement>(stmt, current_compound_statement_, current_function_);
+    auto* sem = Create<sem::Statement>(stmt, current_compound_statement_, current_function_);
     return StatementScope(stmt, sem, [&] {
         auto* lhs = ValueExpression(stmt->lhs);
         if (!lhs) {
@@ -4865,11 +5115,21 @@ bool Resolver::ApplyAddressSpaceUsageToType(core::AddressSpace address_space,
     ty = const_cast<core::type::Type*>(ty->UnwrapRef());
 
     if (auto* str = ty->As<sem::Struct>()) {
-        if (str->AddressSpaceUsage().Contains(address_space)) {
-            return true;  // Already applied
-        }
+        if (worker_) {
+            // The usages applied by other worker threads must not change the diagnostics of this
+            // function body, so only skip the structures already visited by this function body.
+            auto key = TypeAndAddressSpace{str, address_space};
+            if (!worker_->applied_address_space_usages.Add(key)) {
+                return true;  // Already applied
+            }
+            Locked([&] { str->AddUsage(address_space); });
+        } else {
+            if (str->AddressSpaceUsage().Contains(address_space)) {
+                return true;  // Already applied
+            }
 
-        str->AddUsage(address_space);
+            str->AddUsage(address_space);
+        }
 
         for (auto* member : str->Members()) {
             auto decl = member->Declaration();
@@ -4992,6 +5252,11 @@ bool Resolver::Mark(const ast::Node* node) {
     if (TINT_UNLIKELY(node == nullptr)) {
         TINT_ICE() << "Resolver::Mark() called with nullptr";
     }
+    if (worker_) {
+        // The parent resolver marks the nodes once the function body has been resolved.
+        worker_->marked.Push(node);
+        return true;
+    }
     auto marked_bit_ref = marked_[node->node_id.value];
     if (TINT_LIKELY(!marked_bit_ref)) {
         marked_bit_ref = true;
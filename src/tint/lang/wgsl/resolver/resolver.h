@@ -29,6 +29,7 @@
 #define SRC_TINT_LANG_WGSL_RESOLVER_RESOLVER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -102,9 +103,12 @@ class Resolver {
     /// @param builder the program builder
     /// @param allowed_features the extensions and features that are allowed to be used
     /// @param mode the validation mode to use
+    /// @param function_resolution_threads the number of threads to use to resolve function bodies.
+    /// Values less than 2 resolve all function bodies on the calling thread.
     Resolver(ProgramBuilder* builder,
              const wgsl::AllowedFeatures& allowed_features,
-             wgsl::ValidationMode mode = wgsl::ValidationMode::kFull);
+             wgsl::ValidationMode mode = wgsl::ValidationMode::kFull,
+             uint32_t function_resolution_threads = 0);
 
     /// Destructor
     ~Resolver();
@@ -142,10 +146,45 @@ class Resolver {
     const Validator* GetValidatorForTesting() const { return &validator_; }
 
   private:
+    /// Constructor for a resolver that resolves a single function body on a worker thread.
+    /// @param parent the resolver of the module-scope declarations
+    /// @param diagnostics the list that receives the diagnostics raised by the function body
+    /// @param mutex the lock that guards the state shared between the worker threads
+    Resolver(Resolver& parent, diag::List& diagnostics, std::recursive_mutex& mutex);
+
     /// Resolves the program, without creating final the semantic nodes.
     /// @returns true on success, false on error
     bool ResolveInternal();
 
+    /// Resolves the function bodies that Function() deferred, on up to
+    /// #function_resolution_threads_ threads. Functions are resolved in waves, each wave holding
+    /// the functions whose callees were resolved by an earlier wave. The diagnostics of each body
+    /// are merged in declaration order, up to the first declaration that failed to resolve, so
+    /// that the diagnostics match those of resolving all declarations on a single thread.
+    /// @returns true on success, false on error
+    bool ResolveFunctionBodies();
+
+    /// Resolves the body of @p func on a worker thread, with the state that Function() sets up
+    /// before resolving a function body.
+    /// @param func the function
+    /// @returns true on success, false on error
+    bool WorkerFunctionBody(sem::Function* func);
+
+    /// @returns the resolver of the module-scope declarations
+    Resolver& Root();
+
+    /// Calls @p fn, holding the lock of the state shared between the worker threads if this
+    /// resolver is resolving a function body on a worker thread.
+    /// @returns the result of @p fn
+    template <typename F>
+    auto Locked(F&& fn);
+
+    /// Creates a new semantic or type node owned by the program builder, holding the lock of the
+    /// state shared between the worker threads if this resolver is running on a worker thread.
+    /// @returns the new node
+    template <typename T, typename... ARGS>
+    auto* Create(ARGS&&... args);
+
     /// Creates the nodes and adds them to the sem::Info mappings of the
     /// ProgramBuilder.
     void CreateSemanticNodes() const;
@@ -284,6 +323,7 @@ class Resolver {
     sem::ValueExpression* Binary(const ast::BinaryExpression*);
     sem::Call* Call(const ast::CallExpression*);
     sem::Function* Function(const ast::Function*);
+    bool FunctionBody(sem::Function*);
     sem::Call* FunctionCall(const ast::CallExpression*,
                             sem::Function* target,
                             VectorRef<const sem::ValueExpression*> args,
@@ -398,6 +438,12 @@ class Resolver {
     void CollectTextureSamplerPairs(const sem::BuiltinFn* builtin,
                                     VectorRef<const sem::ValueExpression*> args) const;
 
+    /// Adds the texture/sampler pair to the called function @p func. On a worker thread, the pair
+    /// is recorded and added once the function body has been resolved.
+    void AddCalleeTextureSamplerPair(sem::Function* func,
+                                     const sem::Variable* texture,
+                                     const sem::Variable* sampler) const;
+
     /// Resolves the WorkgroupSize for the given function, assigning it to
     /// current_function_
     bool WorkgroupSize(const ast::Function*);
@@ -638,7 +684,9 @@ class Resolver {
 
     /// @returns the nesting depth of @ty as defined in
     /// https://gpuweb.github.io/gpuweb/wgsl/#composite-types
-    size_t NestDepth(const core::type::Type* ty) const;
+    /// @note the nesting depths are held by the root resolver, as the types declared at module
+    /// scope are used by the function bodies resolved on worker threads.
+    size_t NestDepth(const core::type::Type* ty);
 
     // ArrayConstructorSig represents a unique array constructor signature.
     // It is a tuple of the array type, number of arguments provided and earliest evaluation stage.
@@ -673,11 +721,47 @@ class Resolver {
         Hashset<const sem::Variable*, 4> parameter_reads;
     };
 
+    /// DeferredBody is a function body that is resolved after the module-scope declarations, when
+    /// function bodies are resolved on multiple threads.
+    struct DeferredBody {
+        /// The function
+        sem::Function* func = nullptr;
+        /// The number of diagnostics that were raised before the function body was deferred
+        size_t diagnostics_offset = 0;
+        /// The wave of ResolveFunctionBodies() that resolves the function body
+        size_t wave = 0;
+        /// The diagnostics raised while resolving the function body
+        diag::List diagnostics;
+        /// True if the function body was resolved without error
+        bool resolved = false;
+        /// The resolver that resolved the function body on a worker thread
+        std::unique_ptr<Resolver> worker;
+    };
+
+    /// WorkerState is the state of a resolver that resolves a function body on a worker thread.
+    /// Changes to semantic nodes that are shared with other functions are recorded here, and are
+    /// applied by the parent resolver in declaration order, so that they do not depend on the order
+    /// in which the worker threads run.
+    struct WorkerState {
+        /// The AST nodes marked while resolving the function body
+        Vector<const ast::Node*, 64> marked;
+        /// The calls of user-declared functions, and the functions that they call
+        Vector<std::pair<sem::Function*, const sem::Call*>, 8> call_sites;
+        /// The users of module-scope variables, and the variables that they use
+        Vector<std::pair<sem::Variable*, const sem::VariableUser*>, 8> global_users;
+        /// The texture/sampler pairs added to the called functions
+        Vector<std::tuple<sem::Function*, const sem::Variable*, const sem::Variable*>, 4>
+            callee_texture_sampler_pairs;
+        /// The address space usages that were applied to structures by the function body
+        Hashset<TypeAndAddressSpace, 8> applied_address_space_usages;
+    };
+
     ProgramBuilder& b;
     diag::List& diagnostics_;
     core::constant::Eval const_eval_;
     core::intrinsic::Table<wgsl::intrinsic::Dialect> intrinsic_table_;
-    DependencyGraph dependencies_;
+    DependencyGraph dependency_graph_;
+    DependencyGraph& dependencies_;
     SemHelper sem_;
     Validator validator_;
     wgsl::AllowedFeatures allowed_features_;
@@ -702,6 +786,11 @@ class Resolver {
     Hashmap<std::pair<core::intrinsic::Overload, wgsl::BuiltinFn>, sem::BuiltinFn*, 64> builtins_;
     Hashmap<core::intrinsic::Overload, sem::ValueConstructor*, 16> constructors_;
     Hashmap<core::intrinsic::Overload, sem::ValueConversion*, 16> converters_;
+    uint32_t function_resolution_threads_ = 0;
+    Vector<DeferredBody, 16> deferred_bodies_;
+    Resolver* parent_ = nullptr;
+    std::recursive_mutex* mutex_ = nullptr;
+    std::unique_ptr<WorkerState> worker_;
 };
 
 }  // namespace tint::resolver
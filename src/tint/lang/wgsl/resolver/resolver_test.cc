@@ -1077,6 +1077,63 @@ TEST_F(ResolverTest, Function_CallSites) {
     EXPECT_EQ(bar_sem->CallSites().Length(), 0u);
 }
 
+TEST_F(ResolverTest, Function_ParallelBodies) {
+    // var<private> g : i32;
+    // fn leaf() -> i32 { return g; }
+    // fn f<N>() -> i32 { return leaf() + N; }   (for N in [0, 32))
+    // @compute @workgroup_size(1)
+    // fn main() { _ = f0(); _ = f1(); ... }
+    auto* g = GlobalVar("g", ty.i32(), core::AddressSpace::kPrivate);
+    auto* leaf = Func("leaf", tint::Empty, ty.i32(), Vector{Return("g")});
+    Vector<const ast::Function*, 32> funcs;
+    Vector<const ast::Statement*, 32> calls;
+    for (int i = 0; i < 32; i++) {
+        auto name = "f" + std::to_string(i);
+        funcs.Push(Func(name, tint::Empty, ty.i32(), Vector{Return(Add(Call("leaf"), i32(i)))}));
+        calls.Push(Assign(Phony(), Call(name)));
+    }
+    auto* main = Func("main", tint::Empty, ty.void_(), std::move(calls),
+                      Vector{Stage(ast::PipelineStage::kCompute), WorkgroupSize(1_i)});
+
+    Resolver resolver(this, wgsl::AllowedFeatures::Everything(), wgsl::ValidationMode::kFull, 4);
+    ASSERT_TRUE(resolver.Resolve()) << resolver.error();
+
+    auto* leaf_sem = Sem().Get(leaf);
+    ASSERT_NE(leaf_sem, nullptr);
+    ASSERT_EQ(leaf_sem->CallSites().Length(), funcs.Length());
+    for (size_t i = 0; i < funcs.Length(); i++) {
+        auto* func_sem = Sem().Get(funcs[i]);
+        ASSERT_NE(func_sem, nullptr);
+        EXPECT_EQ(leaf_sem->CallSites()[i]->Stmt()->Function(), func_sem);
+        EXPECT_EQ(func_sem->CallSites().Length(), 1u);
+        EXPECT_TRUE(func_sem->TransitivelyCalledFunctions().Contains(leaf_sem));
+        EXPECT_THAT(func_sem->AncestorEntryPoints(), ElementsAre(Sem().Get(main)));
+    }
+    EXPECT_THAT(leaf_sem->AncestorEntryPoints(), ElementsAre(Sem().Get(main)));
+    EXPECT_EQ(Sem().Get(main)->TransitivelyCalledFunctions().Length(), funcs.Length() + 1);
+
+    auto* g_sem = Sem().Get<sem::GlobalVariable>(g);
+    ASSERT_NE(g_sem, nullptr);
+    EXPECT_EQ(g_sem->Users().Length(), 1u);
+    EXPECT_TRUE(Sem().Get(main)->TransitivelyReferencedGlobals().Contains(g_sem));
+}
+
+TEST_F(ResolverTest, Function_ParallelBodies_FirstErrorInDeclarationOrder) {
+    // fn a() { let x : i32 = 1u; }
+    // fn b() { let y : f32 = true; }
+    // fn c() { let z : i32 = 1i; }
+    Func("a", tint::Empty, ty.void_(),
+         Vector{Decl(Let(Source{{12, 34}}, "x", ty.i32(), Expr(1_u)))});
+    Func("b", tint::Empty, ty.void_(),
+         Vector{Decl(Let(Source{{56, 78}}, "y", ty.f32(), Expr(true)))});
+    Func("c", tint::Empty, ty.void_(), Vector{Decl(Let("z", ty.i32(), Expr(1_i)))});
+
+    Resolver resolver(this, wgsl::AllowedFeatures::Everything(), wgsl::ValidationMode::kFull, 4);
+    EXPECT_FALSE(resolver.Resolve());
+    EXPECT_EQ(resolver.error(),
+              R"(12:34 error: cannot initialize 'let' of type 'i32' with value of type 'u32')");
+}
+
 TEST_F(ResolverTest, Function_WorkgroupSize_NotSet) {
     // @compute @workgroup_size(1)
     // fn main() {}
@@ -2743,6 +2800,51 @@ TEST_F(ResolverTest, MaxNestDepthOfCompositeType_ArraysOfStruct_Invalid) {
     EXPECT_EQ(r()->error(), "12:34 error: array has nesting depth of 256, maximum is 255");
 }
 
+TEST_F(ResolverTest, MaxNestDepthOfCompositeType_ArrayInParallelFunctionBody_Valid) {
+    auto a = ty.array(ty.i32(), 10_u);
+    uint32_t depth = 2;  // Depth of array + array in the function
+    uint32_t iterations = kMaxNestDepthOfCompositeType - depth;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        a = ty.array(a, 1_u);
+    }
+    Alias("a", a);
+    Func("f", tint::Empty, ty.void_(), Vector{Decl(Var("v", ty.array(ty("a"), 1_u)))});
+
+    Resolver resolver(this, wgsl::AllowedFeatures::Everything(), wgsl::ValidationMode::kFull, 4);
+    EXPECT_TRUE(resolver.Resolve()) << resolver.error();
+}
+
+TEST_F(ResolverTest, MaxNestDepthOfCompositeType_ArrayInParallelFunctionBody_Invalid) {
+    auto a = ty.array(ty.i32(), 10_u);
+    uint32_t depth = 1;  // Depth of array
+    uint32_t iterations = kMaxNestDepthOfCompositeType - depth;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        a = ty.array(a, 1_u);
+    }
+    Alias("a", a);
+    Func("f", tint::Empty, ty.void_(),
+         Vector{Decl(Var("v", ty.array(Source{{12, 34}}, ty("a"), 1_u)))});
+
+    Resolver resolver(this, wgsl::AllowedFeatures::Everything(), wgsl::ValidationMode::kFull, 4);
+    EXPECT_FALSE(resolver.Resolve());
+    EXPECT_EQ(resolver.error(), "12:34 error: array has nesting depth of 256, maximum is 255");
+}
+
+TEST_F(ResolverTest, MaxNestDepthOfCompositeType_ArrayOfStructInParallelFunctionBody_Invalid) {
+    auto* s = Structure("S", Vector{Member("m", ty.i32())});
+    uint32_t depth = 1;  // Depth of struct
+    uint32_t iterations = kMaxNestDepthOfCompositeType - depth;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        s = Structure("S" + std::to_string(i), Vector{Member("m", ty.Of(s))});
+    }
+    Func("f", tint::Empty, ty.void_(),
+         Vector{Decl(Var("v", ty.array(Source{{12, 34}}, ty.Of(s), 1_u)))});
+
+    Resolver resolver(this, wgsl::AllowedFeatures::Everything(), wgsl::ValidationMode::kFull, 4);
+    EXPECT_FALSE(resolver.Resolve());
+    EXPECT_EQ(resolver.error(), "12:34 error: array has nesting depth of 256, maximum is 255");
+}
+
 TEST_F(ResolverTest, PointerToHandleTextureParameter) {
     Func("helper",
          Vector{
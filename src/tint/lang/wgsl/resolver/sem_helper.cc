@@ -40,7 +40,8 @@
 
 namespace tint::resolver {
 
-SemHelper::SemHelper(ProgramBuilder* builder) : builder_(builder) {}
+SemHelper::SemHelper(ProgramBuilder* builder, diag::List& diagnostics)
+    : builder_(builder), diagnostics_(diagnostics) {}
 
 SemHelper::~SemHelper() = default;
 
@@ -224,14 +225,14 @@ void SemHelper::NoteDeclarationSource(const ast::Node* node) const {
 }
 
 diag::Diagnostic& SemHelper::AddError(const Source& source) const {
-    return builder_->Diagnostics().AddError(source);
+    return diagnostics_.AddError(source);
 }
 
 diag::Diagnostic& SemHelper::AddWarning(const Source& source) const {
-    return builder_->Diagnostics().AddWarning(source);
+    return diagnostics_.AddWarning(source);
 }
 
 diag::Diagnostic& SemHelper::AddNote(const Source& source) const {
-    return builder_->Diagnostics().AddNote(source);
+    return diagnostics_.AddNote(source);
 }
 }  // namespace tint::resolver
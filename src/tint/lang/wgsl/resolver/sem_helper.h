@@ -47,7 +47,8 @@ class SemHelper {
   public:
     /// Constructor
     /// @param builder the program builder
-    explicit SemHelper(ProgramBuilder* builder);
+    /// @param diagnostics the list that receives the diagnostics raised by the helper
+    SemHelper(ProgramBuilder* builder, diag::List& diagnostics);
     ~SemHelper();
 
     /// Get is a helper for obtaining the semantic node for the given AST node.
@@ -259,6 +260,7 @@ class SemHelper {
     diag::Diagnostic& AddNote(const Source& source) const;
 
     ProgramBuilder* builder_;
+    diag::List& diagnostics_;
 };
 
 }  // namespace tint::resolver
@@ -28,7 +28,9 @@
 #include "src/tint/lang/wgsl/resolver/uniformity.h"
 
 #include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -49,9 +51,11 @@
 #include "src/tint/lang/wgsl/sem/value_conversion.h"
 #include "src/tint/lang/wgsl/sem/variable.h"
 #include "src/tint/lang/wgsl/sem/while_statement.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/containers/hashset.h"
 #include "src/tint/utils/containers/map.h"
 #include "src/tint/utils/containers/scope_stack.h"
-#include "src/tint/utils/containers/unique_vector.h"
+#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/macros/defer.h"
 #include "src/tint/utils/memory/block_allocator.h"
 #include "src/tint/utils/rtti/switch.h"
@@ -145,17 +149,45 @@ struct Node {
     /// The function call argument index, if applicable.
     uint32_t arg_index = 0xffffffffu;
 
-    /// The set of edges from this node to other nodes in the graph.
-    UniqueVector<Node*, 4> edges;
+    /// The edges from this node to other nodes in the graph, in insertion order and without
+    /// duplicates.
+    Vector<Node*, 4> edges;
+
+    /// The set of destinations in `edges`, only populated once a node has more than
+    /// kMaxLinearEdgeSearch edges, so that most nodes can deduplicate with a linear search.
+    std::unique_ptr<Hashset<Node*, 16>> edge_set;
 
     /// The node that this node was visited from, or nullptr if not visited.
     Node* visited_from = nullptr;
 
+    /// `true` if this node has been reached by a traversal since the last reset.
+    bool reached = false;
+
+    /// The largest number of edges that will be searched linearly when adding a new edge.
+    static constexpr size_t kMaxLinearEdgeSearch = 16;
+
     /// Add an edge to the `to` node.
     /// @param to the destination node
     void AddEdge(Node* to) {
         TINT_ASSERT(to != nullptr);
-        edges.Add(to);
+        if (edge_set) {
+            if (edge_set->Add(to)) {
+                edges.Push(to);
+            }
+            return;
+        }
+        for (auto* edge : edges) {
+            if (edge == to) {
+                return;
+            }
+        }
+        edges.Push(to);
+        if (edges.Length() > kMaxLinearEdgeSearch) {
+            edge_set = std::make_unique<Hashset<Node*, 16>>();
+            for (auto* edge : edges) {
+                edge_set->Add(edge);
+            }
+        }
     }
 };
 
@@ -191,7 +223,11 @@ struct FunctionInfo {
     /// Constructor
     /// @param func the AST function
     /// @param b the program builder
-    FunctionInfo(const ast::Function* func, const ProgramBuilder& b) {
+    /// @param node_allocator the allocator used for the nodes of the graph
+    FunctionInfo(const ast::Function* func,
+                 const ProgramBuilder& b,
+                 BlockAllocator<Node>& node_allocator)
+        : nodes(node_allocator) {
         name = func->name->symbol.Name();
         callsite_tag = {CallSiteTag::CallSiteNoRestriction};
         function_tag = NoRestriction;
@@ -210,7 +246,7 @@ struct FunctionInfo {
         parameters.Resize(func->params.Length());
         for (size_t i = 0; i < func->params.Length(); i++) {
             auto* param = func->params[i];
-            auto param_name = param->name->symbol.Name();
+            auto param_name = param->name->symbol.NameView();
             auto* sem = b.Sem().Get(param);
             parameters[i].sem = sem;
 
@@ -242,8 +278,17 @@ struct FunctionInfo {
     /// The uniformity requirements of the function's parameters.
     Vector<ParameterInfo, 8> parameters;
 
-    /// The control flow graph.
-    BlockAllocator<Node> nodes;
+    /// The allocator for the nodes of the control flow graph. This is shared by all the functions
+    /// in the module.
+    BlockAllocator<Node>& nodes;
+
+    /// The nodes that have been reached by a traversal since the last call to ResetVisited().
+    Vector<Node*, 64> reached_nodes;
+
+#if TINT_DUMP_UNIFORMITY_GRAPH
+    /// The nodes of this function's control flow graph.
+    Vector<Node*, 64> all_nodes;
+#endif
 
     /// Special `RequiredToBeUniform` nodes.
     Node* required_to_be_uniform_error = nullptr;
@@ -312,6 +357,8 @@ struct FunctionInfo {
         auto* node = nodes.Create(ast);
 
 #if TINT_DUMP_UNIFORMITY_GRAPH
+        all_nodes.Push(node);
+
         // Make the tag unique and set it.
         // This only matters if we're dumping the graph.
         std::string tag = "";
@@ -330,11 +377,22 @@ struct FunctionInfo {
         return node;
     }
 
-    /// Reset the visited status of every node in the graph.
+    /// Mark a node as reached by a traversal.
+    /// @param node the node
+    void MarkReached(Node* node) {
+        if (!node->reached) {
+            node->reached = true;
+            reached_nodes.Push(node);
+        }
+    }
+
+    /// Reset the visited status of every node that has been reached since the last reset.
     void ResetVisited() {
-        for (auto* node : nodes.Objects()) {
+        for (auto* node : reached_nodes) {
             node->visited_from = nullptr;
+            node->reached = false;
         }
+        reached_nodes.Clear();
     }
 
   private:
@@ -393,8 +451,17 @@ class UniformityGraph {
     const sem::Info& sem_;
     diag::List& diagnostics_;
 
+    /// Allocator of the graph nodes for all functions.
+    BlockAllocator<Node> nodes_;
+
+    /// Allocator of the FunctionInfos.
+    BlockAllocator<FunctionInfo> function_infos_;
+
     /// Map of analyzed function results.
-    Hashmap<const ast::Function*, FunctionInfo, 8> functions_;
+    Hashmap<const ast::Function*, FunctionInfo*, 8> functions_;
+
+    /// The stack of nodes left to visit by Traverse(), kept to reuse its allocation.
+    Vector<Node*, 64> to_visit_;
 
     /// The function currently being analyzed.
     FunctionInfo* current_function_;
@@ -411,29 +478,34 @@ class UniformityGraph {
     /// Get the symbol name of an AST expression.
     /// @param expr the expression to get the symbol name of
     /// @returns the symbol name
-    inline std::string NameFor(const ast::IdentifierExpression* expr) {
-        return expr->identifier->symbol.Name();
+    inline std::string_view NameFor(const ast::IdentifierExpression* expr) {
+        return expr->identifier->symbol.NameView();
     }
 
     /// @param var the variable to get the name of
     /// @returns the name of the variable @p var
-    inline std::string NameFor(const ast::Variable* var) { return var->name->symbol.Name(); }
+    inline std::string_view NameFor(const ast::Variable* var) {
+        return var->name->symbol.NameView();
+    }
 
     /// @param var the variable to get the name of
     /// @returns the name of the variable @p var
-    inline std::string NameFor(const sem::Variable* var) { return NameFor(var->Declaration()); }
+    inline std::string_view NameFor(const sem::Variable* var) {
+        return NameFor(var->Declaration());
+    }
 
     /// @param fn the function to get the name of
     /// @returns the name of the function @p fn
-    inline std::string NameFor(const sem::Function* fn) {
-        return fn->Declaration()->name->symbol.Name();
+    inline std::string_view NameFor(const sem::Function* fn) {
+        return fn->Declaration()->name->symbol.NameView();
     }
 
     /// Process a function.
     /// @param func the function to process
     /// @returns true if there are no uniformity issues, false otherwise
     bool ProcessFunction(const ast::Function* func) {
-        current_function_ = &functions_.Add(func, FunctionInfo(func, b)).value;
+        current_function_ = function_infos_.Create(func, b, nodes_);
+        functions_.Add(func, current_function_);
 
         // Process function body.
         if (func->body) {
@@ -444,7 +516,7 @@ class UniformityGraph {
         // Dump the graph for this function as a subgraph.
         std::cout << "\nsubgraph cluster_" << current_function_->name << " {\n";
         std::cout << "  label=" << current_function_->name << ";";
-        for (auto* node : current_function_->nodes.Objects()) {
+        for (auto* node : current_function_->all_nodes) {
             std::cout << "\n  \"" << node->tag << "\";";
             for (auto* edge : node->edges) {
                 std::cout << "\n  \"" << node->tag << "\" -> \"" << edge->tag << "\";";
@@ -454,18 +526,18 @@ class UniformityGraph {
 #endif
 
         /// Helper to generate a tag for the uniformity requirements of the parameter at `index`.
-        auto get_param_tag = [&](UniqueVector<Node*, 4>& reachable, size_t index) {
+        auto get_param_tag = [&](size_t index) {
             auto* param = sem_.Get(func->params[index]);
             auto& param_info = current_function_->parameters[index];
             if (param->Type()->Is<core::type::Pointer>()) {
                 // For pointers, we distinguish between requiring uniformity of the contents versus
                 // the pointer itself.
-                if (reachable.Contains(param_info.ptr_input_contents)) {
+                if (param_info.ptr_input_contents->reached) {
                     return ParameterTag::ParameterContentsRequiredToBeUniform;
-                } else if (reachable.Contains(param_info.value)) {
+                } else if (param_info.value->reached) {
                     return ParameterTag::ParameterValueRequiredToBeUniform;
                 }
-            } else if (reachable.Contains(current_function_->variables.Get(param))) {
+            } else if (current_function_->variables.Get(param)->reached) {
                 // For non-pointers, the requirement is always on the value.
                 return ParameterTag::ParameterValueRequiredToBeUniform;
             }
@@ -474,14 +546,13 @@ class UniformityGraph {
 
         // Look at which nodes are reachable from "RequiredToBeUniform".
         {
-            UniqueVector<Node*, 4> reachable;
             auto traverse = [&](wgsl::DiagnosticSeverity severity) {
-                Traverse(current_function_->RequiredToBeUniform(severity), &reachable);
-                if (reachable.Contains(current_function_->may_be_non_uniform)) {
+                Traverse(*current_function_, current_function_->RequiredToBeUniform(severity));
+                if (current_function_->may_be_non_uniform->reached) {
                     MakeError(*current_function_, current_function_->may_be_non_uniform, severity);
                     return false;
                 }
-                if (reachable.Contains(current_function_->cf_start)) {
+                if (current_function_->cf_start->reached) {
                     if (current_function_->callsite_tag.tag == CallSiteTag::CallSiteNoRestriction) {
                         current_function_->callsite_tag = {CallSiteTag::CallSiteRequiredToBeUniform,
                                                            severity};
@@ -492,7 +563,7 @@ class UniformityGraph {
                 for (size_t i = 0; i < func->params.Length(); i++) {
                     if (current_function_->parameters[i].tag_direct.tag ==
                         ParameterTag::ParameterNoRestriction) {
-                        current_function_->parameters[i].tag_direct = {get_param_tag(reachable, i),
+                        current_function_->parameters[i].tag_direct = {get_param_tag(i),
                                                                        severity};
                     }
                 }
@@ -511,16 +582,15 @@ class UniformityGraph {
         if (current_function_->value_return) {
             current_function_->ResetVisited();
 
-            UniqueVector<Node*, 4> reachable;
-            Traverse(current_function_->value_return, &reachable);
-            if (reachable.Contains(current_function_->may_be_non_uniform)) {
+            Traverse(*current_function_, current_function_->value_return);
+            if (current_function_->may_be_non_uniform->reached) {
                 current_function_->function_tag = ReturnValueMayBeNonUniform;
             }
 
             // Set the tags to capture the uniformity requirements of each parameter with respect to
             // the function return value.
             for (size_t i = 0; i < func->params.Length(); i++) {
-                current_function_->parameters[i].tag_retval = {get_param_tag(reachable, i)};
+                current_function_->parameters[i].tag_retval = {get_param_tag(i)};
             }
         }
 
@@ -534,9 +604,8 @@ class UniformityGraph {
             // Reset "visited" state for all nodes.
             current_function_->ResetVisited();
 
-            UniqueVector<Node*, 4> reachable;
-            Traverse(param_info.ptr_output_contents, &reachable);
-            if (reachable.Contains(current_function_->may_be_non_uniform)) {
+            Traverse(*current_function_, param_info.ptr_output_contents);
+            if (current_function_->may_be_non_uniform->reached) {
                 param_info.pointer_may_become_non_uniform = true;
             }
 
@@ -544,7 +613,7 @@ class UniformityGraph {
             // This includes checking this parameter (as it may feed into its own output value), so
             // we do not skip the `i==j` case.
             for (size_t j = 0; j < func->params.Length(); j++) {
-                auto tag = get_param_tag(reachable, j);
+                auto tag = get_param_tag(j);
                 auto* source_param = sem_.Get(func->params[j]);
                 if (tag == ParameterTag::ParameterContentsRequiredToBeUniform) {
                     param_info.ptr_output_source_param_contents.Push(source_param);
@@ -1548,7 +1617,7 @@ class UniformityGraph {
     /// @param call the function call to process
     /// @returns a pair of (control flow node, value node)
     std::pair<Node*, Node*> ProcessCall(Node* cf, const ast::CallExpression* call) {
-        std::string name = NameFor(call->target);
+        std::string_view name = NameFor(call->target);
 
         // Process call arguments
         Node* cf_last_arg = cf;
@@ -1645,11 +1714,11 @@ class UniformityGraph {
             [&](const sem::Function* func) {
                 // We must have already analyzed the user-defined function since we process
                 // functions in dependency order.
-                auto info = functions_.Get(func->Declaration());
+                auto* info = functions_.GetOr(func->Declaration(), nullptr);
                 TINT_ASSERT(info);
                 callsite_tag = info->callsite_tag;
                 function_tag = info->function_tag;
-                func_info = info.value;
+                func_info = info;
             },
             [&](const sem::ValueConstructor*) {
                 callsite_tag = {CallSiteTag::CallSiteNoRestriction};
@@ -1755,24 +1824,23 @@ class UniformityGraph {
         return {cf_after, result};
     }
 
-    /// Traverse a graph starting at `source`, inserting all visited nodes into `reachable` and
-    /// recording which node they were reached from.
+    /// Traverse the graph of `function` starting at `source`, marking all visited nodes as reached
+    /// and recording which node they were reached from.
+    /// @param function the function that contains `source`
     /// @param source the starting node
-    /// @param reachable the set of reachable nodes to populate, if required
-    void Traverse(Node* source, UniqueVector<Node*, 4>* reachable = nullptr) {
-        Vector<Node*, 8> to_visit{source};
+    void Traverse(FunctionInfo& function, Node* source) {
+        to_visit_.Clear();
+        to_visit_.Push(source);
 
-        while (!to_visit.IsEmpty()) {
-            auto* node = to_visit.Back();
-            to_visit.Pop();
+        while (!to_visit_.IsEmpty()) {
+            auto* node = to_visit_.Back();
+            to_visit_.Pop();
 
-            if (reachable) {
-                reachable->Add(node);
-            }
+            function.MarkReached(node);
             for (auto* to : node->edges) {
                 if (to->visited_from == nullptr) {
                     to->visited_from = node;
-                    to_visit.Push(to);
+                    to_visit_.Push(to);
                 }
             }
         }
@@ -1806,7 +1874,7 @@ class UniformityGraph {
         } else if (auto* user = target->As<sem::Function>()) {
             // This is a call to a user-defined function, so inspect the functions called by that
             // function and look for one whose node has an edge from the RequiredToBeUniform node.
-            auto target_info = functions_.Get(user->Declaration());
+            auto* target_info = functions_.GetOr(user->Declaration(), nullptr);
             for (auto* call_node : target_info->RequiredToBeUniform(severity)->edges) {
                 if (call_node->type == Node::kRegular) {
                     auto* child_call = call_node->ast->As<ast::CallExpression>();
@@ -1828,7 +1896,7 @@ class UniformityGraph {
                                    Node* may_be_non_uniform) {
         // Traverse the graph to generate a path from the node to the source of non-uniformity.
         function.ResetVisited();
-        Traverse(required_to_be_uniform);
+        Traverse(function, required_to_be_uniform);
 
         // Get the source of the non-uniform value.
         auto* non_uniform_source = may_be_non_uniform;
@@ -1921,7 +1989,7 @@ class UniformityGraph {
                 switch (non_uniform_source->type) {
                     case Node::kFunctionCallReturnValue: {
                         diagnostics_.AddNote(c->source)
-                            << "return value of '" + target_name + "' may be non-uniform";
+                            << "return value of '" << target_name << "' may be non-uniform";
                         break;
                     }
                     case Node::kFunctionCallArgumentContents: {
@@ -1973,7 +2041,7 @@ class UniformityGraph {
 
         // Traverse the graph to generate a path from RequiredToBeUniform to the source node.
         function.ResetVisited();
-        Traverse(function.RequiredToBeUniform(severity));
+        Traverse(function, function.RequiredToBeUniform(severity));
         TINT_ASSERT(source_node->visited_from);
 
         // Find a node that is required to be uniform that has a path to the source node.
@@ -1994,7 +2062,7 @@ class UniformityGraph {
             auto* user_func = target->As<sem::Function>();
             if (user_func) {
                 // Recurse into the called function to show the reason for the requirement.
-                auto next_function = functions_.Get(user_func->Declaration());
+                auto* next_function = functions_.GetOr(user_func->Declaration(), nullptr);
                 auto& param_info = next_function->parameters[cause->arg_index];
                 MakeError(*next_function,
                           is_value ? param_info.value : param_info.ptr_input_contents, severity);
@@ -0,0 +1,154 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+#include "src/tint/lang/wgsl/resolver/dependency_graph.h"
+#include "src/tint/lang/wgsl/resolver/uniformity.h"
+
+namespace tint::resolver {
+namespace {
+
+/// @returns a generated shader with a chain of @p depth functions, each of which calls the next
+/// under control flow that depends on its parameters, ending in a call to a barrier.
+std::string GenerateCallChain(size_t depth) {
+    std::string wgsl = "@group(0) @binding(0) var<storage, read_write> buf : array<i32>;\n\n";
+    wgsl += "fn f0(a : i32, b : ptr<function, i32>) -> i32 {\n";
+    wgsl += "    workgroupBarrier();\n";
+    wgsl += "    *b += a;\n";
+    wgsl += "    buf[a] = buf[a + 1];\n";
+    wgsl += "    return a + 1;\n";
+    wgsl += "}\n\n";
+    for (size_t i = 1; i <= depth; i++) {
+        std::string n = std::to_string(i);
+        std::string prev = std::to_string(i - 1);
+        wgsl += "fn f" + n + "(a : i32, b : ptr<function, i32>) -> i32 {\n";
+        wgsl += "    var x = a;\n";
+        wgsl += "    if (x > " + n + ") {\n";
+        wgsl += "        x = f" + prev + "(x, b);\n";
+        wgsl += "    }\n";
+        wgsl += "    buf[x] = buf[*b];\n";
+        wgsl += "    return f" + prev + "(x + *b, b);\n";
+        wgsl += "}\n\n";
+    }
+    wgsl += "@compute @workgroup_size(1)\n";
+    wgsl += "fn main() {\n";
+    wgsl += "    var b = 0;\n";
+    wgsl += "    buf[0] = f" + std::to_string(depth) + "(1, &b);\n";
+    wgsl += "}\n";
+    return wgsl;
+}
+
+/// @returns a generated shader with @p count functions, each of which contains a switch nested
+/// in loops that assign to local variables.
+std::string GenerateControlFlow(size_t count) {
+    std::string wgsl = "@group(0) @binding(0) var<storage, read_write> buf : array<i32>;\n\n";
+    wgsl += "fn g0(a : i32) -> i32 {\n";
+    wgsl += "    return a;\n";
+    wgsl += "}\n\n";
+    for (size_t i = 1; i <= count; i++) {
+        std::string n = std::to_string(i);
+        wgsl += "fn g" + n + "(a : i32) -> i32 {\n";
+        wgsl += "    var r = a;\n";
+        wgsl += "    var s = 0;\n";
+        wgsl += "    for (var j = 0; j < 4; j++) {\n";
+        wgsl += "        loop {\n";
+        wgsl += "            switch (r & 15) {\n";
+        for (size_t c = 0; c < 15; c++) {
+            std::string k = std::to_string(c);
+            wgsl += "                case " + k + ": {\n";
+            wgsl += "                    s += r + " + k + ";\n";
+            wgsl += "                    if (s > " + k + ") {\n";
+            wgsl += "                        r = s;\n";
+            wgsl += "                        break;\n";
+            wgsl += "                    }\n";
+            wgsl += "                    r += j;\n";
+            wgsl += "                }\n";
+        }
+        wgsl += "                default: {\n";
+        wgsl += "                    buf[r] = s;\n";
+        wgsl += "                }\n";
+        wgsl += "            }\n";
+        wgsl += "            if (r == 0) {\n";
+        wgsl += "                workgroupBarrier();\n";
+        wgsl += "            }\n";
+        wgsl += "            continuing {\n";
+        wgsl += "                s += 1;\n";
+        wgsl += "                break if s > 64;\n";
+        wgsl += "            }\n";
+        wgsl += "        }\n";
+        wgsl += "    }\n";
+        wgsl += "    return g" + std::to_string(i - 1) + "(r + s);\n";
+        wgsl += "}\n\n";
+    }
+    wgsl += "@compute @workgroup_size(1)\n";
+    wgsl += "fn main() {\n";
+    wgsl += "    buf[0] = g" + std::to_string(count) + "(1);\n";
+    wgsl += "}\n";
+    return wgsl;
+}
+
+/// Parses and resolves @p wgsl once, then measures the time taken to analyze the uniformity of
+/// the resolved program.
+void RunUniformityAnalysis(benchmark::State& state, const std::string& wgsl) {
+    Source::File file("generated.wgsl", wgsl);
+    auto program = wgsl::reader::Parse(&file);
+    if (program.Diagnostics().ContainsErrors()) {
+        state.SkipWithError(program.Diagnostics().Str());
+        return;
+    }
+    auto builder = ProgramBuilder::Wrap(program);
+    DependencyGraph dependency_graph;
+    if (!DependencyGraph::Build(builder.AST(), builder.Diagnostics(), dependency_graph)) {
+        state.SkipWithError(builder.Diagnostics().Str());
+        return;
+    }
+    for (auto _ : state) {
+        if (!AnalyzeUniformity(builder, dependency_graph)) {
+            state.SkipWithError(builder.Diagnostics().Str());
+            return;
+        }
+    }
+}
+
+void UniformityCallChain(benchmark::State& state) {
+    RunUniformityAnalysis(state, GenerateCallChain(static_cast<size_t>(state.range(0))));
+}
+
+void UniformityControlFlow(benchmark::State& state) {
+    RunUniformityAnalysis(state, GenerateControlFlow(static_cast<size_t>(state.range(0))));
+}
+
+BENCHMARK(UniformityCallChain)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(UniformityControlFlow)->Arg(16)->Arg(64)->Arg(256);
+
+}  // namespace
+}  // namespace tint::resolver
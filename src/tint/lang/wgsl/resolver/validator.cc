@@ -173,6 +173,7 @@ void TraverseCallChain(const sem::Function* from, const sem::Function* to, CALLB
 
 Validator::Validator(
     ProgramBuilder* builder,
+    diag::List& diagnostics,
     SemHelper& sem,
     const wgsl::Extensions& enabled_extensions,
     const wgsl::AllowedFeatures& allowed_features,
@@ -180,7 +181,7 @@ Validator::Validator(
     const Hashmap<const core::type::Type*, const Source*, 8>& atomic_composite_info,
     Hashset<TypeAndAddressSpace, 8>& valid_type_storage_layouts)
     : symbols_(builder->Symbols()),
-      diagnostics_(builder->Diagnostics()),
+      diagnostics_(diagnostics),
       sem_(sem),
       enabled_extensions_(enabled_extensions),
       allowed_features_(allowed_features),
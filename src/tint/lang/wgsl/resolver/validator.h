@@ -125,6 +125,7 @@ class Validator {
   public:
     /// Constructor
     /// @param builder the program builder
+    /// @param diagnostics the list that receives the diagnostics raised by the validator
     /// @param helper the SEM helper to validate with
     /// @param enabled_extensions all the extensions declared in current module
     /// @param allowed_features the allowed extensions and features
@@ -132,6 +133,7 @@ class Validator {
     /// @param atomic_composite_info atomic composite info of the module
     /// @param valid_type_storage_layouts a set of validated type layouts by address space
     Validator(ProgramBuilder* builder,
+              diag::List& diagnostics,
               SemHelper& helper,
               const wgsl::Extensions& enabled_extensions,
               const wgsl::AllowedFeatures& allowed_features,
@@ -161,6 +163,9 @@ class Validator {
     /// @returns the diagnostic filter stack
     DiagnosticFilterStack& DiagnosticFilters() { return diagnostic_filters_; }
 
+    /// @returns the validation mode
+    wgsl::ValidationMode Mode() const { return mode_; }
+
     /// @param type the given type
     /// @returns true if the given type is a plain type
     bool IsPlain(const core::type::Type* type) const;
@@ -28,6 +28,7 @@
 #include "src/tint/utils/diagnostic/source.h"
 
 #include <algorithm>
+#include <mutex>
 #include <string_view>
 #include <utility>
 
@@ -38,105 +39,68 @@
 namespace tint {
 namespace {
 
-bool ParseLineBreak(std::string_view str, size_t i, bool* is_line_break, size_t* line_break_size) {
-    // See https://www.w3.org/TR/WGSL/#blankspace
-
-    auto* utf8 = reinterpret_cast<const uint8_t*>(&str[i]);
-    auto [cp, n] = tint::utf8::Decode(utf8, str.size() - i);
-
-    if (n == 0) {
-        return false;
-    }
-
-    static const auto kLF = tint::CodePoint(0x000A);    // line feed
-    static const auto kVTab = tint::CodePoint(0x000B);  // vertical tab
-    static const auto kFF = tint::CodePoint(0x000C);    // form feed
-    static const auto kNL = tint::CodePoint(0x0085);    // next line
-    static const auto kCR = tint::CodePoint(0x000D);    // carriage return
-    static const auto kLS = tint::CodePoint(0x2028);    // line separator
-    static const auto kPS = tint::CodePoint(0x2029);    // parargraph separator
-
-    if (cp == kLF || cp == kVTab || cp == kFF || cp == kNL || cp == kPS || cp == kLS) {
-        *is_line_break = true;
-        *line_break_size = n;
-        return true;
-    }
-
-    // Handle CRLF as one line break, and CR alone as one line break
-    if (cp == kCR) {
-        *is_line_break = true;
-        *line_break_size = n;
-
-        if (auto next_i = i + n; next_i < str.size()) {
-            auto* next_utf8 = reinterpret_cast<const uint8_t*>(&str[next_i]);
-            auto [next_cp, next_n] = tint::utf8::Decode(next_utf8, str.size() - next_i);
-
-            if (next_n == 0) {
-                return false;
-            }
-
-            if (next_cp == kLF) {
-                // CRLF as one break
-                *line_break_size = n + next_n;
-            }
-        }
-
-        return true;
-    }
-
-    *is_line_break = false;
-    return true;
-}
-
 std::vector<std::string_view> SplitLines(std::string_view str) {
     std::vector<std::string_view> lines;
 
-    size_t lineStart = 0;
-    for (size_t i = 0; i < str.size();) {
-        bool is_line_break{};
-        size_t line_break_size{};
-        // We don't handle decode errors from ParseLineBreak. Instead, we rely on
-        // the Lexer to do so.
-        ParseLineBreak(str, i, &is_line_break, &line_break_size);
-        if (is_line_break) {
-            lines.push_back(str.substr(lineStart, i - lineStart));
-            i += line_break_size;
-            lineStart = i;
-        } else {
-            ++i;
-        }
-    }
-    if (lineStart < str.size()) {
-        lines.push_back(str.substr(lineStart));
+    size_t line_start = 0;
+    while (line_start < str.size()) {
+        auto line_break = FindLineBreak(str, line_start);
+        lines.push_back(str.substr(line_start, line_break.offset - line_start));
+        line_start = line_break.offset + line_break.size;
     }
 
     return lines;
 }
 
-std::vector<std::string_view> CopyRelativeStringViews(const std::vector<std::string_view>& src_list,
-                                                      const std::string_view& src_view,
-                                                      const std::string_view& dst_view) {
-    std::vector<std::string_view> out(src_list.size());
-    for (size_t i = 0; i < src_list.size(); i++) {
-        if (src_list[i].empty()) {
-            continue;
+}  // namespace
+
+LineBreak FindLineBreak(std::string_view str, size_t offset) {
+    static const auto kNL = tint::CodePoint(0x0085);  // next line
+    static const auto kLS = tint::CodePoint(0x2028);  // line separator
+    static const auto kPS = tint::CodePoint(0x2029);  // paragraph separator
+
+    for (size_t i = offset; i < str.size(); i++) {
+        auto c = static_cast<uint8_t>(str[i]);
+        switch (c) {
+            case 0x0A:  // line feed
+            case 0x0B:  // vertical tab
+            case 0x0C:  // form feed
+                return {i, 1};
+            case 0x0D:  // carriage return
+                // Handle CRLF as one line break, and CR alone as one line break
+                return {i, (i + 1 < str.size() && str[i + 1] == '\n') ? 2u : 1u};
+            default:
+                break;
+        }
+        if (c >= 0xC0) {
+            // Only multi-byte code points can be the other line breaks. Invalid UTF-8 is not
+            // handled here. Instead, we rely on the Lexer to do so.
+            auto [cp, n] = tint::utf8::Decode(reinterpret_cast<const uint8_t*>(&str[i]),
+                                              str.size() - i);
+            if (n > 0 && (cp == kNL || cp == kLS || cp == kPS)) {
+                return {i, n};
+            }
         }
-        auto offset = static_cast<size_t>(&src_list[i].front() - &src_view.front());
-        auto count = src_list[i].length();
-        out[i] = dst_view.substr(offset, count);
     }
-    return out;
+    return {str.size(), 0};
 }
 
-}  // namespace
+Source::FileContent::FileContent(std::string_view body) : owned_(body), data(owned_) {}
 
-Source::FileContent::FileContent(std::string_view body) : data(body), lines(SplitLines(data)) {}
+Source::FileContent::FileContent(std::string_view body, BorrowTag) : data(body) {}
 
 Source::FileContent::FileContent(const FileContent& rhs)
-    : data(rhs.data), lines(CopyRelativeStringViews(rhs.lines, rhs.data, data)) {}
+    : owned_(rhs.owned_),
+      // Borrowed content does not point into the (empty) copy
+      data(rhs.data.data() == rhs.owned_.data() ? std::string_view(owned_) : rhs.data) {}
 
 Source::FileContent::~FileContent() = default;
 
+const std::vector<std::string_view>& Source::FileContent::Lines() const {
+    std::call_once(lines_once_, [&] { lines_ = SplitLines(data); });
+    return lines_;
+}
+
 Source::File::~File() = default;
 
 std::string ToString(const Source& source) {
@@ -162,11 +126,12 @@ std::string ToString(const Source& source) {
                 }
             };
 
+            auto& lines = source.file->content.Lines();
             for (size_t line = rng.begin.line; line <= rng.end.line; line++) {
-                if (line < source.file->content.lines.size() + 1) {
-                    auto len = source.file->content.lines[line - 1].size();
+                if (line < lines.size() + 1) {
+                    auto len = lines[line - 1].size();
 
-                    out << source.file->content.lines[line - 1] << "\n";
+                    out << lines[line - 1] << "\n";
 
                     if (line == rng.begin.line && line == rng.end.line) {
                         // Single line
@@ -196,19 +161,20 @@ size_t Source::Range::Length(const FileContent& content) const {
     TINT_ASSERT(begin <= end);
     TINT_ASSERT(begin.column > 0);
     TINT_ASSERT(begin.line > 0);
-    TINT_ASSERT(end.line <= 1 + content.lines.size());
-    TINT_ASSERT(end.column <= 1 + content.lines[end.line - 1].size());
+    auto& lines = content.Lines();
+    TINT_ASSERT(end.line <= 1 + lines.size());
+    TINT_ASSERT(end.column <= 1 + lines[end.line - 1].size());
 
     if (end.line == begin.line) {
         return end.column - begin.column;
     }
 
-    size_t len = (content.lines[begin.line - 1].size() + 1 - begin.column) +  // first line
-                 (end.column - 1) +                                           // last line
-                 end.line - begin.line;                                       // newlines
+    size_t len = (lines[begin.line - 1].size() + 1 - begin.column) +  // first line
+                 (end.column - 1) +                                   // last line
+                 end.line - begin.line;                               // newlines
 
     for (size_t line = begin.line + 1; line < end.line; line++) {
-        len += content.lines[line - 1].size();  // whole-lines
+        len += lines[line - 1].size();  // whole-lines
     }
     return len;
 }
@@ -29,6 +29,7 @@
 #ifndef SRC_TINT_UTILS_DIAGNOSTIC_SOURCE_H_
 #define SRC_TINT_UTILS_DIAGNOSTIC_SOURCE_H_
 
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -42,34 +43,66 @@ namespace tint {
 /// Source describes a range of characters within a source file.
 class Source {
   public:
+    /// BorrowTag is the type of kBorrow.
+    struct BorrowTag {};
+
+    /// kBorrow is passed to the FileContent and File constructors to refer to the file content
+    /// without copying it.
+    static constexpr BorrowTag kBorrow{};
+
     /// FileContent describes the content of a source file encoded using UTF-8.
     class FileContent {
       public:
-        /// Constructs the FileContent with the given file content.
+        /// Constructs the FileContent with a copy of the given file content.
         /// @param data the file contents
         explicit FileContent(std::string_view data);
 
-        /// Copy constructor
+        /// Constructs the FileContent that refers to the given file content without copying it.
+        /// @param data the file contents, which must outlive this FileContent and its copies
+        FileContent(std::string_view data, BorrowTag);
+
+        /// Copy constructor. The copy holds a copy of the file content if @p rhs does, otherwise
+        /// the copy refers to the same borrowed content.
         /// @param rhs the FileContent to copy
         FileContent(const FileContent& rhs);
 
         /// Destructor
         ~FileContent();
 
+        /// @returns #data split by lines. The lines are split on the first call, as they are
+        /// usually only needed to print diagnostics.
+        const std::vector<std::string_view>& Lines() const;
+
+      private:
+        /// The copy of the file content, if the content is not borrowed
+        const std::string owned_;
+
+      public:
         /// The original un-split file content
-        const std::string data;
-        /// #data split by lines
-        const std::vector<std::string_view> lines;
+        const std::string_view data;
+
+      private:
+        /// Guards the initialization of #lines_
+        mutable std::once_flag lines_once_;
+        /// #data split by lines, built by Lines()
+        mutable std::vector<std::string_view> lines_;
     };
 
     /// File describes a source file, including path and content.
     class File {
       public:
-        /// Constructs the File with the given file path and content.
+        /// Constructs the File with the given file path and a copy of the content.
         /// @param p the path for this file
         /// @param c the file contents
         inline File(const std::string& p, std::string_view c) : path(p), content(c) {}
 
+        /// Constructs the File with the given file path, referring to the content without copying
+        /// it.
+        /// @param p the path for this file
+        /// @param c the file contents, which must outlive this File and its copies
+        inline File(const std::string& p, std::string_view c, BorrowTag)
+            : path(p), content(c, kBorrow) {}
+
         /// Copy constructor
         File(const File&) = default;
 
@@ -234,6 +267,20 @@ class Source {
     const File* file = nullptr;
 };
 
+/// LineBreak describes a line break in a string.
+struct LineBreak {
+    /// The byte offset of the line break, or the length of the string if there is no line break
+    size_t offset = 0;
+    /// The length of the line break in bytes, or 0 if there is no line break
+    size_t size = 0;
+};
+
+/// @param str the UTF-8 string to search
+/// @param offset the byte offset to start searching from
+/// @returns the first line break in @p str at or after @p offset. CRLF is a single line break.
+/// @see https://www.w3.org/TR/WGSL/#blankspace-and-line-breaks for the definition of a line break.
+LineBreak FindLineBreak(std::string_view str, size_t offset);
+
 /// @param source the input Source
 /// @returns a string that describes given source location
 std::string ToString(const Source& source);
@@ -29,6 +29,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <utility>
 
@@ -48,11 +49,11 @@ using SourceFileContentTest = testing::Test;
 TEST_F(SourceFileContentTest, Init) {
     Source::FileContent fc(kSource);
     EXPECT_EQ(fc.data, kSource);
-    ASSERT_EQ(fc.lines.size(), 4u);
-    EXPECT_EQ(fc.lines[0], "line one");
-    EXPECT_EQ(fc.lines[1], "line two");
-    EXPECT_EQ(fc.lines[2], "");
-    EXPECT_EQ(fc.lines[3], "line three");
+    ASSERT_EQ(fc.Lines().size(), 4u);
+    EXPECT_EQ(fc.Lines()[0], "line one");
+    EXPECT_EQ(fc.Lines()[1], "line two");
+    EXPECT_EQ(fc.Lines()[2], "");
+    EXPECT_EQ(fc.Lines()[3], "line three");
 }
 
 TEST_F(SourceFileContentTest, CopyInit) {
@@ -60,11 +61,11 @@ TEST_F(SourceFileContentTest, CopyInit) {
     Source::FileContent fc{*src};
     src.reset();
     EXPECT_EQ(fc.data, kSource);
-    ASSERT_EQ(fc.lines.size(), 4u);
-    EXPECT_EQ(fc.lines[0], "line one");
-    EXPECT_EQ(fc.lines[1], "line two");
-    EXPECT_EQ(fc.lines[2], "");
-    EXPECT_EQ(fc.lines[3], "line three");
+    ASSERT_EQ(fc.Lines().size(), 4u);
+    EXPECT_EQ(fc.Lines()[0], "line one");
+    EXPECT_EQ(fc.Lines()[1], "line two");
+    EXPECT_EQ(fc.Lines()[2], "");
+    EXPECT_EQ(fc.Lines()[3], "line three");
 }
 
 TEST_F(SourceFileContentTest, MoveInit) {
@@ -72,11 +73,66 @@ TEST_F(SourceFileContentTest, MoveInit) {
     Source::FileContent fc{std::move(*src)};
     src.reset();
     EXPECT_EQ(fc.data, kSource);
-    ASSERT_EQ(fc.lines.size(), 4u);
-    EXPECT_EQ(fc.lines[0], "line one");
-    EXPECT_EQ(fc.lines[1], "line two");
-    EXPECT_EQ(fc.lines[2], "");
-    EXPECT_EQ(fc.lines[3], "line three");
+    ASSERT_EQ(fc.Lines().size(), 4u);
+    EXPECT_EQ(fc.Lines()[0], "line one");
+    EXPECT_EQ(fc.Lines()[1], "line two");
+    EXPECT_EQ(fc.Lines()[2], "");
+    EXPECT_EQ(fc.Lines()[3], "line three");
+}
+
+TEST_F(SourceFileContentTest, Borrow) {
+    std::string src(kSource);
+    Source::FileContent fc(src, Source::kBorrow);
+    EXPECT_EQ(fc.data.data(), src.data());
+    ASSERT_EQ(fc.Lines().size(), 4u);
+    EXPECT_EQ(fc.Lines()[0], "line one");
+    EXPECT_EQ(fc.Lines()[3], "line three");
+    EXPECT_EQ(fc.Lines()[3].data(), src.data() + src.find("line three"));
+}
+
+TEST_F(SourceFileContentTest, CopyBorrowed) {
+    std::string src(kSource);
+    auto borrowed = std::make_unique<Source::FileContent>(src, Source::kBorrow);
+    Source::FileContent fc{*borrowed};
+    borrowed.reset();
+    EXPECT_EQ(fc.data.data(), src.data());
+    ASSERT_EQ(fc.Lines().size(), 4u);
+    EXPECT_EQ(fc.Lines()[1], "line two");
+}
+
+TEST_F(SourceFileContentTest, CopyDoesNotBorrow) {
+    std::string src(kSource);
+    Source::FileContent fc(src);
+    EXPECT_NE(fc.data.data(), src.data());
+    src = "changed";
+    EXPECT_EQ(fc.data, kSource);
+}
+
+TEST_F(SourceFileContentTest, Empty) {
+    Source::FileContent fc("");
+    EXPECT_EQ(fc.data, "");
+    EXPECT_EQ(fc.Lines().size(), 0u);
+}
+
+TEST_F(SourceFileContentTest, TrailingLineBreak) {
+    Source::FileContent fc("a\nb\n");
+    ASSERT_EQ(fc.Lines().size(), 2u);
+    EXPECT_EQ(fc.Lines()[0], "a");
+    EXPECT_EQ(fc.Lines()[1], "b");
+}
+
+TEST_F(SourceFileContentTest, FindLineBreak) {
+    std::string_view src = "ab\r\ncd\xE2\x80\xA8"  // CRLF, LS
+                           "e";
+    auto crlf = FindLineBreak(src, 0);
+    EXPECT_EQ(crlf.offset, 2u);
+    EXPECT_EQ(crlf.size, 2u);
+    auto ls = FindLineBreak(src, crlf.offset + crlf.size);
+    EXPECT_EQ(ls.offset, 6u);
+    EXPECT_EQ(ls.size, 3u);
+    auto none = FindLineBreak(src, ls.offset + ls.size);
+    EXPECT_EQ(none.offset, src.size());
+    EXPECT_EQ(none.size, 0u);
 }
 
 // Line break code points
@@ -95,9 +151,9 @@ TEST_P(LineBreakTest, Single) {
     src += "line two";
 
     Source::FileContent fc(src);
-    EXPECT_EQ(fc.lines.size(), 2u);
-    EXPECT_EQ(fc.lines[0], "line one");
-    EXPECT_EQ(fc.lines[1], "line two");
+    EXPECT_EQ(fc.Lines().size(), 2u);
+    EXPECT_EQ(fc.Lines()[0], "line one");
+    EXPECT_EQ(fc.Lines()[1], "line two");
 }
 TEST_P(LineBreakTest, Double) {
     std::string src = "line one";
@@ -106,10 +162,10 @@ TEST_P(LineBreakTest, Double) {
     src += "line two";
 
     Source::FileContent fc(src);
-    EXPECT_EQ(fc.lines.size(), 3u);
-    EXPECT_EQ(fc.lines[0], "line one");
-    EXPECT_EQ(fc.lines[1], "");
-    EXPECT_EQ(fc.lines[2], "line two");
+    EXPECT_EQ(fc.Lines().size(), 3u);
+    EXPECT_EQ(fc.Lines()[0], "line one");
+    EXPECT_EQ(fc.Lines()[1], "");
+    EXPECT_EQ(fc.Lines()[2], "line two");
 }
 INSTANTIATE_TEST_SUITE_P(SourceFileContentTest,
                          LineBreakTest,
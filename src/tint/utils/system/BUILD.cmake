@@ -40,6 +40,7 @@
 ################################################################################
 tint_add_target(tint_utils_system lib
   utils/system/env.h
+  utils/system/parallel_for.h
   utils/system/terminal.h
 )
 
@@ -53,6 +54,10 @@ tint_target_add_dependencies(tint_utils_system lib
   tint_utils_traits
 )
 
+tint_target_add_external_dependencies(tint_utils_system lib
+  "thread"
+)
+
 if((NOT TINT_BUILD_IS_LINUX) AND (NOT TINT_BUILD_IS_MAC) AND (NOT TINT_BUILD_IS_WIN))
   tint_target_add_sources(tint_utils_system lib
     "utils/system/terminal_other.cc"
@@ -77,3 +82,27 @@ if(TINT_BUILD_IS_WIN)
     "utils/system/terminal_windows.cc"
   )
 endif(TINT_BUILD_IS_WIN)
+
+################################################################################
+# Target:    tint_utils_system_test
+# Kind:      test
+################################################################################
+tint_add_target(tint_utils_system_test test
+  utils/system/parallel_for_test.cc
+)
+
+tint_target_add_dependencies(tint_utils_system_test test
+  tint_utils_containers
+  tint_utils_ice
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+  tint_utils_rtti
+  tint_utils_system
+  tint_utils_traits
+)
+
+tint_target_add_external_dependencies(tint_utils_system_test test
+  "gtest"
+  "thread"
+)
@@ -0,0 +1,90 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "src/tint/utils/system/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace tint {
+namespace {
+
+TEST(ParallelForTest, NoIndices) {
+    bool called = false;
+    ParallelFor(0, 4, [&](size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(ParallelForTest, SingleThread) {
+    std::vector<size_t> indices;
+    ParallelFor(5, 1, [&](size_t i) { indices.push_back(i); });
+    EXPECT_THAT(indices, testing::ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(ParallelForTest, EachIndexOnce) {
+    constexpr size_t kCount = 1000;
+    std::vector<std::atomic<uint32_t>> calls(kCount);
+    ParallelFor(kCount, 4, [&](size_t i) { calls[i]++; });
+    for (size_t i = 0; i < kCount; i++) {
+        EXPECT_EQ(calls[i], 1u) << "index " << i;
+    }
+}
+
+TEST(ParallelForTest, UsesMultipleThreads) {
+    constexpr uint32_t kThreads = 4;
+    std::mutex mutex;
+    std::vector<std::thread::id> ids;
+    std::atomic<uint32_t> started{0};
+    ParallelFor(kThreads, kThreads, [&](size_t) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ids.push_back(std::this_thread::get_id());
+        }
+        // Block until every index is running, so that each one is on its own thread.
+        started++;
+        while (started < kThreads) {
+            std::this_thread::yield();
+        }
+    });
+    ASSERT_EQ(ids.size(), kThreads);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+TEST(ParallelForTest, FewerIndicesThanThreads) {
+    std::atomic<uint32_t> calls{0};
+    ParallelFor(2, 8, [&](size_t) { calls++; });
+    EXPECT_EQ(calls, 2u);
+}
+
+}  // namespace
+}  // namespace tint